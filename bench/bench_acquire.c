@@ -0,0 +1,181 @@
+/*
+* If not stated otherwise in this file or this component's LICENSE file the
+* following copyright and licenses apply:*
+* Copyright 2023 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+/**
+* @file bench_acquire.c
+*
+* Lease acquisition mode of dhcp4_hal_bench.
+*
+* Measures what a boot-time SLA sees: how long from starting the DHCP client
+* until the HAL reports the eRouter BOUND. Each run drops the lease, starts
+* the client against the DHCP server stand-in of the L2 tests
+* (src/test_l2_standin.h), and polls the FSM state getter until it reports
+* BOUND with a new address. The DISCOVER, OFFER, REQUEST and ACK of that
+* transaction are taken from the server log, splitting each run into:
+*
+* - start to DISCOVER: client start-up until its first DISCOVER arrives
+* - DISCOVER to OFFER and REQUEST to ACK: the server
+* - OFFER to REQUEST: the client selecting the offer
+* - ACK to HAL BOUND: the client applying the lease and the HAL noticing it
+*
+* All times are CLOCK_MONOTONIC, shared by the server's network namespace.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "test_l2_standin.h"
+#include "bench_common.h"
+
+/* ISC dhclient numbering, as used by the skeletons; adjust for HALs that number states differently */
+#define BENCH_FSM_BOUND  5
+
+enum
+{
+    PHASE_START_DISCOVER = 0,
+    PHASE_DISCOVER_OFFER,
+    PHASE_OFFER_REQUEST,
+    PHASE_REQUEST_ACK,
+    PHASE_ACK_BOUND,
+    PHASE_TOTAL,
+    PHASE_COUNT
+};
+
+static const char *gPhaseNames[PHASE_COUNT] =
+{
+    "client start -> DISCOVER",
+    "DISCOVER -> OFFER",
+    "OFFER -> REQUEST",
+    "REQUEST -> ACK",
+    "ACK -> HAL BOUND",
+    "client start -> HAL BOUND"
+};
+
+typedef struct
+{
+    int (*getFsmState)( void *pOut );
+    int (*getIpAddr)( void *pOut );
+    uint32_t before;
+} bound_probe_t;
+
+static int hal_bound( void *pContext, uint32_t *pAddr )
+{
+    bound_probe_t *pProbe = (bound_probe_t *)pContext;
+    int state = 0;
+
+    if (pProbe->getFsmState(&state) != 0 || state != BENCH_FSM_BOUND)
+    {
+        return 0;
+    }
+    return pProbe->getIpAddr(pAddr) == 0 && *pAddr != 0 && *pAddr != pProbe->before;
+}
+
+static uint64_t elapsed( uint64_t from, uint64_t to )
+{
+    return (to > from) ? to - from : 0;
+}
+
+static void print_us( uint64_t ns )
+{
+    printf(" %10.1f", (double)ns / 1000.0);
+}
+
+int bench_run_acquire( const char *pSuiteName, int (*getFsmState)( void *pOut ), int (*getIpAddr)( void *pOut ), const bench_config_t *pConfig )
+{
+    l2_standin_timeline_t timeline;
+    bench_result_t result;
+    bound_probe_t probe;
+    uint64_t *pSamples[PHASE_COUNT];
+    uint32_t failures = 0;
+    uint32_t count = 0;
+    uint32_t run;
+    int phase;
+
+    if (pConfig->runs == 0)
+    {
+        return 0;
+    }
+    l2_standin_setup();
+    if (!l2_standin_ready())
+    {
+        fprintf(stderr, "bench: [%s] needs root, the ip utility and dhcp_standin (see DHCP_L2_STANDIN)\n", pSuiteName);
+        return -1;
+    }
+    for (phase = 0; phase < PHASE_COUNT; phase++)
+    {
+        pSamples[phase] = malloc(sizeof(uint64_t) * pConfig->runs);
+        if (pSamples[phase] == NULL)
+        {
+            fprintf(stderr, "bench: cannot allocate %u samples\n", pConfig->runs);
+            while (phase-- > 0)
+            {
+                free(pSamples[phase]);
+            }
+            l2_standin_cleanup();
+            return -1;
+        }
+    }
+
+    probe.getFsmState = getFsmState;
+    probe.getIpAddr = getIpAddr;
+    for (run = 0; run < pConfig->runs; run++)
+    {
+        /* Every run starts unbound, as after a reboot */
+        if (l2_standin_release() != 0 || getIpAddr(&probe.before) != 0)
+        {
+            probe.before = 0;
+        }
+        if (l2_standin_timeline(hal_bound, &probe, &timeline) != 0 ||
+            timeline.discover_ns == 0 || timeline.offer_ns == 0 || timeline.request_ns == 0)
+        {
+            failures++;
+            continue;
+        }
+        pSamples[PHASE_START_DISCOVER][count] = elapsed(timeline.start_ns, timeline.discover_ns);
+        pSamples[PHASE_DISCOVER_OFFER][count] = elapsed(timeline.discover_ns, timeline.offer_ns);
+        pSamples[PHASE_OFFER_REQUEST][count] = elapsed(timeline.offer_ns, timeline.request_ns);
+        pSamples[PHASE_REQUEST_ACK][count] = elapsed(timeline.request_ns, timeline.ack_ns);
+        pSamples[PHASE_ACK_BOUND][count] = elapsed(timeline.ack_ns, timeline.visible_ns);
+        pSamples[PHASE_TOTAL][count] = elapsed(timeline.start_ns, timeline.visible_ns);
+        count++;
+    }
+    l2_standin_cleanup();
+
+    printf("\n[%s] runs=%u bound=%u fails=%u\n", pSuiteName, pConfig->runs, count, failures);
+    printf("%-42s %10s %10s %10s %10s\n", "phase", "min(us)", "median", "p99", "max");
+    for (phase = 0; phase < PHASE_COUNT && count > 0; phase++)
+    {
+        bench_summarise(pSamples[phase], count, &result);
+        printf("%-42s", gPhaseNames[phase]);
+        print_us(result.min_ns);
+        print_us(result.median_ns);
+        print_us(result.p99_ns);
+        print_us(result.max_ns);
+        printf("\n");
+        if (pConfig->histogram)
+        {
+            bench_print_histogram(pSamples[phase], count);
+        }
+    }
+
+    for (phase = 0; phase < PHASE_COUNT; phase++)
+    {
+        free(pSamples[phase]);
+    }
+    return (failures == 0) ? 0 : -1;
+}
@@ -0,0 +1,282 @@
+/*
+* If not stated otherwise in this file or this component's LICENSE file the
+* following copyright and licenses apply:*
+* Copyright 2023 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "bench_common.h"
+
+#define TIMER_CALIBRATION_LOOPS  10000
+#define HISTOGRAM_BUCKETS        40
+#define HISTOGRAM_BAR_WIDTH      50
+#define BUDGET_CHECK_INTERVAL    64
+
+static int compare_u64( const void *pA, const void *pB )
+{
+    uint64_t a = *(const uint64_t *)pA;
+    uint64_t b = *(const uint64_t *)pB;
+
+    return (a > b) - (a < b);
+}
+
+/* Nearest-rank percentile over sorted samples, permille to keep p99.9 exact */
+static uint64_t percentile( const uint64_t *pSorted, uint32_t count, uint32_t permille )
+{
+    uint64_t rank = ((uint64_t)count * permille + 999) / 1000;
+
+    if (rank == 0)
+    {
+        rank = 1;
+    }
+    return pSorted[rank - 1];
+}
+
+uint64_t bench_now_ns( void )
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+uint64_t bench_timer_overhead_ns( void )
+{
+    uint64_t start = bench_now_ns();
+    uint32_t i;
+
+    for (i = 0; i < TIMER_CALIBRATION_LOOPS; i++)
+    {
+        (void)bench_now_ns();
+    }
+    return (bench_now_ns() - start) / TIMER_CALIBRATION_LOOPS;
+}
+
+void bench_summarise( uint64_t *pSamples, uint32_t count, bench_result_t *pResult )
+{
+    qsort(pSamples, count, sizeof(*pSamples), compare_u64);
+    pResult->min_ns = pSamples[0];
+    pResult->median_ns = percentile(pSamples, count, 500);
+    pResult->p99_ns = percentile(pSamples, count, 990);
+    pResult->p999_ns = percentile(pSamples, count, 999);
+    pResult->max_ns = pSamples[count - 1];
+}
+
+static void format_ns( uint64_t ns, char *pBuf, size_t size )
+{
+    if (ns >= 1000000000ULL)
+    {
+        snprintf(pBuf, size, "%llus", (unsigned long long)(ns / 1000000000ULL));
+    }
+    else if (ns >= 1000000ULL)
+    {
+        snprintf(pBuf, size, "%llums", (unsigned long long)(ns / 1000000ULL));
+    }
+    else if (ns >= 1000ULL)
+    {
+        snprintf(pBuf, size, "%lluus", (unsigned long long)(ns / 1000ULL));
+    }
+    else
+    {
+        snprintf(pBuf, size, "%lluns", (unsigned long long)ns);
+    }
+}
+
+void bench_print_histogram( const uint64_t *pSamples, uint32_t count )
+{
+    uint32_t buckets[HISTOGRAM_BUCKETS] = { 0 };
+    uint32_t peak = 0;
+    char low[16];
+    char high[16];
+    uint32_t i;
+    int b;
+
+    for (i = 0; i < count; i++)
+    {
+        b = 0;
+        while (b < HISTOGRAM_BUCKETS - 1 && (pSamples[i] >> (b + 1)) != 0)
+        {
+            b++;
+        }
+        buckets[b]++;
+    }
+    for (b = 0; b < HISTOGRAM_BUCKETS; b++)
+    {
+        if (buckets[b] > peak)
+        {
+            peak = buckets[b];
+        }
+    }
+    for (b = 0; b < HISTOGRAM_BUCKETS; b++)
+    {
+        if (buckets[b] == 0)
+        {
+            continue;
+        }
+        format_ns(1ULL << b, low, sizeof(low));
+        format_ns(1ULL << (b + 1), high, sizeof(high));
+        printf("    [%6s, %6s) %10u %6.2f%% %.*s\n", low, high, buckets[b], 100.0 * buckets[b] / count,
+               (int)(((uint64_t)buckets[b] * HISTOGRAM_BAR_WIDTH + peak - 1) / peak),
+               "##################################################");
+    }
+}
+
+static void run_case( const bench_case_t *pCase, const bench_config_t *pConfig, uint64_t *pSamples, bench_result_t *pResult )
+{
+    uint64_t out[BENCH_MAX_OUTPUT / sizeof(uint64_t)];
+    uint64_t budget_ns;
+    uint64_t loop_start;
+    uint64_t loop_ns;
+    uint64_t t0;
+    uint32_t i;
+
+    memset(pResult, 0, sizeof(*pResult));
+    for (i = 0; i < pConfig->warmup; i++)
+    {
+        (void)pCase->run(out);
+    }
+
+    budget_ns = (uint64_t)pConfig->budget_ms * 1000000ULL;
+    loop_start = bench_now_ns();
+    for (i = 0; i < pConfig->iterations; i++)
+    {
+        t0 = bench_now_ns();
+        if (pCase->run(out) != 0)
+        {
+            pResult->failures++;
+        }
+        pSamples[i] = bench_now_ns() - t0;
+        /* A getter that has regressed to milliseconds must not stall the whole run */
+        if (budget_ns != 0 && (i % BUDGET_CHECK_INTERVAL) == 0 && t0 + pSamples[i] - loop_start >= budget_ns)
+        {
+            i++;
+            break;
+        }
+    }
+    loop_ns = bench_now_ns() - loop_start;
+
+    pResult->samples = i;
+    bench_summarise(pSamples, pResult->samples, pResult);
+    pResult->calls_per_sec = (loop_ns > 0) ? (double)pResult->samples * 1e9 / (double)loop_ns : 0.0;
+}
+
+int bench_run_suite( const char *pSuiteName, const bench_case_t *pCases, uint32_t count, const bench_config_t *pConfig )
+{
+    return bench_run_suite_hooked(pSuiteName, pCases, count, pConfig, NULL);
+}
+
+int bench_run_suite_hooked( const char *pSuiteName, const bench_case_t *pCases, uint32_t count, const bench_config_t *pConfig,
+                            const bench_hooks_t *pHooks )
+{
+    bench_result_t result;
+    uint64_t *pSamples;
+    int header = 0;
+    int status = 0;
+    uint32_t i;
+
+    if (pConfig->mode == BENCH_MODE_STRESS)
+    {
+        return bench_run_stress(pSuiteName, pCases, count, pConfig, pHooks);
+    }
+    if (pConfig->iterations == 0)
+    {
+        return 0;
+    }
+    pSamples = malloc(sizeof(*pSamples) * pConfig->iterations);
+    if (pSamples == NULL)
+    {
+        fprintf(stderr, "bench: cannot allocate %u samples\n", pConfig->iterations);
+        return -1;
+    }
+
+    for (i = 0; i < count; i++)
+    {
+        if (pConfig->pFilter != NULL && strstr(pCases[i].name, pConfig->pFilter) == NULL)
+        {
+            continue;
+        }
+        if (!header)
+        {
+            printf("\n[%s] iterations=%u warmup=%u timer overhead=%llu ns\n", pSuiteName, pConfig->iterations, pConfig->warmup,
+                   (unsigned long long)bench_timer_overhead_ns());
+            printf("%-42s %10s %10s %10s %10s %10s %10s %14s %8s\n", "function", "calls", "min(ns)", "median", "p99", "p99.9", "max", "calls/sec", "fails");
+            header = 1;
+        }
+        if (pHooks != NULL && pHooks->setup != NULL)
+        {
+            pHooks->setup();
+        }
+        run_case(&pCases[i], pConfig, pSamples, &result);
+        if (pHooks != NULL && pHooks->teardown != NULL)
+        {
+            pHooks->teardown();
+        }
+        printf("%-42s %10u %10llu %10llu %10llu %10llu %10llu %14.0f %8u\n", pCases[i].name,
+               result.samples, (unsigned long long)result.min_ns, (unsigned long long)result.median_ns,
+               (unsigned long long)result.p99_ns, (unsigned long long)result.p999_ns,
+               (unsigned long long)result.max_ns, result.calls_per_sec, result.failures);
+        if (pConfig->histogram)
+        {
+            bench_print_histogram(pSamples, result.samples);
+        }
+        if (result.failures != 0)
+        {
+            status = -1;
+        }
+    }
+
+    free(pSamples);
+    return status;
+}
+
+int bench_run_getters( const char *pSuiteName, const test_getter_t *pGetters, uint32_t count, const bench_config_t *pConfig )
+{
+    bench_case_t *pCases = calloc(count, sizeof(*pCases));
+    uint32_t i;
+    int status;
+
+    if (pCases == NULL)
+    {
+        fprintf(stderr, "bench: cannot allocate %u cases\n", count);
+        return -1;
+    }
+    for (i = 0; i < count; i++)
+    {
+        pCases[i].name = pGetters[i].pFunction;
+        pCases[i].run = pGetters[i].call;
+        pCases[i].out_size = pGetters[i].outputSize;
+        pCases[i].varying = pGetters[i].varying;
+    }
+    status = bench_run_suite(pSuiteName, pCases, count, pConfig);
+    free(pCases);
+    return status;
+}
+
+const test_getter_t *bench_find_getter( const test_getter_t *pGetters, uint32_t count, const char *pFunction )
+{
+    uint32_t i;
+
+    for (i = 0; i < count; i++)
+    {
+        if (strcmp(pGetters[i].pFunction, pFunction) == 0)
+        {
+            return &pGetters[i];
+        }
+    }
+    return NULL;
+}
@@ -0,0 +1,211 @@
+/*
+* If not stated otherwise in this file or this component's LICENSE file the
+* following copyright and licenses apply:*
+* Copyright 2023 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+/**
+* @file bench_common.h
+*
+* Shared timing and reporting for the dhcp4_hal_bench latency suites.
+*
+* Every case is a function making one HAL call into a caller-supplied output
+* buffer and returning the HAL status. In latency mode the runner times each
+* call individually on CLOCK_MONOTONIC, so the reported figures include the
+* cost of one clock read (printed as "timer overhead"). In stress mode every
+* case is called from several threads at once and outputs are checked
+* against a single-threaded reference.
+*/
+
+#ifndef __BENCH_COMMON_H__
+#define __BENCH_COMMON_H__
+
+#include <stdint.h>
+#include "test_getters.h"
+
+#define BENCH_MAX_OUTPUT  1024  /*!< Largest output a case may write */
+
+/**
+* @brief A single function under measurement
+*/
+typedef struct
+{
+    const char *name;             /*!< Reported name, normally the HAL function */
+    int (*run)( void *pOut );     /*!< Performs one call writing to pOut, returns the HAL status */
+    uint32_t out_size;            /*!< Bytes written to pOut, 0 if the case keeps its output private */
+    int varying;                  /*!< Output legitimately changes between calls (timers, FSM state) */
+} bench_case_t;
+
+/**
+* @brief Calls made around the cases of a suite that changes its surroundings while it runs
+*/
+typedef struct
+{
+    void (*setup)( void );        /*!< Before a case's first call; in stress mode, once before all cases */
+    void (*teardown)( void );     /*!< After its last call, before its results are printed */
+} bench_hooks_t;
+
+/**
+* @brief What the runner does with each suite
+*/
+typedef enum
+{
+    BENCH_MODE_LATENCY = 0,       /*!< Time every case single-threaded */
+    BENCH_MODE_STRESS,            /*!< Call every case from several threads at once */
+    BENCH_MODE_ACQUIRE,           /*!< Time lease acquisition against the DHCP server stand-in */
+    BENCH_MODE_TIMERS             /*!< Drive simulated leases from the lease engine's timing wheel */
+} bench_mode_t;
+
+/**
+* @brief Run-time options shared by all suites
+*/
+typedef struct
+{
+    uint32_t iterations;      /*!< Timed calls per case */
+    uint32_t warmup;          /*!< Untimed calls per case before timing */
+    const char *pFilter;      /*!< Only run cases whose name contains this, NULL for all */
+    uint32_t budget_ms;       /*!< Stop timing a case after this much wall time, 0 for no limit */
+    int histogram;            /*!< Non-zero to print a latency histogram per case */
+    bench_mode_t mode;        /*!< Latency or stress */
+    uint32_t threads;         /*!< Stress mode: concurrent callers */
+    uint32_t duration_s;      /*!< Stress mode: seconds to run each suite */
+    uint32_t runs;            /*!< Acquire mode: leases acquired per HAL family */
+    uint32_t leases;          /*!< Timers mode: simulated leases */
+} bench_config_t;
+
+/**
+* @brief Latency summary of one case
+*/
+typedef struct
+{
+    uint64_t min_ns;
+    uint64_t median_ns;
+    uint64_t p99_ns;
+    uint64_t p999_ns;
+    uint64_t max_ns;
+    double   calls_per_sec;   /*!< Timed calls divided by wall time of the timed loop */
+    uint32_t failures;        /*!< Calls that did not return 0 */
+    uint32_t samples;         /*!< Timed calls, fewer than iterations if the budget ran out */
+} bench_result_t;
+
+/**
+* @brief Returns CLOCK_MONOTONIC in nanoseconds
+*/
+uint64_t bench_now_ns( void );
+
+/**
+* @brief Estimates the cost of one bench_now_ns() call
+*/
+uint64_t bench_timer_overhead_ns( void );
+
+/**
+* @brief Reduces a set of per-call samples to a summary
+*
+* Sorts pSamples in place.
+*
+* @param[in,out] pSamples - Per-call latencies in nanoseconds
+* @param[in]     count    - Number of samples, must be non-zero
+* @param[out]    pResult  - Receives min/median/percentiles/max
+*/
+void bench_summarise( uint64_t *pSamples, uint32_t count, bench_result_t *pResult );
+
+/**
+* @brief Prints a log2-bucketed latency histogram
+*
+* Bucket n counts samples in [2^n, 2^(n+1)) nanoseconds; empty buckets are skipped.
+*
+* @param[in] pSamples - Per-call latencies in nanoseconds
+* @param[in] count    - Number of samples
+*/
+void bench_print_histogram( const uint64_t *pSamples, uint32_t count );
+
+/**
+* @brief Calls every case of a suite from several threads for a fixed time
+*
+* Prints per-thread throughput and latency, and every case whose status or
+* non-varying output differed from a single-threaded reference call.
+*
+* @param[in] pSuiteName - Heading printed above the report
+* @param[in] pCases     - Cases to run
+* @param[in] count      - Number of entries in pCases
+* @param[in] pConfig    - Thread count, duration and filter
+* @param[in] pHooks     - Called around the run, NULL for none
+*
+* @return 0 if every call succeeded with consistent output, otherwise -1
+*/
+int bench_run_stress( const char *pSuiteName, const bench_case_t *pCases, uint32_t count, const bench_config_t *pConfig,
+                      const bench_hooks_t *pHooks );
+
+/**
+* @brief Runs a suite in the configured mode
+*
+* In latency mode times every case and prints one report row per case;
+* in stress mode hands over to bench_run_stress().
+*
+* @param[in] pSuiteName - Heading printed above the table
+* @param[in] pCases     - Cases to run
+* @param[in] count      - Number of entries in pCases
+* @param[in] pConfig    - Iteration and filter options
+*
+* @return 0 if every call of every case returned 0, otherwise -1
+*/
+int bench_run_suite( const char *pSuiteName, const bench_case_t *pCases, uint32_t count, const bench_config_t *pConfig );
+
+/**
+* @brief Runs a suite as bench_run_suite() does, with calls around its cases
+*
+* @param[in] pHooks - Called around each case, or around the whole stress run
+*
+* @return As bench_run_suite()
+*/
+int bench_run_suite_hooked( const char *pSuiteName, const bench_case_t *pCases, uint32_t count, const bench_config_t *pConfig,
+                            const bench_hooks_t *pHooks );
+
+/**
+* @brief Runs every entry of a getter table as a suite
+*
+* @param[in] pSuiteName - Heading printed above the table
+* @param[in] pGetters   - Getter table of a HAL family (test_getters.h)
+* @param[in] count      - Number of entries in pGetters
+* @param[in] pConfig    - Iteration and filter options
+*
+* @return As bench_run_suite(), or -1 if out of memory
+*/
+int bench_run_getters( const char *pSuiteName, const test_getter_t *pGetters, uint32_t count, const bench_config_t *pConfig );
+
+/**
+* @brief Looks up a getter table entry by HAL function name
+*
+* @return The entry, or NULL if the table has no such getter
+*/
+const test_getter_t *bench_find_getter( const test_getter_t *pGetters, uint32_t count, const char *pFunction );
+
+/**
+* @brief Times repeated eRouter lease acquisitions through one HAL family
+*
+* Each run drops the lease, starts the DHCP client against the L2 server
+* stand-in and waits for the HAL to report BOUND with a new address, then
+* prints min/median/p99/max of each phase of the exchange over all runs.
+*
+* @param[in] pSuiteName  - Heading printed above the table
+* @param[in] getFsmState - eRouter FSM state getter, writing an int
+* @param[in] getIpAddr   - eRouter address getter, writing a 32-bit address
+* @param[in] pConfig     - Number of runs
+*
+* @return 0 if every run reached BOUND, otherwise -1
+*/
+int bench_run_acquire( const char *pSuiteName, int (*getFsmState)( void *pOut ), int (*getIpAddr)( void *pOut ), const bench_config_t *pConfig );
+
+#endif /* __BENCH_COMMON_H__ */
@@ -0,0 +1,63 @@
+/*
+* If not stated otherwise in this file or this component's LICENSE file the
+* following copyright and licenses apply:*
+* Copyright 2023 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+/**
+* @file bench_dhcp4cApi.c
+*
+* Per-call latency of every dhcp4cApi getter in the L1 getter table
+* (src/test_getters_dhcp4cApi.c).
+*
+* Vendor implementations range from in-memory reads to forking udhcpc helper
+* scripts, so run with -H to see the latency distribution and -b to bound the
+* time spent on a getter that has regressed.
+*/
+
+#include <stddef.h>
+#include "bench_common.h"
+
+/**
+* @brief Runs the dhcp4cApi suite
+*
+* @return 0 if every call succeeded, otherwise -1
+*/
+int bench_dhcp4cApi_run( const bench_config_t *pConfig )
+{
+    uint32_t count;
+    const test_getter_t *pGetters = test_getters_dhcp4cApi(&count);
+
+    return bench_run_getters("dhcp4cApi", pGetters, count, pConfig);
+}
+
+/**
+* @brief Times eRouter lease acquisition through the dhcp4cApi getters
+*
+* @return 0 if every run reached BOUND, otherwise -1
+*/
+int bench_dhcp4cApi_acquire_run( const bench_config_t *pConfig )
+{
+    uint32_t count;
+    const test_getter_t *pGetters = test_getters_dhcp4cApi(&count);
+    const test_getter_t *pFsmState = bench_find_getter(pGetters, count, "dhcp4c_get_ert_fsm_state");
+    const test_getter_t *pIpAddr = bench_find_getter(pGetters, count, "dhcp4c_get_ert_ip_addr");
+
+    if (pFsmState == NULL || pIpAddr == NULL)
+    {
+        return -1;
+    }
+    return bench_run_acquire("dhcp4cApi lease acquisition", pFsmState->call, pIpAddr->call, pConfig);
+}
@@ -0,0 +1,166 @@
+/*
+* If not stated otherwise in this file or this component's LICENSE file the
+* following copyright and licenses apply:*
+* Copyright 2023 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+/**
+* @file bench_dhcp_packet.c
+*
+* Throughput of the DHCP packet codec shared by the skeleton and the server
+* stand-in (linux skeleton only).
+*
+* Each call parses or builds one message, so calls/sec is packets/sec. The
+* messages are those of an eRouter acquisition: a DISCOVER with its
+* parameter request list, and an OFFER and ACK carrying every option behind
+* the getters, four DNS servers included.
+*/
+
+#ifdef BUILD_LINUX
+
+#include <string.h>
+#include <arpa/inet.h>
+#include "dhcp_packet.h"
+#include "bench_common.h"
+
+static dhcp_packet_t gDiscover;
+static dhcp_packet_t gOffer;
+static dhcp_packet_t gAck;
+static uint8_t gDiscoverWire[DHCP_PACKET_MIN_SIZE];
+static uint8_t gAckWire[DHCP_PACKET_MIN_SIZE];
+static size_t gDiscoverLength;
+static size_t gAckLength;
+
+static void bench_messages( void )
+{
+    static const uint8_t params[] = { DHCP_OPT_SUBNET_MASK, DHCP_OPT_ROUTER, DHCP_OPT_DNS, DHCP_OPT_LEASE_TIME,
+                                      DHCP_OPT_SERVER_ID, DHCP_OPT_RENEWAL, DHCP_OPT_REBINDING };
+    int i;
+
+    memset(&gDiscover, 0, sizeof(gDiscover));
+    gDiscover.op = DHCP_BOOTREQUEST;
+    gDiscover.xid = 0x0b0e0c4aU;
+    gDiscover.flags = DHCP_PACKET_FLAG_BROADCAST;
+    for (i = 0; i < 6; i++)
+    {
+        gDiscover.chaddr[i] = (uint8_t)(0x02 + i);
+    }
+    gDiscover.msg_type = DHCPDISCOVER;
+    gDiscover.param_count = (int)sizeof(params);
+    memcpy(gDiscover.params, params, sizeof(params));
+
+    gOffer = gDiscover;
+    gOffer.op = DHCP_BOOTREPLY;
+    gOffer.msg_type = DHCPOFFER;
+    gOffer.param_count = 0;
+    gOffer.yiaddr = htonl(0xcb007164U);           /* 203.0.113.100 */
+    gOffer.server_id = htonl(0xcb007101U);
+    gOffer.mask = htonl(0xffffff00U);
+    gOffer.router = htonl(0xcb007101U);
+    gOffer.dns_count = DHCP_PACKET_MAX_DNS;
+    for (i = 0; i < DHCP_PACKET_MAX_DNS; i++)
+    {
+        gOffer.dns[i] = htonl(0xcb007135U + (uint32_t)i);
+    }
+    gOffer.lease_time = 86400;
+    gOffer.renewal_time = 43200;
+    gOffer.rebinding_time = 75600;
+
+    gAck = gOffer;
+    gAck.msg_type = DHCPACK;
+
+    dhcp_packet_encode(&gDiscover, gDiscoverWire, sizeof(gDiscoverWire), &gDiscoverLength);
+    dhcp_packet_encode(&gAck, gAckWire, sizeof(gAckWire), &gAckLength);
+}
+
+static int bench_decode_discover( void *pOut )
+{
+    return dhcp_packet_decode(gDiscoverWire, gDiscoverLength, (dhcp_packet_t *)pOut);
+}
+
+static int bench_decode_ack( void *pOut )
+{
+    return dhcp_packet_decode(gAckWire, gAckLength, (dhcp_packet_t *)pOut);
+}
+
+static int bench_decode_ack_to_lease( void *pOut )
+{
+    dhcp_packet_t packet;
+
+    if (dhcp_packet_decode(gAckWire, gAckLength, &packet) != 0)
+    {
+        return -1;
+    }
+    memset(pOut, 0, sizeof(dhcp_lease_t));
+    return dhcp_packet_to_lease(&packet, (dhcp_lease_t *)pOut);
+}
+
+static int bench_encode( const dhcp_packet_t *pPacket, void *pOut )
+{
+    size_t length;
+
+    return dhcp_packet_encode(pPacket, (uint8_t *)pOut, DHCP_PACKET_BOOTP_SIZE, &length);
+}
+
+static int bench_encode_discover( void *pOut )
+{
+    return bench_encode(&gDiscover, pOut);
+}
+
+static int bench_encode_offer( void *pOut )
+{
+    return bench_encode(&gOffer, pOut);
+}
+
+static int bench_encode_ack( void *pOut )
+{
+    return bench_encode(&gAck, pOut);
+}
+
+/* The server's side of a REQUEST: parse it, build the ACK */
+static int bench_request_to_ack( void *pOut )
+{
+    dhcp_packet_t request;
+
+    if (dhcp_packet_decode(gDiscoverWire, gDiscoverLength, &request) != 0)
+    {
+        return -1;
+    }
+    return bench_encode(&gAck, pOut);
+}
+
+static const bench_case_t gDhcpPacketCases[] =
+{
+    { "decode: DISCOVER", bench_decode_discover, sizeof(dhcp_packet_t), 0 },
+    { "decode: ACK", bench_decode_ack, sizeof(dhcp_packet_t), 0 },
+    { "decode: ACK + dhcp_packet_to_lease", bench_decode_ack_to_lease, sizeof(dhcp_lease_t), 0 },
+    { "encode: DISCOVER", bench_encode_discover, DHCP_PACKET_BOOTP_SIZE, 0 },
+    { "encode: OFFER", bench_encode_offer, DHCP_PACKET_BOOTP_SIZE, 0 },
+    { "encode: ACK", bench_encode_ack, DHCP_PACKET_BOOTP_SIZE, 0 },
+    { "server: decode request + encode ACK", bench_request_to_ack, DHCP_PACKET_BOOTP_SIZE, 0 },
+};
+
+/**
+* @brief Runs the packet codec suite
+*
+* @return 0 if every call succeeded, otherwise -1
+*/
+int bench_dhcp_packet_run( const bench_config_t *pConfig )
+{
+    bench_messages();
+    return bench_run_suite("dhcp packet codec", gDhcpPacketCases, sizeof(gDhcpPacketCases) / sizeof(gDhcpPacketCases[0]), pConfig);
+}
+
+#endif /* BUILD_LINUX */
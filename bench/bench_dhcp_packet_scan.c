@@ -0,0 +1,300 @@
+/*
+* If not stated otherwise in this file or this component's LICENSE file the
+* following copyright and licenses apply:*
+* Copyright 2023 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+/**
+* @file bench_dhcp_packet_scan.c
+*
+* Option scanning with each scanner the build has (linux skeleton only).
+*
+* The same cases run once per scanner, so the suites compare directly. The
+* messages are the ACKs a cable gateway's other clients get, heavier than
+* the eRouter's: the eCM's, with a 255-byte option 43 of vendor
+* sub-options, option 122 and option 125; and the eMTA's, with a full
+* option 122. Two more show where the vectorized scanner can gain: the eCM
+* ACK with every option aligned to 8 bytes by PAD, as some servers send it,
+* and an ACK overloaded into a file and sname that are mostly PAD. A scan
+* case only locates the options; a decode case also reads the ones the
+* getters use.
+*/
+
+#ifdef BUILD_LINUX
+
+#include <stdio.h>
+#include <string.h>
+#include <arpa/inet.h>
+#include "dhcp_packet.h"
+#include "bench_common.h"
+
+#define BENCH_SCAN_REFS   64
+#define BENCH_WIRE_SIZE   1500
+
+#define FILE_OFFSET       108
+#define FILE_SIZE         128
+#define SNAME_OFFSET      44
+#define SNAME_SIZE        64
+
+typedef struct
+{
+    uint8_t wire[BENCH_WIRE_SIZE];
+    size_t  length;
+    size_t  align;      /* Options start on a multiple of this, 1 for none */
+} bench_wire_t;
+
+static bench_wire_t gEcm;
+static bench_wire_t gEmta;
+static bench_wire_t gAligned;
+static bench_wire_t gOverloaded;
+
+static void wire_start( bench_wire_t *pWire, size_t align )
+{
+    static const uint8_t cookie[] = { 0x63, 0x82, 0x53, 0x63 };
+
+    memset(pWire, 0, sizeof(*pWire));
+    pWire->align = align;
+    pWire->wire[0] = DHCP_BOOTREPLY;
+    pWire->wire[1] = 1;
+    pWire->wire[2] = 6;
+    memcpy(pWire->wire + 16, "\xcb\x00\x71\x64", 4);
+    memcpy(pWire->wire + DHCP_PACKET_FIXED_SIZE, cookie, sizeof(cookie));
+    pWire->length = DHCP_PACKET_OPTIONS_OFFSET;
+}
+
+static void wire_option( bench_wire_t *pWire, uint8_t code, const void *pData, uint8_t length )
+{
+    while (pWire->length % pWire->align != 0)
+    {
+        pWire->wire[pWire->length++] = DHCP_OPT_PAD;
+    }
+    pWire->wire[pWire->length++] = code;
+    pWire->wire[pWire->length++] = length;
+    memcpy(pWire->wire + pWire->length, pData, length);
+    pWire->length += length;
+}
+
+static void wire_u32( bench_wire_t *pWire, uint8_t code, uint32_t value )
+{
+    value = htonl(value);
+    wire_option(pWire, code, &value, 4);
+}
+
+/* Vendor data made of sub-options, as in options 43, 122 and 125 */
+static uint8_t sub_options( uint8_t *pData, uint8_t length )
+{
+    uint8_t used = 0;
+    uint8_t code = 1;
+    uint8_t size;
+
+    while (length - used >= 2)
+    {
+        size = (uint8_t)((length - used - 2 < 30) ? length - used - 2 : 30);
+        pData[used] = code++;
+        pData[used + 1] = size;
+        memset(pData + used + 2, 'a' + code % 26, size);
+        used = (uint8_t)(used + 2 + size);
+    }
+    return used;
+}
+
+static void wire_common( bench_wire_t *pWire )
+{
+    uint8_t type = DHCPACK;
+
+    wire_option(pWire, DHCP_OPT_MSG_TYPE, &type, 1);
+    wire_u32(pWire, DHCP_OPT_SERVER_ID, 0xcb007101U);
+    wire_u32(pWire, DHCP_OPT_LEASE_TIME, 604800);
+    wire_u32(pWire, DHCP_OPT_SUBNET_MASK, 0xfffff000U);
+    wire_u32(pWire, DHCP_OPT_ROUTER, 0xcb007101U);
+}
+
+static void wire_ecm( bench_wire_t *pWire, size_t align )
+{
+    static const char tftp[] = "tftp.cm.example.net";
+    static const char bootfile[] = "docsis/config/modem-profile-gold-1g.cfg";
+    uint8_t data[255];
+    uint32_t servers[2] = { htonl(0xcb007105U), htonl(0xcb007106U) };
+
+    wire_start(pWire, align);
+    wire_common(pWire);
+    wire_u32(pWire, 2, 0xffffb9b0U);                /* Time offset */
+    wire_option(pWire, 4, servers, sizeof(servers));  /* Time servers */
+    wire_u32(pWire, 7, 0xcb007107U);                /* Log server */
+    wire_option(pWire, 66, tftp, sizeof(tftp) - 1);
+    wire_option(pWire, 67, bootfile, sizeof(bootfile) - 1);
+    wire_option(pWire, 43, data, sub_options(data, 255));
+    wire_option(pWire, 122, data, sub_options(data, 120));
+    wire_option(pWire, 125, data, sub_options(data, 200));
+    wire_u32(pWire, DHCP_OPT_RENEWAL, 302400);
+    wire_u32(pWire, DHCP_OPT_REBINDING, 529200);
+    pWire->wire[pWire->length++] = DHCP_OPT_END;
+}
+
+static void wire_emta( bench_wire_t *pWire )
+{
+    static const char host[] = "mta-0002a1b2c3d4";
+    static const char domain[] = "voice.example.net";
+    uint8_t data[255];
+    uint32_t dns[2] = { htonl(0xcb007135U), htonl(0xcb007136U) };
+
+    wire_start(pWire, 1);
+    wire_common(pWire);
+    wire_option(pWire, DHCP_OPT_DNS, dns, sizeof(dns));
+    wire_option(pWire, 12, host, sizeof(host) - 1);
+    wire_option(pWire, 15, domain, sizeof(domain) - 1);
+    wire_option(pWire, 122, data, sub_options(data, 255));
+    pWire->wire[pWire->length++] = DHCP_OPT_END;
+}
+
+/* Main options, then a file and an sname that are PAD but for one option each */
+static void wire_overloaded( bench_wire_t *pWire )
+{
+    uint8_t overload = 3;
+    uint32_t dns[2] = { htonl(0xcb007135U), htonl(0xcb007136U) };
+    uint8_t *pArea;
+
+    wire_start(pWire, 1);
+    wire_common(pWire);
+    wire_option(pWire, DHCP_OPT_OVERLOAD, &overload, 1);
+    pWire->wire[pWire->length++] = DHCP_OPT_END;
+
+    pArea = pWire->wire + FILE_OFFSET;
+    pArea[FILE_SIZE - 11] = DHCP_OPT_DNS;
+    pArea[FILE_SIZE - 10] = sizeof(dns);
+    memcpy(pArea + FILE_SIZE - 9, dns, sizeof(dns));
+    pArea[FILE_SIZE - 1] = DHCP_OPT_END;
+
+    pArea = pWire->wire + SNAME_OFFSET;
+    pArea[SNAME_SIZE - 7] = DHCP_OPT_RENEWAL;
+    pArea[SNAME_SIZE - 6] = 4;
+    pArea[SNAME_SIZE - 5] = 0x00;
+    pArea[SNAME_SIZE - 4] = 0x04;
+    pArea[SNAME_SIZE - 3] = 0x9d;
+    pArea[SNAME_SIZE - 2] = 0x40;
+    pArea[SNAME_SIZE - 1] = DHCP_OPT_END;
+}
+
+static void bench_messages( void )
+{
+    wire_ecm(&gEcm, 1);
+    wire_ecm(&gAligned, 8);
+    wire_emta(&gEmta);
+    wire_overloaded(&gOverloaded);
+}
+
+static int scan_area( const uint8_t *pArea, size_t size, dhcp_option_ref_t *pRefs )
+{
+    size_t offset = 0;
+    int found;
+
+    while ((found = dhcp_packet_scan(pArea, size, &offset, pRefs, BENCH_SCAN_REFS)) > 0)
+    {
+    }
+    return found;
+}
+
+static int bench_scan( const bench_wire_t *pWire, void *pOut )
+{
+    return scan_area(pWire->wire + DHCP_PACKET_OPTIONS_OFFSET, pWire->length - DHCP_PACKET_OPTIONS_OFFSET,
+                     (dhcp_option_ref_t *)pOut);
+}
+
+static int bench_scan_ecm( void *pOut )
+{
+    return bench_scan(&gEcm, pOut);
+}
+
+static int bench_scan_emta( void *pOut )
+{
+    return bench_scan(&gEmta, pOut);
+}
+
+static int bench_scan_aligned( void *pOut )
+{
+    return bench_scan(&gAligned, pOut);
+}
+
+/* The three areas a decoder walks for an overloaded message */
+static int bench_scan_overloaded( void *pOut )
+{
+    if (bench_scan(&gOverloaded, pOut) != 0 ||
+        scan_area(gOverloaded.wire + FILE_OFFSET, FILE_SIZE, (dhcp_option_ref_t *)pOut) != 0)
+    {
+        return -1;
+    }
+    return scan_area(gOverloaded.wire + SNAME_OFFSET, SNAME_SIZE, (dhcp_option_ref_t *)pOut);
+}
+
+static int bench_decode_ecm( void *pOut )
+{
+    return dhcp_packet_decode(gEcm.wire, gEcm.length, (dhcp_packet_t *)pOut);
+}
+
+static int bench_decode_emta( void *pOut )
+{
+    return dhcp_packet_decode(gEmta.wire, gEmta.length, (dhcp_packet_t *)pOut);
+}
+
+static int bench_decode_aligned( void *pOut )
+{
+    return dhcp_packet_decode(gAligned.wire, gAligned.length, (dhcp_packet_t *)pOut);
+}
+
+static int bench_decode_overloaded( void *pOut )
+{
+    return dhcp_packet_decode(gOverloaded.wire, gOverloaded.length, (dhcp_packet_t *)pOut);
+}
+
+static const bench_case_t gDhcpPacketScanCases[] =
+{
+    { "scan: eCM ACK", bench_scan_ecm, sizeof(dhcp_option_ref_t) * BENCH_SCAN_REFS, 0 },
+    { "scan: eMTA ACK", bench_scan_emta, sizeof(dhcp_option_ref_t) * BENCH_SCAN_REFS, 0 },
+    { "scan: eCM ACK, PAD-aligned", bench_scan_aligned, sizeof(dhcp_option_ref_t) * BENCH_SCAN_REFS, 0 },
+    { "scan: ACK overloaded into file/sname", bench_scan_overloaded, sizeof(dhcp_option_ref_t) * BENCH_SCAN_REFS, 0 },
+    { "decode: eCM ACK", bench_decode_ecm, sizeof(dhcp_packet_t), 0 },
+    { "decode: eMTA ACK", bench_decode_emta, sizeof(dhcp_packet_t), 0 },
+    { "decode: eCM ACK, PAD-aligned", bench_decode_aligned, sizeof(dhcp_packet_t), 0 },
+    { "decode: ACK overloaded into file/sname", bench_decode_overloaded, sizeof(dhcp_packet_t), 0 },
+};
+
+/**
+* @brief Runs the scan suite once per scanner built
+*
+* @return 0 if every call succeeded, otherwise -1
+*/
+int bench_dhcp_packet_scan_run( const bench_config_t *pConfig )
+{
+    static const dhcp_packet_scanner_t scanners[] = { DHCP_PACKET_SCANNER_SCALAR, DHCP_PACKET_SCANNER_SIMD };
+    dhcp_packet_scanner_t previous = dhcp_packet_get_scanner();
+    char name[64];
+    size_t i;
+    int status = 0;
+
+    bench_messages();
+    for (i = 0; i < sizeof(scanners) / sizeof(scanners[0]); i++)
+    {
+        if (dhcp_packet_set_scanner(scanners[i]) != 0)
+        {
+            continue;
+        }
+        snprintf(name, sizeof(name), "dhcp option scan, %s", dhcp_packet_scanner_name(scanners[i]));
+        status |= bench_run_suite(name, gDhcpPacketScanCases, sizeof(gDhcpPacketScanCases) / sizeof(gDhcpPacketScanCases[0]), pConfig);
+    }
+    dhcp_packet_set_scanner(previous);
+    return status;
+}
+
+#endif /* BUILD_LINUX */
@@ -0,0 +1,156 @@
+/*
+* If not stated otherwise in this file or this component's LICENSE file the
+* following copyright and licenses apply:*
+* Copyright 2023 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+/**
+* @file bench_dhcpv4c_api.c
+*
+* Per-call latency of every dhcpv4c_api getter in the L1 getter table
+* (src/test_getters_dhcpv4c_api.c), and of the snapshot extension against
+* the individual getters it replaces.
+*/
+
+#include <string.h>
+#include "dhcpv4c_api.h"
+#ifdef DHCPV4C_API_EXT
+#include "dhcpv4c_api_ext.h"
+#endif
+#include "bench_common.h"
+
+#ifdef DHCPV4C_API_EXT
+static int bench_dhcpv4c_get_ert_snapshot( void *pOut )
+{
+    return dhcpv4c_get_ert_snapshot((dhcpv4c_lease_snapshot_t *)pOut);
+}
+
+static int bench_dhcpv4c_get_ecm_snapshot( void *pOut )
+{
+    return dhcpv4c_get_ecm_snapshot((dhcpv4c_lease_snapshot_t *)pOut);
+}
+
+static int bench_dhcpv4c_get_emta_snapshot( void *pOut )
+{
+    return dhcpv4c_get_emta_snapshot((dhcpv4c_emta_snapshot_t *)pOut);
+}
+
+/* What a caller without the snapshot API does to read the same lease */
+#define BENCH_INDIVIDUAL_GETTERS(iface) \
+    static int bench_##iface##_individual_getters( void *pOut ) \
+    { \
+        dhcpv4c_ip_list_t dns; \
+        CHAR name[64]; \
+        UINT value; \
+        INT state; \
+        int status = 0; \
+        (void)pOut; \
+        status |= dhcpv4c_get_##iface##_lease_time(&value); \
+        status |= dhcpv4c_get_##iface##_remain_lease_time(&value); \
+        status |= dhcpv4c_get_##iface##_remain_renew_time(&value); \
+        status |= dhcpv4c_get_##iface##_remain_rebind_time(&value); \
+        status |= dhcpv4c_get_##iface##_config_attempts(&state); \
+        status |= dhcpv4c_get_##iface##_ifname(name); \
+        status |= dhcpv4c_get_##iface##_fsm_state(&state); \
+        status |= dhcpv4c_get_##iface##_ip_addr(&value); \
+        status |= dhcpv4c_get_##iface##_mask(&value); \
+        status |= dhcpv4c_get_##iface##_gw(&value); \
+        status |= dhcpv4c_get_##iface##_dns_svrs(&dns); \
+        status |= dhcpv4c_get_##iface##_dhcp_svr(&value); \
+        return status; \
+    }
+
+BENCH_INDIVIDUAL_GETTERS(ert)
+BENCH_INDIVIDUAL_GETTERS(ecm)
+
+static int bench_emta_individual_getters( void *pOut )
+{
+    UINT value;
+    int status = 0;
+
+    (void)pOut;
+    status |= dhcpv4c_get_emta_remain_lease_time(&value);
+    status |= dhcpv4c_get_emta_remain_renew_time(&value);
+    status |= dhcpv4c_get_emta_remain_rebind_time(&value);
+    return status;
+}
+
+/* A TR-181 poller reading every DHCPv4 client field of the device */
+static int bench_scrape_individual_getters( void *pOut )
+{
+    return bench_ert_individual_getters(pOut) | bench_ecm_individual_getters(pOut) | bench_emta_individual_getters(pOut);
+}
+
+static int bench_scrape_snapshots( void *pOut )
+{
+    dhcpv4c_lease_snapshot_t ert;
+    dhcpv4c_lease_snapshot_t ecm;
+    dhcpv4c_emta_snapshot_t emta;
+
+    (void)pOut;
+    return dhcpv4c_get_ert_snapshot(&ert) | dhcpv4c_get_ecm_snapshot(&ecm) | dhcpv4c_get_emta_snapshot(&emta);
+}
+
+static const bench_case_t gSnapshotCases[] =
+{
+    /* Snapshots carry the remaining times, so their output varies between calls */
+    { "dhcpv4c_get_ert_snapshot", bench_dhcpv4c_get_ert_snapshot, sizeof(dhcpv4c_lease_snapshot_t), 1 },
+    { "ert: 12 individual getters", bench_ert_individual_getters, 0, 1 },
+    { "dhcpv4c_get_ecm_snapshot", bench_dhcpv4c_get_ecm_snapshot, sizeof(dhcpv4c_lease_snapshot_t), 1 },
+    { "ecm: 12 individual getters", bench_ecm_individual_getters, 0, 1 },
+    { "dhcpv4c_get_emta_snapshot", bench_dhcpv4c_get_emta_snapshot, sizeof(dhcpv4c_emta_snapshot_t), 1 },
+    { "emta: 3 individual getters", bench_emta_individual_getters, 0, 1 },
+    { "scrape all: 27 HAL calls", bench_scrape_individual_getters, 0, 1 },
+    { "scrape all: 3 HAL calls (snapshots)", bench_scrape_snapshots, 0, 1 },
+};
+#endif
+
+/**
+* @brief Runs the dhcpv4c_api suites
+*
+* @return 0 if every call succeeded, otherwise -1
+*/
+int bench_dhcpv4c_api_run( const bench_config_t *pConfig )
+{
+    uint32_t count;
+    const test_getter_t *pGetters = test_getters_dhcpv4c_api(&count);
+    int status;
+
+    status = bench_run_getters("dhcpv4c_api", pGetters, count, pConfig);
+#ifdef DHCPV4C_API_EXT
+    /* Each HAL call is one IPC round trip to the DHCP client on production HALs */
+    status |= bench_run_suite("dhcpv4c_api snapshots", gSnapshotCases, sizeof(gSnapshotCases) / sizeof(gSnapshotCases[0]), pConfig);
+#endif
+    return status;
+}
+
+/**
+* @brief Times eRouter lease acquisition through the dhcpv4c_api getters
+*
+* @return 0 if every run reached BOUND, otherwise -1
+*/
+int bench_dhcpv4c_api_acquire_run( const bench_config_t *pConfig )
+{
+    uint32_t count;
+    const test_getter_t *pGetters = test_getters_dhcpv4c_api(&count);
+    const test_getter_t *pFsmState = bench_find_getter(pGetters, count, "dhcpv4c_get_ert_fsm_state");
+    const test_getter_t *pIpAddr = bench_find_getter(pGetters, count, "dhcpv4c_get_ert_ip_addr");
+
+    if (pFsmState == NULL || pIpAddr == NULL)
+    {
+        return -1;
+    }
+    return bench_run_acquire("dhcpv4c_api lease acquisition", pFsmState->call, pIpAddr->call, pConfig);
+}
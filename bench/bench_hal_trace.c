@@ -0,0 +1,192 @@
+/*
+* If not stated otherwise in this file or this component's LICENSE file the
+* following copyright and licenses apply:*
+* Copyright 2023 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+/**
+* @file bench_hal_trace.c
+*
+* What the call tracer of tools/hal_trace adds to a getter call.
+*
+* The same eRouter lease time getter is timed called directly and wrapped
+* as bin/libhal_trace.so wraps it, next to the record path alone. The
+* difference between the first two medians is the tracer's cost per call,
+* without the symbol lookup of LD_PRELOAD, which is one extra indirect
+* call. The cases record into a private segment. In latency mode the timed
+* thread drains it itself every BENCH_TRACE_DRAIN_EVERY calls, which shows
+* in p99.9 and max only; in stress mode a reader thread drains it, as
+* hal_trace_reader would. Calls dropped for a full ring, which take a
+* shorter path, are reported after the suite.
+*/
+
+#include <stdio.h>
+#include <sched.h>
+#include <unistd.h>
+#include <pthread.h>
+#include "hal_trace.h"
+#include "bench_common.h"
+
+#if defined(DHCPV4C_API)
+#define BENCH_TRACE_TABLE       test_getters_dhcpv4c_api
+#define BENCH_TRACE_FUNCTION    "dhcpv4c_get_ert_lease_time"
+#else
+#define BENCH_TRACE_TABLE       test_getters_dhcp4cApi
+#define BENCH_TRACE_FUNCTION    "dhcp4c_get_ert_lease_time"
+#endif
+
+#define BENCH_TRACE_DRAIN_EVERY (HAL_TRACE_SLOTS / 2)
+#define BENCH_TRACE_BATCH       4096
+
+static const test_getter_t *gpTracedGetter;
+static hal_trace_segment_t *gTraceSegment;
+static char gTraceName[64];
+static int gStress;
+static pthread_t gDrainThread;
+static int gDrainStop;
+static uint32_t gSinceDrain;
+static hal_trace_record_t gRecords[BENCH_TRACE_BATCH];     /* Of whichever thread drains */
+static uint64_t gDrained;
+static uint64_t gDropped;
+
+static void *bench_drain( void *pArg )
+{
+    (void)pArg;
+    while (!__atomic_load_n(&gDrainStop, __ATOMIC_RELAXED))
+    {
+        gDrained += hal_trace_drain(gTraceSegment, gRecords, BENCH_TRACE_BATCH);
+        sched_yield();
+    }
+    gDrained += hal_trace_drain(gTraceSegment, gRecords, BENCH_TRACE_BATCH);
+    return NULL;
+}
+
+static void trace_setup( void )
+{
+    snprintf(gTraceName, sizeof(gTraceName), "/hal_trace_bench.%d", (int)getpid());
+    gTraceSegment = hal_trace_open(gTraceName);
+    if (gTraceSegment == NULL)
+    {
+        fprintf(stderr, "bench: cannot map %s, the traced cases record nothing\n", gTraceName);
+        return;
+    }
+    hal_trace_attach(gTraceSegment);
+    gSinceDrain = 0;
+    gDrainStop = -1;
+    if (gStress)
+    {
+        gDrainStop = 0;
+        if (pthread_create(&gDrainThread, NULL, bench_drain, NULL) != 0)
+        {
+            fprintf(stderr, "bench: cannot start the trace reader, rings will fill\n");
+            gDrainStop = -1;
+        }
+    }
+}
+
+static void trace_teardown( void )
+{
+    if (gTraceSegment == NULL)
+    {
+        return;
+    }
+    if (gDrainStop == 0)
+    {
+        __atomic_store_n(&gDrainStop, 1, __ATOMIC_RELAXED);
+        pthread_join(gDrainThread, NULL);
+    }
+    else
+    {
+        gDrained += hal_trace_drain(gTraceSegment, gRecords, BENCH_TRACE_BATCH);
+    }
+    hal_trace_attach(NULL);
+    gDropped += hal_trace_dropped(gTraceSegment);
+    hal_trace_close(gTraceSegment);
+    hal_trace_unlink(gTraceName);
+    gTraceSegment = NULL;
+}
+
+/* Latency mode: one thread records, so it can also be the reader */
+static void keep_up( void )
+{
+    if (!gStress && gTraceSegment != NULL && ++gSinceDrain == BENCH_TRACE_DRAIN_EVERY)
+    {
+        gSinceDrain = 0;
+        gDrained += hal_trace_drain(gTraceSegment, gRecords, BENCH_TRACE_BATCH);
+    }
+}
+
+static int bench_untraced( void *pOut )
+{
+    return gpTracedGetter->call(pOut);
+}
+
+/* As the wrappers of tools/hal_trace/hal_trace_preload.c */
+static int bench_traced( void *pOut )
+{
+    uint64_t start = hal_trace_now();
+    int status = gpTracedGetter->call(pOut);
+
+    hal_trace_record(0, start, hal_trace_now(), status);
+    keep_up();
+    return status;
+}
+
+static int bench_record( void *pOut )
+{
+    (void)pOut;
+    hal_trace_record(0, hal_trace_now(), hal_trace_now(), 0);
+    keep_up();
+    return 0;
+}
+
+/**
+* @brief Runs the call tracer suite
+*
+* @return 0 if every call succeeded, otherwise -1
+*/
+int bench_hal_trace_run( const bench_config_t *pConfig )
+{
+    static const bench_hooks_t hooks = { trace_setup, trace_teardown };
+    const test_getter_t *pGetters;
+    uint32_t count;
+    int status;
+
+    pGetters = BENCH_TRACE_TABLE(&count);
+    gpTracedGetter = bench_find_getter(pGetters, count, BENCH_TRACE_FUNCTION);
+    if (gpTracedGetter == NULL)
+    {
+        return -1;
+    }
+    gStress = (pConfig->mode == BENCH_MODE_STRESS);
+    {
+        const bench_case_t cases[] =
+        {
+            { "trace: " BENCH_TRACE_FUNCTION ", untraced", bench_untraced, gpTracedGetter->outputSize, gpTracedGetter->varying },
+            { "trace: " BENCH_TRACE_FUNCTION ", traced", bench_traced, gpTracedGetter->outputSize, gpTracedGetter->varying },
+            { "trace: record alone", bench_record, 0, 0 },
+        };
+
+        gDrained = 0;
+        gDropped = 0;
+        status = bench_run_suite_hooked("call tracer", cases, sizeof(cases) / sizeof(cases[0]), pConfig, &hooks);
+    }
+    if (gDrained != 0 || gDropped != 0)
+    {
+        printf("trace: %llu calls drained, %llu dropped for a full ring\n", (unsigned long long)gDrained,
+               (unsigned long long)gDropped);
+    }
+    return status;
+}
@@ -0,0 +1,165 @@
+/*
+* If not stated otherwise in this file or this component's LICENSE file the
+* following copyright and licenses apply:*
+* Copyright 2023 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+/**
+* @file bench_lease_file.c
+*
+* Cost of serving the eRouter lease from a lease file (linux skeleton only).
+*
+* Compares the skeleton's cached reader, a cold parse of the mapped file,
+* and what many vendor HALs do on every getter call: fopen() the file and
+* fgets() it line by line. All three share the same line parser, so the
+* difference is the file I/O and caching alone.
+*/
+
+#if defined(BUILD_LINUX) && defined(DHCP4CAPI)
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "dhcp4cApi.h"
+#include "dhcp_lease_file.h"
+#include "bench_common.h"
+
+/* A udhcpc environment dump as found on the field, including keys the HAL ignores */
+static const char gBenchLease[] =
+    "interface=erouter0\n"
+    "ip=203.0.113.77\n"
+    "siaddr=0.0.0.0\n"
+    "sname=\n"
+    "boot_file=\n"
+    "subnet=255.255.255.0\n"
+    "mask=24\n"
+    "broadcast=203.0.113.255\n"
+    "router=203.0.113.1\n"
+    "dns=203.0.113.53 203.0.113.54\n"
+    "domain=example.net\n"
+    "hostname=cpe-203-0-113-77\n"
+    "ntpsrv=203.0.113.123\n"
+    "serverid=203.0.113.5\n"
+    "lease=7200\n"
+    "opt53=05\n"
+    "opt58=00000e10\n"
+    "opt59=00001896\n";
+
+static char gBenchPath[64];
+
+/* bound_ns is cleared so that outputs compare equal in stress mode */
+static int bench_cached_read( void *pOut )
+{
+    dhcp_lease_t *pLease = (dhcp_lease_t *)pOut;
+    int status = dhcp_lease_file_read(gBenchPath, pLease, NULL);
+
+    pLease->bound_ns = 0;
+    return status;
+}
+
+static int bench_cold_parse( void *pOut )
+{
+    dhcp_lease_file_invalidate();
+    return bench_cached_read(pOut);
+}
+
+static int bench_fgets_parse( void *pOut )
+{
+    dhcp_lease_t *pLease = (dhcp_lease_t *)pOut;
+    char line[256];
+    FILE *pFile;
+
+    pFile = fopen(gBenchPath, "r");
+    if (pFile == NULL)
+    {
+        return -1;
+    }
+    (void)dhcp_lease_file_parse("", 0, pLease);
+    while (fgets(line, sizeof(line), pFile) != NULL)
+    {
+        dhcp_lease_file_parse_line(line, strcspn(line, "\n"), pLease);
+    }
+    fclose(pFile);
+    dhcp_lease_apply_defaults(pLease);
+    pLease->bound = (pLease->ip_addr != 0);
+    return pLease->bound ? 0 : -1;
+}
+
+static int bench_dhcp4c_get_ert_ip_addr( void *pOut )
+{
+    return dhcp4c_get_ert_ip_addr((unsigned int *)pOut);
+}
+
+static int bench_dhcp4c_get_ert_remain_lease_time( void *pOut )
+{
+    return dhcp4c_get_ert_remain_lease_time((unsigned int *)pOut);
+}
+
+static const bench_case_t gLeaseFileCases[] =
+{
+    { "cold: open + mmap + parse", bench_cold_parse, sizeof(dhcp_lease_t), 0 },
+    { "warm: stat + cached copy", bench_cached_read, sizeof(dhcp_lease_t), 0 },
+    { "naive: fopen + fgets + parse", bench_fgets_parse, sizeof(dhcp_lease_t), 0 },
+    { "dhcp4c_get_ert_ip_addr (file)", bench_dhcp4c_get_ert_ip_addr, sizeof(unsigned int), 0 },
+    { "dhcp4c_get_ert_remain_lease_time (file)", bench_dhcp4c_get_ert_remain_lease_time, sizeof(unsigned int), 1 },
+};
+
+/**
+* @brief Runs the lease file suite against a temporary lease file
+*
+* @return 0 if every call succeeded, otherwise -1
+*/
+int bench_lease_file_run( const bench_config_t *pConfig )
+{
+    const char *pPrevious = getenv(DHCP_LEASE_FILE_ENV);
+    char *pSaved = (pPrevious != NULL) ? strdup(pPrevious) : NULL;
+    FILE *pFile;
+    int status;
+    int fd;
+
+    strcpy(gBenchPath, "/tmp/dhcp4_hal_bench_lease_XXXXXX");
+    fd = mkstemp(gBenchPath);
+    if (fd < 0)
+    {
+        fprintf(stderr, "bench: cannot create a lease file\n");
+        free(pSaved);
+        return -1;
+    }
+    pFile = fdopen(fd, "w");
+    if (pFile == NULL || fputs(gBenchLease, pFile) < 0 || fclose(pFile) != 0)
+    {
+        fprintf(stderr, "bench: cannot write %s\n", gBenchPath);
+        unlink(gBenchPath);
+        free(pSaved);
+        return -1;
+    }
+
+    setenv(DHCP_LEASE_FILE_ENV, gBenchPath, 1);
+    status = bench_run_suite("lease file", gLeaseFileCases, sizeof(gLeaseFileCases) / sizeof(gLeaseFileCases[0]), pConfig);
+    if (pSaved != NULL)
+    {
+        setenv(DHCP_LEASE_FILE_ENV, pSaved, 1);
+    }
+    else
+    {
+        unsetenv(DHCP_LEASE_FILE_ENV);
+    }
+    free(pSaved);
+    unlink(gBenchPath);
+    return status;
+}
+
+#endif /* BUILD_LINUX && DHCP4CAPI */
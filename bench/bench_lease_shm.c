@@ -0,0 +1,217 @@
+/*
+* If not stated otherwise in this file or this component's LICENSE file the
+* following copyright and licenses apply:*
+* Copyright 2023 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+/**
+* @file bench_lease_shm.c
+*
+* Cost of serving leases from the shared-memory lease page (linux skeleton only).
+*
+* Runs the same cases twice: with the page left alone, then with a writer
+* thread publishing a new eRouter lease back to back, the worst case for the
+* sequence lock. The lease engine's mutex-guarded snapshot is timed alongside
+* for comparison. With -m stress the cases run from several reader threads
+* at once against the writer, giving aggregate reader throughput.
+*/
+
+#ifdef BUILD_LINUX
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <arpa/inet.h>
+#ifdef DHCP4CAPI
+#include "dhcp4cApi.h"
+#endif
+#ifdef DHCPV4C_API
+#include "dhcpv4c_api.h"
+#endif
+#include "dhcp_lease_shm.h"
+#include "bench_common.h"
+
+static const dhcp_lease_shm_page_t *gBenchPage;
+static uint64_t gRetriedReads = 0;
+static uint64_t gRetries = 0;
+static int gWriterStop = 0;
+static uint64_t gWriterUpdates = 0;
+
+static void bench_lease( uint32_t n, dhcp_lease_t *pLease )
+{
+    memset(pLease, 0, sizeof(*pLease));
+    strcpy(pLease->ifname, "erouter0");
+    pLease->ip_addr = htonl(0xcb007100U | (n & 0x3fU));     /* 203.0.113.0/26 */
+    pLease->mask = htonl(0xffffff00U);
+    pLease->gw = htonl(0xcb007101U);
+    pLease->dhcp_svr = htonl(0xcb007105U);
+    pLease->dns_svrs[0] = htonl(0xcb007135U);
+    pLease->dns_count = 1;
+    pLease->lease_time = 7200;
+    dhcp_lease_apply_defaults(pLease);
+    pLease->bound = 1;
+    pLease->bound_ns = dhcp_lease_engine_now_ns();
+}
+
+/* Publishes as fast as it can until told to stop */
+static void *bench_writer( void *pArg )
+{
+    dhcp_lease_shm_page_t *pPage = (dhcp_lease_shm_page_t *)pArg;
+    dhcp_lease_t lease;
+    uint64_t n = 0;
+
+    bench_lease(0, &lease);
+    while (!__atomic_load_n(&gWriterStop, __ATOMIC_RELAXED))
+    {
+        lease.ip_addr = htonl(0xcb007100U | (uint32_t)(++n & 0x3fU));
+        dhcp_lease_shm_publish(pPage, DHCP_LEASE_IF_ERT, &lease);
+    }
+    __atomic_store_n(&gWriterUpdates, n, __ATOMIC_RELAXED);
+    return NULL;
+}
+
+/* Retries are counted only when there were some, so that idle readers share no cache line */
+static int bench_seqlock_read( void *pOut )
+{
+    int retries = dhcp_lease_shm_read(gBenchPage, DHCP_LEASE_IF_ERT, (dhcp_lease_t *)pOut);
+
+    if (retries > 0)
+    {
+        __atomic_add_fetch(&gRetriedReads, 1, __ATOMIC_RELAXED);
+        __atomic_add_fetch(&gRetries, (uint64_t)retries, __ATOMIC_RELAXED);
+    }
+    return (retries < 0) ? -1 : 0;
+}
+
+static int bench_engine_snapshot( void *pOut )
+{
+    dhcp_lease_timers_t timers;
+
+    return dhcp_lease_engine_snapshot(DHCP_LEASE_IF_ERT, (dhcp_lease_t *)pOut, &timers, NULL);
+}
+
+#ifdef DHCP4CAPI
+static int bench_dhcp4c_get_ert_ip_addr( void *pOut )
+{
+    return dhcp4c_get_ert_ip_addr((unsigned int *)pOut);
+}
+
+static int bench_dhcp4c_get_ert_remain_lease_time( void *pOut )
+{
+    return dhcp4c_get_ert_remain_lease_time((unsigned int *)pOut);
+}
+#endif
+
+#ifdef DHCPV4C_API
+static int bench_dhcpv4c_get_ert_ip_addr( void *pOut )
+{
+    return dhcpv4c_get_ert_ip_addr((UINT *)pOut);
+}
+
+static int bench_dhcpv4c_get_ert_fsm_state( void *pOut )
+{
+    return dhcpv4c_get_ert_fsm_state((INT *)pOut);
+}
+#endif
+
+/* The writer changes the address, so every output varies */
+static const bench_case_t gLeaseShmCases[] =
+{
+    { "page: seqlock copy", bench_seqlock_read, sizeof(dhcp_lease_t), 1 },
+    { "engine: mutex + copy (no writer)", bench_engine_snapshot, sizeof(dhcp_lease_t), 1 },
+#ifdef DHCP4CAPI
+    { "dhcp4c_get_ert_ip_addr (page)", bench_dhcp4c_get_ert_ip_addr, sizeof(unsigned int), 1 },
+    { "dhcp4c_get_ert_remain_lease_time (page)", bench_dhcp4c_get_ert_remain_lease_time, sizeof(unsigned int), 1 },
+#endif
+#ifdef DHCPV4C_API
+    { "dhcpv4c_get_ert_ip_addr (page)", bench_dhcpv4c_get_ert_ip_addr, sizeof(UINT), 1 },
+    { "dhcpv4c_get_ert_fsm_state (page)", bench_dhcpv4c_get_ert_fsm_state, sizeof(INT), 1 },
+#endif
+};
+
+/**
+* @brief Runs the lease page suite without and with a concurrent writer
+*
+* @return 0 if every call succeeded, otherwise -1
+*/
+int bench_lease_shm_run( const bench_config_t *pConfig )
+{
+    const uint32_t count = sizeof(gLeaseShmCases) / sizeof(gLeaseShmCases[0]);
+    const char *pPrevious = getenv(DHCP_LEASE_SHM_ENV);
+    char *pSaved = (pPrevious != NULL) ? strdup(pPrevious) : NULL;
+    dhcp_lease_shm_page_t *pPage;
+    dhcp_lease_t lease;
+    pthread_t writer;
+    uint64_t start_ns;
+    uint64_t elapsed_ns;
+    char name[64];
+    int status;
+
+    snprintf(name, sizeof(name), "/dhcp4_hal_bench_%d", (int)getpid());
+    pPage = dhcp_lease_shm_create(name);
+    gBenchPage = dhcp_lease_shm_open(name);
+    if (pPage == NULL || gBenchPage == NULL)
+    {
+        fprintf(stderr, "bench: cannot create the lease page %s\n", name);
+        dhcp_lease_shm_close(pPage);
+        shm_unlink(name);
+        free(pSaved);
+        return -1;
+    }
+    bench_lease(0, &lease);
+    dhcp_lease_shm_publish(pPage, DHCP_LEASE_IF_ERT, &lease);
+    setenv(DHCP_LEASE_SHM_ENV, name, 1);
+
+    status = bench_run_suite("lease page, no writer", gLeaseShmCases, count, pConfig);
+
+    gRetriedReads = 0;
+    gRetries = 0;
+    __atomic_store_n(&gWriterStop, 0, __ATOMIC_RELAXED);
+    start_ns = bench_now_ns();
+    if (pthread_create(&writer, NULL, bench_writer, pPage) != 0)
+    {
+        fprintf(stderr, "bench: cannot start the lease page writer\n");
+        status = -1;
+    }
+    else
+    {
+        status |= bench_run_suite("lease page, writer publishing back to back", gLeaseShmCases, count, pConfig);
+        __atomic_store_n(&gWriterStop, 1, __ATOMIC_RELAXED);
+        pthread_join(writer, NULL);
+        elapsed_ns = bench_now_ns() - start_ns;
+        printf("writer: %llu leases published, %.0f/s; %llu reads retried, %llu retries in all\n",
+               (unsigned long long)gWriterUpdates, (double)gWriterUpdates * 1e9 / (double)(elapsed_ns ? elapsed_ns : 1),
+               (unsigned long long)gRetriedReads, (unsigned long long)gRetries);
+    }
+
+    if (pSaved != NULL)
+    {
+        setenv(DHCP_LEASE_SHM_ENV, pSaved, 1);
+    }
+    else
+    {
+        unsetenv(DHCP_LEASE_SHM_ENV);
+    }
+    free(pSaved);
+    dhcp_lease_shm_close(gBenchPage);
+    dhcp_lease_shm_close(pPage);
+    shm_unlink(name);
+    return status;
+}
+
+#endif /* BUILD_LINUX */
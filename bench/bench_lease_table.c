@@ -0,0 +1,210 @@
+/*
+* If not stated otherwise in this file or this component's LICENSE file the
+* following copyright and licenses apply:*
+* Copyright 2023 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+/**
+* @file bench_lease_table.c
+*
+* Cost of the interface-indexed getters as the lease table grows (linux skeleton only).
+*
+* The table is filled with added interfaces up to 1, 8, 64 and 1024 entries in
+* turn. Lookup cases read one interface per call, moving to the next each
+* time, so that every entry is touched; scan cases read one field of every
+* interface per call, either through a getter per interface or as a single
+* dhcp_lease_engine_scan() over the field's column.
+*/
+
+#ifdef BUILD_LINUX
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#ifdef DHCP4CAPI
+#include "dhcp4cApi.h"
+#endif
+#ifdef DHCP4CAPI_EXT
+#include "dhcp4cApi_ext.h"
+#endif
+#ifdef DHCPV4C_API
+#include "dhcpv4c_api.h"
+#endif
+#ifdef DHCPV4C_API_EXT
+#include "dhcpv4c_api_ext.h"
+#endif
+#include "dhcp_lease_engine.h"
+#include "bench_common.h"
+
+static const uint32_t gTableSizes[] = { 1, 8, 64, DHCP_LEASE_MAX_IFACES };
+
+static uint32_t gTableSize = 1;
+static uint32_t gNextIface = 0;
+static uint32_t gScan[DHCP_LEASE_MAX_IFACES];
+
+/* Racy under -m stress by design: threads only need to spread over the table */
+static uint32_t next_iface( void )
+{
+    uint32_t iface = __atomic_load_n(&gNextIface, __ATOMIC_RELAXED);
+
+    __atomic_store_n(&gNextIface, (iface + 1 < gTableSize) ? iface + 1 : 0, __ATOMIC_RELAXED);
+    return iface;
+}
+
+static int bench_engine_field( void *pOut )
+{
+    return dhcp_lease_engine_field((dhcp_lease_if_t)next_iface(), DHCP_LEASE_FIELD_IP_ADDR, (uint32_t *)pOut);
+}
+
+static int bench_engine_scan_ip_addr( void *pOut )
+{
+    (void)pOut;
+    return (dhcp_lease_engine_scan(DHCP_LEASE_FIELD_IP_ADDR, 0, gTableSize, gScan) == (int)gTableSize) ? 0 : -1;
+}
+
+static int bench_engine_scan_remain_lease( void *pOut )
+{
+    (void)pOut;
+    return (dhcp_lease_engine_scan(DHCP_LEASE_FIELD_REMAIN_LEASE, 0, gTableSize, gScan) == (int)gTableSize) ? 0 : -1;
+}
+
+#ifdef DHCP4CAPI_EXT
+static int bench_dhcp4c_get_if_fsm_state( void *pOut )
+{
+    return dhcp4c_get_if_fsm_state(next_iface(), (int *)pOut);
+}
+
+static int bench_dhcp4c_scan_ip_addr( void *pOut )
+{
+    uint32_t iface;
+
+    (void)pOut;
+    for (iface = 0; iface < gTableSize; iface++)
+    {
+        if (dhcp4c_get_if_ip_addr(iface, &gScan[iface]) != 0)
+        {
+            return -1;
+        }
+    }
+    return 0;
+}
+#endif
+
+#ifdef DHCPV4C_API_EXT
+static int bench_dhcpv4c_get_if_ip_addr( void *pOut )
+{
+    return dhcpv4c_get_if_ip_addr(next_iface(), (UINT *)pOut);
+}
+
+static int bench_dhcpv4c_get_if_remain_lease_time( void *pOut )
+{
+    return dhcpv4c_get_if_remain_lease_time(next_iface(), (UINT *)pOut);
+}
+
+static int bench_dhcpv4c_get_if_snapshot( void *pOut )
+{
+    return dhcpv4c_get_if_snapshot(next_iface(), (dhcpv4c_lease_snapshot_t *)pOut);
+}
+
+static int bench_dhcpv4c_scan_ip_addr( void *pOut )
+{
+    uint32_t iface;
+
+    (void)pOut;
+    for (iface = 0; iface < gTableSize; iface++)
+    {
+        if (dhcpv4c_get_if_ip_addr(iface, &gScan[iface]) != 0)
+        {
+            return -1;
+        }
+    }
+    return 0;
+}
+#endif
+
+/* Lookups move through the table, so their outputs vary; scans keep theirs in gScan */
+static const bench_case_t gLeaseTableCases[] =
+{
+    { "lookup: engine field (ip_addr)", bench_engine_field, sizeof(uint32_t), 1 },
+#ifdef DHCPV4C_API_EXT
+    { "lookup: dhcpv4c_get_if_ip_addr", bench_dhcpv4c_get_if_ip_addr, sizeof(UINT), 1 },
+    { "lookup: dhcpv4c_get_if_remain_lease_time", bench_dhcpv4c_get_if_remain_lease_time, sizeof(UINT), 1 },
+    { "lookup: dhcpv4c_get_if_snapshot", bench_dhcpv4c_get_if_snapshot, sizeof(dhcpv4c_lease_snapshot_t), 1 },
+#endif
+#ifdef DHCP4CAPI_EXT
+    { "lookup: dhcp4c_get_if_fsm_state", bench_dhcp4c_get_if_fsm_state, sizeof(int), 1 },
+#endif
+#ifdef DHCPV4C_API_EXT
+    { "scan: dhcpv4c_get_if_ip_addr per interface", bench_dhcpv4c_scan_ip_addr, 0, 1 },
+#endif
+#ifdef DHCP4CAPI_EXT
+    { "scan: dhcp4c_get_if_ip_addr per interface", bench_dhcp4c_scan_ip_addr, 0, 1 },
+#endif
+    { "scan: engine column (ip_addr)", bench_engine_scan_ip_addr, 0, 1 },
+    { "scan: engine column (remain_lease)", bench_engine_scan_remain_lease, 0, 1 },
+};
+
+/**
+* @brief Runs the lease table suite at each table size
+*
+* @return 0 if every call succeeded, otherwise -1
+*/
+int bench_lease_table_run( const bench_config_t *pConfig )
+{
+    const uint32_t count = sizeof(gLeaseTableCases) / sizeof(gLeaseTableCases[0]);
+    const char *pPrevious = getenv(DHCP_LEASE_ENGINE_IFACES_ENV);
+    char *pSaved = (pPrevious != NULL) ? strdup(pPrevious) : NULL;
+    dhcp_lease_if_t iface;
+    char suite[64];
+    char ifname[16];
+    uint32_t size;
+    int status = 0;
+
+    /* Sizes are exact only without interfaces named in the environment */
+    unsetenv(DHCP_LEASE_ENGINE_IFACES_ENV);
+    dhcp_lease_engine_reset();
+
+    for (size = 0; size < sizeof(gTableSizes) / sizeof(gTableSizes[0]); size++)
+    {
+        while (dhcp_lease_engine_iface_count() < gTableSizes[size])
+        {
+            snprintf(ifname, sizeof(ifname), "wan%u", dhcp_lease_engine_iface_count());
+            if (dhcp_lease_engine_add_iface(ifname, &iface) != 0)
+            {
+                fprintf(stderr, "bench: cannot add interface %s\n", ifname);
+                status = -1;
+                break;
+            }
+        }
+        if (status != 0)
+        {
+            break;
+        }
+        gTableSize = gTableSizes[size];
+        gNextIface = 0;
+        snprintf(suite, sizeof(suite), "lease table, %u interface%s", gTableSize, (gTableSize == 1) ? "" : "s");
+        status |= bench_run_suite(suite, gLeaseTableCases, count, pConfig);
+    }
+
+    if (pSaved != NULL)
+    {
+        setenv(DHCP_LEASE_ENGINE_IFACES_ENV, pSaved, 1);
+    }
+    free(pSaved);
+    dhcp_lease_engine_reset();
+    return status;
+}
+
+#endif /* BUILD_LINUX */
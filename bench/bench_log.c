@@ -0,0 +1,132 @@
+/*
+* If not stated otherwise in this file or this component's LICENSE file the
+* following copyright and licenses apply:*
+* Copyright 2023 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+/**
+* @file bench_log.c
+*
+* Cost to the caller of one UT_LOG_DEBUG line, written synchronously as
+* ut-core does and queued for the async backend of test_log.h.
+*
+* The lines are those the L1 tests log around every HAL call: the test's
+* entry line and a getter's result. While a case runs, standard output goes
+* to BENCH_LOG_SINK (default /dev/null), so a sink on flash gives the
+* figures of a target logging to a file. The async cases include the waits
+* for a full ring when the writer falls behind, which show in p99 and max;
+* the suite ends with the backend's counters.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include "test_log.h"
+#include "bench_common.h"
+
+#define BENCH_LOG_SINK_ENV      "BENCH_LOG_SINK"
+#define BENCH_LOG_DEFAULT_SINK  "/dev/null"
+
+static int gSavedStdout = -1;
+
+static void sink_open( void )
+{
+    const char *pPath = getenv(BENCH_LOG_SINK_ENV);
+    int fd;
+
+    fd = open((pPath != NULL) ? pPath : BENCH_LOG_DEFAULT_SINK, O_WRONLY | O_CREAT | O_APPEND, 0644);
+    if (fd < 0)
+    {
+        fprintf(stderr, "bench: cannot open %s, logging to standard output\n", (pPath != NULL) ? pPath : BENCH_LOG_DEFAULT_SINK);
+        return;
+    }
+    fflush(stdout);
+    gSavedStdout = dup(STDOUT_FILENO);
+    dup2(fd, STDOUT_FILENO);
+    close(fd);
+}
+
+static void sink_close( void )
+{
+    if (gSavedStdout < 0)
+    {
+        return;
+    }
+    /* Every queued line goes to the sink, not into the results */
+    test_log_flush();
+    fflush(stdout);
+    dup2(gSavedStdout, STDOUT_FILENO);
+    close(gSavedStdout);
+    gSavedStdout = -1;
+}
+
+static int bench_entry_sync( void *pOut )
+{
+    (void)pOut;
+    UT_logPrefix(__FILE__, __LINE__, test_log_prefix(TEST_LOG_LEVEL_INFO), "In %s [%02d%03d]\n", "test_l1_dhcpv4c_api_hal_positive1_get_ert_lease_time", 1, 17);
+    return 0;
+}
+
+static int bench_entry_async( void *pOut )
+{
+    (void)pOut;
+    test_log_enqueue(__FILE__, __LINE__, TEST_LOG_LEVEL_INFO, "In %s [%02d%03d]\n", "test_l1_dhcpv4c_api_hal_positive1_get_ert_lease_time", 1, 17);
+    return 0;
+}
+
+static int bench_result_sync( void *pOut )
+{
+    (void)pOut;
+    UT_logPrefix(__FILE__, __LINE__, test_log_prefix(TEST_LOG_LEVEL_DEBUG), "%s returned %d, value %u", "dhcpv4c_get_ert_lease_time", 0, 86400U);
+    return 0;
+}
+
+static int bench_result_async( void *pOut )
+{
+    (void)pOut;
+    test_log_enqueue(__FILE__, __LINE__, TEST_LOG_LEVEL_DEBUG, "%s returned %d, value %u", "dhcpv4c_get_ert_lease_time", 0, 86400U);
+    return 0;
+}
+
+static const bench_case_t gLogCases[] =
+{
+    { "log: test entry line, sync", bench_entry_sync, 0, 0 },
+    { "log: test entry line, async", bench_entry_async, 0, 0 },
+    { "log: getter result, sync", bench_result_sync, 0, 0 },
+    { "log: getter result, async", bench_result_async, 0, 0 },
+};
+
+/**
+* @brief Runs the log backend suite
+*
+* @return 0 if every call succeeded, otherwise -1
+*/
+int bench_log_run( const bench_config_t *pConfig )
+{
+    static const bench_hooks_t hooks = { sink_open, sink_close };
+    test_log_stats_t stats;
+    int status;
+
+    status = bench_run_suite_hooked("log backend", gLogCases, sizeof(gLogCases) / sizeof(gLogCases[0]), pConfig, &hooks);
+    test_log_stats(&stats);
+    if (stats.queued != 0)
+    {
+        printf("async: %llu lines queued, %llu written, %llu waited for a full ring, %llu truncated, %u rings\n",
+               (unsigned long long)stats.queued, (unsigned long long)stats.written, (unsigned long long)stats.waits,
+               (unsigned long long)stats.truncated, stats.rings);
+    }
+    return status;
+}
@@ -0,0 +1,125 @@
+/*
+* If not stated otherwise in this file or this component's LICENSE file the
+* following copyright and licenses apply:*
+* Copyright 2023 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "bench_common.h"
+
+#define DEFAULT_ITERATIONS  100000
+#define DEFAULT_WARMUP      1000
+#define DEFAULT_DURATION_S  10
+#define DEFAULT_RUNS        200
+#define DEFAULT_LEASES      100000
+
+extern int run_hal_bench_suites( const bench_config_t *pConfig );
+
+static void usage( const char *pProgram )
+{
+    printf("Usage: %s [-m latency|stress|acquire|timers] [-i iterations] [-w warmup] [-b budget_ms] [-t threads] [-d seconds] [-r runs] [-l leases] [-f filter] [-H]\n", pProgram);
+    printf("  -m  latency: time each function single-threaded (default)\n");
+    printf("      stress:  call every function from several threads and check results agree\n");
+    printf("      acquire: time eRouter lease acquisition against the DHCP server stand-in (root)\n");
+    printf("      timers:  drive simulated leases from the lease engine's timing wheel (linux skeleton)\n");
+    printf("  -i  timed calls per function, or timers: simulated ticks (default %d)\n", DEFAULT_ITERATIONS);
+    printf("  -w  untimed warm-up calls per function (default %d)\n", DEFAULT_WARMUP);
+    printf("  -b  stop timing a function after budget_ms of wall time (default unlimited)\n");
+    printf("  -f  only run functions whose name contains filter\n");
+    printf("  -H  print a latency histogram per function\n");
+    printf("  -t  stress: concurrent threads (default online CPUs)\n");
+    printf("  -d  stress: seconds to run each suite, timers: seconds of real time (default %d)\n", DEFAULT_DURATION_S);
+    printf("  -r  acquire: leases to acquire per HAL family (default %d)\n", DEFAULT_RUNS);
+    printf("  -l  timers: simulated leases, three timers each (default %d)\n", DEFAULT_LEASES);
+}
+
+int main(int argc, char** argv)
+{
+    bench_config_t config = { DEFAULT_ITERATIONS, DEFAULT_WARMUP, NULL, 0, 0, BENCH_MODE_LATENCY, 0, DEFAULT_DURATION_S, DEFAULT_RUNS, DEFAULT_LEASES };
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    int opt;
+
+    config.threads = (cpus > 0) ? (uint32_t)cpus : 1;
+    while ((opt = getopt(argc, argv, "m:i:w:b:t:d:r:l:f:Hh")) != -1)
+    {
+        switch (opt)
+        {
+            case 'm':
+                if (strcmp(optarg, "stress") == 0)
+                {
+                    config.mode = BENCH_MODE_STRESS;
+                }
+                else if (strcmp(optarg, "acquire") == 0)
+                {
+                    config.mode = BENCH_MODE_ACQUIRE;
+                }
+                else if (strcmp(optarg, "timers") == 0)
+                {
+                    config.mode = BENCH_MODE_TIMERS;
+                }
+                else if (strcmp(optarg, "latency") == 0)
+                {
+                    config.mode = BENCH_MODE_LATENCY;
+                }
+                else
+                {
+                    usage(argv[0]);
+                    return 1;
+                }
+                break;
+            case 'i':
+                config.iterations = (uint32_t)strtoul(optarg, NULL, 0);
+                break;
+            case 'w':
+                config.warmup = (uint32_t)strtoul(optarg, NULL, 0);
+                break;
+            case 'b':
+                config.budget_ms = (uint32_t)strtoul(optarg, NULL, 0);
+                break;
+            case 't':
+                config.threads = (uint32_t)strtoul(optarg, NULL, 0);
+                break;
+            case 'd':
+                config.duration_s = (uint32_t)strtoul(optarg, NULL, 0);
+                break;
+            case 'r':
+                config.runs = (uint32_t)strtoul(optarg, NULL, 0);
+                break;
+            case 'l':
+                config.leases = (uint32_t)strtoul(optarg, NULL, 0);
+                break;
+            case 'f':
+                config.pFilter = optarg;
+                break;
+            case 'H':
+                config.histogram = 1;
+                break;
+            default:
+                usage(argv[0]);
+                return (opt == 'h') ? 0 : 1;
+        }
+    }
+
+    if (config.threads == 0)
+    {
+        config.threads = 1;
+    }
+
+    /* Non-zero exit if any HAL call failed, or in stress mode returned inconsistent results */
+    return (run_hal_bench_suites(&config) == 0) ? 0 : 1;
+}
@@ -0,0 +1,98 @@
+/*
+* If not stated otherwise in this file or this component's LICENSE file the
+* following copyright and licenses apply:*
+* Copyright 2023 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#include <stdio.h>
+#include "bench_common.h"
+
+/* Latency suites */
+#ifdef DHCP4CAPI
+extern int bench_dhcp4cApi_run( const bench_config_t *pConfig );
+extern int bench_dhcp4cApi_acquire_run( const bench_config_t *pConfig );
+#endif
+#ifdef DHCPV4C_API
+extern int bench_dhcpv4c_api_run( const bench_config_t *pConfig );
+extern int bench_dhcpv4c_api_acquire_run( const bench_config_t *pConfig );
+#endif
+#if defined(BUILD_LINUX) && defined(DHCP4CAPI)
+extern int bench_lease_file_run( const bench_config_t *pConfig );
+#endif
+#ifdef BUILD_LINUX
+extern int bench_lease_shm_run( const bench_config_t *pConfig );
+extern int bench_lease_table_run( const bench_config_t *pConfig );
+extern int bench_dhcp_packet_run( const bench_config_t *pConfig );
+extern int bench_dhcp_packet_scan_run( const bench_config_t *pConfig );
+extern int bench_timer_wheel_run( const bench_config_t *pConfig );
+#endif
+extern int bench_ipv4_run( const bench_config_t *pConfig );
+extern int bench_log_run( const bench_config_t *pConfig );
+extern int bench_hal_trace_run( const bench_config_t *pConfig );
+
+int run_hal_bench_suites( const bench_config_t *pConfig )
+{
+    int status = 0;
+
+    if (pConfig->mode == BENCH_MODE_ACQUIRE)
+    {
+        /* End to end against the DHCP server stand-in, once per HAL family */
+#ifdef DHCP4CAPI
+        status |= bench_dhcp4cApi_acquire_run(pConfig);
+#endif
+#ifdef DHCPV4C_API
+        status |= bench_dhcpv4c_api_acquire_run(pConfig);
+#endif
+        return status;
+    }
+    if (pConfig->mode == BENCH_MODE_TIMERS)
+    {
+#ifdef BUILD_LINUX
+        /* The skeleton lease engine's timing wheel, scaled up to many leases */
+        status |= bench_timer_wheel_run(pConfig);
+#else
+        fprintf(stderr, "bench: -m timers needs the linux skeleton\n");
+        status = -1;
+#endif
+        return status;
+    }
+#ifdef DHCP4CAPI
+    status |= bench_dhcp4cApi_run(pConfig);
+#endif
+#ifdef DHCPV4C_API
+    status |= bench_dhcpv4c_api_run(pConfig);
+#endif
+#if defined(BUILD_LINUX) && defined(DHCP4CAPI)
+    /* The skeleton's lease file backend, not available against vendor libraries */
+    status |= bench_lease_file_run(pConfig);
+#endif
+#ifdef BUILD_LINUX
+    /* The skeleton's shared-memory lease page, idle and under a writer */
+    status |= bench_lease_shm_run(pConfig);
+    /* Interface-indexed getters and column scans as the lease table grows */
+    status |= bench_lease_table_run(pConfig);
+    /* The packet codec shared with the DHCP server stand-in */
+    status |= bench_dhcp_packet_run(pConfig);
+    /* Option scanning with each scanner built */
+    status |= bench_dhcp_packet_scan_run(pConfig);
+#endif
+    /* Formatting helpers shared with the L1 tests */
+    status |= bench_ipv4_run(pConfig);
+    /* UT_LOG_DEBUG/INFO, written synchronously and queued for the async backend */
+    status |= bench_log_run(pConfig);
+    /* A getter called directly and through the call tracer of tools/hal_trace */
+    status |= bench_hal_trace_run(pConfig);
+    return status;
+}
@@ -0,0 +1,351 @@
+/*
+* If not stated otherwise in this file or this component's LICENSE file the
+* following copyright and licenses apply:*
+* Copyright 2023 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+/**
+* @file bench_stress.c
+*
+* Concurrency stress mode of dhcp4_hal_bench.
+*
+* Every thread walks the case table round-robin, each starting at a
+* different case so that threads collide on different getters, until the
+* run time expires. Each output is compared with a reference taken
+* single-threaded before the run; a getter that races on shared state shows
+* up as a status failure or as a mismatch. Outputs flagged as varying
+* (remaining times, FSM state) only have their status checked.
+*
+* A run lasts too long to keep every sample, so per-thread latencies go into
+* a log-linear histogram with 8 sub-buckets per power of two. Percentiles
+* are reported as the upper edge of their bucket, at most 12.5% above the
+* true value; the maximum is exact.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <sched.h>
+#include <pthread.h>
+#include "bench_common.h"
+
+#define LATENCY_SUB_BITS     3
+#define LATENCY_SUB_BUCKETS  (1U << LATENCY_SUB_BITS)
+#define LATENCY_BUCKETS      ((64 - LATENCY_SUB_BITS + 1) * LATENCY_SUB_BUCKETS)
+
+typedef struct
+{
+    const bench_case_t **ppCases;   /* Cases selected by the filter */
+    uint32_t count;
+    const uint8_t *pReference;      /* count * BENCH_MAX_OUTPUT bytes of reference output */
+    int go;                         /* Set once every thread has been created */
+    int stop;                       /* Set when the run time expires */
+} stress_suite_t;
+
+typedef struct
+{
+    pthread_t thread;
+    uint32_t index;
+    stress_suite_t *pSuite;
+    uint64_t calls;
+    uint64_t failures;
+    uint64_t mismatches;
+    uint64_t max_ns;
+    uint64_t elapsed_ns;
+    uint32_t *pCaseMismatches;      /* Per case, indexed like ppCases */
+    uint64_t latency[LATENCY_BUCKETS];
+} stress_thread_t;
+
+static uint32_t latency_bucket( uint64_t ns )
+{
+    uint32_t msb;
+
+    if (ns < LATENCY_SUB_BUCKETS)
+    {
+        return (uint32_t)ns;
+    }
+    msb = 63 - (uint32_t)__builtin_clzll(ns);
+    return (msb - LATENCY_SUB_BITS + 1) * LATENCY_SUB_BUCKETS + (uint32_t)((ns >> (msb - LATENCY_SUB_BITS)) & (LATENCY_SUB_BUCKETS - 1));
+}
+
+/* Exclusive upper edge of a bucket */
+static uint64_t latency_bucket_high( uint32_t bucket )
+{
+    uint32_t shift;
+
+    if (bucket < LATENCY_SUB_BUCKETS)
+    {
+        return bucket + 1;
+    }
+    shift = bucket / LATENCY_SUB_BUCKETS - 1;
+    return ((uint64_t)(LATENCY_SUB_BUCKETS + bucket % LATENCY_SUB_BUCKETS) + 1) << shift;
+}
+
+static uint64_t latency_percentile( const uint64_t *pBuckets, uint64_t count, uint32_t permille )
+{
+    uint64_t rank = (count * permille + 999) / 1000;
+    uint64_t seen = 0;
+    uint32_t b;
+
+    if (rank == 0)
+    {
+        rank = 1;
+    }
+    for (b = 0; b < LATENCY_BUCKETS; b++)
+    {
+        seen += pBuckets[b];
+        if (seen >= rank)
+        {
+            return latency_bucket_high(b);
+        }
+    }
+    return 0;
+}
+
+static void *stress_thread( void *pArg )
+{
+    stress_thread_t *pThread = (stress_thread_t *)pArg;
+    stress_suite_t *pSuite = pThread->pSuite;
+    uint64_t out[BENCH_MAX_OUTPUT / sizeof(uint64_t)];
+    const bench_case_t *pCase;
+    uint64_t start;
+    uint64_t t0;
+    uint64_t ns;
+    uint32_t i = pThread->index % pSuite->count;
+    int status;
+
+    while (!__atomic_load_n(&pSuite->go, __ATOMIC_ACQUIRE))
+    {
+        sched_yield();
+    }
+
+    start = bench_now_ns();
+    while (!__atomic_load_n(&pSuite->stop, __ATOMIC_RELAXED))
+    {
+        pCase = pSuite->ppCases[i];
+        memset(out, 0, pCase->out_size);
+
+        t0 = bench_now_ns();
+        status = pCase->run(out);
+        ns = bench_now_ns() - t0;
+
+        pThread->latency[latency_bucket(ns)]++;
+        if (ns > pThread->max_ns)
+        {
+            pThread->max_ns = ns;
+        }
+        pThread->calls++;
+        if (status != 0)
+        {
+            pThread->failures++;
+        }
+        else if (!pCase->varying && pCase->out_size != 0 &&
+                 memcmp(out, pSuite->pReference + (size_t)i * BENCH_MAX_OUTPUT, pCase->out_size) != 0)
+        {
+            pThread->mismatches++;
+            pThread->pCaseMismatches[i]++;
+        }
+        if (++i == pSuite->count)
+        {
+            i = 0;
+        }
+    }
+    pThread->elapsed_ns = bench_now_ns() - start;
+    return NULL;
+}
+
+static void print_row( const char *pLabel, uint64_t calls, uint64_t elapsed_ns, const uint64_t *pBuckets, uint64_t max_ns,
+                       uint64_t failures, uint64_t mismatches )
+{
+    printf("%-8s %14llu %14.0f %10llu %10llu %10llu %10llu %10llu\n", pLabel, (unsigned long long)calls,
+           (elapsed_ns > 0) ? (double)calls * 1e9 / (double)elapsed_ns : 0.0,
+           (unsigned long long)latency_percentile(pBuckets, calls, 500),
+           (unsigned long long)latency_percentile(pBuckets, calls, 990),
+           (unsigned long long)max_ns, (unsigned long long)failures, (unsigned long long)mismatches);
+}
+
+/* Single-threaded reference outputs; returns the number of cases that failed */
+static uint32_t take_reference( const stress_suite_t *pSuite, uint8_t *pReference )
+{
+    uint32_t failures = 0;
+    uint32_t i;
+
+    for (i = 0; i < pSuite->count; i++)
+    {
+        uint8_t *pOut = pReference + (size_t)i * BENCH_MAX_OUTPUT;
+
+        memset(pOut, 0, BENCH_MAX_OUTPUT);
+        if (pSuite->ppCases[i]->run(pOut) != 0)
+        {
+            printf("  reference call failed: %s\n", pSuite->ppCases[i]->name);
+            failures++;
+        }
+    }
+    return failures;
+}
+
+int bench_run_stress( const char *pSuiteName, const bench_case_t *pCases, uint32_t count, const bench_config_t *pConfig,
+                      const bench_hooks_t *pHooks )
+{
+    stress_suite_t suite;
+    stress_thread_t *pThreads = NULL;
+    uint32_t *pCaseMismatches = NULL;
+    uint8_t *pReference = NULL;
+    uint64_t *pTotal = NULL;
+    uint64_t calls = 0;
+    uint64_t failures = 0;
+    uint64_t mismatches = 0;
+    uint64_t max_ns = 0;
+    uint64_t wall_ns = 0;
+    uint32_t started = 0;
+    struct timespec duration;
+    char label[16];
+    uint32_t i;
+    uint32_t t;
+    uint32_t b;
+    int status = -1;
+
+    memset(&suite, 0, sizeof(suite));
+    suite.ppCases = malloc(sizeof(*suite.ppCases) * (count ? count : 1));
+    if (suite.ppCases == NULL)
+    {
+        fprintf(stderr, "bench: cannot allocate stress state\n");
+        return -1;
+    }
+    for (i = 0; i < count; i++)
+    {
+        if (pConfig->pFilter != NULL && strstr(pCases[i].name, pConfig->pFilter) == NULL)
+        {
+            continue;
+        }
+        if (pCases[i].out_size > BENCH_MAX_OUTPUT)
+        {
+            fprintf(stderr, "bench: %s writes %u bytes, more than BENCH_MAX_OUTPUT\n", pCases[i].name, pCases[i].out_size);
+            goto exit;
+        }
+        suite.ppCases[suite.count++] = &pCases[i];
+    }
+    if (suite.count == 0)
+    {
+        status = 0;
+        goto exit;
+    }
+
+    pReference = malloc((size_t)suite.count * BENCH_MAX_OUTPUT);
+    pCaseMismatches = calloc((size_t)suite.count * pConfig->threads, sizeof(*pCaseMismatches));
+    pThreads = calloc(pConfig->threads, sizeof(*pThreads));
+    pTotal = calloc(LATENCY_BUCKETS, sizeof(*pTotal));
+    if (pReference == NULL || pCaseMismatches == NULL || pThreads == NULL || pTotal == NULL)
+    {
+        fprintf(stderr, "bench: cannot allocate stress state for %u threads\n", pConfig->threads);
+        goto exit;
+    }
+
+    printf("\n[%s] stress threads=%u duration=%us functions=%u\n", pSuiteName, pConfig->threads, pConfig->duration_s, suite.count);
+    if (pHooks != NULL && pHooks->setup != NULL)
+    {
+        pHooks->setup();
+    }
+    failures = take_reference(&suite, pReference);
+    suite.pReference = pReference;
+
+    for (t = 0; t < pConfig->threads; t++)
+    {
+        pThreads[t].index = t;
+        pThreads[t].pSuite = &suite;
+        pThreads[t].pCaseMismatches = pCaseMismatches + (size_t)t * suite.count;
+        if (pthread_create(&pThreads[t].thread, NULL, stress_thread, &pThreads[t]) != 0)
+        {
+            fprintf(stderr, "bench: cannot start stress thread %u\n", t);
+            __atomic_store_n(&suite.stop, 1, __ATOMIC_RELAXED);
+            break;
+        }
+        started++;
+    }
+
+    /* Release every thread at once so they contend from the first call */
+    __atomic_store_n(&suite.go, 1, __ATOMIC_RELEASE);
+    if (started == pConfig->threads)
+    {
+        duration.tv_sec = pConfig->duration_s;
+        duration.tv_nsec = 0;
+        while (nanosleep(&duration, &duration) != 0)
+        {
+        }
+        __atomic_store_n(&suite.stop, 1, __ATOMIC_RELAXED);
+    }
+    for (t = 0; t < started; t++)
+    {
+        pthread_join(pThreads[t].thread, NULL);
+    }
+    if (pHooks != NULL && pHooks->teardown != NULL)
+    {
+        pHooks->teardown();
+    }
+    if (started != pConfig->threads)
+    {
+        goto exit;
+    }
+
+    printf("%-8s %14s %14s %10s %10s %10s %10s %10s\n", "thread", "calls", "calls/sec", "median(ns)", "p99", "max", "fails", "mismatches");
+    for (t = 0; t < started; t++)
+    {
+        snprintf(label, sizeof(label), "%u", t);
+        print_row(label, pThreads[t].calls, pThreads[t].elapsed_ns, pThreads[t].latency, pThreads[t].max_ns,
+                  pThreads[t].failures, pThreads[t].mismatches);
+        calls += pThreads[t].calls;
+        failures += pThreads[t].failures;
+        mismatches += pThreads[t].mismatches;
+        if (pThreads[t].max_ns > max_ns)
+        {
+            max_ns = pThreads[t].max_ns;
+        }
+        if (pThreads[t].elapsed_ns > wall_ns)
+        {
+            wall_ns = pThreads[t].elapsed_ns;
+        }
+        for (b = 0; b < LATENCY_BUCKETS; b++)
+        {
+            pTotal[b] += pThreads[t].latency[b];
+        }
+    }
+    /* Aggregate throughput is all calls over the longest-running thread */
+    print_row("all", calls, wall_ns, pTotal, max_ns, failures, mismatches);
+
+    for (i = 0; i < suite.count; i++)
+    {
+        uint64_t caseMismatches = 0;
+
+        for (t = 0; t < started; t++)
+        {
+            caseMismatches += pThreads[t].pCaseMismatches[i];
+        }
+        if (caseMismatches != 0)
+        {
+            printf("  inconsistent result: %s differed from the reference %llu times\n", suite.ppCases[i]->name,
+                   (unsigned long long)caseMismatches);
+        }
+    }
+    status = (failures == 0 && mismatches == 0) ? 0 : -1;
+
+exit:
+    free(pTotal);
+    free(pThreads);
+    free(pCaseMismatches);
+    free(pReference);
+    free(suite.ppCases);
+    return status;
+}
@@ -0,0 +1,361 @@
+/*
+* If not stated otherwise in this file or this component's LICENSE file the
+* following copyright and licenses apply:*
+* Copyright 2023 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+/**
+* @file bench_timer_wheel.c
+*
+* Cost of driving many simulated leases from the lease engine's timing wheel
+* (linux skeleton only).
+*
+* Every lease has T1, T2 and expiry timers on a wheel with the engine's 1 ms
+* tick. At T1 most leases are renewed, which cancels and re-arms all three;
+* one in eight is not, and runs on through T2 to expiry, where it is bound
+* afresh. The simulated run advances the wheel tick by tick on a virtual
+* clock and times every advance; the real-time run sleeps to each tick on
+* CLOCK_MONOTONIC and measures how late each timer fires.
+*/
+
+#ifdef BUILD_LINUX
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "dhcp_timer_wheel.h"
+#include "bench_common.h"
+
+#define WHEEL_TICK_NS        1000000ULL      /* As the lease engine */
+#define WHEEL_SIM_MIN_S      10              /* Simulated lease times, uniform between these */
+#define WHEEL_SIM_MAX_S      300
+#define WHEEL_RT_MIN_S       2               /* Shorter in real time, so that timers fire within the run */
+#define WHEEL_RT_MAX_S       20
+#define WHEEL_MAX_LATENESS   (1U << 22)      /* Lateness samples kept */
+#define WHEEL_RT_SETUP_NS    500000000ULL    /* Real time: binding leases must take less than this */
+#define WHEEL_NSEC_PER_SEC   1000000000ULL
+
+typedef enum
+{
+    LEASE_T1 = 0,
+    LEASE_T2,
+    LEASE_EXPIRY,
+    LEASE_TIMERS
+} lease_timer_t;
+
+typedef struct
+{
+    dhcp_timer_t timers[LEASE_TIMERS];
+    uint32_t lease_s;
+    int renews;             /* Zero for a lease whose server does not answer at T1 */
+} bench_lease_t;
+
+typedef struct
+{
+    dhcp_timer_wheel_t wheel;
+    bench_lease_t *pLeases;
+    uint32_t leases;
+    uint32_t seed;
+    uint64_t now_ns;        /* Time the wheel is being advanced to */
+    int real_time;          /* Measure lateness against CLOCK_MONOTONIC */
+    uint64_t fired[LEASE_TIMERS];
+    uint64_t cancelled;
+    uint64_t *pLateness;
+    uint32_t lateness_count;
+} wheel_run_t;
+
+static uint32_t next_random( uint32_t *pState )
+{
+    *pState = *pState * 1103515245U + 12345U;
+    return *pState >> 8;
+}
+
+/* Arms all three timers of a lease bound at start_ns */
+static void bind_lease( wheel_run_t *pRun, bench_lease_t *pLease, uint64_t start_ns )
+{
+    uint64_t lease_ns = (uint64_t)pLease->lease_s * WHEEL_NSEC_PER_SEC;
+
+    pRun->cancelled += (uint64_t)dhcp_timer_wheel_cancel(&pRun->wheel, &pLease->timers[LEASE_T2]);
+    pRun->cancelled += (uint64_t)dhcp_timer_wheel_cancel(&pRun->wheel, &pLease->timers[LEASE_EXPIRY]);
+    dhcp_timer_wheel_add(&pRun->wheel, &pLease->timers[LEASE_T1], start_ns + lease_ns / 2);
+    dhcp_timer_wheel_add(&pRun->wheel, &pLease->timers[LEASE_T2], start_ns + (lease_ns * 7) / 8);
+    dhcp_timer_wheel_add(&pRun->wheel, &pLease->timers[LEASE_EXPIRY], start_ns + lease_ns);
+}
+
+static void lease_timer_fired( dhcp_timer_t *pTimer, void *pUserData )
+{
+    wheel_run_t *pRun = (wheel_run_t *)pUserData;
+    bench_lease_t *pLease = &pRun->pLeases[((const char *)pTimer - (const char *)pRun->pLeases) / sizeof(bench_lease_t)];
+    lease_timer_t kind = (lease_timer_t)(pTimer - pLease->timers);
+    struct timespec ts;
+    uint64_t now_ns;
+
+    if (pRun->real_time && pRun->lateness_count < WHEEL_MAX_LATENESS)
+    {
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        now_ns = (uint64_t)ts.tv_sec * WHEEL_NSEC_PER_SEC + (uint64_t)ts.tv_nsec;
+        pRun->pLateness[pRun->lateness_count++] = now_ns - dhcp_timer_expires_ns(pTimer);
+    }
+    pRun->fired[kind]++;
+    if ((kind == LEASE_T1 && pLease->renews) || kind == LEASE_EXPIRY)
+    {
+        /* Renewed at T1, or bound again after expiry, from the time the timer was due */
+        bind_lease(pRun, pLease, dhcp_timer_expires_ns(pTimer));
+    }
+}
+
+static int setup_run( wheel_run_t *pRun, const bench_config_t *pConfig, uint32_t min_s, uint32_t max_s, uint64_t start_ns )
+{
+    bench_lease_t *pLease;
+    uint32_t i;
+    int j;
+
+    memset(pRun, 0, sizeof(*pRun));
+    pRun->leases = pConfig->leases;
+    pRun->seed = 20231017;
+    pRun->pLeases = calloc(pRun->leases, sizeof(bench_lease_t));
+    if (pRun->pLeases == NULL)
+    {
+        fprintf(stderr, "bench: cannot allocate %u leases\n", pRun->leases);
+        return -1;
+    }
+    dhcp_timer_wheel_init(&pRun->wheel, WHEEL_TICK_NS, start_ns);
+    for (i = 0; i < pRun->leases; i++)
+    {
+        pLease = &pRun->pLeases[i];
+        pLease->lease_s = min_s + next_random(&pRun->seed) % (max_s - min_s + 1);
+        pLease->renews = (next_random(&pRun->seed) % 8) != 0;
+        for (j = 0; j < LEASE_TIMERS; j++)
+        {
+            dhcp_timer_init(&pLease->timers[j], lease_timer_fired, pRun);
+        }
+    }
+    return 0;
+}
+
+/* Binds every lease up to half a lease ago, at any nanosecond, so that T1s are spread over the run from its start */
+static uint64_t bind_all( wheel_run_t *pRun, uint64_t now_ns )
+{
+    bench_lease_t *pLease;
+    uint64_t start_ns;
+    uint64_t age_ns;
+    uint32_t i;
+
+    start_ns = bench_now_ns();
+    for (i = 0; i < pRun->leases; i++)
+    {
+        pLease = &pRun->pLeases[i];
+        age_ns = ((uint64_t)next_random(&pRun->seed) % (pLease->lease_s * 500ULL)) * WHEEL_TICK_NS +
+                 next_random(&pRun->seed) % WHEEL_TICK_NS;
+        bind_lease(pRun, pLease, now_ns - age_ns);
+    }
+    return bench_now_ns() - start_ns;
+}
+
+static uint64_t cancel_all( wheel_run_t *pRun )
+{
+    uint64_t start_ns = bench_now_ns();
+    uint32_t i;
+    int j;
+
+    for (i = 0; i < pRun->leases; i++)
+    {
+        for (j = 0; j < LEASE_TIMERS; j++)
+        {
+            dhcp_timer_wheel_cancel(&pRun->wheel, &pRun->pLeases[i].timers[j]);
+        }
+    }
+    return bench_now_ns() - start_ns;
+}
+
+static void print_row( const char *pName, uint64_t *pSamples, uint32_t count, double scale, const bench_config_t *pConfig )
+{
+    bench_result_t result;
+
+    if (count == 0)
+    {
+        printf("%-28s %10s\n", pName, "-");
+        return;
+    }
+    bench_summarise(pSamples, count, &result);
+    printf("%-28s %10u %10.1f %10.1f %10.1f %10.1f %10.1f\n", pName, count,
+           (double)result.min_ns / scale, (double)result.median_ns / scale, (double)result.p99_ns / scale,
+           (double)result.p999_ns / scale, (double)result.max_ns / scale);
+    if (pConfig->histogram)
+    {
+        bench_print_histogram(pSamples, count);
+    }
+}
+
+static void print_totals( const wheel_run_t *pRun, uint64_t ticks )
+{
+    uint64_t total = pRun->fired[LEASE_T1] + pRun->fired[LEASE_T2] + pRun->fired[LEASE_EXPIRY];
+
+    printf("fired: %llu T1, %llu T2, %llu expiry (%.2f per tick); %llu timers cancelled by renewals\n",
+           (unsigned long long)pRun->fired[LEASE_T1], (unsigned long long)pRun->fired[LEASE_T2],
+           (unsigned long long)pRun->fired[LEASE_EXPIRY], ticks ? (double)total / (double)ticks : 0.0,
+           (unsigned long long)pRun->cancelled);
+}
+
+/* Advances a virtual clock one tick at a time and times every advance */
+static int run_simulated( const bench_config_t *pConfig )
+{
+    wheel_run_t run;
+    uint64_t *pSamples;
+    uint64_t bind_ns;
+    uint64_t cancel_ns;
+    uint64_t start_ns;
+    uint64_t before;
+    uint32_t tick;
+
+    pSamples = malloc(sizeof(uint64_t) * pConfig->iterations);
+    if (pSamples == NULL || pConfig->iterations == 0)
+    {
+        free(pSamples);
+        return (pConfig->iterations == 0) ? 0 : -1;
+    }
+    /* Start far enough in that leases can be bound up to a whole lease ago */
+    start_ns = (uint64_t)WHEEL_SIM_MAX_S * WHEEL_NSEC_PER_SEC;
+    if (setup_run(&run, pConfig, WHEEL_SIM_MIN_S, WHEEL_SIM_MAX_S, 0) != 0)
+    {
+        free(pSamples);
+        return -1;
+    }
+    bind_ns = bind_all(&run, start_ns);
+
+    run.now_ns = start_ns;
+    for (tick = 0; tick < pConfig->warmup; tick++)
+    {
+        run.now_ns = start_ns + (uint64_t)(tick + 1) * WHEEL_TICK_NS;
+        dhcp_timer_wheel_advance(&run.wheel, run.now_ns);
+    }
+    start_ns = run.now_ns;
+    memset(run.fired, 0, sizeof(run.fired));
+    run.cancelled = 0;
+    for (tick = 0; tick < pConfig->iterations; tick++)
+    {
+        run.now_ns = start_ns + (uint64_t)(tick + 1) * WHEEL_TICK_NS;
+        before = bench_now_ns();
+        dhcp_timer_wheel_advance(&run.wheel, run.now_ns);
+        pSamples[tick] = bench_now_ns() - before;
+    }
+    cancel_ns = cancel_all(&run);
+
+    printf("\n[lease timer wheel, simulated] leases=%u timers=%u ticks=%u tick=1ms lease=%u-%us timer overhead=%llu ns\n",
+           run.leases, run.leases * LEASE_TIMERS, pConfig->iterations, WHEEL_SIM_MIN_S, WHEEL_SIM_MAX_S,
+           (unsigned long long)bench_timer_overhead_ns());
+    printf("%-28s %10s %10s %10s %10s %10s %10s\n", "", "count", "min(ns)", "median", "p99", "p99.9", "max");
+    print_row("advance one tick", pSamples, pConfig->iterations, 1.0, pConfig);
+    printf("arm: %.1f ns per timer; cancel: %.1f ns per timer\n",
+           (double)bind_ns / (double)(run.leases * LEASE_TIMERS), (double)cancel_ns / (double)(run.leases * LEASE_TIMERS));
+    print_totals(&run, pConfig->iterations);
+
+    free(run.pLeases);
+    free(pSamples);
+    return 0;
+}
+
+/* Sleeps to every tick boundary on CLOCK_MONOTONIC and records how late each timer fires */
+static int run_real_time( const bench_config_t *pConfig )
+{
+    wheel_run_t run;
+    struct timespec wake;
+    uint64_t *pTickSamples;
+    uint64_t origin_ns;
+    uint64_t deadline_ns;
+    uint64_t before;
+    uint64_t ticks = 0;
+    uint64_t overruns = 0;
+    uint32_t max_ticks = pConfig->duration_s * 1000U;
+
+    pTickSamples = malloc(sizeof(uint64_t) * (max_ticks ? max_ticks : 1));
+    /* Tick 0 is far enough out that binding every lease is over before the first timer is due */
+    origin_ns = bench_now_ns() + WHEEL_RT_SETUP_NS;
+    if (pTickSamples == NULL || setup_run(&run, pConfig, WHEEL_RT_MIN_S, WHEEL_RT_MAX_S, origin_ns) != 0)
+    {
+        free(pTickSamples);
+        return -1;
+    }
+    run.pLateness = malloc(sizeof(uint64_t) * WHEEL_MAX_LATENESS);
+    if (run.pLateness == NULL)
+    {
+        free(run.pLeases);
+        free(pTickSamples);
+        return -1;
+    }
+    run.real_time = 1;
+    bind_all(&run, origin_ns);
+    run.cancelled = 0;
+
+    deadline_ns = origin_ns + (uint64_t)pConfig->duration_s * WHEEL_NSEC_PER_SEC;
+    for (ticks = 1; ticks <= max_ticks; ticks++)
+    {
+        run.now_ns = origin_ns + ticks * WHEEL_TICK_NS;
+        wake.tv_sec = (time_t)(run.now_ns / WHEEL_NSEC_PER_SEC);
+        wake.tv_nsec = (long)(run.now_ns % WHEEL_NSEC_PER_SEC);
+        while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &wake, NULL) != 0)
+        {
+        }
+        before = bench_now_ns();
+        dhcp_timer_wheel_advance(&run.wheel, before);
+        pTickSamples[ticks - 1] = bench_now_ns() - before;
+        overruns += (pTickSamples[ticks - 1] > WHEEL_TICK_NS);
+        if (before >= deadline_ns)
+        {
+            break;
+        }
+    }
+    if (ticks > max_ticks)
+    {
+        ticks = max_ticks;
+    }
+
+    printf("\n[lease timer wheel, real time] leases=%u timers=%u duration=%us tick=1ms lease=%u-%us\n",
+           run.leases, run.leases * LEASE_TIMERS, pConfig->duration_s, WHEEL_RT_MIN_S, WHEEL_RT_MAX_S);
+    printf("%-28s %10s %10s %10s %10s %10s %10s\n", "", "count", "min(us)", "median", "p99", "p99.9", "max");
+    print_row("fire lateness", run.pLateness, run.lateness_count, 1000.0, pConfig);
+    print_row("advance one tick", pTickSamples, (uint32_t)ticks, 1000.0, pConfig);
+    printf("lateness includes rounding up to the tick; ticks overrunning 1 ms: %llu\n", (unsigned long long)overruns);
+    print_totals(&run, ticks);
+
+    free(run.pLateness);
+    free(run.pLeases);
+    free(pTickSamples);
+    return 0;
+}
+
+/**
+* @brief Runs the lease timer wheel suites: simulated per-tick cost, then real-time lateness
+*
+* @return 0 on success, -1 if out of memory
+*/
+int bench_timer_wheel_run( const bench_config_t *pConfig )
+{
+    int status = 0;
+
+    if (pConfig->leases == 0)
+    {
+        return 0;
+    }
+    status |= run_simulated(pConfig);
+    if (pConfig->duration_s > 0)
+    {
+        status |= run_real_time(pConfig);
+    }
+    return status;
+}
+
+#endif /* BUILD_LINUX */
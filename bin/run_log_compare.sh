@@ -0,0 +1,100 @@
+#!/bin/bash
+
+# *
+# * If not stated otherwise in this file or this component's LICENSE file the
+# * following copyright and licenses apply:
+# *
+# * Copyright 2023 RDK Management
+# *
+# * Licensed under the Apache License, Version 2.0 (the "License");
+# * you may not use this file except in compliance with the License.
+# * You may obtain a copy of the License at
+# *
+# * http://www.apache.org/licenses/LICENSE-2.0
+# *
+# * Unless required by applicable law or agreed to in writing, software
+# * distributed under the License is distributed on an "AS IS" BASIS,
+# * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# * See the License for the specific language governing permissions and
+# * limitations under the License.
+# *
+
+# Compares dhcp4_hal_test (make build) with dhcp4_hal_test_nodebug (make nodebug):
+# binary size, wall time of a whole run, and the status of every test, which must match.
+#
+#   ./run_log_compare.sh [-n runs] [-o log] [-- test options...]
+#
+# -n  runs of each build, default 5; the median wall time is reported
+# -o  where the tests' output goes, default a file under ${TMPDIR:-/tmp}; put it on flash for a target's figures
+# Options after --, such as --jobs 0 or --log async, are passed to both builds.
+
+cd "$(dirname "$0")"
+export LD_LIBRARY_PATH=/usr/lib:/lib:/home/root:./.
+
+RUNS=5
+WORK=$(mktemp -d "${TMPDIR:-/tmp}/log_compare.XXXXXX")
+OUTPUT=${WORK}/output.txt
+trap 'rm -rf "${WORK}"' EXIT
+
+while getopts "n:o:" option; do
+    case ${option} in
+        n) RUNS=${OPTARG} ;;
+        o) OUTPUT=${OPTARG} ;;
+        *) exit 1 ;;
+    esac
+done
+shift $((OPTIND - 1))
+
+for binary in dhcp4_hal_test dhcp4_hal_test_nodebug; do
+    if [ ! -x "./${binary}" ]; then
+        echo "${binary} not found; build it with make build and make nodebug" >&2
+        exit 1
+    fi
+done
+# Identical binaries mean make nodebug did not take effect, and the figures would compare a build with itself
+if cmp -s ./dhcp4_hal_test ./dhcp4_hal_test_nodebug; then
+    echo "dhcp4_hal_test_nodebug is identical to dhcp4_hal_test; rebuild it with make nodebug" >&2
+    exit 1
+fi
+
+now_ms()
+{
+    local ns
+
+    ns=$(date +%s%N)
+    # A date without %N prints it literally; fall back to whole seconds
+    case ${ns} in
+        *N) echo $(( $(date +%s) * 1000 )) ;;
+        *) echo $(( ns / 1000000 )) ;;
+    esac
+}
+
+# Test name and status of every record, sorted
+statuses()
+{
+    sed -n 's/.*"test":"\([^"]*\)","group":[^,]*,"id":[^,]*,"status":"\([^"]*\)".*/\1 \2/p' "$1" | sort
+}
+
+printf "%-24s %12s %12s %14s %10s\n" "build" "file bytes" "text bytes" "median wall ms" "failed"
+for binary in dhcp4_hal_test dhcp4_hal_test_nodebug; do
+    times=""
+    for run in $(seq 1 "${RUNS}"); do
+        rm -f "${WORK}/${binary}.jsonl"
+        start=$(now_ms)
+        ./${binary} --results-jsonl "${WORK}/${binary}.jsonl" "$@" > "${OUTPUT}" 2>&1
+        end=$(now_ms)
+        times="${times} $(( end - start ))"
+    done
+    median=$(echo ${times} | tr ' ' '\n' | sort -n | sed -n "$(( (RUNS + 1) / 2 ))p")
+    text=$(size "./${binary}" 2>/dev/null | awk 'NR == 2 { print $1 }')
+    failed=$(statuses "${WORK}/${binary}.jsonl" | grep -vc " pass$")
+    printf "%-24s %12s %12s %14s %10s\n" "${binary}" "$(wc -c < "./${binary}")" "${text:--}" "${median}" "${failed}"
+    statuses "${WORK}/${binary}.jsonl" > "${WORK}/${binary}.status"
+done
+
+if ! diff "${WORK}/dhcp4_hal_test.status" "${WORK}/dhcp4_hal_test_nodebug.status" > "${WORK}/status.diff"; then
+    echo "test results differ between the builds (< logging, > stripped):"
+    cat "${WORK}/status.diff"
+    exit 1
+fi
+echo "every test has the same status in both builds"
@@ -0,0 +1,191 @@
+/*
+* If not stated otherwise in this file or this component's LICENSE file the
+* following copyright and licenses apply:*
+* Copyright 2023 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+/**
+* @file dhcp4cApi_ext.h
+*
+* Optional extensions to the dhcp4cApi HAL.
+*
+* These entry points are not part of the base HAL specification. The linux
+* skeleton implements them; a vendor library that does too can be tested by
+* building with HAL_EXT=1, which defines DHCP4CAPI_EXT.
+*
+* Return values follow the base HAL: 0 on success, -1 on failure.
+*/
+
+#ifndef __DHCP4CAPI_EXT_H__
+#define __DHCP4CAPI_EXT_H__
+
+#include "dhcp4cApi.h"
+
+#define DHCP4C_IFNAME_SIZE  64    /*!< Buffer size callers pass to the *_ifname getters */
+
+/**
+* @name Interface indices
+* The first interfaces of dhcp4c_get_if_*(); further DHCP clients, such as
+* Ethernet WAN or LTE backup eRouters, follow up to dhcp4c_get_if_count()
+* @{
+*/
+#define DHCP4C_IF_ERT   0U   /*!< eRouter, as dhcp4c_get_ert_* */
+#define DHCP4C_IF_ECM   1U   /*!< eCM, as dhcp4c_get_ecm_* */
+#define DHCP4C_IF_EMTA  2U   /*!< eMTA, as dhcp4c_get_emta_* */
+/** @} */
+
+/**
+* @brief Returns the number of DHCP client interfaces
+*
+* Valid indices for dhcp4c_get_if_*() are 0 to *pCount - 1. The number
+* only grows while the HAL runs.
+*
+* @param[out] pCount - Receives the number, at least 3
+*
+* @return 0 on success, -1 if pCount is NULL
+*/
+int dhcp4c_get_if_count(unsigned int* pCount);
+
+/**
+* @brief Looks up the index of a DHCP client interface by name
+*
+* @param[in]  pIfname - Interface name, as dhcp4c_get_if_ifname returns it
+* @param[out] pIndex  - Receives the index
+*
+* @return 0 on success, -1 if either pointer is NULL or no interface has that name
+*/
+int dhcp4c_get_if_index(const char* pIfname, unsigned int* pIndex);
+
+/**
+* @brief As dhcp4c_get_ert_lease_time, for any interface
+*
+* @param[in]  ifIndex - Interface index, below dhcp4c_get_if_count()
+* @param[out] pValue  - Receives the lease time in seconds
+*
+* @return 0 on success, -1 if ifIndex is out of range, pValue is NULL or the lease cannot be read
+*/
+int dhcp4c_get_if_lease_time(unsigned int ifIndex, unsigned int* pValue);
+
+/**
+* @brief As dhcp4c_get_ert_remain_lease_time, for any interface
+*
+* @param[in]  ifIndex - Interface index, below dhcp4c_get_if_count()
+* @param[out] pValue  - Receives the seconds until the lease expires
+*
+* @return 0 on success, -1 if ifIndex is out of range, pValue is NULL or the lease cannot be read
+*/
+int dhcp4c_get_if_remain_lease_time(unsigned int ifIndex, unsigned int* pValue);
+
+/**
+* @brief As dhcp4c_get_ert_remain_renew_time, for any interface
+*
+* @param[in]  ifIndex - Interface index, below dhcp4c_get_if_count()
+* @param[out] pValue  - Receives the seconds until T1
+*
+* @return 0 on success, -1 if ifIndex is out of range, pValue is NULL or the lease cannot be read
+*/
+int dhcp4c_get_if_remain_renew_time(unsigned int ifIndex, unsigned int* pValue);
+
+/**
+* @brief As dhcp4c_get_ert_remain_rebind_time, for any interface
+*
+* @param[in]  ifIndex - Interface index, below dhcp4c_get_if_count()
+* @param[out] pValue  - Receives the seconds until T2
+*
+* @return 0 on success, -1 if ifIndex is out of range, pValue is NULL or the lease cannot be read
+*/
+int dhcp4c_get_if_remain_rebind_time(unsigned int ifIndex, unsigned int* pValue);
+
+/**
+* @brief As dhcp4c_get_ert_config_attempts, for any interface
+*
+* @param[in]  ifIndex - Interface index, below dhcp4c_get_if_count()
+* @param[out] pValue  - Receives the DISCOVERs sent to obtain the lease
+*
+* @return 0 on success, -1 if ifIndex is out of range, pValue is NULL or the lease cannot be read
+*/
+int dhcp4c_get_if_config_attempts(unsigned int ifIndex, int* pValue);
+
+/**
+* @brief As dhcp4c_get_ert_ifname, for any interface
+*
+* @param[in]  ifIndex - Interface index, below dhcp4c_get_if_count()
+* @param[out] pName   - Receives the interface name, at least DHCP4C_IFNAME_SIZE bytes
+*
+* @return 0 on success, -1 if ifIndex is out of range, pName is NULL or the lease cannot be read
+*/
+int dhcp4c_get_if_ifname(unsigned int ifIndex, char* pName);
+
+/**
+* @brief As dhcp4c_get_ert_fsm_state, for any interface
+*
+* @param[in]  ifIndex - Interface index, below dhcp4c_get_if_count()
+* @param[out] pValue  - Receives the client FSM state
+*
+* @return 0 on success, -1 if ifIndex is out of range, pValue is NULL or the lease cannot be read
+*/
+int dhcp4c_get_if_fsm_state(unsigned int ifIndex, int* pValue);
+
+/**
+* @brief As dhcp4c_get_ert_ip_addr, for any interface
+*
+* @param[in]  ifIndex - Interface index, below dhcp4c_get_if_count()
+* @param[out] pValue  - Receives the leased address, network byte order
+*
+* @return 0 on success, -1 if ifIndex is out of range, pValue is NULL or the lease cannot be read
+*/
+int dhcp4c_get_if_ip_addr(unsigned int ifIndex, unsigned int* pValue);
+
+/**
+* @brief As dhcp4c_get_ert_mask, for any interface
+*
+* @param[in]  ifIndex - Interface index, below dhcp4c_get_if_count()
+* @param[out] pValue  - Receives the subnet mask, network byte order
+*
+* @return 0 on success, -1 if ifIndex is out of range, pValue is NULL or the lease cannot be read
+*/
+int dhcp4c_get_if_mask(unsigned int ifIndex, unsigned int* pValue);
+
+/**
+* @brief As dhcp4c_get_ert_gw, for any interface
+*
+* @param[in]  ifIndex - Interface index, below dhcp4c_get_if_count()
+* @param[out] pValue  - Receives the first router, network byte order
+*
+* @return 0 on success, -1 if ifIndex is out of range, pValue is NULL or the lease cannot be read
+*/
+int dhcp4c_get_if_gw(unsigned int ifIndex, unsigned int* pValue);
+
+/**
+* @brief As dhcp4c_get_ert_dns_svrs, for any interface
+*
+* @param[in]  ifIndex - Interface index, below dhcp4c_get_if_count()
+* @param[out] pList   - Receives the DNS servers
+*
+* @return 0 on success, -1 if ifIndex is out of range, pList is NULL or the lease cannot be read
+*/
+int dhcp4c_get_if_dns_svrs(unsigned int ifIndex, ipv4AddrList_t* pList);
+
+/**
+* @brief As dhcp4c_get_ert_dhcp_svr, for any interface
+*
+* @param[in]  ifIndex - Interface index, below dhcp4c_get_if_count()
+* @param[out] pValue  - Receives the DHCP server, network byte order
+*
+* @return 0 on success, -1 if ifIndex is out of range, pValue is NULL or the lease cannot be read
+*/
+int dhcp4c_get_if_dhcp_svr(unsigned int ifIndex, unsigned int* pValue);
+
+#endif /* __DHCP4CAPI_EXT_H__ */
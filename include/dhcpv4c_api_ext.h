@@ -0,0 +1,391 @@
+/*
+* If not stated otherwise in this file or this component's LICENSE file the
+* following copyright and licenses apply:*
+* Copyright 2023 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+/**
+* @file dhcpv4c_api_ext.h
+*
+* Optional extensions to the dhcpv4c_api HAL.
+*
+* These entry points are not part of the base HAL specification. The linux
+* skeleton implements them; a vendor library that does too can be tested by
+* building with HAL_EXT=1, which defines DHCPV4C_API_EXT.
+*/
+
+#ifndef __DHCPV4C_API_EXT_H__
+#define __DHCPV4C_API_EXT_H__
+
+#include "dhcpv4c_api.h"
+
+#define DHCPV4C_IFNAME_SIZE  64    /*!< Buffer size callers pass to the *_ifname getters */
+
+/**
+* @brief All fields of one DHCPv4 client lease, captured atomically
+*
+* Every field holds what the matching individual getter would have returned
+* at timestamp_ns, so remain_renew_time <= remain_rebind_time <= remain_lease_time.
+*/
+typedef struct
+{
+    UINT lease_time;                      /*!< As dhcpv4c_get_*_lease_time */
+    UINT remain_lease_time;               /*!< As dhcpv4c_get_*_remain_lease_time */
+    UINT remain_renew_time;               /*!< As dhcpv4c_get_*_remain_renew_time */
+    UINT remain_rebind_time;              /*!< As dhcpv4c_get_*_remain_rebind_time */
+    INT  config_attempts;                 /*!< As dhcpv4c_get_*_config_attempts */
+    CHAR ifname[DHCPV4C_IFNAME_SIZE];     /*!< As dhcpv4c_get_*_ifname, NUL terminated */
+    INT  fsm_state;                       /*!< As dhcpv4c_get_*_fsm_state */
+    UINT ip_addr;                         /*!< As dhcpv4c_get_*_ip_addr */
+    UINT mask;                            /*!< As dhcpv4c_get_*_mask */
+    UINT gw;                              /*!< As dhcpv4c_get_*_gw */
+    dhcpv4c_ip_list_t dns_svrs;           /*!< As dhcpv4c_get_*_dns_svrs */
+    UINT dhcp_svr;                        /*!< As dhcpv4c_get_*_dhcp_svr */
+    unsigned long long timestamp_ns;      /*!< CLOCK_MONOTONIC at capture */
+} dhcpv4c_lease_snapshot_t;
+
+/**
+* @brief eMTA lease timers, captured atomically
+*
+* The base HAL only exposes remaining times for the eMTA.
+*/
+typedef struct
+{
+    UINT remain_lease_time;               /*!< As dhcpv4c_get_emta_remain_lease_time */
+    UINT remain_renew_time;               /*!< As dhcpv4c_get_emta_remain_renew_time */
+    UINT remain_rebind_time;              /*!< As dhcpv4c_get_emta_remain_rebind_time */
+    unsigned long long timestamp_ns;      /*!< CLOCK_MONOTONIC at capture */
+} dhcpv4c_emta_snapshot_t;
+
+/**
+* @brief Reads the whole eRouter lease in one call
+*
+* Equivalent to calling dhcpv4c_get_ert_lease_time through dhcpv4c_get_ert_dhcp_svr
+* with no lease change in between.
+*
+* @param[out] pSnapshot - Receives the lease
+*
+* @return The status of the operation
+* @retval STATUS_SUCCESS if successful
+* @retval STATUS_FAILURE if pSnapshot is NULL or the lease cannot be read
+*/
+INT dhcpv4c_get_ert_snapshot(dhcpv4c_lease_snapshot_t* pSnapshot);
+
+/**
+* @brief Reads the whole eCM lease in one call
+*
+* Equivalent to calling dhcpv4c_get_ecm_lease_time through dhcpv4c_get_ecm_dhcp_svr
+* with no lease change in between.
+*
+* @param[out] pSnapshot - Receives the lease
+*
+* @return The status of the operation
+* @retval STATUS_SUCCESS if successful
+* @retval STATUS_FAILURE if pSnapshot is NULL or the lease cannot be read
+*/
+INT dhcpv4c_get_ecm_snapshot(dhcpv4c_lease_snapshot_t* pSnapshot);
+
+/**
+* @brief Reads the eMTA lease timers in one call
+*
+* @param[out] pSnapshot - Receives the timers
+*
+* @return The status of the operation
+* @retval STATUS_SUCCESS if successful
+* @retval STATUS_FAILURE if pSnapshot is NULL or the lease cannot be read
+*/
+INT dhcpv4c_get_emta_snapshot(dhcpv4c_emta_snapshot_t* pSnapshot);
+
+/**
+* @name Interface indices
+* The first interfaces of dhcpv4c_get_if_*(); further DHCP clients, such as
+* Ethernet WAN or LTE backup eRouters, follow up to dhcpv4c_get_if_count()
+* @{
+*/
+#define DHCPV4C_IF_ERT   0U   /*!< eRouter, as dhcpv4c_get_ert_* */
+#define DHCPV4C_IF_ECM   1U   /*!< eCM, as dhcpv4c_get_ecm_* */
+#define DHCPV4C_IF_EMTA  2U   /*!< eMTA, as dhcpv4c_get_emta_* */
+/** @} */
+
+/**
+* @brief Returns the number of DHCP client interfaces
+*
+* Valid indices for dhcpv4c_get_if_*() are 0 to *pCount - 1. The number
+* only grows while the HAL runs.
+*
+* @param[out] pCount - Receives the number, at least 3
+*
+* @return The status of the operation
+* @retval STATUS_SUCCESS if successful
+* @retval STATUS_FAILURE if pCount is NULL
+*/
+INT dhcpv4c_get_if_count(UINT* pCount);
+
+/**
+* @brief Looks up the index of a DHCP client interface by name
+*
+* @param[in]  pIfname - Interface name, as dhcpv4c_get_if_ifname returns it
+* @param[out] pIndex  - Receives the index
+*
+* @return The status of the operation
+* @retval STATUS_SUCCESS if successful
+* @retval STATUS_FAILURE if either pointer is NULL or no interface has that name
+*/
+INT dhcpv4c_get_if_index(const CHAR* pIfname, UINT* pIndex);
+
+/**
+* @brief As dhcpv4c_get_ert_lease_time, for any interface
+*
+* @param[in]  ifIndex - Interface index, below dhcpv4c_get_if_count()
+* @param[out] pValue  - Receives the lease time in seconds
+*
+* @return The status of the operation
+* @retval STATUS_SUCCESS if successful
+* @retval STATUS_FAILURE if ifIndex is out of range, pValue is NULL or the lease cannot be read
+*/
+INT dhcpv4c_get_if_lease_time(UINT ifIndex, UINT* pValue);
+
+/**
+* @brief As dhcpv4c_get_ert_remain_lease_time, for any interface
+*
+* @param[in]  ifIndex - Interface index, below dhcpv4c_get_if_count()
+* @param[out] pValue  - Receives the seconds until the lease expires
+*
+* @return The status of the operation
+* @retval STATUS_SUCCESS if successful
+* @retval STATUS_FAILURE if ifIndex is out of range, pValue is NULL or the lease cannot be read
+*/
+INT dhcpv4c_get_if_remain_lease_time(UINT ifIndex, UINT* pValue);
+
+/**
+* @brief As dhcpv4c_get_ert_remain_renew_time, for any interface
+*
+* @param[in]  ifIndex - Interface index, below dhcpv4c_get_if_count()
+* @param[out] pValue  - Receives the seconds until T1
+*
+* @return The status of the operation
+* @retval STATUS_SUCCESS if successful
+* @retval STATUS_FAILURE if ifIndex is out of range, pValue is NULL or the lease cannot be read
+*/
+INT dhcpv4c_get_if_remain_renew_time(UINT ifIndex, UINT* pValue);
+
+/**
+* @brief As dhcpv4c_get_ert_remain_rebind_time, for any interface
+*
+* @param[in]  ifIndex - Interface index, below dhcpv4c_get_if_count()
+* @param[out] pValue  - Receives the seconds until T2
+*
+* @return The status of the operation
+* @retval STATUS_SUCCESS if successful
+* @retval STATUS_FAILURE if ifIndex is out of range, pValue is NULL or the lease cannot be read
+*/
+INT dhcpv4c_get_if_remain_rebind_time(UINT ifIndex, UINT* pValue);
+
+/**
+* @brief As dhcpv4c_get_ert_config_attempts, for any interface
+*
+* @param[in]  ifIndex - Interface index, below dhcpv4c_get_if_count()
+* @param[out] pValue  - Receives the DISCOVERs sent to obtain the lease
+*
+* @return The status of the operation
+* @retval STATUS_SUCCESS if successful
+* @retval STATUS_FAILURE if ifIndex is out of range, pValue is NULL or the lease cannot be read
+*/
+INT dhcpv4c_get_if_config_attempts(UINT ifIndex, INT* pValue);
+
+/**
+* @brief As dhcpv4c_get_ert_ifname, for any interface
+*
+* @param[in]  ifIndex - Interface index, below dhcpv4c_get_if_count()
+* @param[out] pName   - Receives the interface name, at least DHCPV4C_IFNAME_SIZE bytes
+*
+* @return The status of the operation
+* @retval STATUS_SUCCESS if successful
+* @retval STATUS_FAILURE if ifIndex is out of range, pName is NULL or the lease cannot be read
+*/
+INT dhcpv4c_get_if_ifname(UINT ifIndex, CHAR* pName);
+
+/**
+* @brief As dhcpv4c_get_ert_fsm_state, for any interface
+*
+* @param[in]  ifIndex - Interface index, below dhcpv4c_get_if_count()
+* @param[out] pValue  - Receives the client FSM state
+*
+* @return The status of the operation
+* @retval STATUS_SUCCESS if successful
+* @retval STATUS_FAILURE if ifIndex is out of range, pValue is NULL or the lease cannot be read
+*/
+INT dhcpv4c_get_if_fsm_state(UINT ifIndex, INT* pValue);
+
+/**
+* @brief As dhcpv4c_get_ert_ip_addr, for any interface
+*
+* @param[in]  ifIndex - Interface index, below dhcpv4c_get_if_count()
+* @param[out] pValue  - Receives the leased address, network byte order
+*
+* @return The status of the operation
+* @retval STATUS_SUCCESS if successful
+* @retval STATUS_FAILURE if ifIndex is out of range, pValue is NULL or the lease cannot be read
+*/
+INT dhcpv4c_get_if_ip_addr(UINT ifIndex, UINT* pValue);
+
+/**
+* @brief As dhcpv4c_get_ert_mask, for any interface
+*
+* @param[in]  ifIndex - Interface index, below dhcpv4c_get_if_count()
+* @param[out] pValue  - Receives the subnet mask, network byte order
+*
+* @return The status of the operation
+* @retval STATUS_SUCCESS if successful
+* @retval STATUS_FAILURE if ifIndex is out of range, pValue is NULL or the lease cannot be read
+*/
+INT dhcpv4c_get_if_mask(UINT ifIndex, UINT* pValue);
+
+/**
+* @brief As dhcpv4c_get_ert_gw, for any interface
+*
+* @param[in]  ifIndex - Interface index, below dhcpv4c_get_if_count()
+* @param[out] pValue  - Receives the first router, network byte order
+*
+* @return The status of the operation
+* @retval STATUS_SUCCESS if successful
+* @retval STATUS_FAILURE if ifIndex is out of range, pValue is NULL or the lease cannot be read
+*/
+INT dhcpv4c_get_if_gw(UINT ifIndex, UINT* pValue);
+
+/**
+* @brief As dhcpv4c_get_ert_dns_svrs, for any interface
+*
+* @param[in]  ifIndex - Interface index, below dhcpv4c_get_if_count()
+* @param[out] pList   - Receives the DNS servers
+*
+* @return The status of the operation
+* @retval STATUS_SUCCESS if successful
+* @retval STATUS_FAILURE if ifIndex is out of range, pList is NULL or the lease cannot be read
+*/
+INT dhcpv4c_get_if_dns_svrs(UINT ifIndex, dhcpv4c_ip_list_t* pList);
+
+/**
+* @brief As dhcpv4c_get_ert_dhcp_svr, for any interface
+*
+* @param[in]  ifIndex - Interface index, below dhcpv4c_get_if_count()
+* @param[out] pValue  - Receives the DHCP server, network byte order
+*
+* @return The status of the operation
+* @retval STATUS_SUCCESS if successful
+* @retval STATUS_FAILURE if ifIndex is out of range, pValue is NULL or the lease cannot be read
+*/
+INT dhcpv4c_get_if_dhcp_svr(UINT ifIndex, UINT* pValue);
+
+/**
+* @brief Reads the whole lease of any interface in one call
+*
+* As dhcpv4c_get_ert_snapshot; for DHCPV4C_IF_EMTA the lease is the one
+* behind the eMTA timers.
+*
+* @param[in]  ifIndex   - Interface index, below dhcpv4c_get_if_count()
+* @param[out] pSnapshot - Receives the lease
+*
+* @return The status of the operation
+* @retval STATUS_SUCCESS if successful
+* @retval STATUS_FAILURE if ifIndex is out of range, pSnapshot is NULL or the lease cannot be read
+*/
+INT dhcpv4c_get_if_snapshot(UINT ifIndex, dhcpv4c_lease_snapshot_t* pSnapshot);
+
+/**
+* @name Lease event interfaces
+* Bits of the interface mask given to dhcpv4c_lease_subscribe() and dhcpv4c_lease_subscribe_fd()
+* @{
+*/
+#define DHCPV4C_LEASE_EVENT_ERT   0x1U   /*!< eRouter lease */
+#define DHCPV4C_LEASE_EVENT_ECM   0x2U   /*!< eCM lease */
+#define DHCPV4C_LEASE_EVENT_EMTA  0x4U   /*!< eMTA lease */
+/** @} */
+
+/**
+* @brief A change of a client lease or of its FSM state
+*/
+typedef struct
+{
+    UINT iface;                           /*!< One of DHCPV4C_LEASE_EVENT_ERT, _ECM or _EMTA */
+    INT  fsm_state;                       /*!< As dhcpv4c_get_*_fsm_state after the change */
+    UINT ip_addr;                         /*!< As dhcpv4c_get_*_ip_addr after the change, 0 when unbound */
+    unsigned long long timestamp_ns;      /*!< CLOCK_MONOTONIC when the change was announced */
+} dhcpv4c_lease_event_t;
+
+/**
+* @brief Called once per lease event
+*
+* Runs on a thread of the HAL. The event is only valid during the call.
+* The callback may call the getters and dhcpv4c_lease_unsubscribe(), but
+* must return promptly: events are delivered one at a time.
+*
+* @param[in] pEvent    - The change
+* @param[in] pUserData - As given to dhcpv4c_lease_subscribe()
+*/
+typedef void (*dhcpv4c_lease_callback_t)(const dhcpv4c_lease_event_t* pEvent, void* pUserData);
+
+/**
+* @brief Subscribes a callback to lease and FSM state changes
+*
+* Replaces polling the getters: the callback runs when a lease is bound,
+* renewed with different contents or released on one of the interfaces in
+* ifaceMask.
+*
+* @param[in]  ifaceMask - DHCPV4C_LEASE_EVENT_* bits of the interfaces to watch
+* @param[in]  callback  - Called for every event
+* @param[in]  pUserData - Passed to callback
+* @param[out] pHandle   - Receives the subscription, for dhcpv4c_lease_unsubscribe()
+*
+* @return The status of the operation
+* @retval STATUS_SUCCESS if successful
+* @retval STATUS_FAILURE if ifaceMask has no known bit, callback or pHandle is NULL, or events cannot be received
+*/
+INT dhcpv4c_lease_subscribe(UINT ifaceMask, dhcpv4c_lease_callback_t callback, void* pUserData, INT* pHandle);
+
+/**
+* @brief Subscribes an eventfd to lease and FSM state changes
+*
+* For callers with their own poll() loop. The descriptor becomes readable
+* when an event has happened since it was last read; read() returns the
+* number of events as an 8-byte counter, then the getters or
+* dhcpv4c_get_*_snapshot() give the new lease. The descriptor belongs to
+* the subscription and is closed by dhcpv4c_lease_unsubscribe().
+*
+* @param[in]  ifaceMask - DHCPV4C_LEASE_EVENT_* bits of the interfaces to watch
+* @param[out] pHandle   - Receives the subscription, for dhcpv4c_lease_unsubscribe()
+* @param[out] pFd       - Receives the non-blocking descriptor
+*
+* @return The status of the operation
+* @retval STATUS_SUCCESS if successful
+* @retval STATUS_FAILURE if ifaceMask has no known bit, pHandle or pFd is NULL, or events cannot be received
+*/
+INT dhcpv4c_lease_subscribe_fd(UINT ifaceMask, INT* pHandle, INT* pFd);
+
+/**
+* @brief Ends a subscription
+*
+* No callback of the subscription runs after this returns, unless it is
+* called from that callback.
+*
+* @param[in] handle - From dhcpv4c_lease_subscribe() or dhcpv4c_lease_subscribe_fd()
+*
+* @return The status of the operation
+* @retval STATUS_SUCCESS if successful
+* @retval STATUS_FAILURE if handle is not a current subscription
+*/
+INT dhcpv4c_lease_unsubscribe(INT handle);
+
+#endif /* __DHCPV4C_API_EXT_H__ */
@@ -0,0 +1,341 @@
+/*
+* If not stated otherwise in this file or this component's LICENSE file the
+* following copyright and licenses apply:*
+* Copyright 2023 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+/**
+* @file dhcp_lease_engine.h
+*
+* In-process DHCPv4 lease simulator backing the skeleton HAL implementations.
+*
+* The engine keeps one lease per simulated interface: the eRouter, eCM and
+* eMTA of the base HAL at indices 0 to 2, then any further eRouter-style
+* clients (Ethernet WAN, LTE backup) added with dhcp_lease_engine_add_iface()
+* or named in DHCP_LEASE_ENGINE_IFACES. Leases are held in a table with one
+* array per field, so reading one field touches one array and
+* dhcp_lease_engine_scan() reads a field of every interface in one copy.
+*
+* Each lease records when it was bound on the monotonic clock, so the
+* remaining lease/renew/rebind times and the client FSM state are derived
+* with O(1) arithmetic on every call instead of being stored and ticked.
+*
+* The moments those values change, T1, T2 and expiry, are timers on a
+* hierarchical timing wheel (dhcp_timer_wheel.h). Every engine call first
+* fires the timers that are due: at T1 the simulated server renews the lease,
+* or, with renewals disabled, the client moves to RENEWING, then REBINDING
+* at T2 and INIT at expiry, each announced to lease subscribers (for the
+* three base interfaces, which are the ones subscribers can name).
+*
+* Addresses are held in network byte order, matching what the HAL getters
+* return to their callers.
+*/
+
+#ifndef __DHCP_LEASE_ENGINE_H__
+#define __DHCP_LEASE_ENGINE_H__
+
+#include <stdint.h>
+
+#define DHCP_LEASE_IFNAME_LEN     16          /*!< Matches IFNAMSIZ */
+#define DHCP_LEASE_MAX_DNS        4           /*!< DNS servers kept per lease */
+#define DHCP_LEASE_INFINITE       0xFFFFFFFFU /*!< RFC 2131 infinite lease time */
+#define DHCP_LEASE_MAX_IFACES     1024        /*!< Interfaces the engine can hold, base ones included */
+#define DHCP_LEASE_ENGINE_IFACES_ENV  "DHCP_LEASE_ENGINE_IFACES"  /*!< Comma-separated interfaces to add at start-up */
+
+/**
+* @brief Simulated DHCP client interfaces
+*
+* Interfaces are indices into the lease table. The base HAL's three are
+* named here; those added later follow DHCP_LEASE_IF_MAX.
+*/
+typedef enum
+{
+    DHCP_LEASE_IF_ERT = 0,   /*!< eRouter WAN interface */
+    DHCP_LEASE_IF_ECM,       /*!< Embedded cable modem */
+    DHCP_LEASE_IF_EMTA,      /*!< Embedded MTA */
+    DHCP_LEASE_IF_MAX        /*!< Base interfaces, and the index of the first added one */
+} dhcp_lease_if_t;
+
+/**
+* @brief DHCP client FSM states
+*
+* Numbering follows ISC dhclient's enum dhcp_state.
+*/
+typedef enum
+{
+    DHCP_LEASE_FSM_REBOOTING = 1,
+    DHCP_LEASE_FSM_INIT,
+    DHCP_LEASE_FSM_SELECTING,
+    DHCP_LEASE_FSM_REQUESTING,
+    DHCP_LEASE_FSM_BOUND,
+    DHCP_LEASE_FSM_RENEWING,
+    DHCP_LEASE_FSM_REBINDING
+} dhcp_lease_fsm_t;
+
+/**
+* @brief A lease as handed out by a DHCP server
+*/
+typedef struct
+{
+    char     ifname[DHCP_LEASE_IFNAME_LEN];   /*!< Client interface name */
+    uint32_t ip_addr;                         /*!< yiaddr */
+    uint32_t mask;                            /*!< Option 1 */
+    uint32_t gw;                              /*!< Option 3, first router */
+    uint32_t dhcp_svr;                        /*!< Option 54 */
+    uint32_t dns_svrs[DHCP_LEASE_MAX_DNS];    /*!< Option 6 */
+    int      dns_count;                       /*!< Valid entries in dns_svrs */
+    uint32_t lease_time;                      /*!< Option 51, seconds */
+    uint32_t renew_time;                      /*!< Option 58 (T1), seconds */
+    uint32_t rebind_time;                     /*!< Option 59 (T2), seconds */
+    int      config_attempts;                 /*!< DISCOVERs sent to obtain the lease */
+    int      bound;                           /*!< Non-zero once an ACK has been applied */
+    uint64_t bound_ns;                        /*!< Monotonic time of the ACK */
+} dhcp_lease_t;
+
+/**
+* @brief Lease timers evaluated at a point in time
+*/
+typedef struct
+{
+    uint32_t remain_lease;    /*!< Seconds until the lease expires */
+    uint32_t remain_renew;    /*!< Seconds until T1 */
+    uint32_t remain_rebind;   /*!< Seconds until T2 */
+    int      fsm_state;       /*!< One of dhcp_lease_fsm_t */
+} dhcp_lease_timers_t;
+
+/**
+* @brief Single-value lease fields, one per getter of the base HAL
+*/
+typedef enum
+{
+    DHCP_LEASE_FIELD_LEASE_TIME = 0,    /*!< dhcp_lease_t lease_time */
+    DHCP_LEASE_FIELD_REMAIN_LEASE,      /*!< dhcp_lease_timers_t remain_lease */
+    DHCP_LEASE_FIELD_REMAIN_RENEW,      /*!< dhcp_lease_timers_t remain_renew */
+    DHCP_LEASE_FIELD_REMAIN_REBIND,     /*!< dhcp_lease_timers_t remain_rebind */
+    DHCP_LEASE_FIELD_CONFIG_ATTEMPTS,   /*!< dhcp_lease_t config_attempts */
+    DHCP_LEASE_FIELD_FSM_STATE,         /*!< dhcp_lease_timers_t fsm_state */
+    DHCP_LEASE_FIELD_IP_ADDR,           /*!< dhcp_lease_t ip_addr */
+    DHCP_LEASE_FIELD_MASK,              /*!< dhcp_lease_t mask */
+    DHCP_LEASE_FIELD_GW,                /*!< dhcp_lease_t gw */
+    DHCP_LEASE_FIELD_DHCP_SVR,          /*!< dhcp_lease_t dhcp_svr */
+    DHCP_LEASE_FIELD_MAX
+} dhcp_lease_field_t;
+
+/**
+* @brief Returns the engine clock in nanoseconds
+*
+* CLOCK_MONOTONIC plus any offset applied with dhcp_lease_engine_advance().
+*/
+uint64_t dhcp_lease_engine_now_ns( void );
+
+/**
+* @brief Copies the current lease of an interface
+*
+* @param[in]  iface  - Interface to read
+* @param[out] pLease - Receives the lease
+*
+* @return 0 on success, -1 on an invalid argument
+*/
+int dhcp_lease_engine_get( dhcp_lease_if_t iface, dhcp_lease_t *pLease );
+
+/**
+* @brief Evaluates the lease timers and FSM state of an interface now
+*
+* @param[in]  iface   - Interface to read
+* @param[out] pTimers - Receives the timers
+*
+* @return 0 on success, -1 on an invalid argument
+*/
+int dhcp_lease_engine_timers( dhcp_lease_if_t iface, dhcp_lease_timers_t *pTimers );
+
+/**
+* @brief Copies a lease and evaluates its timers under a single lock
+*
+* @param[in]  iface   - Interface to read
+* @param[out] pLease  - Receives the lease
+* @param[out] pTimers - Receives the timers, consistent with pLease
+* @param[out] pNowNs  - Receives the engine time used for pTimers, may be NULL
+*
+* @return 0 on success, -1 on an invalid argument
+*/
+int dhcp_lease_engine_snapshot( dhcp_lease_if_t iface, dhcp_lease_t *pLease, dhcp_lease_timers_t *pTimers, uint64_t *pNowNs );
+
+/**
+* @brief Reads one field of an interface's lease now
+*
+* Cheaper than dhcp_lease_engine_snapshot() for a single value: only the
+* arrays holding the field, or the lease times for a timer, are read.
+*
+* @param[in]  iface  - Interface to read
+* @param[in]  field  - Field to read
+* @param[out] pValue - Receives the value; signed fields are converted
+*
+* @return 0 on success, -1 on an invalid argument
+*/
+int dhcp_lease_engine_field( dhcp_lease_if_t iface, dhcp_lease_field_t field, uint32_t *pValue );
+
+/**
+* @brief Reads one field of consecutive interfaces under a single lock
+*
+* Stored fields are copied straight from their array; timer fields are
+* evaluated at one engine time for every interface.
+*
+* @param[in]  field   - Field to read
+* @param[in]  first   - First interface
+* @param[in]  count   - Interfaces to read, fewer if the table ends first
+* @param[out] pValues - Receives one value per interface read
+*
+* @return The number of interfaces read, or -1 on an invalid argument
+*/
+int dhcp_lease_engine_scan( dhcp_lease_field_t field, uint32_t first, uint32_t count, uint32_t *pValues );
+
+/**
+* @brief Returns the number of interfaces in the lease table
+*
+* @return DHCP_LEASE_IF_MAX plus the interfaces added since the last reset
+*/
+uint32_t dhcp_lease_engine_iface_count( void );
+
+/**
+* @brief Adds an eRouter-style client interface
+*
+* The interface gets the next index and is bound to a default one-hour
+* lease from 198.18.0.0/15 (RFC 2544), as the base ones are at start-up.
+* Its timers run as the base ones do, but its changes are not announced.
+*
+* @param[in]  pIfname - Interface name, unique and shorter than DHCP_LEASE_IFNAME_LEN
+* @param[out] pIface  - Receives the index, may be NULL
+*
+* @return 0 on success, -1 on an invalid or duplicate name or a full table
+*/
+int dhcp_lease_engine_add_iface( const char *pIfname, dhcp_lease_if_t *pIface );
+
+/**
+* @brief Looks up an interface by name
+*
+* @param[in]  pIfname - Interface name
+* @param[out] pIface  - Receives the index
+*
+* @return 0 on success, -1 if no interface has that name or on an invalid argument
+*/
+int dhcp_lease_engine_find_iface( const char *pIfname, dhcp_lease_if_t *pIface );
+
+/**
+* @brief Picks one field out of a lease and its timers
+*
+* Pure function, for leases read from elsewhere than the engine.
+*
+* @param[in] pLease  - Lease
+* @param[in] pTimers - Its timers
+* @param[in] field   - Field to pick
+*
+* @return The value, signed fields converted; 0 for an unknown field
+*/
+uint32_t dhcp_lease_field_value( const dhcp_lease_t *pLease, const dhcp_lease_timers_t *pTimers, dhcp_lease_field_t field );
+
+/**
+* @brief Evaluates the timers of a lease at a given engine time
+*
+* Pure function; does not touch engine state.
+*
+* @param[in]  pLease     - Lease to evaluate
+* @param[in]  now_ns     - Engine time, see dhcp_lease_engine_now_ns()
+* @param[in]  auto_renew - Non-zero to assume the server renews the lease at every T1
+* @param[out] pTimers    - Receives the timers
+*/
+void dhcp_lease_eval( const dhcp_lease_t *pLease, uint64_t now_ns, int auto_renew, dhcp_lease_timers_t *pTimers );
+
+/**
+* @brief Fills in T1/T2 left 0 or beyond the lease time
+*
+* Zero T1/T2 default to 0.5 and 0.875 of the lease time as per RFC 2131 4.4.5,
+* and T2 is raised to T1 if below it. Infinite leases are left alone.
+*
+* @param[in,out] pLease - Lease to complete
+*/
+void dhcp_lease_apply_defaults( dhcp_lease_t *pLease );
+
+/**
+* @brief Applies a DHCPACK to an interface
+*
+* The lease is stamped as bound at the current engine time, with T1/T2
+* completed by dhcp_lease_apply_defaults(), and the change is announced to
+* lease subscribers (dhcp_lease_notify.h).
+*
+* @param[in] iface  - Interface to bind
+* @param[in] pLease - Lease contents; bound and bound_ns are ignored
+*
+* @return 0 on success, -1 on an invalid argument
+*/
+int dhcp_lease_engine_bind( dhcp_lease_if_t iface, const dhcp_lease_t *pLease );
+
+/**
+* @brief Drops the lease of an interface, returning its client to INIT
+*
+* The change is announced to lease subscribers.
+*
+* @param[in] iface - Interface to release
+*
+* @return 0 on success, -1 on an invalid argument
+*/
+int dhcp_lease_engine_release( dhcp_lease_if_t iface );
+
+/**
+* @brief Restores the built-in default leases on every interface
+*
+* Interfaces added with dhcp_lease_engine_add_iface() are dropped; those
+* named in DHCP_LEASE_ENGINE_IFACES are added again.
+*/
+void dhcp_lease_engine_reset( void );
+
+/**
+* @brief Enables or disables simulated renewals
+*
+* When enabled (the default) every lease is renewed by the server at T1,
+* so the client stays BOUND indefinitely. When disabled the client moves
+* through RENEWING and REBINDING and falls back to INIT at expiry.
+* The DHCP_LEASE_ENGINE_AUTO_RENEW environment variable sets the initial value.
+*
+* @param[in] enable - Non-zero to enable
+*/
+void dhcp_lease_engine_set_auto_renew( int enable );
+
+/**
+* @brief Moves the engine clock forward
+*
+* Lets tests walk a lease through T1, T2 and expiry without sleeping. The
+* lease timers that fall due fire at once, to within the wheel's 1 ms tick.
+*
+* @param[in] seconds - Amount to advance
+*/
+void dhcp_lease_engine_advance( uint32_t seconds );
+
+/**
+* @brief Fires the lease timers due now, announcing the changes they make
+*
+* Every other engine call does this first; the notification thread calls it
+* when the next timer is due, so that subscribers hear of T1, T2 and expiry
+* without anyone reading a lease.
+*/
+void dhcp_lease_engine_run_timers( void );
+
+/**
+* @brief Returns when dhcp_lease_engine_run_timers() next has work to do
+*
+* @return Engine time in nanoseconds, possibly early, or UINT64_MAX if no lease timer is armed
+*/
+uint64_t dhcp_lease_engine_next_timer_ns( void );
+
+#endif /* __DHCP_LEASE_ENGINE_H__ */
@@ -0,0 +1,94 @@
+/*
+* If not stated otherwise in this file or this component's LICENSE file the
+* following copyright and licenses apply:*
+* Copyright 2023 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+/**
+* @file dhcp_lease_file.h
+*
+* DHCPv4 lease file reader for the skeleton HAL implementations.
+*
+* Reads the lease a DHCP client leaves on disk, in either of two layouts:
+* - udhcpc environment dumps, one KEY=value per line (interface, ip, subnet,
+*   router, dns, serverid, lease, and T1/T2 as the hex opt58/opt59),
+*   optionally prefixed with "export" and with quoted values
+* - ISC dhclient lease files (fixed-address, option subnet-mask, option
+*   routers, ...); when the file holds several lease blocks the last wins
+*
+* The file is mapped and parsed once. Later reads only stat() the path and
+* copy the cached lease, parsing again when the device, inode, size, mtime
+* or ctime changes, which covers both in-place rewrites and rename-into-place.
+*
+* Neither layout records when the lease was obtained, so the lease is taken
+* to start at the file's mtime: clients rewrite the file on every ACK.
+*/
+
+#ifndef __DHCP_LEASE_FILE_H__
+#define __DHCP_LEASE_FILE_H__
+
+#include <stddef.h>
+#include <stdint.h>
+#include "dhcp_lease_engine.h"
+
+#define DHCP_LEASE_FILE_ENV  "DHCP4C_ERT_LEASE_FILE"   /*!< Path of the eRouter lease file, unset to use the lease engine */
+
+/**
+* @brief Applies one line of a lease file to a lease
+*
+* Unknown keys and malformed values are ignored.
+*
+* @param[in]     pLine  - Line contents, need not be terminated
+* @param[in]     length - Bytes in pLine, excluding any newline
+* @param[in,out] pLease - Lease being built
+*/
+void dhcp_lease_file_parse_line( const char *pLine, size_t length, dhcp_lease_t *pLease );
+
+/**
+* @brief Parses a whole lease file held in memory
+*
+* @param[in]  pText  - File contents, need not be terminated
+* @param[in]  length - Bytes in pText
+* @param[out] pLease - Receives the lease; bound_ns is left 0
+*
+* @return 0 if the text held an address, otherwise -1
+*/
+int dhcp_lease_file_parse( const char *pText, size_t length, dhcp_lease_t *pLease );
+
+/**
+* @brief Reads a lease file, parsing it only if it changed since the last read
+*
+* The lease is reported as bound at the file's mtime, and the timers are
+* evaluated against it without simulated renewals.
+*
+* @param[in]  pPath   - Lease file
+* @param[out] pLease  - Receives the lease
+* @param[out] pTimers - Receives the lease timers now, may be NULL
+*
+* @return 0 on success, -1 if the file cannot be read or holds no lease
+*/
+int dhcp_lease_file_read( const char *pPath, dhcp_lease_t *pLease, dhcp_lease_timers_t *pTimers );
+
+/**
+* @brief Drops the cached lease so the next read parses the file again
+*/
+void dhcp_lease_file_invalidate( void );
+
+/**
+* @brief Returns how many times a lease file has been parsed by dhcp_lease_file_read()
+*/
+uint32_t dhcp_lease_file_parse_count( void );
+
+#endif /* __DHCP_LEASE_FILE_H__ */
@@ -0,0 +1,146 @@
+/*
+* If not stated otherwise in this file or this component's LICENSE file the
+* following copyright and licenses apply:*
+* Copyright 2023 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+/**
+* @file dhcp_lease_notify.h
+*
+* Lease change notifications for the skeleton HAL implementations.
+*
+* A change is announced as the sysevent tuple DHCP_LEASE_NOTIFY_KEY_<IF>
+* with the value "<fsm state> <dotted address> <CLOCK_MONOTONIC ns>", which
+* is what a platform's DHCP client script would set. With DHCP_SYSEVENT_SOCKET
+* naming a running sysevent stand-in (dhcp_sysevent.h), announcements go
+* through it, so that leases bound by another process, such as the stand-in
+* DHCP client of the L2 tests, reach subscribers too. Without it they only
+* reach subscribers in the announcing process.
+*
+* Subscribers are served by one thread per process, which runs while there
+* is at least one subscription. The lease engine announces every bind and
+* release, and, with renewals disabled, the moves to RENEWING, REBINDING and
+* INIT at T1, T2 and expiry. The thread wakes for the engine's next lease
+* timer, so these are announced on time even when nobody reads a lease.
+*/
+
+#ifndef __DHCP_LEASE_NOTIFY_H__
+#define __DHCP_LEASE_NOTIFY_H__
+
+#include <stddef.h>
+#include <stdint.h>
+#include "dhcp_lease_engine.h"
+
+#define DHCP_LEASE_NOTIFY_MAX       16                    /*!< Subscriptions per process */
+#define DHCP_LEASE_NOTIFY_KEY_ERT   "dhcp4c_ert_lease"    /*!< Sysevent key of eRouter changes */
+#define DHCP_LEASE_NOTIFY_KEY_ECM   "dhcp4c_ecm_lease"    /*!< Sysevent key of eCM changes */
+#define DHCP_LEASE_NOTIFY_KEY_EMTA  "dhcp4c_emta_lease"   /*!< Sysevent key of eMTA changes */
+
+/**
+* @brief A lease change as delivered to subscribers
+*/
+typedef struct
+{
+    dhcp_lease_if_t iface;
+    int             fsm_state;      /*!< One of dhcp_lease_fsm_t */
+    uint32_t        ip_addr;        /*!< Network byte order, 0 when unbound */
+    uint64_t        timestamp_ns;   /*!< CLOCK_MONOTONIC of the announcement */
+} dhcp_lease_event_t;
+
+/**
+* @brief Called on the notification thread for every event of a subscription
+*/
+typedef void (*dhcp_lease_notify_cb_t)( const dhcp_lease_event_t *pEvent, void *pUserData );
+
+/**
+* @brief Subscribes a callback to the changes of some interfaces
+*
+* @param[in]  ifaceMask - Bit (1 << iface) per dhcp_lease_if_t to watch
+* @param[in]  callback  - Called for every event
+* @param[in]  pUserData - Passed to callback
+* @param[out] pHandle   - Receives the subscription
+*
+* @return 0 on success, -1 on an invalid argument, when all subscriptions are
+*         taken, or when DHCP_SYSEVENT_SOCKET is set but the daemon cannot be reached
+*/
+int dhcp_lease_notify_subscribe( uint32_t ifaceMask, dhcp_lease_notify_cb_t callback, void *pUserData, int *pHandle );
+
+/**
+* @brief Subscribes a new eventfd to the changes of some interfaces
+*
+* Every event adds one to the eventfd counter.
+*
+* @param[in]  ifaceMask - Bit (1 << iface) per dhcp_lease_if_t to watch
+* @param[out] pHandle   - Receives the subscription
+* @param[out] pFd       - Receives the non-blocking eventfd, owned by the subscription
+*
+* @return 0 on success, -1 as dhcp_lease_notify_subscribe()
+*/
+int dhcp_lease_notify_subscribe_fd( uint32_t ifaceMask, int *pHandle, int *pFd );
+
+/**
+* @brief Ends a subscription, closing its eventfd
+*
+* Once this returns the callback is not running and will not run again,
+* unless this was called from the callback itself.
+*
+* The handle may be given to a new subscription as soon as this returns, so
+* what the subscription's pUserData points to is handed back here, rather
+* than being looked up again by handle.
+*
+* @param[in]  handle     - From dhcp_lease_notify_subscribe() or dhcp_lease_notify_subscribe_fd()
+* @param[out] ppUserData - Receives the subscription's pUserData, may be NULL
+*
+* @return 0 on success, -1 if handle is not a current subscription
+*/
+int dhcp_lease_notify_unsubscribe( int handle, void **ppUserData );
+
+/**
+* @brief Announces the current state of an interface's lease
+*
+* @param[in] iface     - Interface that changed
+* @param[in] fsm_state - Its client FSM state now
+* @param[in] ip_addr   - Its address now, 0 when unbound
+*/
+void dhcp_lease_notify_publish( dhcp_lease_if_t iface, int fsm_state, uint32_t ip_addr );
+
+/**
+* @brief Makes the notification thread recompute when the engine's next lease timer is due
+*
+* For when the engine clock jumps; does nothing while nobody is subscribed.
+*/
+void dhcp_lease_notify_wake( void );
+
+/**
+* @brief Formats the sysevent value of a change
+*
+* @param[in]  pEvent - Change
+* @param[out] pValue - Receives the value
+* @param[in]  size   - Bytes at pValue
+*/
+void dhcp_lease_notify_format( const dhcp_lease_event_t *pEvent, char *pValue, size_t size );
+
+/**
+* @brief Parses a sysevent tuple of a change
+*
+* @param[in]  pKey   - One of the DHCP_LEASE_NOTIFY_KEY_* keys
+* @param[in]  pValue - Value as dhcp_lease_notify_format() writes it
+* @param[out] pEvent - Receives the change
+*
+* @return 0 on success, -1 if the tuple is not a lease change
+*/
+int dhcp_lease_notify_parse( const char *pKey, const char *pValue, dhcp_lease_event_t *pEvent );
+
+#endif /* __DHCP_LEASE_NOTIFY_H__ */
@@ -0,0 +1,188 @@
+/*
+* If not stated otherwise in this file or this component's LICENSE file the
+* following copyright and licenses apply:*
+* Copyright 2023 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+/**
+* @file dhcp_lease_replay.h
+*
+* Getter responses recorded on a device, and their replay by the skeleton
+* HAL implementations.
+*
+* dhcp4_hal_test --capture (src/test_capture.h) polls every getter of the
+* eRouter, eCM and eMTA on a device and writes what each returned into a
+* trace file. With DHCP_LEASE_REPLAY naming such a file, the getters of both
+* skeletons return, for those three interfaces, the return code and output
+* the device's getter gave at the same point of the trace, ahead of
+* DHCP_LEASE_SHM, DHCP4C_ERT_LEASE_FILE and the lease engine. The trace
+* starts when a process first reads it and runs on the engine clock, times
+* DHCP_LEASE_REPLAY_SPEED; past its end the last responses hold, or it
+* starts over with DHCP_LEASE_REPLAY_LOOP=1. DHCP_LEASE_REPLAY_LATENCY=1
+* also makes each call take as long as the recorded one did.
+*
+* A trace is keyed by interface and lease field rather than by function, so
+* one captured from either HAL family replays through both.
+*
+* File layout, in the byte order of the device that wrote it:
+* - dhcp_lease_replay_header_t
+* - channelCount dhcp_lease_replay_channel_t, the getters captured
+* - records to the end of the file, one per getter call:
+*   - uint8   channel index, or'ed with DHCP_LEASE_REPLAY_SAME when the
+*             status and output equal the channel's previous record
+*   - varint  microseconds from the previous record's call to this one
+*   - varint  duration of the call in nanoseconds
+*   - unless SAME: varint zigzag status, varint output length, output bytes
+*
+* Varints are unsigned LEB128. Outputs are kept as the getter wrote them:
+* values in the device's byte order, addresses in network order, names up
+* to their NUL, address lists as the count and the addresses counted; the
+* outputs of failed calls are not kept. A reader on a device of the other
+* byte order converts the values.
+*/
+
+#ifndef __DHCP_LEASE_REPLAY_H__
+#define __DHCP_LEASE_REPLAY_H__
+
+#include <stdint.h>
+#include "dhcp_lease_engine.h"
+
+#define DHCP_LEASE_REPLAY_ENV          "DHCP_LEASE_REPLAY"          /*!< Trace to serve; unset to read leases elsewhere */
+#define DHCP_LEASE_REPLAY_SPEED_ENV    "DHCP_LEASE_REPLAY_SPEED"    /*!< Trace seconds per engine second, default 1 */
+#define DHCP_LEASE_REPLAY_LOOP_ENV     "DHCP_LEASE_REPLAY_LOOP"     /*!< 1 to start over at the end of the trace */
+#define DHCP_LEASE_REPLAY_LATENCY_ENV  "DHCP_LEASE_REPLAY_LATENCY"  /*!< 1 to take as long as the recorded calls */
+#define DHCP_LEASE_REPLAY_MAGIC        0x54524844U                  /*!< "DHRT" */
+#define DHCP_LEASE_REPLAY_VERSION      1
+#define DHCP_LEASE_REPLAY_SAME         0x80    /*!< Channel byte flag: status and output unchanged */
+#define DHCP_LEASE_REPLAY_CHANNELS_MAX 0x80
+#define DHCP_LEASE_REPLAY_OUTPUT_MAX   256     /*!< Longest output kept */
+#define DHCP_LEASE_REPLAY_IFNAME_SIZE  64      /*!< Buffer the ifname getters fill, as in the getter tables */
+#define DHCP_LEASE_REPLAY_RECORD_MAX   (1 + 10 + 10 + 5 + 5 + DHCP_LEASE_REPLAY_OUTPUT_MAX)
+
+/**
+* @brief What a channel records: the single-value fields, then the two others
+*/
+typedef enum
+{
+    DHCP_LEASE_REPLAY_IFNAME = DHCP_LEASE_FIELD_MAX,    /*!< NUL-terminated interface name */
+    DHCP_LEASE_REPLAY_DNS_SVRS,                         /*!< { int number; uint32_t addresses[]; } */
+    DHCP_LEASE_REPLAY_ITEMS
+} dhcp_lease_replay_item_t;
+
+/**
+* @brief Start of a trace file
+*/
+typedef struct
+{
+    uint32_t magic;             /*!< DHCP_LEASE_REPLAY_MAGIC, byte-swapped if written on the other byte order */
+    uint16_t version;           /*!< DHCP_LEASE_REPLAY_VERSION */
+    uint16_t channelCount;      /*!< At most DHCP_LEASE_REPLAY_CHANNELS_MAX */
+    uint32_t intervalUs;        /*!< Time between the captures of one getter */
+    uint32_t reserved;
+    uint64_t startRealtimeNs;   /*!< CLOCK_REALTIME when the capture started */
+    char     family[24];        /*!< HAL family captured, such as "dhcpv4c_api" */
+} dhcp_lease_replay_header_t;
+
+/**
+* @brief One getter of a trace
+*/
+typedef struct
+{
+    uint8_t iface;              /*!< dhcp_lease_if_t, a base interface */
+    uint8_t item;               /*!< dhcp_lease_field_t or dhcp_lease_replay_item_t */
+} dhcp_lease_replay_channel_t;
+
+/**
+* @brief Appends a varint
+*
+* @return Bytes written, at most 10
+*/
+static inline uint32_t dhcp_lease_replay_put_varint( uint8_t *pOut, uint64_t value )
+{
+    uint32_t length = 0;
+
+    while (value >= 0x80)
+    {
+        pOut[length++] = (uint8_t)(value | 0x80);
+        value >>= 7;
+    }
+    pOut[length++] = (uint8_t)value;
+    return length;
+}
+
+/**
+* @brief Reads a varint and moves past it
+*
+* @return 0 on success, -1 if it runs past pEnd or over 64 bits
+*/
+static inline int dhcp_lease_replay_get_varint( const uint8_t **ppIn, const uint8_t *pEnd, uint64_t *pValue )
+{
+    const uint8_t *pIn = *ppIn;
+    uint64_t value = 0;
+    uint32_t shift;
+
+    for (shift = 0; pIn < pEnd && shift < 64; shift += 7)
+    {
+        value |= (uint64_t)(*pIn & 0x7F) << shift;
+        if ((*pIn++ & 0x80) == 0)
+        {
+            *ppIn = pIn;
+            *pValue = value;
+            return 0;
+        }
+    }
+    return -1;
+}
+
+/**
+* @brief Tells whether DHCP_LEASE_REPLAY names a trace
+*/
+int dhcp_lease_replay_enabled( void );
+
+/**
+* @brief Serves one getter of a base interface from the trace
+*
+* Copies the output of the call recorded at the current point of the trace,
+* or of its first call if the trace has not reached the getter yet.
+*
+* @param[in]  iface - Base interface
+* @param[in]  item  - dhcp_lease_field_t or dhcp_lease_replay_item_t
+* @param[out] pOut  - Receives the recorded output
+* @param[in]  size  - Bytes pOut holds; a longer output is cut
+*
+* @return The recorded status, or -1 if the trace cannot be read or did not capture the getter
+*/
+int dhcp_lease_replay_read( dhcp_lease_if_t iface, uint32_t item, void *pOut, uint32_t size );
+
+/**
+* @brief Builds a lease of a base interface from the trace, for the snapshot getters
+*
+* Fields the trace did not capture are left 0.
+*
+* @param[in]  iface   - Base interface
+* @param[out] pLease  - Receives the lease
+* @param[out] pTimers - Receives the timers
+* @param[out] pNowNs  - Receives the engine time of the point of the trace, may be NULL
+*
+* @return 0 if every getter of the interface recorded success there, otherwise -1
+*/
+int dhcp_lease_replay_get( dhcp_lease_if_t iface, dhcp_lease_t *pLease, dhcp_lease_timers_t *pTimers, uint64_t *pNowNs );
+
+/**
+* @brief Reads the trace again on the next call, starting it over
+*/
+void dhcp_lease_replay_reset( void );
+
+#endif /* __DHCP_LEASE_REPLAY_H__ */
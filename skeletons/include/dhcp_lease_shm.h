@@ -0,0 +1,160 @@
+/*
+* If not stated otherwise in this file or this component's LICENSE file the
+* following copyright and licenses apply:*
+* Copyright 2023 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+/**
+* @file dhcp_lease_shm.h
+*
+* Shared-memory lease page for the skeleton HAL implementations.
+*
+* The DHCP client process publishes the eRouter, eCM and eMTA leases into a
+* POSIX shared memory object, and the HAL maps it read-only, so that a
+* getter call is a copy out of the page instead of IPC to the client. Each
+* interface has a slot guarded by a sequence lock: the writer makes the
+* sequence odd, updates the lease and makes it even again, and a reader
+* copies the lease and retries until it saw the same even sequence before
+* and after the copy. Readers never write to the page, so any number of
+* processes can read while the client writes.
+*
+* With DHCP_LEASE_SHM naming the object, the getters of both skeletons serve
+* every interface from the page, ahead of DHCP4C_ERT_LEASE_FILE and the lease
+* engine, which serve an interface whose slot the writer left mid-update. The page is mapped on the first read and stays mapped for the life
+* of the process; after that a read makes no system call (clock_gettime() is
+* served by the vDSO). A client that restarts must reopen the object rather
+* than unlink and recreate it, or readers keep the old page.
+*
+* One writer per page. The timers are evaluated as for a lease file, without
+* simulated renewals: the client publishes every renewal.
+*/
+
+#ifndef __DHCP_LEASE_SHM_H__
+#define __DHCP_LEASE_SHM_H__
+
+#include <stdint.h>
+#include "dhcp_lease_engine.h"
+
+#define DHCP_LEASE_SHM_ENV         "DHCP_LEASE_SHM"   /*!< Name of the page, such as "/dhcp4c_leases"; unset to read leases elsewhere */
+#define DHCP_LEASE_SHM_MAGIC       0x4448534cU        /*!< "DHSL" */
+#define DHCP_LEASE_SHM_VERSION     1                  /*!< Bumped on any layout change */
+#define DHCP_LEASE_SHM_SPIN_LIMIT  1000               /*!< Retries of dhcp_lease_shm_read() before it starts yielding */
+#define DHCP_LEASE_SHM_STALL_MS    250                /*!< Yielding for this long, dhcp_lease_shm_read() gives up */
+#define DHCP_LEASE_SHM_STALLED     (-2)               /*!< dhcp_lease_shm_read() gave up on a slot held odd */
+
+/**
+* @brief One interface's lease and the sequence guarding it
+*
+* An odd sequence means the writer is inside an update; 0 means the lease
+* was never published. Aligned to a cache line so that updating one
+* interface does not slow readers of another.
+*/
+typedef struct
+{
+    uint32_t sequence;
+    uint32_t reserved;
+    union
+    {
+        dhcp_lease_t lease;
+        uint32_t     words[sizeof(dhcp_lease_t) / sizeof(uint32_t)];   /*!< dhcp_lease_t holds a uint64_t, so its size is a multiple of 8 */
+    } data;
+} __attribute__((aligned(64))) dhcp_lease_shm_slot_t;
+
+/**
+* @brief Layout of the shared object
+*/
+typedef struct
+{
+    uint32_t magic;                                 /*!< DHCP_LEASE_SHM_MAGIC */
+    uint32_t version;                               /*!< DHCP_LEASE_SHM_VERSION */
+    uint32_t size;                                  /*!< sizeof(dhcp_lease_shm_page_t) of the writer */
+    dhcp_lease_shm_slot_t slots[DHCP_LEASE_IF_MAX]; /*!< Indexed by dhcp_lease_if_t */
+} dhcp_lease_shm_page_t;
+
+/**
+* @brief Creates or reopens a page for writing
+*
+* A new page has no lease published. Reopening keeps what was published.
+*
+* @param[in] pName - Shared memory object name, starting with '/'
+*
+* @return The writable page, or NULL if it cannot be created or holds another layout
+*/
+dhcp_lease_shm_page_t *dhcp_lease_shm_create( const char *pName );
+
+/**
+* @brief Publishes the lease of an interface
+*
+* Readers see either the previous lease or this one, never a mix. The lease
+* is stored as given: set bound and bound_ns (CLOCK_MONOTONIC of the ACK)
+* for a bound lease, or clear bound once it is released.
+*
+* @param[in,out] pPage  - Page from dhcp_lease_shm_create()
+* @param[in]     iface  - Interface whose lease changed
+* @param[in]     pLease - The lease now
+*
+* @return 0 on success, -1 on an invalid argument
+*/
+int dhcp_lease_shm_publish( dhcp_lease_shm_page_t *pPage, dhcp_lease_if_t iface, const dhcp_lease_t *pLease );
+
+/**
+* @brief Maps a page read-only
+*
+* @param[in] pName - Shared memory object name
+*
+* @return The page, or NULL if it does not exist or holds another layout
+*/
+const dhcp_lease_shm_page_t *dhcp_lease_shm_open( const char *pName );
+
+/**
+* @brief Unmaps a page from dhcp_lease_shm_create() or dhcp_lease_shm_open()
+*
+* @param[in] pPage - Page, may be NULL
+*/
+void dhcp_lease_shm_close( const dhcp_lease_shm_page_t *pPage );
+
+/**
+* @brief Copies the lease of an interface out of a page
+*
+* Spins while the writer is inside an update of that slot, yielding the CPU
+* only after DHCP_LEASE_SHM_SPIN_LIMIT attempts, in case the writer was
+* preempted mid-update. A writer that died mid-update leaves the sequence
+* odd for good, so after DHCP_LEASE_SHM_STALL_MS of yielding the read gives
+* up.
+*
+* @param[in]  pPage  - Page
+* @param[in]  iface  - Interface to read
+* @param[out] pLease - Receives the lease
+*
+* @return The number of times the copy was retried, -1 on an invalid
+*         argument or if the lease was never published, or
+*         DHCP_LEASE_SHM_STALLED if it gave up
+*/
+int dhcp_lease_shm_read( const dhcp_lease_shm_page_t *pPage, dhcp_lease_if_t iface, dhcp_lease_t *pLease );
+
+/**
+* @brief Reads a lease from the page named by DHCP_LEASE_SHM, for the HAL getters
+*
+* @param[in]  iface   - Interface to read
+* @param[out] pLease  - Receives the lease
+* @param[out] pTimers - Receives the lease timers now
+* @param[out] pNowNs  - Receives the engine time used for pTimers, may be NULL
+*
+* @return 0 on success, -1 if the page cannot be mapped or the lease was never published,
+*         or DHCP_LEASE_SHM_STALLED if the writer left the slot mid-update
+*/
+int dhcp_lease_shm_get( dhcp_lease_if_t iface, dhcp_lease_t *pLease, dhcp_lease_timers_t *pTimers, uint64_t *pNowNs );
+
+#endif /* __DHCP_LEASE_SHM_H__ */
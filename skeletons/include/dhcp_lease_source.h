@@ -0,0 +1,90 @@
+/*
+* If not stated otherwise in this file or this component's LICENSE file the
+* following copyright and licenses apply:*
+* Copyright 2023 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+/**
+* @file dhcp_lease_source.h
+*
+* Where the skeleton getters of both HAL families read a lease from.
+*
+* With DHCP_LEASE_REPLAY set, the getters of the base interfaces return what
+* that trace recorded, ahead of every other source. Otherwise, with
+* DHCP_LEASE_SHM set, the leases of the base interfaces are read from the
+* page the DHCP client publishes there, unless the client left a slot
+* mid-update. Otherwise the eRouter lease is read from the file named by
+* DHCP4C_ERT_LEASE_FILE when that is set, as platforms running udhcpc or
+* dhclient keep it. Everything else, including every interface added after
+* the base three, comes from the in-process lease engine.
+*/
+
+#ifndef __DHCP_LEASE_SOURCE_H__
+#define __DHCP_LEASE_SOURCE_H__
+
+#include <stddef.h>
+#include <stdint.h>
+#include "dhcp_lease_engine.h"
+
+/**
+* @brief Reads the whole lease of an interface from its source
+*
+* @param[in]  iface   - Interface
+* @param[out] pLease  - Receives the lease
+* @param[out] pTimers - Receives the timers
+* @param[out] pNowNs  - Receives the engine time the timers were computed at, may be NULL
+*
+* @return 0 on success, -1 if the source has no lease for the interface
+*/
+int dhcp_lease_source_get( dhcp_lease_if_t iface, dhcp_lease_t *pLease, dhcp_lease_timers_t *pTimers, uint64_t *pNowNs );
+
+/**
+* @brief Reads one value of an interface's lease
+*
+* From the lease engine this reads the field alone, without copying the lease.
+*
+* @param[in]  iface  - Interface
+* @param[in]  field  - Value to read
+* @param[out] pValue - Receives the value
+*
+* @return 0 on success, -1 on failure, or the status a replayed getter recorded
+*/
+int dhcp_lease_source_field( dhcp_lease_if_t iface, dhcp_lease_field_t field, uint32_t *pValue );
+
+/**
+* @brief Reads the interface name of a lease
+*
+* @param[in]  iface - Interface
+* @param[out] pName - Receives the NUL-terminated name, DHCP_LEASE_REPLAY_IFNAME_SIZE bytes
+*
+* @return 0 on success, -1 on failure, or the status a replayed getter recorded
+*/
+int dhcp_lease_source_ifname( dhcp_lease_if_t iface, char *pName );
+
+/**
+* @brief Reads the DNS servers of a lease into a HAL address list
+*
+* Both HAL families lay their lists out as { int number; uint32_t addresses[]; },
+* the layout DHCP_LEASE_REPLAY_DNS_SVRS records.
+*
+* @param[in]  iface - Interface
+* @param[out] pList - Receives the list
+* @param[in]  size  - Bytes pList holds; servers that do not fit are dropped
+*
+* @return 0 on success, -1 on failure, or the status a replayed getter recorded
+*/
+int dhcp_lease_source_dns_svrs( dhcp_lease_if_t iface, void *pList, size_t size );
+
+#endif /* __DHCP_LEASE_SOURCE_H__ */
@@ -0,0 +1,245 @@
+/*
+* If not stated otherwise in this file or this component's LICENSE file the
+* following copyright and licenses apply:*
+* Copyright 2023 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+/**
+* @file dhcp_packet.h
+*
+* DHCPv4 message codec (RFC 2131/2132) shared by the skeleton and the DHCP
+* server stand-in.
+*
+* Only the fields and options behind the HAL getters are kept: the message
+* type, the requested address, and options 1, 3, 6, 51, 54, 58 and 59, which
+* dhcp_packet_to_lease() turns into a lease. Other options are skipped.
+*
+* Both directions work on a caller's buffer and never allocate. The decoder
+* checks every length against the end of the buffer before reading, so any
+* input is safe to hand it; it also reads options overloaded into the file
+* and sname fields (option 52). The encoder fails rather than truncating
+* when the buffer is too small.
+*
+* Options are located by a scanner that walks an option area and lists the
+* code, length and offset of each option. Besides the scalar walk there is a
+* vectorized one (SSE2 on x86-64, NEON on AArch64) that skips runs of PAD
+* 16 bytes at a time; the walk from one option to the next follows each
+* length byte in turn either way, so long options such as 43 and 122 cost
+* the same in both. The scanner is chosen at run time with
+* dhcp_packet_set_scanner() or DHCP_PACKET_SCANNER=scalar|simd, and defaults
+* to the vectorized one where the build has it.
+*
+* Addresses are held in network byte order, times in host byte order, and a
+* zero option value means the option is absent.
+*/
+
+#ifndef __DHCP_PACKET_H__
+#define __DHCP_PACKET_H__
+
+#include <stddef.h>
+#include <stdint.h>
+#include "dhcp_lease_engine.h"
+
+#define DHCP_PACKET_SERVER_PORT    67
+#define DHCP_PACKET_CLIENT_PORT    68
+#define DHCP_PACKET_MAGIC_COOKIE   0x63825363U
+#define DHCP_PACKET_FIXED_SIZE     236     /*!< op .. file, before the magic cookie */
+#define DHCP_PACKET_OPTIONS_OFFSET 240     /*!< First option, after the magic cookie */
+#define DHCP_PACKET_BOOTP_SIZE     300     /*!< Encoded messages are padded to this, some clients drop shorter ones */
+#define DHCP_PACKET_MIN_SIZE       576     /*!< Minimum every host must accept, RFC 2131 */
+#define DHCP_PACKET_FLAG_BROADCAST 0x8000
+#define DHCP_PACKET_MAX_DNS        DHCP_LEASE_MAX_DNS
+#define DHCP_PACKET_MAX_PARAMS     16      /*!< Parameter request list entries kept */
+#define DHCP_PACKET_SCANNER_ENV    "DHCP_PACKET_SCANNER"   /*!< "scalar" or "simd"; unset for the best one built */
+
+#define DHCP_BOOTREQUEST           1
+#define DHCP_BOOTREPLY             2
+
+/**
+* @name Option codes
+* @{
+*/
+#define DHCP_OPT_PAD               0
+#define DHCP_OPT_SUBNET_MASK       1
+#define DHCP_OPT_ROUTER            3
+#define DHCP_OPT_DNS               6
+#define DHCP_OPT_REQUESTED_IP      50
+#define DHCP_OPT_LEASE_TIME        51
+#define DHCP_OPT_OVERLOAD          52
+#define DHCP_OPT_MSG_TYPE          53
+#define DHCP_OPT_SERVER_ID         54
+#define DHCP_OPT_PARAM_LIST        55
+#define DHCP_OPT_RENEWAL           58
+#define DHCP_OPT_REBINDING         59
+#define DHCP_OPT_END               255
+/** @} */
+
+/**
+* @brief DHCP message types (option 53)
+*/
+typedef enum
+{
+    DHCPDISCOVER = 1,
+    DHCPOFFER,
+    DHCPREQUEST,
+    DHCPDECLINE,
+    DHCPACK,
+    DHCPNAK,
+    DHCPRELEASE,
+    DHCPINFORM
+} dhcp_msg_type_t;
+
+/**
+* @brief Option scanners
+*/
+typedef enum
+{
+    DHCP_PACKET_SCANNER_SCALAR = 0,   /*!< One byte at a time */
+    DHCP_PACKET_SCANNER_SIMD          /*!< PAD runs 16 bytes at a time, where the build supports it */
+} dhcp_packet_scanner_t;
+
+/**
+* @brief An option located by dhcp_packet_scan()
+*/
+typedef struct
+{
+    uint32_t offset;    /*!< Offset of the option data from the start of the area */
+    uint8_t  code;      /*!< Option code, never PAD or END */
+    uint8_t  length;    /*!< Bytes of option data */
+} dhcp_option_ref_t;
+
+/**
+* @brief The fields of a DHCP message the HAL and the stand-ins act on
+*/
+typedef struct
+{
+    uint8_t  op;                                  /*!< DHCP_BOOTREQUEST or DHCP_BOOTREPLY */
+    uint8_t  hops;
+    uint16_t flags;                               /*!< DHCP_PACKET_FLAG_BROADCAST */
+    uint32_t xid;
+    uint16_t secs;
+    uint32_t ciaddr;
+    uint32_t yiaddr;
+    uint32_t siaddr;
+    uint32_t giaddr;
+    uint8_t  chaddr[16];                          /*!< Ethernet address in the first 6 bytes */
+    int      msg_type;                            /*!< Option 53, one of dhcp_msg_type_t */
+    uint32_t requested_ip;                        /*!< Option 50 */
+    uint32_t server_id;                           /*!< Option 54 */
+    uint32_t mask;                                /*!< Option 1 */
+    uint32_t router;                              /*!< Option 3, first router */
+    uint32_t dns[DHCP_PACKET_MAX_DNS];            /*!< Option 6 */
+    int      dns_count;                           /*!< Valid entries in dns */
+    uint32_t lease_time;                          /*!< Option 51, seconds */
+    uint32_t renewal_time;                        /*!< Option 58 (T1), seconds */
+    uint32_t rebinding_time;                      /*!< Option 59 (T2), seconds */
+    uint8_t  params[DHCP_PACKET_MAX_PARAMS];      /*!< Option 55 */
+    int      param_count;                         /*!< Valid entries in params */
+} dhcp_packet_t;
+
+/**
+* @brief Decodes a message
+*
+* Repeated options are taken last one wins, except option 6, whose
+* addresses are appended up to DHCP_PACKET_MAX_DNS. A fixed-size option of
+* the wrong length is ignored; an option running past the end of its area
+* is an error. A missing END option is tolerated.
+*
+* @param[in]  pBuf    - Message as received (UDP payload)
+* @param[in]  length  - Bytes in pBuf
+* @param[out] pPacket - Decoded fields, zeroed first
+*
+* @return 0 on success, -1 if the message is short, has no magic cookie,
+*         a truncated option, or no message type
+*/
+int dhcp_packet_decode( const uint8_t *pBuf, size_t length, dhcp_packet_t *pPacket );
+
+/**
+* @brief Encodes a message
+*
+* Writes the fixed fields, the magic cookie, option 53, then each option
+* that is set, and END, padded with zeroes to DHCP_PACKET_BOOTP_SIZE.
+*
+* @param[in]  pPacket - Fields to encode; msg_type must be set
+* @param[out] pBuf    - Buffer for the message
+* @param[in]  size    - Bytes available in pBuf
+* @param[out] pLength - Bytes written
+*
+* @return 0 on success, -1 on an invalid argument or if the message does not fit
+*/
+int dhcp_packet_encode( const dhcp_packet_t *pPacket, uint8_t *pBuf, size_t size, size_t *pLength );
+
+/**
+* @brief Fills a lease from an ACK
+*
+* Sets the address, mask, gateway, server, DNS servers and the three times;
+* everything else, including the interface name, is left as it was. T1 and
+* T2 stay 0 when the ACK does not carry them; dhcp_lease_apply_defaults()
+* fills them in.
+*
+* @param[in]     pPacket - Decoded DHCPACK
+* @param[in,out] pLease  - Lease to fill
+*
+* @return 0 on success, -1 if the message is not an ACK or has no address
+*/
+int dhcp_packet_to_lease( const dhcp_packet_t *pPacket, dhcp_lease_t *pLease );
+
+/**
+* @brief Locates the options of an option area, a batch at a time
+*
+* Call with *pOffset at 0, then again until it returns 0. PAD is skipped;
+* END, or the end of the area, finishes the scan.
+*
+* @param[in]     pArea   - Option area: the options field, or file or sname when overloaded
+* @param[in]     size    - Bytes in pArea
+* @param[in,out] pOffset - Where to continue; moved past the options returned, to size once finished
+* @param[out]    pRefs   - Options found, in order
+* @param[in]     max     - Entries available in pRefs, at least 1
+*
+* @return The number of options stored, 0 once finished, or -1 if an option runs past the end of the area
+*/
+int dhcp_packet_scan( const uint8_t *pArea, size_t size, size_t *pOffset, dhcp_option_ref_t *pRefs, uint32_t max );
+
+/**
+* @brief Selects the scanner used by dhcp_packet_scan() and dhcp_packet_decode()
+*
+* Applies to the whole process, and may be changed at any time.
+*
+* @param[in] scanner - Scanner to use
+*
+* @return 0 on success, -1 if this build has no such scanner
+*/
+int dhcp_packet_set_scanner( dhcp_packet_scanner_t scanner );
+
+/**
+* @brief Returns the scanner in use
+*/
+dhcp_packet_scanner_t dhcp_packet_get_scanner( void );
+
+/**
+* @brief Returns the name of a scanner: "scalar", or "sse2" or "neon" for DHCP_PACKET_SCANNER_SIMD
+*
+* @return The name, or NULL if this build has no such scanner
+*/
+const char *dhcp_packet_scanner_name( dhcp_packet_scanner_t scanner );
+
+/**
+* @brief Returns the name of a message type, such as "DISCOVER"
+*
+* @return The name, or "UNKNOWN"
+*/
+const char *dhcp_packet_type_name( int msg_type );
+
+#endif /* __DHCP_PACKET_H__ */
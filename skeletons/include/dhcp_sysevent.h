@@ -0,0 +1,134 @@
+/*
+* If not stated otherwise in this file or this component's LICENSE file the
+* following copyright and licenses apply:*
+* Copyright 2023 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+/**
+* @file dhcp_sysevent.h
+*
+* Client of the sysevent stand-in (tools/sysevent_standin) for the skeleton HAL implementations.
+*
+* On RDK-B devices the DHCP client scripts announce lease changes through
+* syseventd, and HAL implementations linked with -lsysevent listen for
+* them. The stand-in gives plain Linux the same model: a daemon holding
+* key/value tuples, where a set notifies every connection that asked for
+* that key. It speaks one request per line on a UNIX stream socket:
+*
+* | Request | Reply |
+* | ------- | ----- |
+* | SET key value | OK |
+* | GET key | VALUE value, or NONE when the key was never set |
+* | NOTIFY key | OK; the connection then also receives "EVENT key value" on every SET of key |
+*
+* Keys hold no spaces; the value is the rest of the line. Events can arrive
+* ahead of a reply; the calls below that wait for one drop them, so a
+* connection that asked for notifications is best kept for them alone.
+*/
+
+#ifndef __DHCP_SYSEVENT_H__
+#define __DHCP_SYSEVENT_H__
+
+#include <stddef.h>
+
+#define DHCP_SYSEVENT_ENV        "DHCP_SYSEVENT_SOCKET"   /*!< Socket of the stand-in, unset for in-process events only */
+#define DHCP_SYSEVENT_KEY_LEN    64                       /*!< Longest key, with its terminator */
+#define DHCP_SYSEVENT_VALUE_LEN  256                      /*!< Longest value, with its terminator */
+#define DHCP_SYSEVENT_LINE_LEN   (DHCP_SYSEVENT_KEY_LEN + DHCP_SYSEVENT_VALUE_LEN + 16)
+
+/**
+* @brief A connection to the stand-in
+*/
+typedef struct
+{
+    int    fd;
+    size_t used;                                /*!< Bytes received but not yet returned */
+    char   buffer[2 * DHCP_SYSEVENT_LINE_LEN];
+} dhcp_sysevent_t;
+
+/**
+* @brief Connects to the stand-in
+*
+* @param[out] pConn - Receives the connection
+* @param[in]  pPath - Socket path
+*
+* @return 0 on success, -1 if the daemon cannot be reached
+*/
+int dhcp_sysevent_open( dhcp_sysevent_t *pConn, const char *pPath );
+
+/**
+* @brief Closes a connection
+*
+* @param[in,out] pConn - Connection, may already be closed
+*/
+void dhcp_sysevent_close( dhcp_sysevent_t *pConn );
+
+/**
+* @brief Sets a tuple, notifying whoever asked for the key
+*
+* @param[in,out] pConn  - Connection
+* @param[in]     pKey   - Key, without spaces
+* @param[in]     pValue - Value, without newlines
+*
+* @return 0 once the daemon acknowledged it, otherwise -1
+*/
+int dhcp_sysevent_set( dhcp_sysevent_t *pConn, const char *pKey, const char *pValue );
+
+/**
+* @brief Reads a tuple
+*
+* @param[in,out] pConn  - Connection
+* @param[in]     pKey   - Key
+* @param[out]    pValue - Receives the value
+* @param[in]     size   - Bytes at pValue
+*
+* @return 0 on success, 1 if the key was never set, -1 on an error
+*/
+int dhcp_sysevent_get( dhcp_sysevent_t *pConn, const char *pKey, char *pValue, size_t size );
+
+/**
+* @brief Asks for notifications of a key on this connection
+*
+* Every SET the daemon handles after this returns is notified.
+*
+* @param[in,out] pConn - Connection
+* @param[in]     pKey  - Key
+*
+* @return 0 once the daemon acknowledged it, otherwise -1
+*/
+int dhcp_sysevent_notify( dhcp_sysevent_t *pConn, const char *pKey );
+
+/**
+* @brief Waits for the next notification
+*
+* Returns at once when a notification is already buffered, so callers
+* polling the descriptor must call this until dhcp_sysevent_pending() is 0.
+*
+* @param[in,out] pConn  - Connection that asked for notifications
+* @param[out]    pKey   - Receives the key, DHCP_SYSEVENT_KEY_LEN bytes
+* @param[out]    pValue - Receives the value, DHCP_SYSEVENT_VALUE_LEN bytes
+*
+* @return 0 on success, -1 if the daemon went away
+*/
+int dhcp_sysevent_next( dhcp_sysevent_t *pConn, char *pKey, char *pValue );
+
+/**
+* @brief Returns non-zero if a whole line is already buffered
+*
+* @param[in] pConn - Connection
+*/
+int dhcp_sysevent_pending( const dhcp_sysevent_t *pConn );
+
+#endif /* __DHCP_SYSEVENT_H__ */
@@ -0,0 +1,171 @@
+/*
+* If not stated otherwise in this file or this component's LICENSE file the
+* following copyright and licenses apply:*
+* Copyright 2023 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+/**
+* @file dhcp_timer_wheel.h
+*
+* Hierarchical timing wheel driving the lease engine's T1, T2 and expiry events.
+*
+* Time is counted in ticks of a fixed length from the wheel's origin. Level 0
+* has one slot per tick for the next 64 ticks, and each level above has
+* slots 64 times as long, so six levels cover 2^36 ticks; timers further out
+* wait in the top level and are placed again as it turns. Timers are
+* intrusive list nodes owned by the caller, so adding and cancelling are
+* O(1) and never allocate. A timer moves down a level when the slot holding
+* it comes round (at most once per level), and fires on the first
+* dhcp_timer_wheel_advance() that reaches its tick, never before its expiry.
+*
+* The wheel is driven by its owner: nothing fires unless advance is called.
+* Runs of empty ticks are skipped using a bitmap of occupied slots per level,
+* so advancing costs the slots visited rather than the ticks elapsed, and a
+* call with nothing due is a single comparison.
+*
+* Not thread safe; the owner serialises every call on a wheel.
+*/
+
+#ifndef __DHCP_TIMER_WHEEL_H__
+#define __DHCP_TIMER_WHEEL_H__
+
+#include <stdint.h>
+
+#define DHCP_TIMER_WHEEL_BITS    6                                 /*!< log2 of the slots per level */
+#define DHCP_TIMER_WHEEL_SLOTS   (1U << DHCP_TIMER_WHEEL_BITS)    /*!< Slots per level */
+#define DHCP_TIMER_WHEEL_LEVELS  6                                 /*!< Levels, covering 2^36 ticks */
+
+typedef struct dhcp_timer dhcp_timer_t;
+
+/**
+* @brief Called from dhcp_timer_wheel_advance() when a timer expires
+*
+* The timer is no longer pending and may be added again, to this or any
+* other time; other timers of the wheel may be added or cancelled too.
+*
+* @param[in] pTimer    - The timer that expired
+* @param[in] pUserData - As given to dhcp_timer_init()
+*/
+typedef void (*dhcp_timer_cb_t)( dhcp_timer_t *pTimer, void *pUserData );
+
+/**
+* @brief Doubly linked list node; a slot's list head is one of these
+*/
+typedef struct dhcp_timer_link
+{
+    struct dhcp_timer_link *pNext;
+    struct dhcp_timer_link *pPrev;
+} dhcp_timer_link_t;
+
+/**
+* @brief A timer, embedded wherever its owner likes
+*
+* Fields are private to the wheel; use dhcp_timer_init() and the wheel calls.
+*/
+struct dhcp_timer
+{
+    dhcp_timer_link_t link;     /*!< Must stay first */
+    uint64_t expires;           /*!< Tick at which it fires */
+    uint64_t expires_ns;        /*!< Expiry as requested */
+    int32_t slot;               /*!< level * DHCP_TIMER_WHEEL_SLOTS + index, -1 when not in a slot */
+    int32_t pending;            /*!< Non-zero from add until it fires or is cancelled */
+    dhcp_timer_cb_t callback;
+    void *pUserData;
+};
+
+/**
+* @brief A timing wheel; large (about 6 KiB), so keep it static or on the heap
+*/
+typedef struct
+{
+    uint64_t tick_ns;                                                         /*!< Length of a tick */
+    uint64_t origin_ns;                                                       /*!< Time of tick 0 */
+    uint64_t current;                                                         /*!< Last tick processed */
+    uint64_t next_ns;                                                         /*!< advance() has nothing to do before this time */
+    uint32_t pending;                                                         /*!< Timers added and not yet fired or cancelled */
+    uint64_t occupied[DHCP_TIMER_WHEEL_LEVELS];                               /*!< Bit per non-empty slot */
+    dhcp_timer_link_t slots[DHCP_TIMER_WHEEL_LEVELS][DHCP_TIMER_WHEEL_SLOTS];  /*!< List heads */
+} dhcp_timer_wheel_t;
+
+/**
+* @brief Initialises an empty wheel
+*
+* @param[out] pWheel  - Wheel to initialise
+* @param[in]  tick_ns - Length of a tick; timers fire up to one tick after their expiry
+* @param[in]  now_ns  - Time of tick 0, on the clock later passed to the wheel
+*
+* @return 0 on success, -1 on an invalid argument
+*/
+int dhcp_timer_wheel_init( dhcp_timer_wheel_t *pWheel, uint64_t tick_ns, uint64_t now_ns );
+
+/**
+* @brief Initialises a timer before its first use
+*
+* @param[out] pTimer    - Timer to initialise, not pending
+* @param[in]  callback  - Called when it expires
+* @param[in]  pUserData - Passed to callback
+*/
+void dhcp_timer_init( dhcp_timer_t *pTimer, dhcp_timer_cb_t callback, void *pUserData );
+
+/**
+* @brief Arms a timer, moving it if already pending
+*
+* A time already passed fires on the next advance.
+*
+* @param[in,out] pWheel     - Wheel
+* @param[in,out] pTimer     - Timer from dhcp_timer_init()
+* @param[in]     expires_ns - Time at which it fires
+*
+* @return 0 on success, -1 on an invalid argument
+*/
+int dhcp_timer_wheel_add( dhcp_timer_wheel_t *pWheel, dhcp_timer_t *pTimer, uint64_t expires_ns );
+
+/**
+* @brief Disarms a timer
+*
+* @param[in,out] pWheel - Wheel the timer was added to
+* @param[in,out] pTimer - Timer, pending or not
+*
+* @return 1 if it was pending, 0 if not
+*/
+int dhcp_timer_wheel_cancel( dhcp_timer_wheel_t *pWheel, dhcp_timer_t *pTimer );
+
+/**
+* @brief Tells whether a timer is armed
+*
+* @return Non-zero from dhcp_timer_wheel_add() until it fires or is cancelled
+*/
+int dhcp_timer_pending( const dhcp_timer_t *pTimer );
+
+/**
+* @brief Returns the time a timer was armed for
+*
+* @return The expires_ns of the last dhcp_timer_wheel_add()
+*/
+uint64_t dhcp_timer_expires_ns( const dhcp_timer_t *pTimer );
+
+/**
+* @brief Fires every timer due at a time
+*
+* Timers fire in tick order; within a tick, in no particular order.
+*
+* @param[in,out] pWheel - Wheel
+* @param[in]     now_ns - Current time; a time before the last advance does nothing
+*
+* @return The number of timers fired
+*/
+uint32_t dhcp_timer_wheel_advance( dhcp_timer_wheel_t *pWheel, uint64_t now_ns );
+
+#endif /* __DHCP_TIMER_WHEEL_H__ */
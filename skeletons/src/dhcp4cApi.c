@@ -16,198 +16,232 @@
 * limitations under the License.
 */
 
-#include <string.h>
-#include <stdlib.h>
-#include <setjmp.h>
 #include "dhcp4cApi.h"
+#include "dhcp4cApi_ext.h"
+#include "dhcp_lease_engine.h"
+#include "dhcp_lease_source.h"
 
+#ifndef STATUS_SUCCESS
+#define STATUS_SUCCESS   0
+#endif
+
+#ifndef STATUS_FAILURE
+#define STATUS_FAILURE   -1
+#endif
+
+int dhcp4c_get_if_count(unsigned int* pCount)
+{
+  if (pCount == NULL)
+  {
+    return STATUS_FAILURE;
+  }
+  *pCount = dhcp_lease_engine_iface_count();
+  return STATUS_SUCCESS;
+}
+
+int dhcp4c_get_if_index(const char* pIfname, unsigned int* pIndex)
+{
+  dhcp_lease_if_t iface;
+
+  if (pIndex == NULL || dhcp_lease_engine_find_iface(pIfname, &iface) != 0)
+  {
+    return STATUS_FAILURE;
+  }
+  *pIndex = (unsigned int)iface;
+  return STATUS_SUCCESS;
+}
+
+int dhcp4c_get_if_lease_time(unsigned int ifIndex, unsigned int* pValue)
+{
+  return dhcp_lease_source_field((dhcp_lease_if_t)ifIndex, DHCP_LEASE_FIELD_LEASE_TIME, pValue);
+}
+
+int dhcp4c_get_if_remain_lease_time(unsigned int ifIndex, unsigned int* pValue)
+{
+  return dhcp_lease_source_field((dhcp_lease_if_t)ifIndex, DHCP_LEASE_FIELD_REMAIN_LEASE, pValue);
+}
+
+int dhcp4c_get_if_remain_renew_time(unsigned int ifIndex, unsigned int* pValue)
+{
+  return dhcp_lease_source_field((dhcp_lease_if_t)ifIndex, DHCP_LEASE_FIELD_REMAIN_RENEW, pValue);
+}
+
+int dhcp4c_get_if_remain_rebind_time(unsigned int ifIndex, unsigned int* pValue)
+{
+  return dhcp_lease_source_field((dhcp_lease_if_t)ifIndex, DHCP_LEASE_FIELD_REMAIN_REBIND, pValue);
+}
+
+int dhcp4c_get_if_config_attempts(unsigned int ifIndex, int* pValue)
+{
+  return dhcp_lease_source_field((dhcp_lease_if_t)ifIndex, DHCP_LEASE_FIELD_CONFIG_ATTEMPTS, (uint32_t *)pValue);
+}
+
+int dhcp4c_get_if_ifname(unsigned int ifIndex, char* pName)
+{
+  return dhcp_lease_source_ifname((dhcp_lease_if_t)ifIndex, pName);
+}
+
+int dhcp4c_get_if_fsm_state(unsigned int ifIndex, int* pValue)
+{
+  return dhcp_lease_source_field((dhcp_lease_if_t)ifIndex, DHCP_LEASE_FIELD_FSM_STATE, (uint32_t *)pValue);
+}
+
+int dhcp4c_get_if_ip_addr(unsigned int ifIndex, unsigned int* pValue)
+{
+  return dhcp_lease_source_field((dhcp_lease_if_t)ifIndex, DHCP_LEASE_FIELD_IP_ADDR, pValue);
+}
+
+int dhcp4c_get_if_mask(unsigned int ifIndex, unsigned int* pValue)
+{
+  return dhcp_lease_source_field((dhcp_lease_if_t)ifIndex, DHCP_LEASE_FIELD_MASK, pValue);
+}
+
+int dhcp4c_get_if_gw(unsigned int ifIndex, unsigned int* pValue)
+{
+  return dhcp_lease_source_field((dhcp_lease_if_t)ifIndex, DHCP_LEASE_FIELD_GW, pValue);
+}
+
+int dhcp4c_get_if_dns_svrs(unsigned int ifIndex, ipv4AddrList_t* pList)
+{
+  return dhcp_lease_source_dns_svrs((dhcp_lease_if_t)ifIndex, pList, sizeof(*pList));
+}
+
+int dhcp4c_get_if_dhcp_svr(unsigned int ifIndex, unsigned int* pValue)
+{
+  return dhcp_lease_source_field((dhcp_lease_if_t)ifIndex, DHCP_LEASE_FIELD_DHCP_SVR, pValue);
+}
 
 int dhcp4c_get_ert_lease_time(unsigned int* pValue)
 {
-  /*TODO: Implement Me!*/
-  (void)pValue;
-  return (int)0;
+  return dhcp4c_get_if_lease_time(DHCP4C_IF_ERT, pValue);
 }
 
 int dhcp4c_get_ert_remain_lease_time(unsigned int* pValue)
 {
-  /*TODO: Implement Me!*/
-  (void)pValue;
-  return (int)0;
+  return dhcp4c_get_if_remain_lease_time(DHCP4C_IF_ERT, pValue);
 }
 
 int dhcp4c_get_ert_remain_renew_time(unsigned int* pValue)
 {
-  /*TODO: Implement Me!*/
-  (void)pValue;
-  return (int)0;
+  return dhcp4c_get_if_remain_renew_time(DHCP4C_IF_ERT, pValue);
 }
 
 int dhcp4c_get_ert_remain_rebind_time(unsigned int* pValue)
 {
-  /*TODO: Implement Me!*/
-  (void)pValue;
-  return (int)0;
+  return dhcp4c_get_if_remain_rebind_time(DHCP4C_IF_ERT, pValue);
 }
 
 int dhcp4c_get_ert_config_attempts(int* pValue)
 {
-  /*TODO: Implement Me!*/
-  (void)pValue;
-  return (int)0;
+  return dhcp4c_get_if_config_attempts(DHCP4C_IF_ERT, pValue);
 }
 
 int dhcp4c_get_ert_ifname(char* pName)
 {
-  /*TODO: Implement Me!*/
-  (void)pName;
-  return (int)0;
+  return dhcp4c_get_if_ifname(DHCP4C_IF_ERT, pName);
 }
 
 int dhcp4c_get_ert_fsm_state(int* pValue)
 {
-  /*TODO: Implement Me!*/
-  (void)pValue;
-  return (int)0;
+  return dhcp4c_get_if_fsm_state(DHCP4C_IF_ERT, pValue);
 }
 
 int dhcp4c_get_ert_ip_addr(unsigned int* pValue)
 {
-  /*TODO: Implement Me!*/
-  (void)pValue;
-  return (int)0;
+  return dhcp4c_get_if_ip_addr(DHCP4C_IF_ERT, pValue);
 }
 
 int dhcp4c_get_ert_mask(unsigned int* pValue)
 {
-  /*TODO: Implement Me!*/
-  (void)pValue;
-  return (int)0;
+  return dhcp4c_get_if_mask(DHCP4C_IF_ERT, pValue);
 }
 
 int dhcp4c_get_ert_gw(unsigned int* pValue)
 {
-  /*TODO: Implement Me!*/
-  (void)pValue;
-  return (int)0;
+  return dhcp4c_get_if_gw(DHCP4C_IF_ERT, pValue);
 }
 
 int dhcp4c_get_ert_dns_svrs(ipv4AddrList_t* pList)
 {
-  /*TODO: Implement Me!*/
-  (void)pList;
-  return (int)0;
+  return dhcp4c_get_if_dns_svrs(DHCP4C_IF_ERT, pList);
 }
 
 int dhcp4c_get_ert_dhcp_svr(unsigned int* pValue)
 {
-  /*TODO: Implement Me!*/
-  (void)pValue;
-  return (int)0;
+  return dhcp4c_get_if_dhcp_svr(DHCP4C_IF_ERT, pValue);
 }
 
 int dhcp4c_get_ecm_lease_time(unsigned int* pValue)
 {
-  /*TODO: Implement Me!*/
-  (void)pValue;
-  return (int)0;
+  return dhcp4c_get_if_lease_time(DHCP4C_IF_ECM, pValue);
 }
 
 int dhcp4c_get_ecm_remain_lease_time(unsigned int* pValue)
 {
-  /*TODO: Implement Me!*/
-  (void)pValue;
-  return (int)0;
+  return dhcp4c_get_if_remain_lease_time(DHCP4C_IF_ECM, pValue);
 }
 
 int dhcp4c_get_ecm_remain_renew_time(unsigned int* pValue)
 {
-  /*TODO: Implement Me!*/
-  (void)pValue;
-  return (int)0;
+  return dhcp4c_get_if_remain_renew_time(DHCP4C_IF_ECM, pValue);
 }
 
 int dhcp4c_get_ecm_remain_rebind_time(unsigned int* pValue)
 {
-  /*TODO: Implement Me!*/
-  (void)pValue;
-  return (int)0;
+  return dhcp4c_get_if_remain_rebind_time(DHCP4C_IF_ECM, pValue);
 }
 
 int dhcp4c_get_ecm_config_attempts(int* pValue)
 {
-  /*TODO: Implement Me!*/
-  (void)pValue;
-  return (int)0;
+  return dhcp4c_get_if_config_attempts(DHCP4C_IF_ECM, pValue);
 }
 
 int dhcp4c_get_ecm_ifname(char* pName)
 {
-  /*TODO: Implement Me!*/
-  (void)pName;
-  return (int)0;
+  return dhcp4c_get_if_ifname(DHCP4C_IF_ECM, pName);
 }
 
 int dhcp4c_get_ecm_fsm_state(int* pValue)
 {
-  /*TODO: Implement Me!*/
-  (void)pValue;
-  return (int)0;
+  return dhcp4c_get_if_fsm_state(DHCP4C_IF_ECM, pValue);
 }
 
 int dhcp4c_get_ecm_ip_addr(unsigned int* pValue)
 {
-  /*TODO: Implement Me!*/
-  (void)pValue;
-  return (int)0;
+  return dhcp4c_get_if_ip_addr(DHCP4C_IF_ECM, pValue);
 }
 
 int dhcp4c_get_ecm_mask(unsigned int* pValue)
 {
-  /*TODO: Implement Me!*/
-  (void)pValue;
-  return (int)0;
+  return dhcp4c_get_if_mask(DHCP4C_IF_ECM, pValue);
 }
 
 int dhcp4c_get_ecm_gw(unsigned int* pValue)
 {
-  /*TODO: Implement Me!*/
-  (void)pValue;
-  return (int)0;
+  return dhcp4c_get_if_gw(DHCP4C_IF_ECM, pValue);
 }
 
 int dhcp4c_get_ecm_dns_svrs(ipv4AddrList_t* pList)
 {
-  /*TODO: Implement Me!*/
-  (void)pList;
-  return (int)0;
+  return dhcp4c_get_if_dns_svrs(DHCP4C_IF_ECM, pList);
 }
 
 int dhcp4c_get_ecm_dhcp_svr(unsigned int* pValue)
 {
-  /*TODO: Implement Me!*/
-  (void)pValue;
-  return (int)0;
+  return dhcp4c_get_if_dhcp_svr(DHCP4C_IF_ECM, pValue);
 }
 
 int dhcp4c_get_emta_remain_lease_time(unsigned int* pValue)
 {
-  /*TODO: Implement Me!*/
-  (void)pValue;
-  return (int)0;
+  return dhcp4c_get_if_remain_lease_time(DHCP4C_IF_EMTA, pValue);
 }
 
 int dhcp4c_get_emta_remain_renew_time(unsigned int* pValue)
 {
-  /*TODO: Implement Me!*/
-  (void)pValue;
-  return (int)0;
+  return dhcp4c_get_if_remain_renew_time(DHCP4C_IF_EMTA, pValue);
 }
 
 int dhcp4c_get_emta_remain_rebind_time(unsigned int* pValue)
 {
-  /*TODO: Implement Me!*/
-  (void)pValue;
-  return (int)0;
+  return dhcp4c_get_if_remain_rebind_time(DHCP4C_IF_EMTA, pValue);
 }
-
@@ -0,0 +1,748 @@
+/*
+* If not stated otherwise in this file or this component's LICENSE file the
+* following copyright and licenses apply:*
+* Copyright 2023 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#include <string.h>
+#include <stdlib.h>
+#include <time.h>
+#include <pthread.h>
+#include <arpa/inet.h>
+#include "dhcp_lease_engine.h"
+#include "dhcp_lease_notify.h"
+#include "dhcp_timer_wheel.h"
+
+#define NSEC_PER_SEC    1000000000ULL
+#define ENGINE_TICK_NS  1000000ULL      /* Lease timers fire within a millisecond of their time */
+
+#define IPV4(a, b, c, d)  htonl(((uint32_t)(a) << 24) | ((uint32_t)(b) << 16) | ((uint32_t)(c) << 8) | (uint32_t)(d))
+
+static pthread_once_t gEngineOnce = PTHREAD_ONCE_INIT;
+static pthread_mutex_t gEngineLock = PTHREAD_MUTEX_INITIALIZER;
+static int gAutoRenew = 1;
+static uint64_t gClockOffsetNs = 0;
+
+/* T1, T2 and expiry of every lease, on the engine clock */
+typedef enum
+{
+    ENGINE_TIMER_T1 = 0,
+    ENGINE_TIMER_T2,
+    ENGINE_TIMER_EXPIRY,
+    ENGINE_TIMER_MAX
+} engine_timer_t;
+
+/*
+* Lease table, one column per field: a getter touches only the columns it
+* reads, and a scan of one field over every interface is a contiguous copy.
+*/
+typedef struct
+{
+    uint32_t count;                                               /* Interfaces in use */
+    uint32_t ip_addr[DHCP_LEASE_MAX_IFACES];
+    uint32_t mask[DHCP_LEASE_MAX_IFACES];
+    uint32_t gw[DHCP_LEASE_MAX_IFACES];
+    uint32_t dhcp_svr[DHCP_LEASE_MAX_IFACES];
+    uint32_t lease_time[DHCP_LEASE_MAX_IFACES];
+    uint32_t renew_time[DHCP_LEASE_MAX_IFACES];
+    uint32_t rebind_time[DHCP_LEASE_MAX_IFACES];
+    uint64_t bound_ns[DHCP_LEASE_MAX_IFACES];
+    uint8_t  bound[DHCP_LEASE_MAX_IFACES];
+    int32_t  config_attempts[DHCP_LEASE_MAX_IFACES];
+    int32_t  dns_count[DHCP_LEASE_MAX_IFACES];
+    uint32_t dns_svrs[DHCP_LEASE_MAX_IFACES][DHCP_LEASE_MAX_DNS];
+    char     ifname[DHCP_LEASE_MAX_IFACES][DHCP_LEASE_IFNAME_LEN];
+} lease_table_t;
+
+static lease_table_t gTable;
+static dhcp_timer_wheel_t gWheel;
+static dhcp_timer_t gTimers[DHCP_LEASE_MAX_IFACES][ENGINE_TIMER_MAX];
+static uint64_t gTimerNowNs;        /* Engine time the wheel is being advanced to */
+static uint32_t gChangedMask;       /* Interfaces whose state a timer changed, to announce */
+
+/*
+* Documentation address ranges (RFC 5737) for the three base interfaces, and
+* a /30 of the benchmarking range (RFC 2544) for each one added after them
+*/
+static void default_lease( dhcp_lease_if_t iface, dhcp_lease_t *pLease )
+{
+    uint32_t subnet;
+
+    memset(pLease, 0, sizeof(*pLease));
+    pLease->config_attempts = 1;
+
+    switch (iface)
+    {
+        case DHCP_LEASE_IF_ERT:
+            strcpy(pLease->ifname, "erouter0");
+            pLease->ip_addr = IPV4(203, 0, 113, 10);
+            pLease->mask = IPV4(255, 255, 255, 0);
+            pLease->gw = IPV4(203, 0, 113, 1);
+            pLease->dhcp_svr = IPV4(203, 0, 113, 2);
+            pLease->dns_svrs[0] = IPV4(203, 0, 113, 53);
+            pLease->dns_svrs[1] = IPV4(203, 0, 113, 54);
+            pLease->dns_count = 2;
+            pLease->lease_time = 86400;
+            break;
+        case DHCP_LEASE_IF_ECM:
+            strcpy(pLease->ifname, "wan0");
+            pLease->ip_addr = IPV4(192, 0, 2, 100);
+            pLease->mask = IPV4(255, 255, 255, 0);
+            pLease->gw = IPV4(192, 0, 2, 1);
+            pLease->dhcp_svr = IPV4(192, 0, 2, 2);
+            pLease->dns_svrs[0] = IPV4(192, 0, 2, 53);
+            pLease->dns_count = 1;
+            pLease->lease_time = 604800;
+            break;
+        case DHCP_LEASE_IF_EMTA:
+            strcpy(pLease->ifname, "mta0");
+            pLease->ip_addr = IPV4(198, 51, 100, 100);
+            pLease->mask = IPV4(255, 255, 255, 0);
+            pLease->gw = IPV4(198, 51, 100, 1);
+            pLease->dhcp_svr = IPV4(198, 51, 100, 2);
+            pLease->dns_svrs[0] = IPV4(198, 51, 100, 53);
+            pLease->dns_count = 1;
+            pLease->lease_time = 3600;
+            break;
+        default:
+            subnet = (198U << 24) | (18U << 16) | ((uint32_t)iface << 2);
+            pLease->ip_addr = htonl(subnet + 2);
+            pLease->mask = IPV4(255, 255, 255, 252);
+            pLease->gw = htonl(subnet + 1);
+            pLease->dhcp_svr = htonl(subnet + 1);
+            pLease->dns_svrs[0] = htonl(subnet + 1);
+            pLease->dns_count = 1;
+            pLease->lease_time = 3600;
+            break;
+    }
+}
+
+static uint64_t monotonic_ns( void )
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * NSEC_PER_SEC + (uint64_t)ts.tv_nsec;
+}
+
+/* Caller holds gEngineLock; gathers one row of the lease table */
+static void load_locked( dhcp_lease_if_t iface, dhcp_lease_t *pLease )
+{
+    memcpy(pLease->ifname, gTable.ifname[iface], DHCP_LEASE_IFNAME_LEN);
+    pLease->ip_addr = gTable.ip_addr[iface];
+    pLease->mask = gTable.mask[iface];
+    pLease->gw = gTable.gw[iface];
+    pLease->dhcp_svr = gTable.dhcp_svr[iface];
+    memcpy(pLease->dns_svrs, gTable.dns_svrs[iface], sizeof(pLease->dns_svrs));
+    pLease->dns_count = gTable.dns_count[iface];
+    pLease->lease_time = gTable.lease_time[iface];
+    pLease->renew_time = gTable.renew_time[iface];
+    pLease->rebind_time = gTable.rebind_time[iface];
+    pLease->config_attempts = gTable.config_attempts[iface];
+    pLease->bound = gTable.bound[iface];
+    pLease->bound_ns = gTable.bound_ns[iface];
+}
+
+/* Caller holds gEngineLock; scatters a lease over one row of the lease table */
+static void store_locked( dhcp_lease_if_t iface, const dhcp_lease_t *pLease )
+{
+    memcpy(gTable.ifname[iface], pLease->ifname, DHCP_LEASE_IFNAME_LEN);
+    gTable.ip_addr[iface] = pLease->ip_addr;
+    gTable.mask[iface] = pLease->mask;
+    gTable.gw[iface] = pLease->gw;
+    gTable.dhcp_svr[iface] = pLease->dhcp_svr;
+    memcpy(gTable.dns_svrs[iface], pLease->dns_svrs, sizeof(gTable.dns_svrs[iface]));
+    gTable.dns_count[iface] = pLease->dns_count;
+    gTable.lease_time[iface] = pLease->lease_time;
+    gTable.renew_time[iface] = pLease->renew_time;
+    gTable.rebind_time[iface] = pLease->rebind_time;
+    gTable.config_attempts[iface] = pLease->config_attempts;
+    gTable.bound[iface] = (uint8_t)(pLease->bound != 0);
+    gTable.bound_ns[iface] = pLease->bound_ns;
+}
+
+/* Caller holds gEngineLock; arms the timers of a lease from its bound time */
+static void schedule_locked( dhcp_lease_if_t iface )
+{
+    const uint32_t seconds[ENGINE_TIMER_MAX] = { gTable.renew_time[iface], gTable.rebind_time[iface], gTable.lease_time[iface] };
+    int i;
+
+    for (i = 0; i < ENGINE_TIMER_MAX; i++)
+    {
+        if (gTable.bound[iface] && gTable.lease_time[iface] != DHCP_LEASE_INFINITE)
+        {
+            dhcp_timer_wheel_add(&gWheel, &gTimers[iface][i], gTable.bound_ns[iface] + (uint64_t)seconds[i] * NSEC_PER_SEC);
+        }
+        else
+        {
+            dhcp_timer_wheel_cancel(&gWheel, &gTimers[iface][i]);
+        }
+    }
+}
+
+/* Runs under gEngineLock from dhcp_timer_wheel_advance() */
+static void timer_fired( dhcp_timer_t *pTimer, void *pUserData )
+{
+    uint32_t index = (uint32_t)(pTimer - &gTimers[0][0]);
+    dhcp_lease_if_t iface = (dhcp_lease_if_t)(index / ENGINE_TIMER_MAX);
+    uint64_t t1_ns = (uint64_t)gTable.renew_time[iface] * NSEC_PER_SEC;
+
+    (void)pUserData;
+    if (index % ENGINE_TIMER_MAX == ENGINE_TIMER_T1 && __atomic_load_n(&gAutoRenew, __ATOMIC_RELAXED) && t1_ns > 0)
+    {
+        /* The simulated server renews at T1; the client stays BOUND, so there is nothing to announce */
+        gTable.bound_ns[iface] += ((gTimerNowNs - gTable.bound_ns[iface]) / t1_ns) * t1_ns;
+        schedule_locked(iface);
+        return;
+    }
+    /* RENEWING at T1, REBINDING at T2, INIT at expiry; only the base interfaces are announced */
+    if ((unsigned)iface < DHCP_LEASE_IF_MAX)
+    {
+        gChangedMask |= 1U << iface;
+    }
+}
+
+/* Caller holds gEngineLock */
+static void bind_locked( dhcp_lease_if_t iface, const dhcp_lease_t *pLease )
+{
+    dhcp_lease_t lease = *pLease;
+
+    lease.ifname[DHCP_LEASE_IFNAME_LEN - 1] = '\0';
+    if (lease.dns_count < 0)
+    {
+        lease.dns_count = 0;
+    }
+    else if (lease.dns_count > DHCP_LEASE_MAX_DNS)
+    {
+        lease.dns_count = DHCP_LEASE_MAX_DNS;
+    }
+    dhcp_lease_apply_defaults(&lease);
+    lease.bound = 1;
+    lease.bound_ns = dhcp_lease_engine_now_ns();
+    store_locked(iface, &lease);
+    schedule_locked(iface);
+}
+
+/* Caller holds gEngineLock; -1 if the name is not in the table */
+static int find_locked( const char *pIfname )
+{
+    uint32_t i;
+
+    for (i = 0; i < gTable.count; i++)
+    {
+        if (strncmp(gTable.ifname[i], pIfname, DHCP_LEASE_IFNAME_LEN) == 0)
+        {
+            return (int)i;
+        }
+    }
+    return -1;
+}
+
+/* Caller holds gEngineLock; appends an interface bound to its default lease */
+static int add_locked( const char *pIfname, dhcp_lease_if_t *pIface )
+{
+    dhcp_lease_if_t iface = (dhcp_lease_if_t)gTable.count;
+    dhcp_lease_t lease;
+
+    if (pIfname[0] == '\0' || strlen(pIfname) >= DHCP_LEASE_IFNAME_LEN ||
+        gTable.count >= DHCP_LEASE_MAX_IFACES || find_locked(pIfname) >= 0)
+    {
+        return -1;
+    }
+    default_lease(iface, &lease);
+    strcpy(lease.ifname, pIfname);
+    gTable.count++;
+    bind_locked(iface, &lease);
+    if (pIface != NULL)
+    {
+        *pIface = iface;
+    }
+    return 0;
+}
+
+/* Adds the interfaces named in DHCP_LEASE_ENGINE_IFACES, comma separated */
+static void add_env_ifaces( void )
+{
+    const char *pList = getenv(DHCP_LEASE_ENGINE_IFACES_ENV);
+    char name[DHCP_LEASE_IFNAME_LEN];
+    size_t length;
+
+    while (pList != NULL && *pList != '\0')
+    {
+        length = strcspn(pList, ",");
+        if (length > 0 && length < sizeof(name))
+        {
+            memcpy(name, pList, length);
+            name[length] = '\0';
+            add_locked(name, NULL);
+        }
+        pList += length;
+        pList += (*pList == ',');
+    }
+}
+
+static void engine_init( void )
+{
+    const char *pAutoRenew = getenv("DHCP_LEASE_ENGINE_AUTO_RENEW");
+    dhcp_lease_t lease;
+    int i;
+    int j;
+
+    if (pAutoRenew != NULL)
+    {
+        gAutoRenew = atoi(pAutoRenew) != 0;
+    }
+    dhcp_timer_wheel_init(&gWheel, ENGINE_TICK_NS, dhcp_lease_engine_now_ns());
+    gChangedMask = 0;
+    memset(&gTable, 0, sizeof(gTable));
+    for (i = 0; i < DHCP_LEASE_MAX_IFACES; i++)
+    {
+        for (j = 0; j < ENGINE_TIMER_MAX; j++)
+        {
+            dhcp_timer_init(&gTimers[i][j], timer_fired, NULL);
+        }
+    }
+    gTable.count = DHCP_LEASE_IF_MAX;
+    for (i = 0; i < DHCP_LEASE_IF_MAX; i++)
+    {
+        default_lease((dhcp_lease_if_t)i, &lease);
+        bind_locked((dhcp_lease_if_t)i, &lease);
+    }
+    add_env_ifaces();
+}
+
+/* Takes gEngineLock and fires the lease timers due at the engine time, returned in pNowNs */
+static void engine_lock( uint64_t *pNowNs )
+{
+    pthread_once(&gEngineOnce, engine_init);
+    pthread_mutex_lock(&gEngineLock);
+    *pNowNs = dhcp_lease_engine_now_ns();
+    gTimerNowNs = *pNowNs;
+    dhcp_timer_wheel_advance(&gWheel, *pNowNs);
+}
+
+static uint32_t remaining_sec( uint64_t deadline_ns, uint64_t now_ns )
+{
+    return (deadline_ns > now_ns) ? (uint32_t)((deadline_ns - now_ns) / NSEC_PER_SEC) : 0;
+}
+
+/* Called unlocked, after the change, so that subscribers reading the lease see it */
+static void announce( dhcp_lease_if_t iface )
+{
+    dhcp_lease_timers_t timers;
+    dhcp_lease_t lease;
+
+    if ((unsigned)iface < DHCP_LEASE_IF_MAX && dhcp_lease_engine_snapshot(iface, &lease, &timers, NULL) == 0)
+    {
+        dhcp_lease_notify_publish(iface, timers.fsm_state, lease.bound ? lease.ip_addr : 0);
+    }
+}
+
+/* Drops gEngineLock, then announces the interfaces whose state a lease timer changed */
+static void engine_leave( void )
+{
+    uint32_t changed = gChangedMask;
+    int i;
+
+    gChangedMask = 0;
+    pthread_mutex_unlock(&gEngineLock);
+    for (i = 0; i < DHCP_LEASE_IF_MAX; i++)
+    {
+        if (changed & (1U << i))
+        {
+            announce((dhcp_lease_if_t)i);
+        }
+    }
+}
+
+/* As engine_lock, for a call on one interface; -1, unlocked, if there is no such interface */
+static int engine_enter( dhcp_lease_if_t iface, uint64_t *pNowNs )
+{
+    engine_lock(pNowNs);
+    if ((unsigned)iface >= gTable.count)
+    {
+        engine_leave();
+        return -1;
+    }
+    return 0;
+}
+
+uint64_t dhcp_lease_engine_now_ns( void )
+{
+    return monotonic_ns() + __atomic_load_n(&gClockOffsetNs, __ATOMIC_RELAXED);
+}
+
+void dhcp_lease_apply_defaults( dhcp_lease_t *pLease )
+{
+    if (pLease->lease_time == DHCP_LEASE_INFINITE)
+    {
+        return;
+    }
+    if (pLease->renew_time == 0 || pLease->renew_time > pLease->lease_time)
+    {
+        pLease->renew_time = pLease->lease_time / 2;
+    }
+    if (pLease->rebind_time == 0 || pLease->rebind_time > pLease->lease_time)
+    {
+        pLease->rebind_time = (uint32_t)(((uint64_t)pLease->lease_time * 7) / 8);
+    }
+    if (pLease->rebind_time < pLease->renew_time)
+    {
+        pLease->rebind_time = pLease->renew_time;
+    }
+}
+
+/* dhcp_lease_eval() on the fields it reads, so that it runs on a row of the table as well */
+static void eval_times( int bound, uint64_t bound_ns, uint32_t lease_time, uint32_t renew_time, uint32_t rebind_time,
+                        uint64_t now_ns, int auto_renew, dhcp_lease_timers_t *pTimers )
+{
+    uint64_t start_ns;
+    uint64_t t1_ns;
+
+    memset(pTimers, 0, sizeof(*pTimers));
+    pTimers->fsm_state = DHCP_LEASE_FSM_INIT;
+    if (!bound)
+    {
+        return;
+    }
+
+    if (lease_time == DHCP_LEASE_INFINITE)
+    {
+        pTimers->remain_lease = DHCP_LEASE_INFINITE;
+        pTimers->remain_renew = DHCP_LEASE_INFINITE;
+        pTimers->remain_rebind = DHCP_LEASE_INFINITE;
+        pTimers->fsm_state = DHCP_LEASE_FSM_BOUND;
+        return;
+    }
+
+    /* A server that always renews at T1 restarts the lease every T1 seconds */
+    start_ns = bound_ns;
+    t1_ns = (uint64_t)renew_time * NSEC_PER_SEC;
+    if (auto_renew && t1_ns > 0 && now_ns >= start_ns + t1_ns)
+    {
+        start_ns += ((now_ns - start_ns) / t1_ns) * t1_ns;
+    }
+
+    pTimers->remain_lease = remaining_sec(start_ns + (uint64_t)lease_time * NSEC_PER_SEC, now_ns);
+    pTimers->remain_rebind = remaining_sec(start_ns + (uint64_t)rebind_time * NSEC_PER_SEC, now_ns);
+    pTimers->remain_renew = remaining_sec(start_ns + t1_ns, now_ns);
+
+    if (now_ns < start_ns + t1_ns)
+    {
+        pTimers->fsm_state = DHCP_LEASE_FSM_BOUND;
+    }
+    else if (pTimers->remain_rebind > 0)
+    {
+        pTimers->fsm_state = DHCP_LEASE_FSM_RENEWING;
+    }
+    else if (pTimers->remain_lease > 0)
+    {
+        pTimers->fsm_state = DHCP_LEASE_FSM_REBINDING;
+    }
+}
+
+void dhcp_lease_eval( const dhcp_lease_t *pLease, uint64_t now_ns, int auto_renew, dhcp_lease_timers_t *pTimers )
+{
+    eval_times(pLease->bound, pLease->bound_ns, pLease->lease_time, pLease->renew_time, pLease->rebind_time, now_ns, auto_renew, pTimers);
+}
+
+/* Caller holds gEngineLock */
+static void eval_locked( dhcp_lease_if_t iface, uint64_t now_ns, dhcp_lease_timers_t *pTimers )
+{
+    eval_times(gTable.bound[iface], gTable.bound_ns[iface], gTable.lease_time[iface], gTable.renew_time[iface],
+               gTable.rebind_time[iface], now_ns, __atomic_load_n(&gAutoRenew, __ATOMIC_RELAXED), pTimers);
+}
+
+/* The fields derived from the timers; 0 for any other */
+static uint32_t timer_field( const dhcp_lease_timers_t *pTimers, dhcp_lease_field_t field )
+{
+    switch (field)
+    {
+        case DHCP_LEASE_FIELD_REMAIN_LEASE:    return pTimers->remain_lease;
+        case DHCP_LEASE_FIELD_REMAIN_RENEW:    return pTimers->remain_renew;
+        case DHCP_LEASE_FIELD_REMAIN_REBIND:   return pTimers->remain_rebind;
+        case DHCP_LEASE_FIELD_FSM_STATE:       return (uint32_t)pTimers->fsm_state;
+        default:                               return 0;
+    }
+}
+
+uint32_t dhcp_lease_field_value( const dhcp_lease_t *pLease, const dhcp_lease_timers_t *pTimers, dhcp_lease_field_t field )
+{
+    switch (field)
+    {
+        case DHCP_LEASE_FIELD_LEASE_TIME:      return pLease->lease_time;
+        case DHCP_LEASE_FIELD_CONFIG_ATTEMPTS: return (uint32_t)pLease->config_attempts;
+        case DHCP_LEASE_FIELD_IP_ADDR:         return pLease->ip_addr;
+        case DHCP_LEASE_FIELD_MASK:            return pLease->mask;
+        case DHCP_LEASE_FIELD_GW:              return pLease->gw;
+        case DHCP_LEASE_FIELD_DHCP_SVR:        return pLease->dhcp_svr;
+        default:                               return timer_field(pTimers, field);
+    }
+}
+
+/* Caller holds gEngineLock; the column holding a field, or NULL for one derived from the timers */
+static const uint32_t *column_locked( dhcp_lease_field_t field )
+{
+    switch (field)
+    {
+        case DHCP_LEASE_FIELD_LEASE_TIME:      return gTable.lease_time;
+        case DHCP_LEASE_FIELD_CONFIG_ATTEMPTS: return (const uint32_t *)gTable.config_attempts;
+        case DHCP_LEASE_FIELD_IP_ADDR:         return gTable.ip_addr;
+        case DHCP_LEASE_FIELD_MASK:            return gTable.mask;
+        case DHCP_LEASE_FIELD_GW:              return gTable.gw;
+        case DHCP_LEASE_FIELD_DHCP_SVR:        return gTable.dhcp_svr;
+        default:                               return NULL;
+    }
+}
+
+int dhcp_lease_engine_get( dhcp_lease_if_t iface, dhcp_lease_t *pLease )
+{
+    uint64_t now_ns;
+
+    if (pLease == NULL || engine_enter(iface, &now_ns) != 0)
+    {
+        return -1;
+    }
+    load_locked(iface, pLease);
+    engine_leave();
+    return 0;
+}
+
+int dhcp_lease_engine_timers( dhcp_lease_if_t iface, dhcp_lease_timers_t *pTimers )
+{
+    uint64_t now_ns;
+
+    if (pTimers == NULL || engine_enter(iface, &now_ns) != 0)
+    {
+        return -1;
+    }
+    eval_locked(iface, now_ns, pTimers);
+    engine_leave();
+    return 0;
+}
+
+int dhcp_lease_engine_snapshot( dhcp_lease_if_t iface, dhcp_lease_t *pLease, dhcp_lease_timers_t *pTimers, uint64_t *pNowNs )
+{
+    uint64_t now_ns;
+
+    if (pLease == NULL || pTimers == NULL || engine_enter(iface, &now_ns) != 0)
+    {
+        return -1;
+    }
+    load_locked(iface, pLease);
+    eval_locked(iface, now_ns, pTimers);
+    engine_leave();
+    if (pNowNs != NULL)
+    {
+        *pNowNs = now_ns;
+    }
+    return 0;
+}
+
+int dhcp_lease_engine_field( dhcp_lease_if_t iface, dhcp_lease_field_t field, uint32_t *pValue )
+{
+    const uint32_t *pColumn;
+    dhcp_lease_timers_t timers;
+    uint64_t now_ns;
+
+    if (pValue == NULL || (unsigned)field >= DHCP_LEASE_FIELD_MAX || engine_enter(iface, &now_ns) != 0)
+    {
+        return -1;
+    }
+    pColumn = column_locked(field);
+    if (pColumn != NULL)
+    {
+        *pValue = pColumn[iface];
+    }
+    else
+    {
+        eval_locked(iface, now_ns, &timers);
+        *pValue = timer_field(&timers, field);
+    }
+    engine_leave();
+    return 0;
+}
+
+int dhcp_lease_engine_scan( dhcp_lease_field_t field, uint32_t first, uint32_t count, uint32_t *pValues )
+{
+    const uint32_t *pColumn;
+    dhcp_lease_timers_t timers;
+    uint64_t now_ns;
+    uint32_t i;
+
+    if (pValues == NULL || (unsigned)field >= DHCP_LEASE_FIELD_MAX)
+    {
+        return -1;
+    }
+    engine_lock(&now_ns);
+    if (first > gTable.count)
+    {
+        engine_leave();
+        return -1;
+    }
+    if (count > gTable.count - first)
+    {
+        count = gTable.count - first;
+    }
+    pColumn = column_locked(field);
+    if (pColumn != NULL)
+    {
+        memcpy(pValues, &pColumn[first], (size_t)count * sizeof(uint32_t));
+    }
+    else
+    {
+        for (i = 0; i < count; i++)
+        {
+            eval_locked((dhcp_lease_if_t)(first + i), now_ns, &timers);
+            pValues[i] = timer_field(&timers, field);
+        }
+    }
+    engine_leave();
+    return (int)count;
+}
+
+uint32_t dhcp_lease_engine_iface_count( void )
+{
+    uint32_t count;
+
+    pthread_once(&gEngineOnce, engine_init);
+    pthread_mutex_lock(&gEngineLock);
+    count = gTable.count;
+    pthread_mutex_unlock(&gEngineLock);
+    return count;
+}
+
+int dhcp_lease_engine_add_iface( const char *pIfname, dhcp_lease_if_t *pIface )
+{
+    uint64_t now_ns;
+    int status;
+
+    if (pIfname == NULL)
+    {
+        return -1;
+    }
+    engine_lock(&now_ns);
+    status = add_locked(pIfname, pIface);
+    engine_leave();
+    return status;
+}
+
+int dhcp_lease_engine_find_iface( const char *pIfname, dhcp_lease_if_t *pIface )
+{
+    int index;
+
+    if (pIfname == NULL || pIface == NULL)
+    {
+        return -1;
+    }
+    pthread_once(&gEngineOnce, engine_init);
+    pthread_mutex_lock(&gEngineLock);
+    index = find_locked(pIfname);
+    pthread_mutex_unlock(&gEngineLock);
+    if (index < 0)
+    {
+        return -1;
+    }
+    *pIface = (dhcp_lease_if_t)index;
+    return 0;
+}
+
+int dhcp_lease_engine_bind( dhcp_lease_if_t iface, const dhcp_lease_t *pLease )
+{
+    uint64_t now_ns;
+
+    if (pLease == NULL || engine_enter(iface, &now_ns) != 0)
+    {
+        return -1;
+    }
+    bind_locked(iface, pLease);
+    if ((unsigned)iface < DHCP_LEASE_IF_MAX)
+    {
+        gChangedMask &= ~(1U << iface);
+    }
+    engine_leave();
+    announce(iface);
+    return 0;
+}
+
+int dhcp_lease_engine_release( dhcp_lease_if_t iface )
+{
+    dhcp_lease_t lease;
+    uint64_t now_ns;
+
+    if (engine_enter(iface, &now_ns) != 0)
+    {
+        return -1;
+    }
+    memset(&lease, 0, sizeof(lease));
+    memcpy(lease.ifname, gTable.ifname[iface], sizeof(lease.ifname));
+    store_locked(iface, &lease);
+    schedule_locked(iface);
+    if ((unsigned)iface < DHCP_LEASE_IF_MAX)
+    {
+        gChangedMask &= ~(1U << iface);
+    }
+    engine_leave();
+    announce(iface);
+    return 0;
+}
+
+void dhcp_lease_engine_reset( void )
+{
+    int i;
+
+    pthread_once(&gEngineOnce, engine_init);
+    pthread_mutex_lock(&gEngineLock);
+    __atomic_store_n(&gClockOffsetNs, 0, __ATOMIC_RELAXED);
+    engine_init();
+    pthread_mutex_unlock(&gEngineLock);
+    for (i = 0; i < DHCP_LEASE_IF_MAX; i++)
+    {
+        announce((dhcp_lease_if_t)i);
+    }
+}
+
+void dhcp_lease_engine_set_auto_renew( int enable )
+{
+    pthread_once(&gEngineOnce, engine_init);
+    __atomic_store_n(&gAutoRenew, enable != 0, __ATOMIC_RELAXED);
+}
+
+void dhcp_lease_engine_advance( uint32_t seconds )
+{
+    __atomic_add_fetch(&gClockOffsetNs, (uint64_t)seconds * NSEC_PER_SEC, __ATOMIC_RELAXED);
+    dhcp_lease_engine_run_timers();
+    /* A timer rounded up to the next tick is left to the notification thread, which slept on the old clock */
+    dhcp_lease_notify_wake();
+}
+
+void dhcp_lease_engine_run_timers( void )
+{
+    uint64_t now_ns;
+
+    engine_lock(&now_ns);
+    engine_leave();
+}
+
+uint64_t dhcp_lease_engine_next_timer_ns( void )
+{
+    uint64_t next_ns;
+
+    pthread_once(&gEngineOnce, engine_init);
+    pthread_mutex_lock(&gEngineLock);
+    next_ns = gWheel.next_ns;
+    pthread_mutex_unlock(&gEngineLock);
+    return next_ns;
+}
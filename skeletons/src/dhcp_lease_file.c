@@ -0,0 +1,483 @@
+/*
+* If not stated otherwise in this file or this component's LICENSE file the
+* following copyright and licenses apply:*
+* Copyright 2023 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#include <string.h>
+#include <time.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "dhcp_lease_file.h"
+
+#define NSEC_PER_SEC  1000000000LL
+
+typedef enum
+{
+    LEASE_KEY_IFNAME,
+    LEASE_KEY_IP,
+    LEASE_KEY_MASK,
+    LEASE_KEY_ROUTER,
+    LEASE_KEY_DNS,
+    LEASE_KEY_SERVER,
+    LEASE_KEY_LEASE,
+    LEASE_KEY_RENEW,
+    LEASE_KEY_REBIND,
+    LEASE_KEY_RENEW_HEX,
+    LEASE_KEY_REBIND_HEX
+} lease_key_t;
+
+/* udhcpc environment names first, then their dhclient lease file equivalents */
+static const struct
+{
+    const char *pName;
+    lease_key_t key;
+} gLeaseKeys[] =
+{
+    { "interface", LEASE_KEY_IFNAME },
+    { "ip", LEASE_KEY_IP },
+    { "subnet", LEASE_KEY_MASK },
+    { "router", LEASE_KEY_ROUTER },
+    { "dns", LEASE_KEY_DNS },
+    { "serverid", LEASE_KEY_SERVER },
+    { "lease", LEASE_KEY_LEASE },
+    { "opt58", LEASE_KEY_RENEW_HEX },       /* udhcpc exports options it has no name for in hex */
+    { "opt59", LEASE_KEY_REBIND_HEX },
+    { "fixed-address", LEASE_KEY_IP },
+    { "subnet-mask", LEASE_KEY_MASK },
+    { "routers", LEASE_KEY_ROUTER },
+    { "domain-name-servers", LEASE_KEY_DNS },
+    { "dhcp-server-identifier", LEASE_KEY_SERVER },
+    { "dhcp-lease-time", LEASE_KEY_LEASE },
+    { "dhcp-renewal-time", LEASE_KEY_RENEW },
+    { "dhcp-rebinding-time", LEASE_KEY_REBIND },
+};
+
+/* The last file read by dhcp_lease_file_read() and what identified it */
+static pthread_mutex_t gFileLock = PTHREAD_MUTEX_INITIALIZER;
+static struct
+{
+    int valid;
+    int status;
+    char path[PATH_MAX];
+    dev_t dev;
+    ino_t ino;
+    off_t size;
+    struct timespec mtime;
+    struct timespec ctime;
+    dhcp_lease_t lease;
+} gCache;
+static uint32_t gParseCount = 0;
+
+static int is_space( char c )
+{
+    return c == ' ' || c == '\t' || c == '\r';
+}
+
+static const char *skip_space( const char *p, const char *pEnd )
+{
+    while (p < pEnd && is_space(*p))
+    {
+        p++;
+    }
+    return p;
+}
+
+/* Matches a whole word followed by white space */
+static int starts_with_word( const char *p, const char *pEnd, const char *pWord )
+{
+    size_t length = strlen(pWord);
+
+    return (size_t)(pEnd - p) > length && memcmp(p, pWord, length) == 0 && is_space(p[length]);
+}
+
+static const char *parse_u32( const char *p, const char *pEnd, uint32_t *pValue )
+{
+    uint64_t value = 0;
+    const char *pStart = p;
+
+    while (p < pEnd && *p >= '0' && *p <= '9')
+    {
+        value = value * 10 + (uint64_t)(*p - '0');
+        if (value > 0xFFFFFFFFULL)
+        {
+            return NULL;
+        }
+        p++;
+    }
+    if (p == pStart)
+    {
+        return NULL;
+    }
+    *pValue = (uint32_t)value;
+    return p;
+}
+
+static const char *parse_hex_u32( const char *p, const char *pEnd, uint32_t *pValue )
+{
+    uint32_t value = 0;
+    int digits = 0;
+    int nibble;
+
+    while (p < pEnd && digits < 8)
+    {
+        if (*p >= '0' && *p <= '9')
+        {
+            nibble = *p - '0';
+        }
+        else if (*p >= 'a' && *p <= 'f')
+        {
+            nibble = *p - 'a' + 10;
+        }
+        else if (*p >= 'A' && *p <= 'F')
+        {
+            nibble = *p - 'A' + 10;
+        }
+        else
+        {
+            break;
+        }
+        value = (value << 4) | (uint32_t)nibble;
+        digits++;
+        p++;
+    }
+    if (digits == 0)
+    {
+        return NULL;
+    }
+    *pValue = value;
+    return p;
+}
+
+/* Dotted quad to network byte order; returns the first unparsed character or NULL */
+static const char *parse_ipv4( const char *p, const char *pEnd, uint32_t *pAddr )
+{
+    unsigned char octets[4];
+    unsigned int value;
+    int digits;
+    int i;
+
+    for (i = 0; i < 4; i++)
+    {
+        if (i > 0)
+        {
+            if (p >= pEnd || *p != '.')
+            {
+                return NULL;
+            }
+            p++;
+        }
+        value = 0;
+        digits = 0;
+        while (p < pEnd && *p >= '0' && *p <= '9' && digits < 3)
+        {
+            value = value * 10 + (unsigned int)(*p - '0');
+            p++;
+            digits++;
+        }
+        if (digits == 0 || value > 255)
+        {
+            return NULL;
+        }
+        octets[i] = (unsigned char)value;
+    }
+    if (p < pEnd && *p >= '0' && *p <= '9')
+    {
+        return NULL;
+    }
+    memcpy(pAddr, octets, sizeof(octets));
+    return p;
+}
+
+static void reset_lease( dhcp_lease_t *pLease )
+{
+    memset(pLease, 0, sizeof(*pLease));
+    pLease->config_attempts = 1;
+}
+
+void dhcp_lease_file_parse_line( const char *pLine, size_t length, dhcp_lease_t *pLease )
+{
+    const char *pEnd = pLine + length;
+    const char *p = skip_space(pLine, pEnd);
+    const char *pKey;
+    size_t keyLength;
+    uint32_t addr;
+    size_t i;
+
+    while (pEnd > p && (is_space(pEnd[-1]) || pEnd[-1] == ';'))
+    {
+        pEnd--;
+    }
+    if (p == pEnd || *p == '#')
+    {
+        return;
+    }
+    if (starts_with_word(p, pEnd, "export"))
+    {
+        p = skip_space(p + strlen("export"), pEnd);
+    }
+    else if (starts_with_word(p, pEnd, "option"))
+    {
+        p = skip_space(p + strlen("option"), pEnd);
+    }
+
+    pKey = p;
+    while (p < pEnd && *p != '=' && !is_space(*p))
+    {
+        p++;
+    }
+    keyLength = (size_t)(p - pKey);
+    p = skip_space(p, pEnd);
+    if (p < pEnd && *p == '=')
+    {
+        p = skip_space(p + 1, pEnd);
+    }
+    if (pEnd - p >= 2 && (*p == '\'' || *p == '"') && pEnd[-1] == *p)
+    {
+        p++;
+        pEnd--;
+    }
+
+    /* "lease {" opens a dhclient lease block, which replaces any earlier one */
+    if (keyLength == strlen("lease") && memcmp(pKey, "lease", keyLength) == 0 && p < pEnd && *p == '{')
+    {
+        reset_lease(pLease);
+        return;
+    }
+
+    for (i = 0; i < sizeof(gLeaseKeys) / sizeof(gLeaseKeys[0]); i++)
+    {
+        if (strlen(gLeaseKeys[i].pName) == keyLength && memcmp(gLeaseKeys[i].pName, pKey, keyLength) == 0)
+        {
+            break;
+        }
+    }
+    if (i == sizeof(gLeaseKeys) / sizeof(gLeaseKeys[0]))
+    {
+        return;
+    }
+
+    switch (gLeaseKeys[i].key)
+    {
+        case LEASE_KEY_IFNAME:
+            length = (size_t)(pEnd - p);
+            if (length >= sizeof(pLease->ifname))
+            {
+                length = sizeof(pLease->ifname) - 1;
+            }
+            memcpy(pLease->ifname, p, length);
+            pLease->ifname[length] = '\0';
+            break;
+        case LEASE_KEY_IP:
+            (void)parse_ipv4(p, pEnd, &pLease->ip_addr);
+            break;
+        case LEASE_KEY_MASK:
+            (void)parse_ipv4(p, pEnd, &pLease->mask);
+            break;
+        case LEASE_KEY_ROUTER:
+            /* Only the first router is reported */
+            (void)parse_ipv4(p, pEnd, &pLease->gw);
+            break;
+        case LEASE_KEY_DNS:
+            pLease->dns_count = 0;
+            while (pLease->dns_count < DHCP_LEASE_MAX_DNS)
+            {
+                while (p < pEnd && (is_space(*p) || *p == ','))
+                {
+                    p++;
+                }
+                p = parse_ipv4(p, pEnd, &addr);
+                if (p == NULL)
+                {
+                    break;
+                }
+                pLease->dns_svrs[pLease->dns_count++] = addr;
+            }
+            break;
+        case LEASE_KEY_SERVER:
+            (void)parse_ipv4(p, pEnd, &pLease->dhcp_svr);
+            break;
+        case LEASE_KEY_LEASE:
+            (void)parse_u32(p, pEnd, &pLease->lease_time);
+            break;
+        case LEASE_KEY_RENEW:
+            (void)parse_u32(p, pEnd, &pLease->renew_time);
+            break;
+        case LEASE_KEY_REBIND:
+            (void)parse_u32(p, pEnd, &pLease->rebind_time);
+            break;
+        case LEASE_KEY_RENEW_HEX:
+            (void)parse_hex_u32(p, pEnd, &pLease->renew_time);
+            break;
+        case LEASE_KEY_REBIND_HEX:
+            (void)parse_hex_u32(p, pEnd, &pLease->rebind_time);
+            break;
+    }
+}
+
+int dhcp_lease_file_parse( const char *pText, size_t length, dhcp_lease_t *pLease )
+{
+    const char *pEnd = pText + length;
+    const char *pLine = pText;
+    const char *pNewline;
+
+    reset_lease(pLease);
+    while (pLine < pEnd)
+    {
+        pNewline = memchr(pLine, '\n', (size_t)(pEnd - pLine));
+        if (pNewline == NULL)
+        {
+            pNewline = pEnd;
+        }
+        dhcp_lease_file_parse_line(pLine, (size_t)(pNewline - pLine), pLease);
+        pLine = pNewline + 1;
+    }
+    if (pLease->ip_addr == 0)
+    {
+        return -1;
+    }
+    dhcp_lease_apply_defaults(pLease);
+    pLease->bound = 1;
+    return 0;
+}
+
+static int same_time( const struct timespec *pA, const struct timespec *pB )
+{
+    return pA->tv_sec == pB->tv_sec && pA->tv_nsec == pB->tv_nsec;
+}
+
+/* Caller holds gFileLock */
+static int cache_matches_locked( const char *pPath, const struct stat *pStat )
+{
+    return gCache.valid && gCache.dev == pStat->st_dev && gCache.ino == pStat->st_ino && gCache.size == pStat->st_size &&
+           same_time(&gCache.mtime, &pStat->st_mtim) && same_time(&gCache.ctime, &pStat->st_ctim) && strcmp(gCache.path, pPath) == 0;
+}
+
+/* Caller holds gFileLock */
+static void load_locked( const char *pPath )
+{
+    struct stat st;
+    void *pMap;
+    int fd;
+
+    gCache.valid = 0;
+    gCache.status = -1;
+    if (strlen(pPath) >= sizeof(gCache.path))
+    {
+        return;
+    }
+    fd = open(pPath, O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+    {
+        return;
+    }
+    if (fstat(fd, &st) != 0)
+    {
+        close(fd);
+        return;
+    }
+
+    /* The identity recorded is that of the file actually parsed */
+    if (st.st_size > 0)
+    {
+        pMap = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (pMap == MAP_FAILED)
+        {
+            close(fd);
+            return;
+        }
+        gCache.status = dhcp_lease_file_parse((const char *)pMap, (size_t)st.st_size, &gCache.lease);
+        munmap(pMap, (size_t)st.st_size);
+    }
+    else
+    {
+        gCache.status = dhcp_lease_file_parse("", 0, &gCache.lease);
+    }
+    close(fd);
+
+    strcpy(gCache.path, pPath);
+    gCache.dev = st.st_dev;
+    gCache.ino = st.st_ino;
+    gCache.size = st.st_size;
+    gCache.mtime = st.st_mtim;
+    gCache.ctime = st.st_ctim;
+    gCache.valid = 1;
+    gParseCount++;
+}
+
+/* Nanoseconds since the lease file was written, 0 if it is dated in the future */
+static uint64_t lease_age_ns( const struct timespec *pMtime )
+{
+    struct timespec now;
+    int64_t age;
+
+    clock_gettime(CLOCK_REALTIME, &now);
+    age = (int64_t)(now.tv_sec - pMtime->tv_sec) * NSEC_PER_SEC + (now.tv_nsec - pMtime->tv_nsec);
+    return (age > 0) ? (uint64_t)age : 0;
+}
+
+int dhcp_lease_file_read( const char *pPath, dhcp_lease_t *pLease, dhcp_lease_timers_t *pTimers )
+{
+    struct timespec mtime;
+    struct stat st;
+    int status;
+
+    if (pPath == NULL || pLease == NULL || stat(pPath, &st) != 0)
+    {
+        return -1;
+    }
+
+    pthread_mutex_lock(&gFileLock);
+    if (!cache_matches_locked(pPath, &st))
+    {
+        load_locked(pPath);
+    }
+    status = gCache.status;
+    *pLease = gCache.lease;
+    mtime = gCache.mtime;
+    pthread_mutex_unlock(&gFileLock);
+
+    if (status != 0)
+    {
+        return -1;
+    }
+    /* Evaluated with the lease bound at time 0, so "now" is the age of the file */
+    if (pTimers != NULL)
+    {
+        dhcp_lease_eval(pLease, lease_age_ns(&mtime), 0, pTimers);
+    }
+    return 0;
+}
+
+void dhcp_lease_file_invalidate( void )
+{
+    pthread_mutex_lock(&gFileLock);
+    gCache.valid = 0;
+    pthread_mutex_unlock(&gFileLock);
+}
+
+uint32_t dhcp_lease_file_parse_count( void )
+{
+    uint32_t count;
+
+    pthread_mutex_lock(&gFileLock);
+    count = gParseCount;
+    pthread_mutex_unlock(&gFileLock);
+    return count;
+}
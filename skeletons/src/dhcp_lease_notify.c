@@ -0,0 +1,498 @@
+/*
+* If not stated otherwise in this file or this component's LICENSE file the
+* following copyright and licenses apply:*
+* Copyright 2023 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <time.h>
+#include <limits.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <arpa/inet.h>
+#include <sys/eventfd.h>
+#include "dhcp_lease_notify.h"
+#include "dhcp_sysevent.h"
+
+typedef struct
+{
+    int                    used;
+    uint32_t               mask;
+    dhcp_lease_notify_cb_t callback;
+    void                  *pUserData;
+    int                    eventFd;         /* -1 for a callback subscription */
+} subscription_t;
+
+static const char * const gKeys[DHCP_LEASE_IF_MAX] =
+{
+    DHCP_LEASE_NOTIFY_KEY_ERT,
+    DHCP_LEASE_NOTIFY_KEY_ECM,
+    DHCP_LEASE_NOTIFY_KEY_EMTA
+};
+
+/* Subscriptions and the thread serving them */
+static pthread_mutex_t gLock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t gChanged = PTHREAD_COND_INITIALIZER;
+static subscription_t gSubs[DHCP_LEASE_NOTIFY_MAX];
+static uint32_t gSubCount;
+static int gRunning;
+static int gStopping;
+static pid_t gOwnerPid;                     /* A forked child inherits the state but not the thread */
+static pthread_t gThread;
+static int gDispatching = -1;               /* Subscription whose callback is running */
+static int gQueue[2] = { -1, -1 };          /* In-process announcements and wake-ups, to the thread */
+static dhcp_sysevent_t gEvents = { -1, 0, { 0 } };
+
+/* Connection announcements are set on when going through the stand-in */
+static pthread_mutex_t gPublishLock = PTHREAD_MUTEX_INITIALIZER;
+static dhcp_sysevent_t gPublisher = { -1, 0, { 0 } };
+static pid_t gPublisherPid;
+
+static uint64_t monotonic_ns( void )
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static const char *sysevent_path( void )
+{
+    const char *pPath = getenv(DHCP_SYSEVENT_ENV);
+
+    return (pPath != NULL && pPath[0] != '\0') ? pPath : NULL;
+}
+
+/* Caller holds gLock */
+static int on_thread( void )
+{
+    return gRunning && pthread_equal(pthread_self(), gThread);
+}
+
+/* Caller holds gLock; drops what a forked child inherited from its parent */
+static void forget_parent( void )
+{
+    int i;
+
+    if (!gRunning || gOwnerPid == getpid())
+    {
+        return;
+    }
+    for (i = 0; i < DHCP_LEASE_NOTIFY_MAX; i++)
+    {
+        if (gSubs[i].used && gSubs[i].eventFd >= 0)
+        {
+            close(gSubs[i].eventFd);
+        }
+    }
+    memset(gSubs, 0, sizeof(gSubs));
+    gSubCount = 0;
+    close(gQueue[0]);
+    close(gQueue[1]);
+    gQueue[0] = gQueue[1] = -1;
+    dhcp_sysevent_close(&gEvents);
+    gRunning = 0;
+    gStopping = 0;
+    gDispatching = -1;
+}
+
+static void dispatch( const dhcp_lease_event_t *pEvent )
+{
+    const uint64_t one = 1;
+    dhcp_lease_notify_cb_t callback;
+    void *pUserData;
+    ssize_t ignored;
+    int i;
+
+    pthread_mutex_lock(&gLock);
+    for (i = 0; i < DHCP_LEASE_NOTIFY_MAX; i++)
+    {
+        if (!gSubs[i].used || (gSubs[i].mask & (1U << pEvent->iface)) == 0)
+        {
+            continue;
+        }
+        if (gSubs[i].eventFd >= 0)
+        {
+            ignored = write(gSubs[i].eventFd, &one, sizeof(one));
+            (void)ignored;
+            continue;
+        }
+        /* Called unlocked, so that the callback may unsubscribe or read the lease */
+        callback = gSubs[i].callback;
+        pUserData = gSubs[i].pUserData;
+        gDispatching = i;
+        pthread_mutex_unlock(&gLock);
+        callback(pEvent, pUserData);
+        pthread_mutex_lock(&gLock);
+        gDispatching = -1;
+        pthread_cond_broadcast(&gChanged);
+    }
+    pthread_mutex_unlock(&gLock);
+}
+
+/* Milliseconds until the lease engine's next timer, -1 if none is armed */
+static int timer_wait_ms( void )
+{
+    uint64_t next_ns = dhcp_lease_engine_next_timer_ns();
+    uint64_t now_ns;
+    uint64_t wait_ms;
+
+    if (next_ns == UINT64_MAX)
+    {
+        return -1;
+    }
+    now_ns = dhcp_lease_engine_now_ns();
+    if (next_ns <= now_ns)
+    {
+        return 0;
+    }
+    wait_ms = (next_ns - now_ns + 999999ULL) / 1000000ULL;
+    return (wait_ms > INT_MAX) ? INT_MAX : (int)wait_ms;
+}
+
+static void *notify_thread( void *pArg )
+{
+    struct pollfd fds[2];
+    dhcp_lease_event_t event;
+    char key[DHCP_SYSEVENT_KEY_LEN];
+    char value[DHCP_SYSEVENT_VALUE_LEN];
+    int stop;
+
+    (void)pArg;
+    for (;;)
+    {
+        fds[0].fd = gQueue[0];
+        fds[0].events = POLLIN;
+        fds[0].revents = 0;
+        fds[1].fd = gEvents.fd;
+        fds[1].events = POLLIN;
+        fds[1].revents = 0;
+        if (!dhcp_sysevent_pending(&gEvents) && poll(fds, 2, timer_wait_ms()) < 0 && errno != EINTR)
+        {
+            fprintf(stderr, "dhcp_lease_notify: poll failed: %s\n", strerror(errno));
+            break;
+        }
+        /* Announces T1, T2 and expiry through the queue, read on the next pass */
+        dhcp_lease_engine_run_timers();
+        if ((fds[0].revents & POLLIN) && read(gQueue[0], &event, sizeof(event)) == (ssize_t)sizeof(event) &&
+            (unsigned)event.iface < DHCP_LEASE_IF_MAX)
+        {
+            dispatch(&event);
+        }
+        if (gEvents.fd >= 0 && (dhcp_sysevent_pending(&gEvents) || fds[1].revents != 0))
+        {
+            if (dhcp_sysevent_next(&gEvents, key, value) != 0)
+            {
+                fprintf(stderr, "dhcp_lease_notify: the sysevent daemon went away, no more lease events\n");
+                dhcp_sysevent_close(&gEvents);
+            }
+            else if (dhcp_lease_notify_parse(key, value, &event) == 0)
+            {
+                dispatch(&event);
+            }
+        }
+
+        pthread_mutex_lock(&gLock);
+        stop = gStopping;
+        if (stop)
+        {
+            close(gQueue[0]);
+            close(gQueue[1]);
+            gQueue[0] = gQueue[1] = -1;
+            dhcp_sysevent_close(&gEvents);
+            gRunning = 0;
+            gStopping = 0;
+            pthread_cond_broadcast(&gChanged);
+        }
+        pthread_mutex_unlock(&gLock);
+        if (stop)
+        {
+            break;
+        }
+    }
+    return NULL;
+}
+
+/* Caller holds gLock */
+static int start_thread( void )
+{
+    const char *pPath = sysevent_path();
+    int i;
+
+    if (pipe(gQueue) != 0)
+    {
+        return -1;
+    }
+    fcntl(gQueue[0], F_SETFD, FD_CLOEXEC);
+    fcntl(gQueue[1], F_SETFD, FD_CLOEXEC);
+    /* Announcing must never block on a thread that waits for gLock */
+    fcntl(gQueue[1], F_SETFL, O_NONBLOCK);
+
+    if (pPath != NULL)
+    {
+        for (i = 0; i < DHCP_LEASE_IF_MAX; i++)
+        {
+            if ((i == 0 && dhcp_sysevent_open(&gEvents, pPath) != 0) || dhcp_sysevent_notify(&gEvents, gKeys[i]) != 0)
+            {
+                fprintf(stderr, "dhcp_lease_notify: cannot subscribe at %s\n", pPath);
+                break;
+            }
+        }
+    }
+    if ((pPath != NULL && i < DHCP_LEASE_IF_MAX) || pthread_create(&gThread, NULL, notify_thread, NULL) != 0)
+    {
+        dhcp_sysevent_close(&gEvents);
+        close(gQueue[0]);
+        close(gQueue[1]);
+        gQueue[0] = gQueue[1] = -1;
+        return -1;
+    }
+    pthread_detach(gThread);
+    gRunning = 1;
+    gOwnerPid = getpid();
+    return 0;
+}
+
+static int subscribe( uint32_t ifaceMask, dhcp_lease_notify_cb_t callback, void *pUserData, int eventFd, int *pHandle )
+{
+    int i;
+
+    pthread_mutex_lock(&gLock);
+    forget_parent();
+    /* The last unsubscribe may still be stopping the thread; from its own callback, keep it instead */
+    if (gStopping && on_thread())
+    {
+        gStopping = 0;
+    }
+    while (gStopping)
+    {
+        pthread_cond_wait(&gChanged, &gLock);
+    }
+    for (i = 0; i < DHCP_LEASE_NOTIFY_MAX && gSubs[i].used; i++)
+    {
+    }
+    if (i == DHCP_LEASE_NOTIFY_MAX || (!gRunning && start_thread() != 0))
+    {
+        pthread_mutex_unlock(&gLock);
+        return -1;
+    }
+    gSubs[i].used = 1;
+    gSubs[i].mask = ifaceMask;
+    gSubs[i].callback = callback;
+    gSubs[i].pUserData = pUserData;
+    gSubs[i].eventFd = eventFd;
+    gSubCount++;
+    pthread_mutex_unlock(&gLock);
+    *pHandle = i;
+    return 0;
+}
+
+int dhcp_lease_notify_subscribe( uint32_t ifaceMask, dhcp_lease_notify_cb_t callback, void *pUserData, int *pHandle )
+{
+    if ((ifaceMask & ((1U << DHCP_LEASE_IF_MAX) - 1)) == 0 || callback == NULL || pHandle == NULL)
+    {
+        return -1;
+    }
+    return subscribe(ifaceMask, callback, pUserData, -1, pHandle);
+}
+
+int dhcp_lease_notify_subscribe_fd( uint32_t ifaceMask, int *pHandle, int *pFd )
+{
+    int fd;
+
+    if ((ifaceMask & ((1U << DHCP_LEASE_IF_MAX) - 1)) == 0 || pHandle == NULL || pFd == NULL)
+    {
+        return -1;
+    }
+    fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (fd < 0)
+    {
+        return -1;
+    }
+    if (subscribe(ifaceMask, NULL, NULL, fd, pHandle) != 0)
+    {
+        close(fd);
+        return -1;
+    }
+    *pFd = fd;
+    return 0;
+}
+
+int dhcp_lease_notify_unsubscribe( int handle, void **ppUserData )
+{
+    dhcp_lease_event_t wake;
+    ssize_t ignored;
+    int fd;
+
+    pthread_mutex_lock(&gLock);
+    forget_parent();
+    if (handle < 0 || handle >= DHCP_LEASE_NOTIFY_MAX || !gSubs[handle].used)
+    {
+        pthread_mutex_unlock(&gLock);
+        return -1;
+    }
+    fd = gSubs[handle].eventFd;
+    if (ppUserData != NULL)
+    {
+        *ppUserData = gSubs[handle].pUserData;
+    }
+    memset(&gSubs[handle], 0, sizeof(gSubs[handle]));
+    while (gDispatching == handle && !on_thread())
+    {
+        pthread_cond_wait(&gChanged, &gLock);
+    }
+    if (--gSubCount == 0 && gRunning)
+    {
+        gStopping = 1;
+        memset(&wake, 0, sizeof(wake));
+        wake.iface = DHCP_LEASE_IF_MAX;
+        ignored = write(gQueue[1], &wake, sizeof(wake));
+        (void)ignored;
+        while (gStopping && !on_thread())
+        {
+            pthread_cond_wait(&gChanged, &gLock);
+        }
+    }
+    pthread_mutex_unlock(&gLock);
+    if (fd >= 0)
+    {
+        close(fd);
+    }
+    return 0;
+}
+
+/* Caller holds gPublishLock */
+static int publish_sysevent( const char *pPath, const dhcp_lease_event_t *pEvent )
+{
+    char value[DHCP_SYSEVENT_VALUE_LEN];
+    int attempt;
+
+    if (gPublisher.fd >= 0 && gPublisherPid != getpid())
+    {
+        dhcp_sysevent_close(&gPublisher);
+    }
+    dhcp_lease_notify_format(pEvent, value, sizeof(value));
+    /* A second attempt on a new connection covers a daemon restarted since the last one */
+    for (attempt = 0; attempt < 2; attempt++)
+    {
+        if (gPublisher.fd < 0)
+        {
+            if (dhcp_sysevent_open(&gPublisher, pPath) != 0)
+            {
+                return -1;
+            }
+            gPublisherPid = getpid();
+        }
+        if (dhcp_sysevent_set(&gPublisher, gKeys[pEvent->iface], value) == 0)
+        {
+            return 0;
+        }
+        dhcp_sysevent_close(&gPublisher);
+    }
+    return -1;
+}
+
+void dhcp_lease_notify_wake( void )
+{
+    dhcp_lease_event_t wake;
+    ssize_t ignored;
+
+    pthread_mutex_lock(&gLock);
+    forget_parent();
+    if (gRunning && !gStopping)
+    {
+        memset(&wake, 0, sizeof(wake));
+        wake.iface = DHCP_LEASE_IF_MAX;
+        ignored = write(gQueue[1], &wake, sizeof(wake));
+        (void)ignored;
+    }
+    pthread_mutex_unlock(&gLock);
+}
+
+void dhcp_lease_notify_publish( dhcp_lease_if_t iface, int fsm_state, uint32_t ip_addr )
+{
+    const char *pPath = sysevent_path();
+    dhcp_lease_event_t event;
+    ssize_t ignored;
+
+    if ((unsigned)iface >= DHCP_LEASE_IF_MAX)
+    {
+        return;
+    }
+    memset(&event, 0, sizeof(event));
+    event.iface = iface;
+    event.fsm_state = fsm_state;
+    event.ip_addr = ip_addr;
+    event.timestamp_ns = monotonic_ns();
+
+    if (pPath != NULL)
+    {
+        pthread_mutex_lock(&gPublishLock);
+        if (publish_sysevent(pPath, &event) != 0)
+        {
+            fprintf(stderr, "dhcp_lease_notify: cannot announce %s at %s\n", gKeys[iface], pPath);
+        }
+        pthread_mutex_unlock(&gPublishLock);
+        return;
+    }
+
+    /* A full queue drops the event rather than wait for the thread */
+    pthread_mutex_lock(&gLock);
+    forget_parent();
+    if (gRunning && !gStopping)
+    {
+        ignored = write(gQueue[1], &event, sizeof(event));
+        (void)ignored;
+    }
+    pthread_mutex_unlock(&gLock);
+}
+
+void dhcp_lease_notify_format( const dhcp_lease_event_t *pEvent, char *pValue, size_t size )
+{
+    char ip_str[INET_ADDRSTRLEN];
+    struct in_addr addr;
+
+    addr.s_addr = pEvent->ip_addr;
+    inet_ntop(AF_INET, &addr, ip_str, sizeof(ip_str));
+    snprintf(pValue, size, "%d %s %llu", pEvent->fsm_state, ip_str, (unsigned long long)pEvent->timestamp_ns);
+}
+
+int dhcp_lease_notify_parse( const char *pKey, const char *pValue, dhcp_lease_event_t *pEvent )
+{
+    char ip_str[INET_ADDRSTRLEN];
+    unsigned long long timestamp_ns;
+    struct in_addr addr;
+    int fsm_state;
+    int i;
+
+    for (i = 0; i < DHCP_LEASE_IF_MAX && strcmp(pKey, gKeys[i]) != 0; i++)
+    {
+    }
+    if (i == DHCP_LEASE_IF_MAX || sscanf(pValue, "%d %15s %llu", &fsm_state, ip_str, &timestamp_ns) != 3 ||
+        inet_pton(AF_INET, ip_str, &addr) != 1)
+    {
+        return -1;
+    }
+    pEvent->iface = (dhcp_lease_if_t)i;
+    pEvent->fsm_state = fsm_state;
+    pEvent->ip_addr = addr.s_addr;
+    pEvent->timestamp_ns = (uint64_t)timestamp_ns;
+    return 0;
+}
@@ -0,0 +1,499 @@
+/*
+* If not stated otherwise in this file or this component's LICENSE file the
+* following copyright and licenses apply:*
+* Copyright 2023 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+/**
+* @file dhcp_lease_replay.c
+*
+* Replay of a getter trace, see dhcp_lease_replay.h.
+*
+* The whole file is read on the first call and its records are sorted into
+* one array of samples per interface and field, so that serving a getter is
+* a binary search on the time of the trace and a copy. A loaded trace is
+* never changed. One that is replaced, by a new DHCP_LEASE_REPLAY or by
+* dhcp_lease_replay_reset(), is kept until the process exits, since another
+* thread may still be serving a getter from it.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <limits.h>
+#include <pthread.h>
+#include "dhcp_lease_replay.h"
+
+#define REPLAY_SPIN_LIMIT_NS  200000ULL   /* Recorded durations below this are spun, longer ones slept */
+
+typedef char replay_header_size_check[(sizeof(dhcp_lease_replay_header_t) == 48) ? 1 : -1];
+
+typedef struct
+{
+    uint64_t timeUs;        /* From the start of the capture */
+    uint32_t durationNs;
+    int32_t  status;
+    uint32_t offset;        /* Of the output in the file contents */
+    uint32_t length;
+} replay_sample_t;
+
+typedef struct
+{
+    replay_sample_t *pSamples;
+    uint32_t count;
+} replay_channel_t;
+
+typedef struct
+{
+    char     path[PATH_MAX];
+    int      status;        /* 0 once the trace is loaded, -1 if it cannot be */
+    uint64_t startNs;       /* Engine time the trace started at */
+    uint64_t spanUs;        /* Last record plus one capture interval */
+    double   speed;
+    int      loop;
+    int      latency;
+    uint8_t *pData;
+    replay_sample_t *pSamples;
+    replay_channel_t channels[DHCP_LEASE_IF_MAX][DHCP_LEASE_REPLAY_ITEMS];
+} replay_t;
+
+static pthread_mutex_t gReplayLock = PTHREAD_MUTEX_INITIALIZER;
+static replay_t *gpReplay;
+
+static int env_flag( const char *pName )
+{
+    const char *pValue = getenv(pName);
+
+    return (pValue != NULL && strcmp(pValue, "1") == 0);
+}
+
+/* Addresses are in network order in every byte order; the other values are converted */
+static void swap_output( uint32_t item, uint8_t *pOutput, uint32_t length )
+{
+    uint32_t value;
+
+    if (item == DHCP_LEASE_FIELD_IP_ADDR || item == DHCP_LEASE_FIELD_MASK || item == DHCP_LEASE_FIELD_GW ||
+        item == DHCP_LEASE_FIELD_DHCP_SVR || item == DHCP_LEASE_REPLAY_IFNAME || length < sizeof(value))
+    {
+        return;
+    }
+    memcpy(&value, pOutput, sizeof(value));
+    value = __builtin_bswap32(value);
+    memcpy(pOutput, &value, sizeof(value));
+}
+
+/**
+* @brief Walks the records, counting samples per channel, or also storing them when pReplay->pSamples is set
+*
+* @return 0 on success, -1 on a malformed record; a record cut short by the end of the file ends the walk
+*/
+static int walk_records( replay_t *pReplay, const dhcp_lease_replay_channel_t *pChannels, uint32_t channelCount,
+                         const uint8_t *pRecords, const uint8_t *pEnd, int swapped, uint64_t *pLastUs )
+{
+    const uint8_t *pIn = pRecords;
+    uint64_t timeUs = 0;
+
+    while (pIn < pEnd)
+    {
+        replay_channel_t *pChannel;
+        replay_sample_t sample = { 0, 0, 0, 0, 0 };
+        uint64_t delta;
+        uint64_t duration;
+        uint64_t value;
+        uint32_t index = *pIn & ~DHCP_LEASE_REPLAY_SAME;
+        int same = (*pIn & DHCP_LEASE_REPLAY_SAME) != 0;
+
+        pIn++;
+        if (index >= channelCount)
+        {
+            return -1;
+        }
+        pChannel = &pReplay->channels[pChannels[index].iface][pChannels[index].item];
+        if (dhcp_lease_replay_get_varint(&pIn, pEnd, &delta) != 0 ||
+            dhcp_lease_replay_get_varint(&pIn, pEnd, &duration) != 0)
+        {
+            return 0;
+        }
+        timeUs += delta;
+        sample.timeUs = timeUs;
+        sample.durationNs = (duration > UINT32_MAX) ? UINT32_MAX : (uint32_t)duration;
+        if (same && pChannel->count == 0)
+        {
+            return -1;
+        }
+        if (same && pReplay->pSamples != NULL)
+        {
+            sample.status = pChannel->pSamples[pChannel->count - 1].status;
+            sample.offset = pChannel->pSamples[pChannel->count - 1].offset;
+            sample.length = pChannel->pSamples[pChannel->count - 1].length;
+        }
+        else if (!same)
+        {
+            if (dhcp_lease_replay_get_varint(&pIn, pEnd, &value) != 0)
+            {
+                return 0;
+            }
+            sample.status = (int32_t)((value >> 1) ^ (~(value & 1) + 1));
+            if (dhcp_lease_replay_get_varint(&pIn, pEnd, &value) != 0)
+            {
+                return 0;
+            }
+            if (value > DHCP_LEASE_REPLAY_OUTPUT_MAX)
+            {
+                return -1;
+            }
+            if ((uint64_t)(pEnd - pIn) < value)
+            {
+                return 0;
+            }
+            sample.offset = (uint32_t)(pIn - pReplay->pData);
+            sample.length = (uint32_t)value;
+            if (swapped && pReplay->pSamples != NULL)
+            {
+                swap_output(pChannels[index].item, pReplay->pData + sample.offset, sample.length);
+            }
+            pIn += value;
+        }
+        /* The counting pass leaves pSamples NULL */
+        if (pReplay->pSamples != NULL)
+        {
+            pChannel->pSamples[pChannel->count] = sample;
+        }
+        pChannel->count++;
+        *pLastUs = timeUs;
+    }
+    return 0;
+}
+
+/**
+* @brief Reads a trace and indexes its records
+*/
+static void load( replay_t *pReplay )
+{
+    dhcp_lease_replay_header_t header;
+    const dhcp_lease_replay_channel_t *pChannels;
+    replay_sample_t *pNext;
+    uint64_t lastUs = 0;
+    uint32_t total = 0;
+    uint32_t stored;
+    FILE *pFile;
+    long size;
+    int swapped;
+    uint32_t i;
+    uint32_t j;
+
+    pReplay->status = -1;
+    pFile = fopen(pReplay->path, "rb");
+    if (pFile == NULL)
+    {
+        return;
+    }
+    if (fseek(pFile, 0, SEEK_END) != 0 || (size = ftell(pFile)) < (long)sizeof(header) || fseek(pFile, 0, SEEK_SET) != 0 ||
+        (pReplay->pData = malloc((size_t)size)) == NULL || fread(pReplay->pData, 1, (size_t)size, pFile) != (size_t)size)
+    {
+        fclose(pFile);
+        return;
+    }
+    fclose(pFile);
+
+    memcpy(&header, pReplay->pData, sizeof(header));
+    swapped = (header.magic == __builtin_bswap32(DHCP_LEASE_REPLAY_MAGIC));
+    if (swapped)
+    {
+        header.version = __builtin_bswap16(header.version);
+        header.channelCount = __builtin_bswap16(header.channelCount);
+        header.intervalUs = __builtin_bswap32(header.intervalUs);
+    }
+    else if (header.magic != DHCP_LEASE_REPLAY_MAGIC)
+    {
+        return;
+    }
+    if (header.version != DHCP_LEASE_REPLAY_VERSION || header.channelCount > DHCP_LEASE_REPLAY_CHANNELS_MAX ||
+        (size_t)size < sizeof(header) + header.channelCount * sizeof(dhcp_lease_replay_channel_t))
+    {
+        return;
+    }
+    pChannels = (const dhcp_lease_replay_channel_t *)(pReplay->pData + sizeof(header));
+    for (i = 0; i < header.channelCount; i++)
+    {
+        if (pChannels[i].iface >= DHCP_LEASE_IF_MAX || pChannels[i].item >= DHCP_LEASE_REPLAY_ITEMS)
+        {
+            return;
+        }
+    }
+
+    /* Count the samples of each channel, then store them, each channel's in one stretch of a single array */
+    if (walk_records(pReplay, pChannels, header.channelCount, (const uint8_t *)(pChannels + header.channelCount),
+                     pReplay->pData + size, swapped, &lastUs) != 0)
+    {
+        return;
+    }
+    for (i = 0; i < DHCP_LEASE_IF_MAX; i++)
+    {
+        for (j = 0; j < DHCP_LEASE_REPLAY_ITEMS; j++)
+        {
+            total += pReplay->channels[i][j].count;
+        }
+    }
+    pReplay->pSamples = malloc((total > 0 ? total : 1) * sizeof(replay_sample_t));
+    if (pReplay->pSamples == NULL)
+    {
+        return;
+    }
+    pNext = pReplay->pSamples;
+    for (i = 0; i < DHCP_LEASE_IF_MAX; i++)
+    {
+        for (j = 0; j < DHCP_LEASE_REPLAY_ITEMS; j++)
+        {
+            pReplay->channels[i][j].pSamples = pNext;
+            pNext += pReplay->channels[i][j].count;
+            pReplay->channels[i][j].count = 0;
+        }
+    }
+    /* The same walk again: anything but the samples just counted means the trace cannot be trusted */
+    stored = 0;
+    if (walk_records(pReplay, pChannels, header.channelCount, (const uint8_t *)(pChannels + header.channelCount),
+                     pReplay->pData + size, swapped, &lastUs) == 0)
+    {
+        for (i = 0; i < DHCP_LEASE_IF_MAX; i++)
+        {
+            for (j = 0; j < DHCP_LEASE_REPLAY_ITEMS; j++)
+            {
+                stored += pReplay->channels[i][j].count;
+            }
+        }
+    }
+    if (stored != total)
+    {
+        free(pReplay->pSamples);
+        pReplay->pSamples = NULL;
+        memset(pReplay->channels, 0, sizeof(pReplay->channels));
+        return;
+    }
+
+    pReplay->spanUs = lastUs + header.intervalUs;
+    pReplay->speed = (getenv(DHCP_LEASE_REPLAY_SPEED_ENV) != NULL) ? strtod(getenv(DHCP_LEASE_REPLAY_SPEED_ENV), NULL) : 1.0;
+    if (!(pReplay->speed > 0.0))
+    {
+        pReplay->speed = 1.0;
+    }
+    pReplay->loop = env_flag(DHCP_LEASE_REPLAY_LOOP_ENV);
+    pReplay->latency = env_flag(DHCP_LEASE_REPLAY_LATENCY_ENV);
+    pReplay->startNs = dhcp_lease_engine_now_ns();
+    pReplay->status = 0;
+}
+
+/**
+* @brief Returns the trace DHCP_LEASE_REPLAY names, loading it on first use
+*/
+static const replay_t *current( void )
+{
+    const char *pPath = getenv(DHCP_LEASE_REPLAY_ENV);
+    replay_t *pReplay = __atomic_load_n(&gpReplay, __ATOMIC_ACQUIRE);
+
+    if (pPath == NULL || pPath[0] == '\0')
+    {
+        return NULL;
+    }
+    if (pReplay != NULL && strcmp(pReplay->path, pPath) == 0)
+    {
+        return pReplay;
+    }
+    pthread_mutex_lock(&gReplayLock);
+    pReplay = gpReplay;
+    if (pReplay == NULL || strcmp(pReplay->path, pPath) != 0)
+    {
+        pReplay = calloc(1, sizeof(*pReplay));
+        if (pReplay != NULL)
+        {
+            snprintf(pReplay->path, sizeof(pReplay->path), "%s", pPath);
+            load(pReplay);
+            __atomic_store_n(&gpReplay, pReplay, __ATOMIC_RELEASE);
+        }
+    }
+    pthread_mutex_unlock(&gReplayLock);
+    return pReplay;
+}
+
+/**
+* @brief Finds the sample of a channel at a point of the trace
+*/
+static const replay_sample_t *sample_at( const replay_channel_t *pChannel, uint64_t timeUs )
+{
+    uint32_t low = 0;
+    uint32_t high = pChannel->count;
+
+    /* The first sample past timeUs */
+    while (low < high)
+    {
+        uint32_t middle = low + (high - low) / 2;
+
+        if (pChannel->pSamples[middle].timeUs <= timeUs)
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+    return &pChannel->pSamples[(low > 0) ? low - 1 : 0];
+}
+
+/**
+* @brief Returns the point of the trace the engine clock is at
+*/
+static uint64_t trace_time( const replay_t *pReplay, uint64_t nowNs )
+{
+    uint64_t timeUs = (uint64_t)((double)(nowNs - pReplay->startNs) / 1000.0 * pReplay->speed);
+
+    if (pReplay->loop && pReplay->spanUs > 0)
+    {
+        timeUs %= pReplay->spanUs;
+    }
+    return timeUs;
+}
+
+static void take_as_long( uint32_t durationNs )
+{
+    struct timespec now;
+    uint64_t endNs;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    endNs = (uint64_t)now.tv_sec * 1000000000ULL + (uint64_t)now.tv_nsec + durationNs;
+    if (durationNs >= REPLAY_SPIN_LIMIT_NS)
+    {
+        struct timespec until = { (time_t)(endNs / 1000000000ULL), (long)(endNs % 1000000000ULL) };
+
+        while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &until, NULL) != 0)
+        {
+        }
+        return;
+    }
+    do
+    {
+        clock_gettime(CLOCK_MONOTONIC, &now);
+    } while ((uint64_t)now.tv_sec * 1000000000ULL + (uint64_t)now.tv_nsec < endNs);
+}
+
+int dhcp_lease_replay_enabled( void )
+{
+    const char *pPath = getenv(DHCP_LEASE_REPLAY_ENV);
+
+    return (pPath != NULL && pPath[0] != '\0');
+}
+
+int dhcp_lease_replay_read( dhcp_lease_if_t iface, uint32_t item, void *pOut, uint32_t size )
+{
+    const replay_t *pReplay = current();
+    const replay_channel_t *pChannel;
+    const replay_sample_t *pSample;
+
+    if (pReplay == NULL || pReplay->status != 0 || (unsigned)iface >= DHCP_LEASE_IF_MAX ||
+        item >= DHCP_LEASE_REPLAY_ITEMS || pOut == NULL)
+    {
+        return -1;
+    }
+    pChannel = &pReplay->channels[iface][item];
+    if (pChannel->count == 0)
+    {
+        return -1;
+    }
+    pSample = sample_at(pChannel, trace_time(pReplay, dhcp_lease_engine_now_ns()));
+    memcpy(pOut, pReplay->pData + pSample->offset, (pSample->length < size) ? pSample->length : size);
+    if (pReplay->latency)
+    {
+        take_as_long(pSample->durationNs);
+    }
+    return pSample->status;
+}
+
+int dhcp_lease_replay_get( dhcp_lease_if_t iface, dhcp_lease_t *pLease, dhcp_lease_timers_t *pTimers, uint64_t *pNowNs )
+{
+    const replay_t *pReplay = current();
+    uint32_t values[DHCP_LEASE_FIELD_MAX];
+    uint8_t output[DHCP_LEASE_REPLAY_OUTPUT_MAX];
+    uint64_t nowNs = dhcp_lease_engine_now_ns();
+    uint64_t timeUs;
+    uint32_t captured = 0;
+    int status = 0;
+    uint32_t item;
+    int32_t count;
+
+    if (pReplay == NULL || pReplay->status != 0 || (unsigned)iface >= DHCP_LEASE_IF_MAX || pLease == NULL || pTimers == NULL)
+    {
+        return -1;
+    }
+    timeUs = trace_time(pReplay, nowNs);
+    memset(values, 0, sizeof(values));
+    memset(pLease, 0, sizeof(*pLease));
+    for (item = 0; item < DHCP_LEASE_REPLAY_ITEMS; item++)
+    {
+        const replay_channel_t *pChannel = &pReplay->channels[iface][item];
+        const replay_sample_t *pSample;
+
+        if (pChannel->count == 0)
+        {
+            continue;
+        }
+        captured++;
+        pSample = sample_at(pChannel, timeUs);
+        status |= (pSample->status != 0);
+        memset(output, 0, sizeof(output));
+        memcpy(output, pReplay->pData + pSample->offset, pSample->length);
+        if (item < DHCP_LEASE_FIELD_MAX)
+        {
+            memcpy(&values[item], output, sizeof(values[item]));
+        }
+        else if (item == DHCP_LEASE_REPLAY_IFNAME)
+        {
+            memcpy(pLease->ifname, output, sizeof(pLease->ifname) - 1);
+        }
+        else
+        {
+            memcpy(&count, output, sizeof(count));
+            pLease->dns_count = (count < 0) ? 0 : (count > DHCP_LEASE_MAX_DNS) ? DHCP_LEASE_MAX_DNS : count;
+            memcpy(pLease->dns_svrs, output + sizeof(count), pLease->dns_count * sizeof(uint32_t));
+        }
+    }
+    if (captured == 0 || status != 0)
+    {
+        return -1;
+    }
+    pLease->lease_time = values[DHCP_LEASE_FIELD_LEASE_TIME];
+    pLease->config_attempts = (int)values[DHCP_LEASE_FIELD_CONFIG_ATTEMPTS];
+    pLease->ip_addr = values[DHCP_LEASE_FIELD_IP_ADDR];
+    pLease->mask = values[DHCP_LEASE_FIELD_MASK];
+    pLease->gw = values[DHCP_LEASE_FIELD_GW];
+    pLease->dhcp_svr = values[DHCP_LEASE_FIELD_DHCP_SVR];
+    pLease->bound = (pLease->ip_addr != 0);
+    pTimers->remain_lease = values[DHCP_LEASE_FIELD_REMAIN_LEASE];
+    pTimers->remain_renew = values[DHCP_LEASE_FIELD_REMAIN_RENEW];
+    pTimers->remain_rebind = values[DHCP_LEASE_FIELD_REMAIN_REBIND];
+    pTimers->fsm_state = (int)values[DHCP_LEASE_FIELD_FSM_STATE];
+    if (pNowNs != NULL)
+    {
+        *pNowNs = nowNs;
+    }
+    return 0;
+}
+
+void dhcp_lease_replay_reset( void )
+{
+    pthread_mutex_lock(&gReplayLock);
+    __atomic_store_n(&gpReplay, NULL, __ATOMIC_RELEASE);
+    pthread_mutex_unlock(&gReplayLock);
+}
@@ -0,0 +1,295 @@
+/*
+* If not stated otherwise in this file or this component's LICENSE file the
+* following copyright and licenses apply:*
+* Copyright 2023 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#include <string.h>
+#include <stdlib.h>
+#include <limits.h>
+#include <fcntl.h>
+#include <sched.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "dhcp_lease_shm.h"
+
+#define SHM_MAX_MAPPINGS  8   /* Distinct DHCP_LEASE_SHM values one process maps */
+#define SHM_WORDS         (sizeof(dhcp_lease_t) / sizeof(uint32_t))
+
+typedef struct
+{
+    char name[NAME_MAX + 1];
+    const dhcp_lease_shm_page_t *pPage;
+} shm_mapping_t;
+
+/* Entries below gMappingCount are complete and never change */
+static shm_mapping_t gMappings[SHM_MAX_MAPPINGS];
+static uint32_t gMappingCount = 0;
+static pthread_mutex_t gMappingLock = PTHREAD_MUTEX_INITIALIZER;
+
+static int valid_layout( const dhcp_lease_shm_page_t *pPage )
+{
+    return __atomic_load_n(&pPage->magic, __ATOMIC_ACQUIRE) == DHCP_LEASE_SHM_MAGIC &&
+           pPage->version == DHCP_LEASE_SHM_VERSION && pPage->size == sizeof(dhcp_lease_shm_page_t);
+}
+
+dhcp_lease_shm_page_t *dhcp_lease_shm_create( const char *pName )
+{
+    dhcp_lease_shm_page_t *pPage;
+    struct stat st;
+    int fd;
+
+    if (pName == NULL)
+    {
+        return NULL;
+    }
+    fd = shm_open(pName, O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (fd < 0)
+    {
+        return NULL;
+    }
+    if (fstat(fd, &st) != 0 || (st.st_size == 0 && ftruncate(fd, sizeof(*pPage)) != 0) ||
+        (st.st_size != 0 && (size_t)st.st_size < sizeof(*pPage)))
+    {
+        close(fd);
+        return NULL;
+    }
+    pPage = mmap(NULL, sizeof(*pPage), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (pPage == MAP_FAILED)
+    {
+        return NULL;
+    }
+
+    /* A new object is all zeroes; the magic goes in last, so readers never map a half-made page */
+    if (__atomic_load_n(&pPage->magic, __ATOMIC_RELAXED) == 0)
+    {
+        pPage->version = DHCP_LEASE_SHM_VERSION;
+        pPage->size = sizeof(*pPage);
+        __atomic_store_n(&pPage->magic, DHCP_LEASE_SHM_MAGIC, __ATOMIC_RELEASE);
+    }
+    if (!valid_layout(pPage))
+    {
+        munmap(pPage, sizeof(*pPage));
+        return NULL;
+    }
+    return pPage;
+}
+
+int dhcp_lease_shm_publish( dhcp_lease_shm_page_t *pPage, dhcp_lease_if_t iface, const dhcp_lease_t *pLease )
+{
+    dhcp_lease_shm_slot_t *pSlot;
+    dhcp_lease_shm_slot_t copy;
+    uint32_t sequence;
+    uint32_t next;
+    size_t i;
+
+    if (pPage == NULL || pLease == NULL || (unsigned)iface >= DHCP_LEASE_IF_MAX)
+    {
+        return -1;
+    }
+    pSlot = &pPage->slots[iface];
+    copy.data.lease = *pLease;
+
+    sequence = __atomic_load_n(&pSlot->sequence, __ATOMIC_RELAXED);
+    next = sequence + 2;
+    if (next == 0)
+    {
+        /* 0 is kept for a slot never published */
+        next = 2;
+    }
+    __atomic_store_n(&pSlot->sequence, sequence + 1, __ATOMIC_RELAXED);
+    /* Orders the odd sequence before the lease, so a reader that sees part of the new lease sees the sequence move */
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    for (i = 0; i < SHM_WORDS; i++)
+    {
+        __atomic_store_n(&pSlot->data.words[i], copy.data.words[i], __ATOMIC_RELAXED);
+    }
+    __atomic_store_n(&pSlot->sequence, next, __ATOMIC_RELEASE);
+    return 0;
+}
+
+const dhcp_lease_shm_page_t *dhcp_lease_shm_open( const char *pName )
+{
+    const dhcp_lease_shm_page_t *pPage;
+    struct stat st;
+    int fd;
+
+    if (pName == NULL)
+    {
+        return NULL;
+    }
+    fd = shm_open(pName, O_RDONLY | O_CLOEXEC, 0);
+    if (fd < 0)
+    {
+        return NULL;
+    }
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(*pPage))
+    {
+        close(fd);
+        return NULL;
+    }
+    pPage = mmap(NULL, sizeof(*pPage), PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (pPage == MAP_FAILED)
+    {
+        return NULL;
+    }
+    if (!valid_layout(pPage))
+    {
+        munmap((void *)pPage, sizeof(*pPage));
+        return NULL;
+    }
+    return pPage;
+}
+
+void dhcp_lease_shm_close( const dhcp_lease_shm_page_t *pPage )
+{
+    if (pPage != NULL)
+    {
+        munmap((void *)pPage, sizeof(*pPage));
+    }
+}
+
+int dhcp_lease_shm_read( const dhcp_lease_shm_page_t *pPage, dhcp_lease_if_t iface, dhcp_lease_t *pLease )
+{
+    const dhcp_lease_shm_slot_t *pSlot;
+    dhcp_lease_shm_slot_t copy;
+    struct timespec now;
+    uint64_t now_ns;
+    uint64_t giveUpNs = 0;
+    uint32_t before;
+    int retries;
+    size_t i;
+
+    if (pPage == NULL || pLease == NULL || (unsigned)iface >= DHCP_LEASE_IF_MAX)
+    {
+        return -1;
+    }
+    pSlot = &pPage->slots[iface];
+    for (retries = 0; ; retries++)
+    {
+        if (retries >= DHCP_LEASE_SHM_SPIN_LIMIT)
+        {
+            clock_gettime(CLOCK_MONOTONIC, &now);
+            now_ns = (uint64_t)now.tv_sec * 1000000000ULL + (uint64_t)now.tv_nsec;
+            if (giveUpNs == 0)
+            {
+                giveUpNs = now_ns + DHCP_LEASE_SHM_STALL_MS * 1000000ULL;
+            }
+            else if (now_ns >= giveUpNs)
+            {
+                return DHCP_LEASE_SHM_STALLED;
+            }
+            sched_yield();
+        }
+        before = __atomic_load_n(&pSlot->sequence, __ATOMIC_ACQUIRE);
+        if (before == 0)
+        {
+            return -1;
+        }
+        if (before & 1)
+        {
+            continue;
+        }
+        for (i = 0; i < SHM_WORDS; i++)
+        {
+            copy.data.words[i] = __atomic_load_n(&pSlot->data.words[i], __ATOMIC_RELAXED);
+        }
+        /* Keeps the copy ahead of the second sequence load */
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        if (__atomic_load_n(&pSlot->sequence, __ATOMIC_RELAXED) == before)
+        {
+            break;
+        }
+    }
+    *pLease = copy.data.lease;
+    return retries;
+}
+
+/* Maps each name once; later calls find it without a system call or a lock */
+static const dhcp_lease_shm_page_t *find_page( const char *pName )
+{
+    const dhcp_lease_shm_page_t *pPage = NULL;
+    uint32_t count = __atomic_load_n(&gMappingCount, __ATOMIC_ACQUIRE);
+    uint32_t i;
+
+    for (i = 0; i < count; i++)
+    {
+        if (strcmp(gMappings[i].name, pName) == 0)
+        {
+            return gMappings[i].pPage;
+        }
+    }
+    if (strlen(pName) > NAME_MAX)
+    {
+        return NULL;
+    }
+
+    pthread_mutex_lock(&gMappingLock);
+    count = gMappingCount;
+    for (; i < count && pPage == NULL; i++)
+    {
+        if (strcmp(gMappings[i].name, pName) == 0)
+        {
+            pPage = gMappings[i].pPage;
+        }
+    }
+    if (pPage == NULL && count < SHM_MAX_MAPPINGS)
+    {
+        pPage = dhcp_lease_shm_open(pName);
+        if (pPage != NULL)
+        {
+            strcpy(gMappings[count].name, pName);
+            gMappings[count].pPage = pPage;
+            __atomic_store_n(&gMappingCount, count + 1, __ATOMIC_RELEASE);
+        }
+    }
+    pthread_mutex_unlock(&gMappingLock);
+    return pPage;
+}
+
+int dhcp_lease_shm_get( dhcp_lease_if_t iface, dhcp_lease_t *pLease, dhcp_lease_timers_t *pTimers, uint64_t *pNowNs )
+{
+    const char *pName = getenv(DHCP_LEASE_SHM_ENV);
+    const dhcp_lease_shm_page_t *pPage;
+    uint64_t now_ns;
+    int retries;
+
+    if (pName == NULL || pLease == NULL || pTimers == NULL)
+    {
+        return -1;
+    }
+    pPage = find_page(pName);
+    if (pPage == NULL)
+    {
+        return -1;
+    }
+    retries = dhcp_lease_shm_read(pPage, iface, pLease);
+    if (retries < 0)
+    {
+        return retries;
+    }
+    now_ns = dhcp_lease_engine_now_ns();
+    dhcp_lease_eval(pLease, now_ns, 0, pTimers);
+    if (pNowNs != NULL)
+    {
+        *pNowNs = now_ns;
+    }
+    return 0;
+}
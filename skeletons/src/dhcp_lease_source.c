@@ -0,0 +1,170 @@
+/*
+* If not stated otherwise in this file or this component's LICENSE file the
+* following copyright and licenses apply:*
+* Copyright 2023 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#include <string.h>
+#include <stdlib.h>
+#include "dhcp_lease_source.h"
+#include "dhcp_lease_file.h"
+#include "dhcp_lease_shm.h"
+#include "dhcp_lease_replay.h"
+
+static int from_replay( dhcp_lease_if_t iface )
+{
+    return ((unsigned)iface < DHCP_LEASE_IF_MAX) && dhcp_lease_replay_enabled();
+}
+
+static int from_engine( dhcp_lease_if_t iface )
+{
+    const char *pPath;
+
+    if ((unsigned)iface < DHCP_LEASE_IF_MAX)
+    {
+        pPath = getenv(DHCP_LEASE_SHM_ENV);
+        if (pPath != NULL && pPath[0] != '\0')
+        {
+            return 0;
+        }
+    }
+    if (iface == DHCP_LEASE_IF_ERT)
+    {
+        pPath = getenv(DHCP_LEASE_FILE_ENV);
+        if (pPath != NULL && pPath[0] != '\0')
+        {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+int dhcp_lease_source_get( dhcp_lease_if_t iface, dhcp_lease_t *pLease, dhcp_lease_timers_t *pTimers, uint64_t *pNowNs )
+{
+    const char *pPath;
+    int status;
+
+    if (from_replay(iface))
+    {
+        return dhcp_lease_replay_get(iface, pLease, pTimers, pNowNs);
+    }
+    if (from_engine(iface))
+    {
+        return dhcp_lease_engine_snapshot(iface, pLease, pTimers, pNowNs);
+    }
+    pPath = getenv(DHCP_LEASE_SHM_ENV);
+    if (pPath != NULL && pPath[0] != '\0')
+    {
+        status = dhcp_lease_shm_get(iface, pLease, pTimers, pNowNs);
+        /* A client that died mid-update left the slot locked: serve the next source */
+        if (status != DHCP_LEASE_SHM_STALLED)
+        {
+            return status;
+        }
+    }
+    pPath = getenv(DHCP_LEASE_FILE_ENV);
+    if (iface != DHCP_LEASE_IF_ERT || pPath == NULL || pPath[0] == '\0')
+    {
+        return dhcp_lease_engine_snapshot(iface, pLease, pTimers, pNowNs);
+    }
+    if (pNowNs != NULL)
+    {
+        *pNowNs = dhcp_lease_engine_now_ns();
+    }
+    return dhcp_lease_file_read(pPath, pLease, pTimers);
+}
+
+int dhcp_lease_source_field( dhcp_lease_if_t iface, dhcp_lease_field_t field, uint32_t *pValue )
+{
+    dhcp_lease_timers_t timers;
+    dhcp_lease_t lease;
+
+    if (pValue == NULL)
+    {
+        return -1;
+    }
+    if (from_replay(iface))
+    {
+        return dhcp_lease_replay_read(iface, field, pValue, sizeof(*pValue));
+    }
+    if (from_engine(iface))
+    {
+        return (dhcp_lease_engine_field(iface, field, pValue) == 0) ? 0 : -1;
+    }
+    if (dhcp_lease_source_get(iface, &lease, &timers, NULL) != 0)
+    {
+        return -1;
+    }
+    *pValue = dhcp_lease_field_value(&lease, &timers, field);
+    return 0;
+}
+
+int dhcp_lease_source_ifname( dhcp_lease_if_t iface, char *pName )
+{
+    dhcp_lease_timers_t timers;
+    dhcp_lease_t lease;
+    size_t length;
+
+    if (pName == NULL)
+    {
+        return -1;
+    }
+    if (from_replay(iface))
+    {
+        return dhcp_lease_replay_read(iface, DHCP_LEASE_REPLAY_IFNAME, pName, DHCP_LEASE_REPLAY_IFNAME_SIZE);
+    }
+    if (dhcp_lease_source_get(iface, &lease, &timers, NULL) != 0)
+    {
+        return -1;
+    }
+    /* A lease page is written by another process, so the name may not be terminated */
+    length = strnlen(lease.ifname, sizeof(lease.ifname));
+    if (length > DHCP_LEASE_REPLAY_IFNAME_SIZE - 1)
+    {
+        length = DHCP_LEASE_REPLAY_IFNAME_SIZE - 1;
+    }
+    memcpy(pName, lease.ifname, length);
+    pName[length] = '\0';
+    return 0;
+}
+
+int dhcp_lease_source_dns_svrs( dhcp_lease_if_t iface, void *pList, size_t size )
+{
+    const size_t first = sizeof(int);
+    dhcp_lease_timers_t timers;
+    dhcp_lease_t lease;
+    int number;
+
+    if (pList == NULL || size < first)
+    {
+        return -1;
+    }
+    if (from_replay(iface))
+    {
+        return dhcp_lease_replay_read(iface, DHCP_LEASE_REPLAY_DNS_SVRS, pList, (uint32_t)size);
+    }
+    if (dhcp_lease_source_get(iface, &lease, &timers, NULL) != 0)
+    {
+        return -1;
+    }
+    number = lease.dns_count;
+    if ((size_t)number > (size - first) / sizeof(uint32_t))
+    {
+        number = (int)((size - first) / sizeof(uint32_t));
+    }
+    memcpy(pList, &number, sizeof(number));
+    memcpy((uint8_t *)pList + first, lease.dns_svrs, sizeof(uint32_t) * (size_t)number);
+    return 0;
+}
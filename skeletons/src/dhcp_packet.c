@@ -0,0 +1,450 @@
+/*
+* If not stated otherwise in this file or this component's LICENSE file the
+* following copyright and licenses apply:*
+* Copyright 2023 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#include <stdlib.h>
+#include <string.h>
+#include "dhcp_packet.h"
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define SCAN_VECTOR_NAME "sse2"
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define SCAN_VECTOR_NAME "neon"
+#endif
+
+#define SNAME_OFFSET   44
+#define SNAME_SIZE     64
+#define FILE_OFFSET    108
+#define FILE_SIZE      128
+
+#define OVERLOAD_FILE  1
+#define OVERLOAD_SNAME 2
+
+#define SCAN_LEAD      8       /* PAD bytes stepped over before going a vector at a time */
+#define SCAN_BATCH     32      /* Options located per scan call while decoding */
+#define SCANNER_UNSET  (-1)
+
+static int gScanner = SCANNER_UNSET;
+
+static void put_u16( uint8_t *p, uint16_t value )
+{
+    p[0] = (uint8_t)(value >> 8);
+    p[1] = (uint8_t)value;
+}
+
+static void put_u32( uint8_t *p, uint32_t value )
+{
+    p[0] = (uint8_t)(value >> 24);
+    p[1] = (uint8_t)(value >> 16);
+    p[2] = (uint8_t)(value >> 8);
+    p[3] = (uint8_t)value;
+}
+
+static uint16_t get_u16( const uint8_t *p )
+{
+    return (uint16_t)((p[0] << 8) | p[1]);
+}
+
+static uint32_t get_u32( const uint8_t *p )
+{
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | (uint32_t)p[3];
+}
+
+static void decode_option( uint8_t code, const uint8_t *p, uint8_t length, dhcp_packet_t *pPacket, int *pOverload )
+{
+    int i;
+
+    switch (code)
+    {
+        case DHCP_OPT_MSG_TYPE:
+            if (length == 1) pPacket->msg_type = p[0];
+            break;
+        case DHCP_OPT_REQUESTED_IP:
+            if (length == 4) memcpy(&pPacket->requested_ip, p, 4);
+            break;
+        case DHCP_OPT_SERVER_ID:
+            if (length == 4) memcpy(&pPacket->server_id, p, 4);
+            break;
+        case DHCP_OPT_SUBNET_MASK:
+            if (length == 4) memcpy(&pPacket->mask, p, 4);
+            break;
+        case DHCP_OPT_ROUTER:
+            if (length >= 4) memcpy(&pPacket->router, p, 4);
+            break;
+        case DHCP_OPT_DNS:
+            for (i = 0; i < length / 4 && pPacket->dns_count < DHCP_PACKET_MAX_DNS; i++)
+            {
+                memcpy(&pPacket->dns[pPacket->dns_count++], p + i * 4, 4);
+            }
+            break;
+        case DHCP_OPT_LEASE_TIME:
+            if (length == 4) pPacket->lease_time = get_u32(p);
+            break;
+        case DHCP_OPT_RENEWAL:
+            if (length == 4) pPacket->renewal_time = get_u32(p);
+            break;
+        case DHCP_OPT_REBINDING:
+            if (length == 4) pPacket->rebinding_time = get_u32(p);
+            break;
+        case DHCP_OPT_PARAM_LIST:
+            pPacket->param_count = (length < DHCP_PACKET_MAX_PARAMS) ? length : DHCP_PACKET_MAX_PARAMS;
+            memcpy(pPacket->params, p, (size_t)pPacket->param_count);
+            break;
+        case DHCP_OPT_OVERLOAD:
+            /* Only honoured in the options field itself */
+            if (length == 1 && pOverload != NULL) *pOverload = p[0] & (OVERLOAD_FILE | OVERLOAD_SNAME);
+            break;
+        default:
+            break;
+    }
+}
+
+#ifdef SCAN_VECTOR_NAME
+/* Offset of the first byte from offset on that is not PAD, or size */
+static size_t skip_pad( const uint8_t *pArea, size_t offset, size_t size )
+{
+#if defined(__SSE2__)
+    const __m128i zero = _mm_setzero_si128();
+    uint32_t mask;
+#else
+    uint8x16_t bytes;
+    uint64_t nibbles;
+#endif
+    size_t lead = (size - offset < SCAN_LEAD) ? size - offset : SCAN_LEAD;
+
+    /* Alignment PAD runs are a few bytes long and cheaper to step over */
+    while (lead-- != 0)
+    {
+        if (pArea[offset] != DHCP_OPT_PAD)
+        {
+            return offset;
+        }
+        offset++;
+    }
+#if defined(__SSE2__)
+    while (size - offset >= 16)
+    {
+        mask = (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *)(pArea + offset)), zero)) ^ 0xFFFFU;
+        if (mask != 0)
+        {
+            return offset + (size_t)__builtin_ctz(mask);
+        }
+        offset += 16;
+    }
+#else
+    while (size - offset >= 16)
+    {
+        /* Narrowing leaves 4 bits per byte, set where the byte is not PAD */
+        bytes = vld1q_u8(pArea + offset);
+        nibbles = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(vtstq_u8(bytes, bytes)), 4)), 0);
+        if (nibbles != 0)
+        {
+            return offset + (size_t)(__builtin_ctzll(nibbles) >> 2);
+        }
+        offset += 16;
+    }
+#endif
+    while (offset < size && pArea[offset] == DHCP_OPT_PAD)
+    {
+        offset++;
+    }
+    return offset;
+}
+#endif
+
+/* The option walk itself, with PAD runs skipped a byte or a vector at a time */
+static int scan_area( const uint8_t *pArea, size_t size, size_t *pOffset, dhcp_option_ref_t *pRefs, uint32_t max, int vector )
+{
+    size_t offset = *pOffset;
+    uint32_t count = 0;
+    uint8_t code;
+
+    (void)vector;
+    while (offset < size && count < max)
+    {
+        code = pArea[offset];
+        if (code == DHCP_OPT_PAD)
+        {
+#ifdef SCAN_VECTOR_NAME
+            offset = vector ? skip_pad(pArea, offset, size) : offset + 1;
+#else
+            offset++;
+#endif
+            continue;
+        }
+        if (code == DHCP_OPT_END)
+        {
+            offset = size;
+            break;
+        }
+        if (size - offset < 2 || size - offset - 2 < pArea[offset + 1])
+        {
+            return -1;
+        }
+        pRefs[count].offset = (uint32_t)(offset + 2);
+        pRefs[count].code = code;
+        pRefs[count].length = pArea[offset + 1];
+        count++;
+        offset += 2 + (size_t)pArea[offset + 1];
+    }
+    *pOffset = offset;
+    return (int)count;
+}
+
+int dhcp_packet_scan( const uint8_t *pArea, size_t size, size_t *pOffset, dhcp_option_ref_t *pRefs, uint32_t max )
+{
+    if (pArea == NULL || pOffset == NULL || pRefs == NULL || max == 0 || *pOffset > size)
+    {
+        return -1;
+    }
+    return scan_area(pArea, size, pOffset, pRefs, max, dhcp_packet_get_scanner() == DHCP_PACKET_SCANNER_SIMD);
+}
+
+int dhcp_packet_set_scanner( dhcp_packet_scanner_t scanner )
+{
+    if (dhcp_packet_scanner_name(scanner) == NULL)
+    {
+        return -1;
+    }
+    __atomic_store_n(&gScanner, (int)scanner, __ATOMIC_RELAXED);
+    return 0;
+}
+
+dhcp_packet_scanner_t dhcp_packet_get_scanner( void )
+{
+    const char *pName;
+    int scanner = __atomic_load_n(&gScanner, __ATOMIC_RELAXED);
+    int unset = SCANNER_UNSET;
+
+    if (scanner == SCANNER_UNSET)
+    {
+        pName = getenv(DHCP_PACKET_SCANNER_ENV);
+        scanner = (dhcp_packet_scanner_name(DHCP_PACKET_SCANNER_SIMD) != NULL && (pName == NULL || strcmp(pName, "scalar") != 0))
+                ? DHCP_PACKET_SCANNER_SIMD : DHCP_PACKET_SCANNER_SCALAR;
+        /* A dhcp_packet_set_scanner() in the meantime wins */
+        if (!__atomic_compare_exchange_n(&gScanner, &unset, scanner, 0, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+        {
+            scanner = unset;
+        }
+    }
+    return (dhcp_packet_scanner_t)scanner;
+}
+
+const char *dhcp_packet_scanner_name( dhcp_packet_scanner_t scanner )
+{
+    switch (scanner)
+    {
+        case DHCP_PACKET_SCANNER_SCALAR:
+            return "scalar";
+#ifdef SCAN_VECTOR_NAME
+        case DHCP_PACKET_SCANNER_SIMD:
+            return SCAN_VECTOR_NAME;
+#endif
+        default:
+            return NULL;
+    }
+}
+
+/* Decodes one option area; returns -1 if an option runs past its end */
+static int decode_area( const uint8_t *pArea, size_t size, dhcp_packet_t *pPacket, int *pOverload )
+{
+    dhcp_option_ref_t refs[SCAN_BATCH];
+    int vector = (dhcp_packet_get_scanner() == DHCP_PACKET_SCANNER_SIMD);
+    size_t offset = 0;
+    int count;
+    int i;
+
+    while ((count = scan_area(pArea, size, &offset, refs, SCAN_BATCH, vector)) > 0)
+    {
+        for (i = 0; i < count; i++)
+        {
+            decode_option(refs[i].code, pArea + refs[i].offset, refs[i].length, pPacket, pOverload);
+        }
+    }
+    return count;
+}
+
+int dhcp_packet_decode( const uint8_t *pBuf, size_t length, dhcp_packet_t *pPacket )
+{
+    int overload = 0;
+
+    if (pBuf == NULL || pPacket == NULL)
+    {
+        return -1;
+    }
+    memset(pPacket, 0, sizeof(*pPacket));
+    if (length < DHCP_PACKET_OPTIONS_OFFSET || get_u32(pBuf + DHCP_PACKET_FIXED_SIZE) != DHCP_PACKET_MAGIC_COOKIE)
+    {
+        return -1;
+    }
+    pPacket->op = pBuf[0];
+    pPacket->hops = pBuf[3];
+    pPacket->xid = get_u32(pBuf + 4);
+    pPacket->secs = get_u16(pBuf + 8);
+    pPacket->flags = get_u16(pBuf + 10);
+    memcpy(&pPacket->ciaddr, pBuf + 12, 4);
+    memcpy(&pPacket->yiaddr, pBuf + 16, 4);
+    memcpy(&pPacket->siaddr, pBuf + 20, 4);
+    memcpy(&pPacket->giaddr, pBuf + 24, 4);
+    memcpy(pPacket->chaddr, pBuf + 28, 16);
+
+    if (decode_area(pBuf + DHCP_PACKET_OPTIONS_OFFSET, length - DHCP_PACKET_OPTIONS_OFFSET, pPacket, &overload) != 0)
+    {
+        return -1;
+    }
+    /* RFC 2131 4.1: file before sname */
+    if ((overload & OVERLOAD_FILE) && decode_area(pBuf + FILE_OFFSET, FILE_SIZE, pPacket, NULL) != 0)
+    {
+        return -1;
+    }
+    if ((overload & OVERLOAD_SNAME) && decode_area(pBuf + SNAME_OFFSET, SNAME_SIZE, pPacket, NULL) != 0)
+    {
+        return -1;
+    }
+    return (pPacket->msg_type != 0) ? 0 : -1;
+}
+
+/* Appends an option if it leaves room for END; NULL once anything did not fit */
+static uint8_t *put_option( uint8_t *p, const uint8_t *pEnd, uint8_t code, const void *pData, size_t length )
+{
+    if (p == NULL || length > 255 || (size_t)(pEnd - p) < 2 + length + 1)
+    {
+        return NULL;
+    }
+    p[0] = code;
+    p[1] = (uint8_t)length;
+    memcpy(p + 2, pData, length);
+    return p + 2 + length;
+}
+
+static uint8_t *put_option_u32( uint8_t *p, const uint8_t *pEnd, uint8_t code, uint32_t value )
+{
+    uint8_t data[4];
+
+    put_u32(data, value);
+    return put_option(p, pEnd, code, data, sizeof(data));
+}
+
+int dhcp_packet_encode( const dhcp_packet_t *pPacket, uint8_t *pBuf, size_t size, size_t *pLength )
+{
+    const uint8_t *pEnd = pBuf + size;
+    uint8_t *p;
+    uint8_t type;
+    size_t length;
+
+    if (pPacket == NULL || pBuf == NULL || pLength == NULL || pPacket->msg_type <= 0 || pPacket->msg_type > 255 ||
+        pPacket->dns_count < 0 || pPacket->dns_count > DHCP_PACKET_MAX_DNS ||
+        pPacket->param_count < 0 || pPacket->param_count > DHCP_PACKET_MAX_PARAMS || size < DHCP_PACKET_OPTIONS_OFFSET)
+    {
+        return -1;
+    }
+    type = (uint8_t)pPacket->msg_type;
+
+    memset(pBuf, 0, DHCP_PACKET_FIXED_SIZE);
+    pBuf[0] = pPacket->op;
+    pBuf[1] = 1;                                /* Ethernet */
+    pBuf[2] = 6;
+    pBuf[3] = pPacket->hops;
+    put_u32(pBuf + 4, pPacket->xid);
+    put_u16(pBuf + 8, pPacket->secs);
+    put_u16(pBuf + 10, pPacket->flags);
+    memcpy(pBuf + 12, &pPacket->ciaddr, 4);
+    memcpy(pBuf + 16, &pPacket->yiaddr, 4);
+    memcpy(pBuf + 20, &pPacket->siaddr, 4);
+    memcpy(pBuf + 24, &pPacket->giaddr, 4);
+    memcpy(pBuf + 28, pPacket->chaddr, 16);
+    put_u32(pBuf + DHCP_PACKET_FIXED_SIZE, DHCP_PACKET_MAGIC_COOKIE);
+
+    p = pBuf + DHCP_PACKET_OPTIONS_OFFSET;
+    p = put_option(p, pEnd, DHCP_OPT_MSG_TYPE, &type, 1);
+    if (pPacket->requested_ip != 0)
+    {
+        p = put_option(p, pEnd, DHCP_OPT_REQUESTED_IP, &pPacket->requested_ip, 4);
+    }
+    if (pPacket->param_count > 0)
+    {
+        p = put_option(p, pEnd, DHCP_OPT_PARAM_LIST, pPacket->params, (size_t)pPacket->param_count);
+    }
+    if (pPacket->server_id != 0)
+    {
+        p = put_option(p, pEnd, DHCP_OPT_SERVER_ID, &pPacket->server_id, 4);
+    }
+    if (pPacket->lease_time != 0)
+    {
+        p = put_option_u32(p, pEnd, DHCP_OPT_LEASE_TIME, pPacket->lease_time);
+    }
+    if (pPacket->renewal_time != 0)
+    {
+        p = put_option_u32(p, pEnd, DHCP_OPT_RENEWAL, pPacket->renewal_time);
+    }
+    if (pPacket->rebinding_time != 0)
+    {
+        p = put_option_u32(p, pEnd, DHCP_OPT_REBINDING, pPacket->rebinding_time);
+    }
+    if (pPacket->mask != 0)
+    {
+        p = put_option(p, pEnd, DHCP_OPT_SUBNET_MASK, &pPacket->mask, 4);
+    }
+    if (pPacket->router != 0)
+    {
+        p = put_option(p, pEnd, DHCP_OPT_ROUTER, &pPacket->router, 4);
+    }
+    if (pPacket->dns_count > 0)
+    {
+        p = put_option(p, pEnd, DHCP_OPT_DNS, pPacket->dns, (size_t)pPacket->dns_count * 4);
+    }
+    if (p == NULL)
+    {
+        return -1;
+    }
+    *p++ = DHCP_OPT_END;
+
+    length = (size_t)(p - pBuf);
+    if (length < DHCP_PACKET_BOOTP_SIZE && size >= DHCP_PACKET_BOOTP_SIZE)
+    {
+        memset(p, 0, DHCP_PACKET_BOOTP_SIZE - length);
+        length = DHCP_PACKET_BOOTP_SIZE;
+    }
+    *pLength = length;
+    return 0;
+}
+
+int dhcp_packet_to_lease( const dhcp_packet_t *pPacket, dhcp_lease_t *pLease )
+{
+    if (pPacket == NULL || pLease == NULL || pPacket->msg_type != DHCPACK || pPacket->yiaddr == 0)
+    {
+        return -1;
+    }
+    pLease->ip_addr = pPacket->yiaddr;
+    pLease->mask = pPacket->mask;
+    pLease->gw = pPacket->router;
+    pLease->dhcp_svr = pPacket->server_id;
+    memcpy(pLease->dns_svrs, pPacket->dns, sizeof(pLease->dns_svrs));
+    pLease->dns_count = pPacket->dns_count;
+    pLease->lease_time = pPacket->lease_time;
+    pLease->renew_time = pPacket->renewal_time;
+    pLease->rebind_time = pPacket->rebinding_time;
+    return 0;
+}
+
+const char *dhcp_packet_type_name( int msg_type )
+{
+    static const char *names[] = { "UNKNOWN", "DISCOVER", "OFFER", "REQUEST", "DECLINE", "ACK", "NAK", "RELEASE", "INFORM" };
+
+    return (msg_type > 0 && msg_type < (int)(sizeof(names) / sizeof(names[0]))) ? names[msg_type] : names[0];
+}
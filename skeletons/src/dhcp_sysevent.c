@@ -0,0 +1,210 @@
+/*
+* If not stated otherwise in this file or this component's LICENSE file the
+* following copyright and licenses apply:*
+* Copyright 2023 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include "dhcp_sysevent.h"
+
+static int send_line( dhcp_sysevent_t *pConn, const char *pLine, size_t length )
+{
+    ssize_t sent;
+
+    while (length > 0)
+    {
+        sent = send(pConn->fd, pLine, length, MSG_NOSIGNAL);
+        if (sent < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (sent <= 0)
+        {
+            return -1;
+        }
+        pLine += sent;
+        length -= (size_t)sent;
+    }
+    return 0;
+}
+
+int dhcp_sysevent_pending( const dhcp_sysevent_t *pConn )
+{
+    return memchr(pConn->buffer, '\n', pConn->used) != NULL;
+}
+
+/* Returns the next line without its newline, receiving until one is complete */
+static int read_line( dhcp_sysevent_t *pConn, char *pLine, size_t size )
+{
+    char *pEnd;
+    size_t length;
+    ssize_t got;
+
+    while ((pEnd = memchr(pConn->buffer, '\n', pConn->used)) == NULL)
+    {
+        if (pConn->used == sizeof(pConn->buffer))
+        {
+            return -1;
+        }
+        got = recv(pConn->fd, &pConn->buffer[pConn->used], sizeof(pConn->buffer) - pConn->used, 0);
+        if (got < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (got <= 0)
+        {
+            return -1;
+        }
+        pConn->used += (size_t)got;
+    }
+    length = (size_t)(pEnd - pConn->buffer);
+    if (length >= size)
+    {
+        return -1;
+    }
+    memcpy(pLine, pConn->buffer, length);
+    pLine[length] = '\0';
+    pConn->used -= length + 1;
+    memmove(pConn->buffer, pEnd + 1, pConn->used);
+    return 0;
+}
+
+/* Returns the reply to the last request; events that come first are dropped, as they precede it */
+static int read_reply( dhcp_sysevent_t *pConn, char *pLine, size_t size )
+{
+    do
+    {
+        if (read_line(pConn, pLine, size) != 0)
+        {
+            return -1;
+        }
+    } while (strncmp(pLine, "EVENT ", 6) == 0);
+    return 0;
+}
+
+int dhcp_sysevent_open( dhcp_sysevent_t *pConn, const char *pPath )
+{
+    struct sockaddr_un address;
+
+    pConn->fd = -1;
+    pConn->used = 0;
+    if (pPath == NULL || strlen(pPath) >= sizeof(address.sun_path))
+    {
+        return -1;
+    }
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    strcpy(address.sun_path, pPath);
+    pConn->fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (pConn->fd < 0)
+    {
+        return -1;
+    }
+    if (connect(pConn->fd, (struct sockaddr *)&address, sizeof(address)) != 0)
+    {
+        close(pConn->fd);
+        pConn->fd = -1;
+        return -1;
+    }
+    return 0;
+}
+
+void dhcp_sysevent_close( dhcp_sysevent_t *pConn )
+{
+    if (pConn->fd >= 0)
+    {
+        close(pConn->fd);
+    }
+    pConn->fd = -1;
+    pConn->used = 0;
+}
+
+int dhcp_sysevent_set( dhcp_sysevent_t *pConn, const char *pKey, const char *pValue )
+{
+    char line[DHCP_SYSEVENT_LINE_LEN];
+    int length = snprintf(line, sizeof(line), "SET %s %s\n", pKey, pValue);
+
+    if (length < 0 || (size_t)length >= sizeof(line) || strchr(pKey, ' ') != NULL ||
+        send_line(pConn, line, (size_t)length) != 0 || read_reply(pConn, line, sizeof(line)) != 0)
+    {
+        return -1;
+    }
+    return (strcmp(line, "OK") == 0) ? 0 : -1;
+}
+
+int dhcp_sysevent_get( dhcp_sysevent_t *pConn, const char *pKey, char *pValue, size_t size )
+{
+    char line[DHCP_SYSEVENT_LINE_LEN];
+    int length = snprintf(line, sizeof(line), "GET %s\n", pKey);
+
+    if (length < 0 || (size_t)length >= sizeof(line) || send_line(pConn, line, (size_t)length) != 0 ||
+        read_reply(pConn, line, sizeof(line)) != 0)
+    {
+        return -1;
+    }
+    if (strcmp(line, "NONE") == 0)
+    {
+        return 1;
+    }
+    if (strncmp(line, "VALUE ", 6) != 0 || strlen(&line[6]) >= size)
+    {
+        return -1;
+    }
+    strcpy(pValue, &line[6]);
+    return 0;
+}
+
+int dhcp_sysevent_notify( dhcp_sysevent_t *pConn, const char *pKey )
+{
+    char line[DHCP_SYSEVENT_LINE_LEN];
+    int length = snprintf(line, sizeof(line), "NOTIFY %s\n", pKey);
+
+    if (length < 0 || (size_t)length >= sizeof(line) || send_line(pConn, line, (size_t)length) != 0 ||
+        read_reply(pConn, line, sizeof(line)) != 0)
+    {
+        return -1;
+    }
+    return (strcmp(line, "OK") == 0) ? 0 : -1;
+}
+
+int dhcp_sysevent_next( dhcp_sysevent_t *pConn, char *pKey, char *pValue )
+{
+    char line[DHCP_SYSEVENT_LINE_LEN];
+    char *pSpace;
+
+    for (;;)
+    {
+        if (read_line(pConn, line, sizeof(line)) != 0)
+        {
+            return -1;
+        }
+        pSpace = (strncmp(line, "EVENT ", 6) == 0) ? strchr(&line[6], ' ') : NULL;
+        /* Anything else is a reply nobody waits for, or too long to be ours */
+        if (pSpace != NULL && (size_t)(pSpace - &line[6]) < DHCP_SYSEVENT_KEY_LEN &&
+            strlen(pSpace + 1) < DHCP_SYSEVENT_VALUE_LEN)
+        {
+            break;
+        }
+    }
+    *pSpace = '\0';
+    strcpy(pKey, &line[6]);
+    strcpy(pValue, pSpace + 1);
+    return 0;
+}
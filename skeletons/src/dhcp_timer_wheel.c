@@ -0,0 +1,328 @@
+/*
+* If not stated otherwise in this file or this component's LICENSE file the
+* following copyright and licenses apply:*
+* Copyright 2023 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#include <stddef.h>
+#include "dhcp_timer_wheel.h"
+
+#define WHEEL_MASK     ((uint64_t)DHCP_TIMER_WHEEL_SLOTS - 1)
+#define WHEEL_HORIZON  (1ULL << (DHCP_TIMER_WHEEL_BITS * DHCP_TIMER_WHEEL_LEVELS))   /* Ticks the levels cover */
+#define NO_SLOT        (-1)
+
+static void list_init( dhcp_timer_link_t *pHead )
+{
+    pHead->pNext = pHead;
+    pHead->pPrev = pHead;
+}
+
+static int list_empty( const dhcp_timer_link_t *pHead )
+{
+    return pHead->pNext == pHead;
+}
+
+static void list_append( dhcp_timer_link_t *pHead, dhcp_timer_link_t *pLink )
+{
+    pLink->pNext = pHead;
+    pLink->pPrev = pHead->pPrev;
+    pHead->pPrev->pNext = pLink;
+    pHead->pPrev = pLink;
+}
+
+static void list_unlink( dhcp_timer_link_t *pLink )
+{
+    pLink->pPrev->pNext = pLink->pNext;
+    pLink->pNext->pPrev = pLink->pPrev;
+    pLink->pNext = pLink;
+    pLink->pPrev = pLink;
+}
+
+/* Moves every node of pFrom to the empty list pTo */
+static void list_splice( dhcp_timer_link_t *pFrom, dhcp_timer_link_t *pTo )
+{
+    if (list_empty(pFrom))
+    {
+        list_init(pTo);
+        return;
+    }
+    pTo->pNext = pFrom->pNext;
+    pTo->pPrev = pFrom->pPrev;
+    pTo->pNext->pPrev = pTo;
+    pTo->pPrev->pNext = pTo;
+    list_init(pFrom);
+}
+
+static uint32_t level_shift( uint32_t level )
+{
+    return level * DHCP_TIMER_WHEEL_BITS;
+}
+
+/* First tick after the current one at which the slot's list is visited */
+static uint64_t slot_visit( const dhcp_timer_wheel_t *pWheel, uint32_t level, uint32_t index )
+{
+    uint32_t shift = level_shift(level);
+    uint64_t period = pWheel->current >> shift;
+    uint64_t distance = ((uint64_t)index - (period & WHEEL_MASK)) & WHEEL_MASK;
+
+    /* The slot under the current tick comes round again a whole turn later */
+    return (period + (distance ? distance : DHCP_TIMER_WHEEL_SLOTS)) << shift;
+}
+
+/* Earliest tick at which a slot of any level is visited, or UINT64_MAX if every slot is empty */
+static uint64_t next_visit( const dhcp_timer_wheel_t *pWheel )
+{
+    uint64_t best = UINT64_MAX;
+    uint64_t visit;
+    uint64_t rotated;
+    uint32_t start;
+    uint32_t level;
+
+    for (level = 0; level < DHCP_TIMER_WHEEL_LEVELS; level++)
+    {
+        if (pWheel->occupied[level] == 0)
+        {
+            continue;
+        }
+        /* Rotate so that bit 0 is the slot after the current one */
+        start = (uint32_t)(((pWheel->current >> level_shift(level)) + 1) & WHEEL_MASK);
+        rotated = start ? (pWheel->occupied[level] >> start) | (pWheel->occupied[level] << (DHCP_TIMER_WHEEL_SLOTS - start))
+                        : pWheel->occupied[level];
+        visit = slot_visit(pWheel, level, (uint32_t)((start + (uint32_t)__builtin_ctzll(rotated)) & WHEEL_MASK));
+        if (visit < best)
+        {
+            best = visit;
+        }
+    }
+    return best;
+}
+
+static uint64_t tick_to_ns( const dhcp_timer_wheel_t *pWheel, uint64_t tick )
+{
+    if (tick == UINT64_MAX || tick > (UINT64_MAX - pWheel->origin_ns) / pWheel->tick_ns)
+    {
+        return UINT64_MAX;
+    }
+    return pWheel->origin_ns + tick * pWheel->tick_ns;
+}
+
+/*
+* Puts a timer in the slot that comes round last before it expires, seen
+* from tick ref: level 0 for the next 64 ticks, level n for 64^n ticks and up.
+*/
+static void place( dhcp_timer_wheel_t *pWheel, dhcp_timer_t *pTimer, uint64_t ref )
+{
+    uint64_t expires = (pTimer->expires > ref) ? pTimer->expires : ref;
+    uint64_t delta = expires - ref;
+    uint32_t level = 0;
+    uint32_t index;
+
+    if (delta >= WHEEL_HORIZON)
+    {
+        /* Waits in the top level and is placed again when that slot comes round */
+        delta = WHEEL_HORIZON - 1;
+        expires = ref + delta;
+    }
+    if (delta >= DHCP_TIMER_WHEEL_SLOTS)
+    {
+        level = (uint32_t)(63 - __builtin_clzll(delta)) / DHCP_TIMER_WHEEL_BITS;
+    }
+    index = (uint32_t)((expires >> level_shift(level)) & WHEEL_MASK);
+    list_append(&pWheel->slots[level][index], &pTimer->link);
+    pWheel->occupied[level] |= 1ULL << index;
+    pTimer->slot = (int32_t)(level * DHCP_TIMER_WHEEL_SLOTS + index);
+}
+
+/* Moves the timers of a higher-level slot that has come round to lower levels */
+static void cascade( dhcp_timer_wheel_t *pWheel, uint32_t level, uint32_t index )
+{
+    dhcp_timer_link_t moving;
+    dhcp_timer_t *pTimer;
+
+    list_splice(&pWheel->slots[level][index], &moving);
+    pWheel->occupied[level] &= ~(1ULL << index);
+    while (!list_empty(&moving))
+    {
+        pTimer = (dhcp_timer_t *)moving.pNext;
+        list_unlink(&pTimer->link);
+        place(pWheel, pTimer, pWheel->current);
+    }
+}
+
+int dhcp_timer_wheel_init( dhcp_timer_wheel_t *pWheel, uint64_t tick_ns, uint64_t now_ns )
+{
+    uint32_t level;
+    uint32_t index;
+
+    if (pWheel == NULL || tick_ns == 0)
+    {
+        return -1;
+    }
+    pWheel->tick_ns = tick_ns;
+    pWheel->origin_ns = now_ns;
+    pWheel->current = 0;
+    pWheel->next_ns = UINT64_MAX;
+    pWheel->pending = 0;
+    for (level = 0; level < DHCP_TIMER_WHEEL_LEVELS; level++)
+    {
+        pWheel->occupied[level] = 0;
+        for (index = 0; index < DHCP_TIMER_WHEEL_SLOTS; index++)
+        {
+            list_init(&pWheel->slots[level][index]);
+        }
+    }
+    return 0;
+}
+
+void dhcp_timer_init( dhcp_timer_t *pTimer, dhcp_timer_cb_t callback, void *pUserData )
+{
+    list_init(&pTimer->link);
+    pTimer->expires = 0;
+    pTimer->expires_ns = 0;
+    pTimer->slot = NO_SLOT;
+    pTimer->pending = 0;
+    pTimer->callback = callback;
+    pTimer->pUserData = pUserData;
+}
+
+int dhcp_timer_wheel_add( dhcp_timer_wheel_t *pWheel, dhcp_timer_t *pTimer, uint64_t expires_ns )
+{
+    uint64_t offset_ns;
+    uint64_t visit_ns;
+    uint32_t level;
+
+    if (pWheel == NULL || pTimer == NULL || pTimer->callback == NULL)
+    {
+        return -1;
+    }
+    dhcp_timer_wheel_cancel(pWheel, pTimer);
+
+    /* Rounded up, so that a timer never fires before its time */
+    offset_ns = (expires_ns > pWheel->origin_ns) ? expires_ns - pWheel->origin_ns : 0;
+    pTimer->expires = offset_ns / pWheel->tick_ns + ((offset_ns % pWheel->tick_ns) != 0);
+    if (pTimer->expires <= pWheel->current)
+    {
+        pTimer->expires = pWheel->current + 1;
+    }
+    pTimer->expires_ns = expires_ns;
+    place(pWheel, pTimer, pWheel->current + 1);
+    pTimer->pending = 1;
+    pWheel->pending++;
+
+    level = (uint32_t)pTimer->slot / DHCP_TIMER_WHEEL_SLOTS;
+    visit_ns = tick_to_ns(pWheel, slot_visit(pWheel, level, (uint32_t)pTimer->slot % DHCP_TIMER_WHEEL_SLOTS));
+    if (visit_ns < pWheel->next_ns)
+    {
+        pWheel->next_ns = visit_ns;
+    }
+    return 0;
+}
+
+int dhcp_timer_wheel_cancel( dhcp_timer_wheel_t *pWheel, dhcp_timer_t *pTimer )
+{
+    uint32_t level;
+    uint32_t index;
+
+    if (pWheel == NULL || pTimer == NULL || !pTimer->pending)
+    {
+        return 0;
+    }
+    list_unlink(&pTimer->link);
+    if (pTimer->slot != NO_SLOT)
+    {
+        level = (uint32_t)pTimer->slot / DHCP_TIMER_WHEEL_SLOTS;
+        index = (uint32_t)pTimer->slot % DHCP_TIMER_WHEEL_SLOTS;
+        if (list_empty(&pWheel->slots[level][index]))
+        {
+            pWheel->occupied[level] &= ~(1ULL << index);
+        }
+        pTimer->slot = NO_SLOT;
+    }
+    /* next_ns is left early; the next advance finds nothing to do and moves it on */
+    pTimer->pending = 0;
+    pWheel->pending--;
+    return 1;
+}
+
+int dhcp_timer_pending( const dhcp_timer_t *pTimer )
+{
+    return pTimer != NULL && pTimer->pending;
+}
+
+uint64_t dhcp_timer_expires_ns( const dhcp_timer_t *pTimer )
+{
+    return (pTimer != NULL) ? pTimer->expires_ns : 0;
+}
+
+uint32_t dhcp_timer_wheel_advance( dhcp_timer_wheel_t *pWheel, uint64_t now_ns )
+{
+    dhcp_timer_link_t due;
+    dhcp_timer_t *pTimer;
+    uint64_t target;
+    uint64_t tick;
+    uint32_t fired = 0;
+    uint32_t level;
+    uint32_t index;
+
+    if (pWheel == NULL || now_ns < pWheel->next_ns)
+    {
+        return 0;
+    }
+    target = (now_ns - pWheel->origin_ns) / pWheel->tick_ns;
+
+    while (pWheel->pending > 0)
+    {
+        tick = next_visit(pWheel);
+        if (tick > target)
+        {
+            break;
+        }
+        pWheel->current = tick;
+
+        /* Every level whose period starts at this tick turns by one slot */
+        for (level = 1; level < DHCP_TIMER_WHEEL_LEVELS && (tick & ((1ULL << level_shift(level)) - 1)) == 0; level++)
+        {
+            index = (uint32_t)((tick >> level_shift(level)) & WHEEL_MASK);
+            if (pWheel->occupied[level] & (1ULL << index))
+            {
+                cascade(pWheel, level, index);
+            }
+        }
+
+        index = (uint32_t)(tick & WHEEL_MASK);
+        list_splice(&pWheel->slots[0][index], &due);
+        pWheel->occupied[0] &= ~(1ULL << index);
+        for (pTimer = (dhcp_timer_t *)due.pNext; &pTimer->link != &due; pTimer = (dhcp_timer_t *)pTimer->link.pNext)
+        {
+            pTimer->slot = NO_SLOT;
+        }
+        /* A callback may cancel a timer still in due, or add one, which lands after this tick */
+        while (!list_empty(&due))
+        {
+            pTimer = (dhcp_timer_t *)due.pNext;
+            list_unlink(&pTimer->link);
+            pTimer->pending = 0;
+            pWheel->pending--;
+            fired++;
+            pTimer->callback(pTimer, pTimer->pUserData);
+        }
+    }
+    if (pWheel->current < target)
+    {
+        pWheel->current = target;
+    }
+    pWheel->next_ns = (pWheel->pending > 0) ? tick_to_ns(pWheel, next_visit(pWheel)) : UINT64_MAX;
+    return fired;
+}
@@ -18,196 +18,359 @@
 
 #include <string.h>
 #include <stdlib.h>
-#include <setjmp.h>
 #include "dhcpv4c_api.h"
+#include "dhcpv4c_api_ext.h"
+#include "dhcp_lease_engine.h"
+#include "dhcp_lease_source.h"
+#include "dhcp_lease_notify.h"
 
+INT dhcpv4c_get_if_count(UINT* pCount)
+{
+  if (pCount == NULL)
+  {
+    return STATUS_FAILURE;
+  }
+  *pCount = dhcp_lease_engine_iface_count();
+  return STATUS_SUCCESS;
+}
+
+INT dhcpv4c_get_if_index(const CHAR* pIfname, UINT* pIndex)
+{
+  dhcp_lease_if_t iface;
+
+  if (pIndex == NULL || dhcp_lease_engine_find_iface(pIfname, &iface) != 0)
+  {
+    return STATUS_FAILURE;
+  }
+  *pIndex = (UINT)iface;
+  return STATUS_SUCCESS;
+}
+
+INT dhcpv4c_get_if_lease_time(UINT ifIndex, UINT* pValue)
+{
+  return dhcp_lease_source_field((dhcp_lease_if_t)ifIndex, DHCP_LEASE_FIELD_LEASE_TIME, pValue);
+}
+
+INT dhcpv4c_get_if_remain_lease_time(UINT ifIndex, UINT* pValue)
+{
+  return dhcp_lease_source_field((dhcp_lease_if_t)ifIndex, DHCP_LEASE_FIELD_REMAIN_LEASE, pValue);
+}
+
+INT dhcpv4c_get_if_remain_renew_time(UINT ifIndex, UINT* pValue)
+{
+  return dhcp_lease_source_field((dhcp_lease_if_t)ifIndex, DHCP_LEASE_FIELD_REMAIN_RENEW, pValue);
+}
+
+INT dhcpv4c_get_if_remain_rebind_time(UINT ifIndex, UINT* pValue)
+{
+  return dhcp_lease_source_field((dhcp_lease_if_t)ifIndex, DHCP_LEASE_FIELD_REMAIN_REBIND, pValue);
+}
+
+INT dhcpv4c_get_if_config_attempts(UINT ifIndex, INT* pValue)
+{
+  return dhcp_lease_source_field((dhcp_lease_if_t)ifIndex, DHCP_LEASE_FIELD_CONFIG_ATTEMPTS, (uint32_t *)pValue);
+}
+
+INT dhcpv4c_get_if_ifname(UINT ifIndex, CHAR* pName)
+{
+  return dhcp_lease_source_ifname((dhcp_lease_if_t)ifIndex, pName);
+}
+
+INT dhcpv4c_get_if_fsm_state(UINT ifIndex, INT* pValue)
+{
+  return dhcp_lease_source_field((dhcp_lease_if_t)ifIndex, DHCP_LEASE_FIELD_FSM_STATE, (uint32_t *)pValue);
+}
+
+INT dhcpv4c_get_if_ip_addr(UINT ifIndex, UINT* pValue)
+{
+  return dhcp_lease_source_field((dhcp_lease_if_t)ifIndex, DHCP_LEASE_FIELD_IP_ADDR, pValue);
+}
+
+INT dhcpv4c_get_if_mask(UINT ifIndex, UINT* pValue)
+{
+  return dhcp_lease_source_field((dhcp_lease_if_t)ifIndex, DHCP_LEASE_FIELD_MASK, pValue);
+}
+
+INT dhcpv4c_get_if_gw(UINT ifIndex, UINT* pValue)
+{
+  return dhcp_lease_source_field((dhcp_lease_if_t)ifIndex, DHCP_LEASE_FIELD_GW, pValue);
+}
+
+INT dhcpv4c_get_if_dns_svrs(UINT ifIndex, dhcpv4c_ip_list_t* pList)
+{
+  return dhcp_lease_source_dns_svrs((dhcp_lease_if_t)ifIndex, pList, sizeof(*pList));
+}
+
+INT dhcpv4c_get_if_dhcp_svr(UINT ifIndex, UINT* pValue)
+{
+  return dhcp_lease_source_field((dhcp_lease_if_t)ifIndex, DHCP_LEASE_FIELD_DHCP_SVR, pValue);
+}
+
+INT dhcpv4c_get_if_snapshot(UINT ifIndex, dhcpv4c_lease_snapshot_t* pSnapshot)
+{
+  const int max = (int)(sizeof(pSnapshot->dns_svrs.addrs) / sizeof(pSnapshot->dns_svrs.addrs[0]));
+  dhcp_lease_timers_t timers;
+  dhcp_lease_t lease;
+  uint64_t now_ns;
+  int i;
+
+  if (pSnapshot == NULL || dhcp_lease_source_get((dhcp_lease_if_t)ifIndex, &lease, &timers, &now_ns) != 0)
+  {
+    return STATUS_FAILURE;
+  }
+  memset(pSnapshot, 0, sizeof(*pSnapshot));
+  pSnapshot->lease_time = lease.lease_time;
+  pSnapshot->remain_lease_time = timers.remain_lease;
+  pSnapshot->remain_renew_time = timers.remain_renew;
+  pSnapshot->remain_rebind_time = timers.remain_rebind;
+  pSnapshot->config_attempts = lease.config_attempts;
+  memcpy(pSnapshot->ifname, lease.ifname, sizeof(lease.ifname));
+  pSnapshot->fsm_state = timers.fsm_state;
+  pSnapshot->ip_addr = lease.ip_addr;
+  pSnapshot->mask = lease.mask;
+  pSnapshot->gw = lease.gw;
+  pSnapshot->dns_svrs.number = (lease.dns_count < max) ? lease.dns_count : max;
+  for (i = 0; i < pSnapshot->dns_svrs.number; i++)
+  {
+    pSnapshot->dns_svrs.addrs[i] = lease.dns_svrs[i];
+  }
+  pSnapshot->dhcp_svr = lease.dhcp_svr;
+  pSnapshot->timestamp_ns = now_ns;
+  return STATUS_SUCCESS;
+}
 
 INT dhcpv4c_get_ert_lease_time(UINT* pValue)
 {
-  /*TODO: Implement Me!*/
-  (void)pValue;
-  return (INT)0;
+  return dhcpv4c_get_if_lease_time(DHCPV4C_IF_ERT, pValue);
 }
 
 INT dhcpv4c_get_ert_remain_lease_time(UINT* pValue)
 {
-  /*TODO: Implement Me!*/
-  (void)pValue;
-  return (INT)0;
+  return dhcpv4c_get_if_remain_lease_time(DHCPV4C_IF_ERT, pValue);
 }
 
 INT dhcpv4c_get_ert_remain_renew_time(UINT* pValue)
 {
-  /*TODO: Implement Me!*/
-  (void)pValue;
-  return (INT)0;
+  return dhcpv4c_get_if_remain_renew_time(DHCPV4C_IF_ERT, pValue);
 }
 
 INT dhcpv4c_get_ert_remain_rebind_time(UINT* pValue)
 {
-  /*TODO: Implement Me!*/
-  (void)pValue;
-  return (INT)0;
+  return dhcpv4c_get_if_remain_rebind_time(DHCPV4C_IF_ERT, pValue);
 }
 
 INT dhcpv4c_get_ert_config_attempts(INT* pValue)
 {
-  /*TODO: Implement Me!*/
-  (void)pValue;
-  return (INT)0;
+  return dhcpv4c_get_if_config_attempts(DHCPV4C_IF_ERT, pValue);
 }
 
 INT dhcpv4c_get_ert_ifname(CHAR* pName)
 {
-  /*TODO: Implement Me!*/
-  (void)pName;
-  return (INT)0;
+  return dhcpv4c_get_if_ifname(DHCPV4C_IF_ERT, pName);
 }
 
 INT dhcpv4c_get_ert_fsm_state(INT* pValue)
 {
-  /*TODO: Implement Me!*/
-  (void)pValue;
-  return (INT)0;
+  return dhcpv4c_get_if_fsm_state(DHCPV4C_IF_ERT, pValue);
 }
 
 INT dhcpv4c_get_ert_ip_addr(UINT* pValue)
 {
-  /*TODO: Implement Me!*/
-  (void)pValue;
-  return (INT)0;
+  return dhcpv4c_get_if_ip_addr(DHCPV4C_IF_ERT, pValue);
 }
 
 INT dhcpv4c_get_ert_mask(UINT* pValue)
 {
-  /*TODO: Implement Me!*/
-  (void)pValue;
-  return (INT)0;
+  return dhcpv4c_get_if_mask(DHCPV4C_IF_ERT, pValue);
 }
 
 INT dhcpv4c_get_ert_gw(UINT* pValue)
 {
-  /*TODO: Implement Me!*/
-  (void)pValue;
-  return (INT)0;
+  return dhcpv4c_get_if_gw(DHCPV4C_IF_ERT, pValue);
 }
 
 INT dhcpv4c_get_ert_dns_svrs(dhcpv4c_ip_list_t* pList)
 {
-  /*TODO: Implement Me!*/
-  (void)pList;
-  return (INT)0;
+  return dhcpv4c_get_if_dns_svrs(DHCPV4C_IF_ERT, pList);
 }
 
 INT dhcpv4c_get_ert_dhcp_svr(UINT* pValue)
 {
-  /*TODO: Implement Me!*/
-  (void)pValue;
-  return (INT)0;
+  return dhcpv4c_get_if_dhcp_svr(DHCPV4C_IF_ERT, pValue);
+}
+
+INT dhcpv4c_get_ert_snapshot(dhcpv4c_lease_snapshot_t* pSnapshot)
+{
+  return dhcpv4c_get_if_snapshot(DHCPV4C_IF_ERT, pSnapshot);
 }
 
 INT dhcpv4c_get_ecm_lease_time(UINT* pValue)
 {
-  /*TODO: Implement Me!*/
-  (void)pValue;
-  return (INT)0;
+  return dhcpv4c_get_if_lease_time(DHCPV4C_IF_ECM, pValue);
 }
 
 INT dhcpv4c_get_ecm_remain_lease_time(UINT* pValue)
 {
-  /*TODO: Implement Me!*/
-  (void)pValue;
-  return (INT)0;
+  return dhcpv4c_get_if_remain_lease_time(DHCPV4C_IF_ECM, pValue);
 }
 
 INT dhcpv4c_get_ecm_remain_renew_time(UINT* pValue)
 {
-  /*TODO: Implement Me!*/
-  (void)pValue;
-  return (INT)0;
+  return dhcpv4c_get_if_remain_renew_time(DHCPV4C_IF_ECM, pValue);
 }
 
 INT dhcpv4c_get_ecm_remain_rebind_time(UINT* pValue)
 {
-  /*TODO: Implement Me!*/
-  (void)pValue;
-  return (INT)0;
+  return dhcpv4c_get_if_remain_rebind_time(DHCPV4C_IF_ECM, pValue);
 }
 
 INT dhcpv4c_get_ecm_config_attempts(INT* pValue)
 {
-  /*TODO: Implement Me!*/
-  (void)pValue;
-  return (INT)0;
+  return dhcpv4c_get_if_config_attempts(DHCPV4C_IF_ECM, pValue);
 }
 
 INT dhcpv4c_get_ecm_ifname(CHAR* pName)
 {
-  /*TODO: Implement Me!*/
-  (void)pName;
-  return (INT)0;
+  return dhcpv4c_get_if_ifname(DHCPV4C_IF_ECM, pName);
 }
 
 INT dhcpv4c_get_ecm_fsm_state(INT* pValue)
 {
-  /*TODO: Implement Me!*/
-  (void)pValue;
-  return (INT)0;
+  return dhcpv4c_get_if_fsm_state(DHCPV4C_IF_ECM, pValue);
 }
 
 INT dhcpv4c_get_ecm_ip_addr(UINT* pValue)
 {
-  /*TODO: Implement Me!*/
-  (void)pValue;
-  return (INT)0;
+  return dhcpv4c_get_if_ip_addr(DHCPV4C_IF_ECM, pValue);
 }
 
 INT dhcpv4c_get_ecm_mask(UINT* pValue)
 {
-  /*TODO: Implement Me!*/
-  (void)pValue;
-  return (INT)0;
+  return dhcpv4c_get_if_mask(DHCPV4C_IF_ECM, pValue);
 }
 
 INT dhcpv4c_get_ecm_gw(UINT* pValue)
 {
-  /*TODO: Implement Me!*/
-  (void)pValue;
-  return (INT)0;
+  return dhcpv4c_get_if_gw(DHCPV4C_IF_ECM, pValue);
 }
 
 INT dhcpv4c_get_ecm_dns_svrs(dhcpv4c_ip_list_t* pList)
 {
-  /*TODO: Implement Me!*/
-  (void)pList;
-  return (INT)0;
+  return dhcpv4c_get_if_dns_svrs(DHCPV4C_IF_ECM, pList);
 }
 
 INT dhcpv4c_get_ecm_dhcp_svr(UINT* pValue)
 {
-  /*TODO: Implement Me!*/
-  (void)pValue;
-  return (INT)0;
+  return dhcpv4c_get_if_dhcp_svr(DHCPV4C_IF_ECM, pValue);
+}
+
+INT dhcpv4c_get_ecm_snapshot(dhcpv4c_lease_snapshot_t* pSnapshot)
+{
+  return dhcpv4c_get_if_snapshot(DHCPV4C_IF_ECM, pSnapshot);
 }
 
 INT dhcpv4c_get_emta_remain_lease_time(UINT* pValue)
 {
-  /*TODO: Implement Me!*/
-  (void)pValue;
-  return (INT)0;
+  return dhcpv4c_get_if_remain_lease_time(DHCPV4C_IF_EMTA, pValue);
 }
 
 INT dhcpv4c_get_emta_remain_renew_time(UINT* pValue)
 {
-  /*TODO: Implement Me!*/
-  (void)pValue;
-  return (INT)0;
+  return dhcpv4c_get_if_remain_renew_time(DHCPV4C_IF_EMTA, pValue);
 }
 
 INT dhcpv4c_get_emta_remain_rebind_time(UINT* pValue)
 {
-  /*TODO: Implement Me!*/
-  (void)pValue;
-  return (INT)0;
+  return dhcpv4c_get_if_remain_rebind_time(DHCPV4C_IF_EMTA, pValue);
+}
+
+INT dhcpv4c_get_emta_snapshot(dhcpv4c_emta_snapshot_t* pSnapshot)
+{
+  dhcp_lease_timers_t timers;
+  dhcp_lease_t lease;
+  uint64_t now_ns;
+
+  if (pSnapshot == NULL || dhcp_lease_source_get(DHCP_LEASE_IF_EMTA, &lease, &timers, &now_ns) != 0)
+  {
+    return STATUS_FAILURE;
+  }
+  pSnapshot->remain_lease_time = timers.remain_lease;
+  pSnapshot->remain_renew_time = timers.remain_renew;
+  pSnapshot->remain_rebind_time = timers.remain_rebind;
+  pSnapshot->timestamp_ns = now_ns;
+  return STATUS_SUCCESS;
 }
 
+/* DHCPV4C_LEASE_EVENT_* bits are 1 << dhcp_lease_if_t */
+#define LEASE_EVENT_ALL  (DHCPV4C_LEASE_EVENT_ERT | DHCPV4C_LEASE_EVENT_ECM | DHCPV4C_LEASE_EVENT_EMTA)
+
+typedef struct
+{
+  dhcpv4c_lease_callback_t callback;
+  void* pUserData;
+} lease_subscriber_t;
+
+static void lease_event(const dhcp_lease_event_t* pEvent, void* pUserData)
+{
+  const lease_subscriber_t* pSubscriber = (const lease_subscriber_t*)pUserData;
+  dhcpv4c_lease_event_t event;
+
+  event.iface = 1U << pEvent->iface;
+  event.fsm_state = pEvent->fsm_state;
+  event.ip_addr = pEvent->ip_addr;
+  event.timestamp_ns = pEvent->timestamp_ns;
+  pSubscriber->callback(&event, pSubscriber->pUserData);
+}
+
+INT dhcpv4c_lease_subscribe(UINT ifaceMask, dhcpv4c_lease_callback_t callback, void* pUserData, INT* pHandle)
+{
+  lease_subscriber_t* pSubscriber;
+  int handle;
+
+  if ((ifaceMask & LEASE_EVENT_ALL) == 0 || callback == NULL || pHandle == NULL)
+  {
+    return STATUS_FAILURE;
+  }
+  pSubscriber = malloc(sizeof(*pSubscriber));
+  if (pSubscriber == NULL)
+  {
+    return STATUS_FAILURE;
+  }
+  pSubscriber->callback = callback;
+  pSubscriber->pUserData = pUserData;
+  if (dhcp_lease_notify_subscribe(ifaceMask & LEASE_EVENT_ALL, lease_event, pSubscriber, &handle) != 0)
+  {
+    free(pSubscriber);
+    return STATUS_FAILURE;
+  }
+  *pHandle = handle;
+  return STATUS_SUCCESS;
+}
+
+INT dhcpv4c_lease_subscribe_fd(UINT ifaceMask, INT* pHandle, INT* pFd)
+{
+  int handle;
+  int fd;
+
+  if ((ifaceMask & LEASE_EVENT_ALL) == 0 || pHandle == NULL || pFd == NULL ||
+      dhcp_lease_notify_subscribe_fd(ifaceMask & LEASE_EVENT_ALL, &handle, &fd) != 0)
+  {
+    return STATUS_FAILURE;
+  }
+  *pHandle = handle;
+  *pFd = fd;
+  return STATUS_SUCCESS;
+}
+
+INT dhcpv4c_lease_unsubscribe(INT handle)
+{
+  void* pSubscriber = NULL;
+
+  /* Owned by the subscription, and NULL for an eventfd one; no callback of it runs any more, unless this is it */
+  if (dhcp_lease_notify_unsubscribe(handle, &pSubscriber) != 0)
+  {
+    return STATUS_FAILURE;
+  }
+  free(pSubscriber);
+  return STATUS_SUCCESS;
+}
@@ -19,12 +19,41 @@
 #include<stdio.h>
 #include <ut.h>
 #include <ut_log.h>
+#include "test_runner.h"
+#include "test_harness.h"
+#include "test_results.h"
+#include "test_log.h"
+#include "test_capture.h"
 
 extern int register_hal_l1_tests( void );
+extern int register_hal_l2_tests( void );
 
 int main(int argc, char** argv)
 {
     int registerReturn = 0;
+    int runReturn = 0;
+    test_runner_config_t runner;
+    test_capture_config_t capture;
+
+    /* --jobs/--timeout/--deadline/--log/--capture/--results-* are ours, UT_init() would reject them */
+    test_runner_parse_args( &argc, argv, &runner );
+    test_harness_parse_args( &argc, argv );
+    if (test_log_parse_args( &argc, argv ) != 0)
+    {
+        printf("test_log_parse_args() returned failure");
+        return 1;
+    }
+    if (test_results_parse_args( &argc, argv ) != 0)
+    {
+        printf("test_results_parse_args() returned failure");
+        return 1;
+    }
+    /* Capture mode records the getters' responses instead of running the tests */
+    test_capture_parse_args( &argc, argv, &capture );
+    if (capture.enabled)
+    {
+        return (test_capture_run( &capture ) == 0) ? 0 : 1;
+    }
     /* Register tests as required, then call the UT-main to support switches and triggering */
     UT_init( argc, argv );
     /* Check if tests are registered successfully */
@@ -38,9 +67,41 @@ int main(int argc, char** argv)
         printf("register_hal_l1_tests() returned failure");
         return 1;
     }
+    registerReturn = register_hal_l2_tests();
+    if (registerReturn == 0)
+    {
+        printf("register_hal_l2_tests() returned success");
+    }
+    else
+    {
+        printf("register_hal_l2_tests() returned failure");
+        return 1;
+    }
+
+    /* Time every test and abandon any that overruns --deadline */
+    if (test_harness_install() != 0)
+    {
+        printf("test_harness_install() returned failure");
+        return 1;
+    }
+
+    /* Begin test executions, each test in a process of its own with --jobs */
+    if (runner.enabled)
+    {
+        runReturn = (test_runner_run( &runner ) == 0) ? 0 : 1;
+    }
+    else
+    {
+        UT_run_tests();
+        test_harness_report();
+    }
 
-    /* Begin test executions */
-    UT_run_tests();
+    /* JSON Lines records were streamed during the run; this writes the rest and the JUnit file */
+    if (test_results_finish() != 0)
+    {
+        printf("test_results_finish() returned failure");
+        return 1;
+    }
 
-    return 0;
+    return runReturn;
 }
\ No newline at end of file
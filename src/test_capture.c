@@ -0,0 +1,329 @@
+/*
+* If not stated otherwise in this file or this component's LICENSE file the
+* following copyright and licenses apply:*
+* Copyright 2023 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+/**
+* @file test_capture.c
+*
+* Capture mode, see test_capture.h.
+*
+* Every getter of the table is called in turn, once per interval, on
+* absolute deadlines so that slow getters do not stretch the interval. A
+* record is encoded into a local buffer and appended through stdio, which
+* writes the trace in blocks; the trace is complete once the capture ends,
+* and a record cut short by a crash is ignored on replay.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <signal.h>
+#include <time.h>
+#include "test_capture.h"
+#include "test_getters.h"
+#include "dhcp_lease_replay.h"
+
+/* The family captured; a trace replays through either skeleton */
+#if defined(DHCPV4C_API)
+#define CAPTURE_FAMILY  "dhcpv4c_api"
+#define CAPTURE_TABLE   test_getters_dhcpv4c_api
+#else
+#define CAPTURE_FAMILY  "dhcp4cApi"
+#define CAPTURE_TABLE   test_getters_dhcp4cApi
+#endif
+
+#define CAPTURE_BUFFER  65536
+
+/* Getter table names of the base interfaces and lease fields, in dhcp_lease_if_t and item order */
+static const char *const gInterfaces[DHCP_LEASE_IF_MAX] = { "ert", "ecm", "emta" };
+static const char *const gItems[DHCP_LEASE_REPLAY_ITEMS] =
+{
+    "lease_time", "remain_lease_time", "remain_renew_time", "remain_rebind_time", "config_attempts", "fsm_state",
+    "ip_addr", "mask", "gw", "dhcp_svr", "ifname", "dns_svrs"
+};
+
+typedef struct
+{
+    const test_getter_t *pGetter;
+    int      have;          /* A record was written, status and output hold it */
+    int32_t  status;
+    uint32_t length;
+    uint8_t  output[DHCP_LEASE_REPLAY_OUTPUT_MAX];
+} capture_channel_t;
+
+static volatile sig_atomic_t gStop = 0;
+
+static void on_signal( int signum )
+{
+    (void)signum;
+    gStop = 1;
+}
+
+static uint64_t monotonic_ns( void )
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/* Matches "--name value" or "--name=value"; returns the number of arguments used, 0 if argv[i] is not the option */
+static int match_option( const char *pName, int argc, char **argv, int i, const char **ppValue )
+{
+    size_t length = strlen(pName);
+
+    if (strncmp(argv[i], pName, length) != 0)
+    {
+        return 0;
+    }
+    if (argv[i][length] == '=')
+    {
+        *ppValue = &argv[i][length + 1];
+        return 1;
+    }
+    if (argv[i][length] == '\0' && i + 1 < argc)
+    {
+        *ppValue = argv[i + 1];
+        return 2;
+    }
+    return 0;
+}
+
+static int find_name( const char *const *ppNames, uint32_t count, const char *pName )
+{
+    uint32_t i;
+
+    for (i = 0; i < count; i++)
+    {
+        if (strcmp(ppNames[i], pName) == 0)
+        {
+            return (int)i;
+        }
+    }
+    return -1;
+}
+
+/* Bytes of a successful output worth keeping: a name up to its NUL, a list up to its last address */
+static uint32_t output_length( const test_getter_t *pGetter, const uint8_t *pOutput, int status )
+{
+    uint32_t size = (pGetter->outputSize < DHCP_LEASE_REPLAY_OUTPUT_MAX) ? pGetter->outputSize : DHCP_LEASE_REPLAY_OUTPUT_MAX;
+    uint32_t length;
+    int number;
+
+    if (status != 0)
+    {
+        return 0;
+    }
+    switch (pGetter->output)
+    {
+        case GETTER_OUTPUT_STRING:
+            length = (uint32_t)strnlen((const char *)pOutput, size);
+            return (length < size) ? length + 1 : size;
+        case GETTER_OUTPUT_IPV4_LIST:
+            memcpy(&number, pOutput, sizeof(number));
+            if (number < 0)
+            {
+                number = 0;
+            }
+            if ((uint32_t)number > (size - sizeof(number)) / sizeof(uint32_t))
+            {
+                number = (int)((size - sizeof(number)) / sizeof(uint32_t));
+            }
+            return (uint32_t)(sizeof(number) + number * sizeof(uint32_t));
+        default:
+            return size;
+    }
+}
+
+void test_capture_parse_args( int *pArgc, char **argv, test_capture_config_t *pConfig )
+{
+    const char *pValue = NULL;
+    int used;
+    int out = 1;
+    int i;
+
+    pConfig->enabled = 0;
+    pConfig->pPath = NULL;
+    pConfig->interval_ms = TEST_CAPTURE_DEFAULT_INTERVAL_MS;
+    pConfig->count = 0;
+    for (i = 1; i < *pArgc; i += (used > 0) ? used : 1)
+    {
+        used = match_option("--capture", *pArgc, argv, i, &pConfig->pPath);
+        if (used > 0)
+        {
+            pConfig->enabled = 1;
+            continue;
+        }
+        used = match_option("--capture-interval", *pArgc, argv, i, &pValue);
+        if (used > 0)
+        {
+            pConfig->interval_ms = (uint32_t)strtoul(pValue, NULL, 0);
+            continue;
+        }
+        used = match_option("--capture-count", *pArgc, argv, i, &pValue);
+        if (used > 0)
+        {
+            pConfig->count = (uint32_t)strtoul(pValue, NULL, 0);
+            continue;
+        }
+        argv[out++] = argv[i];
+    }
+    argv[out] = NULL;
+    *pArgc = out;
+}
+
+int test_capture_run( const test_capture_config_t *pConfig )
+{
+    capture_channel_t channels[DHCP_LEASE_REPLAY_CHANNELS_MAX];
+    dhcp_lease_replay_channel_t table[DHCP_LEASE_REPLAY_CHANNELS_MAX];
+    dhcp_lease_replay_header_t header;
+    uint8_t output[DHCP_LEASE_REPLAY_OUTPUT_MAX];
+    uint8_t record[DHCP_LEASE_REPLAY_RECORD_MAX];
+    struct sigaction action;
+    struct sigaction previous[2];
+    const test_getter_t *pGetters;
+    struct timespec realtime;
+    uint64_t records = 0;
+    uint64_t changed = 0;
+    uint64_t startNs;
+    uint64_t lastUs = 0;
+    uint32_t getterCount;
+    uint32_t channelCount = 0;
+    uint32_t poll;
+    uint32_t i;
+    FILE *pFile;
+    long bytes;
+    int status = 0;
+
+    pGetters = CAPTURE_TABLE(&getterCount);
+    for (i = 0; i < getterCount && channelCount < DHCP_LEASE_REPLAY_CHANNELS_MAX; i++)
+    {
+        int iface = find_name(gInterfaces, DHCP_LEASE_IF_MAX, pGetters[i].pInterface);
+        int item = find_name(gItems, DHCP_LEASE_REPLAY_ITEMS, pGetters[i].pField);
+
+        if (iface < 0 || item < 0)
+        {
+            fprintf(stderr, "capture: %s has no place in a trace, not captured\n", pGetters[i].pFunction);
+            continue;
+        }
+        memset(&channels[channelCount], 0, sizeof(channels[channelCount]));
+        channels[channelCount].pGetter = &pGetters[i];
+        table[channelCount].iface = (uint8_t)iface;
+        table[channelCount].item = (uint8_t)item;
+        channelCount++;
+    }
+
+    pFile = fopen(pConfig->pPath, "wb");
+    if (pFile == NULL)
+    {
+        fprintf(stderr, "capture: cannot create %s: %s\n", pConfig->pPath, strerror(errno));
+        return -1;
+    }
+    setvbuf(pFile, NULL, _IOFBF, CAPTURE_BUFFER);
+    clock_gettime(CLOCK_REALTIME, &realtime);
+    memset(&header, 0, sizeof(header));
+    header.magic = DHCP_LEASE_REPLAY_MAGIC;
+    header.version = DHCP_LEASE_REPLAY_VERSION;
+    header.channelCount = (uint16_t)channelCount;
+    header.intervalUs = pConfig->interval_ms * 1000U;
+    header.startRealtimeNs = (uint64_t)realtime.tv_sec * 1000000000ULL + (uint64_t)realtime.tv_nsec;
+    snprintf(header.family, sizeof(header.family), "%s", CAPTURE_FAMILY);
+    if (fwrite(&header, sizeof(header), 1, pFile) != 1 ||
+        fwrite(table, sizeof(table[0]), channelCount, pFile) != channelCount)
+    {
+        status = -1;
+    }
+
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = on_signal;
+    sigemptyset(&action.sa_mask);
+    sigaction(SIGINT, &action, &previous[0]);
+    sigaction(SIGTERM, &action, &previous[1]);
+    gStop = 0;
+    printf("capture: %u %s getters every %u ms into %s\n", channelCount, CAPTURE_FAMILY, pConfig->interval_ms, pConfig->pPath);
+    fflush(stdout);
+
+    startNs = monotonic_ns();
+    for (poll = 0; status == 0 && !gStop && (pConfig->count == 0 || poll < pConfig->count); poll++)
+    {
+        uint64_t deadlineNs = startNs + (uint64_t)poll * pConfig->interval_ms * 1000000ULL;
+        struct timespec deadline = { (time_t)(deadlineNs / 1000000000ULL), (long)(deadlineNs % 1000000000ULL) };
+
+        /* EINTR from SIGINT or SIGTERM ends the capture */
+        if (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline, NULL) != 0 && gStop)
+        {
+            break;
+        }
+        for (i = 0; i < channelCount && status == 0; i++)
+        {
+            capture_channel_t *pChannel = &channels[i];
+            uint64_t callNs;
+            uint64_t endNs;
+            uint64_t callUs;
+            uint32_t length;
+            uint32_t used;
+            int result;
+            int same;
+
+            memset(output, 0, sizeof(output));
+            callNs = monotonic_ns();
+            result = pChannel->pGetter->call(output);
+            endNs = monotonic_ns();
+            length = output_length(pChannel->pGetter, output, result);
+            same = pChannel->have && pChannel->status == result && pChannel->length == length &&
+                   memcmp(pChannel->output, output, length) == 0;
+
+            callUs = (callNs - startNs) / 1000;
+            record[0] = (uint8_t)(i | (same ? DHCP_LEASE_REPLAY_SAME : 0));
+            used = 1;
+            used += dhcp_lease_replay_put_varint(&record[used], callUs - lastUs);
+            used += dhcp_lease_replay_put_varint(&record[used], endNs - callNs);
+            if (!same)
+            {
+                /* Zigzag: small negative statuses stay short */
+                used += dhcp_lease_replay_put_varint(&record[used], ((uint64_t)(int64_t)result << 1) ^ (uint64_t)((int64_t)result >> 63));
+                used += dhcp_lease_replay_put_varint(&record[used], length);
+                memcpy(&record[used], output, length);
+                used += length;
+                pChannel->have = 1;
+                pChannel->status = result;
+                pChannel->length = length;
+                memcpy(pChannel->output, output, length);
+                changed++;
+            }
+            lastUs = callUs;
+            if (fwrite(record, 1, used, pFile) != used)
+            {
+                status = -1;
+            }
+            records++;
+        }
+    }
+    sigaction(SIGINT, &previous[0], NULL);
+    sigaction(SIGTERM, &previous[1], NULL);
+
+    bytes = ftell(pFile);
+    if (fclose(pFile) != 0 || status != 0)
+    {
+        fprintf(stderr, "capture: cannot write %s: %s\n", pConfig->pPath, strerror(errno));
+        return -1;
+    }
+    printf("capture: %llu calls in %.1f s, %llu with a new status or output, %ld bytes\n", (unsigned long long)records,
+           (double)(monotonic_ns() - startNs) / 1e9, (unsigned long long)changed, bytes);
+    return 0;
+}
@@ -0,0 +1,76 @@
+/*
+* If not stated otherwise in this file or this component's LICENSE file the
+* following copyright and licenses apply:*
+* Copyright 2023 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+/**
+* @file test_capture.h
+*
+* Capture mode: records what the getters of a device return.
+*
+* Instead of running the tests, dhcp4_hal_test --capture PATH calls every
+* getter of the family table (test_getters.h) once per interval and writes
+* each call's time, duration, return code and output into a trace, in the
+* format of skeletons/include/dhcp_lease_replay.h. A call whose return code
+* and output are the same as the getter's previous one takes a few bytes.
+* The linux skeletons serve the trace back with DHCP_LEASE_REPLAY, so that
+* the tests and benchmarks run against what the device did.
+*/
+
+#ifndef __TEST_CAPTURE_H__
+#define __TEST_CAPTURE_H__
+
+#include <stdint.h>
+
+#define TEST_CAPTURE_DEFAULT_INTERVAL_MS  1000
+
+/**
+* @brief Capture options
+*/
+typedef struct
+{
+    int         enabled;        /*!< Non-zero when --capture was given */
+    const char *pPath;          /*!< Trace to write */
+    uint32_t    interval_ms;    /*!< Between two calls of one getter */
+    uint32_t    count;          /*!< Calls of each getter, 0 until interrupted */
+} test_capture_config_t;
+
+/**
+* @brief Takes the capture options out of the command line
+*
+* Recognises "--capture PATH", "--capture-interval MS" and
+* "--capture-count N" (also in the --name=value form) and removes them, so
+* that the remaining arguments can be passed to UT_init() unchanged.
+*
+* @param[in,out] pArgc   - Argument count, reduced by the options removed
+* @param[in,out] argv    - Arguments, compacted in place
+* @param[out]    pConfig - Receives the options
+*/
+void test_capture_parse_args( int *pArgc, char **argv, test_capture_config_t *pConfig );
+
+/**
+* @brief Captures the getters until the count is reached, SIGINT or SIGTERM
+*
+* Prints how many calls were recorded, how many changed, and the size of
+* the trace.
+*
+* @param[in] pConfig - Options from test_capture_parse_args()
+*
+* @return 0 on success, -1 if the trace cannot be written
+*/
+int test_capture_run( const test_capture_config_t *pConfig );
+
+#endif /* __TEST_CAPTURE_H__ */
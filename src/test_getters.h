@@ -0,0 +1,101 @@
+/*
+* If not stated otherwise in this file or this component's LICENSE file the
+* following copyright and licenses apply:*
+* Copyright 2023 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+/**
+* @file test_getters.h
+*
+* Descriptor tables of the single-output getters of both HAL families.
+*
+* One entry per getter says how to call it, what it writes and what a valid
+* output looks like. The L1 tests generate their positive and negative cases
+* from these tables (test_l1_getters.h) and dhcp4_hal_bench times the same
+* entries, so adding a getter to a family is one line in its table.
+*/
+
+#ifndef __TEST_GETTERS_H__
+#define __TEST_GETTERS_H__
+
+#include <stdint.h>
+
+/* What a getter writes through its pointer argument */
+typedef enum
+{
+    GETTER_OUTPUT_UNSIGNED = 0,     /* Unsigned value: lease and remaining times */
+    GETTER_OUTPUT_SIGNED,           /* Signed value: config attempts, FSM state */
+    GETTER_OUTPUT_STRING,           /* NUL-terminated string, interface names */
+    GETTER_OUTPUT_IPV4,             /* Address in network byte order */
+    GETTER_OUTPUT_IPV4_LIST         /* { int number; uint32_t addresses[]; } */
+} getter_output_t;
+
+/* What the positive test checks in a successful output, beyond the status */
+typedef enum
+{
+    GETTER_RULE_NONE = 0,
+    GETTER_RULE_TERMINATED,         /* The string ends inside the output buffer */
+    GETTER_RULE_NETMASK,            /* Contiguous ones from the most significant bit */
+    GETTER_RULE_LIST_BOUNDS         /* 0 <= number <= capacity of the list */
+} getter_rule_t;
+
+/**
+* @brief One getter of a HAL family
+*/
+typedef struct
+{
+    const char     *pFunction;      /*!< HAL function name, for logs and bench reports */
+    int           (*call)( void *pOut ); /*!< Calls the getter, returns its status */
+    const char     *pInterface;     /*!< "ert", "ecm" or "emta" */
+    const char     *pField;         /*!< Lease field, e.g. "remain_renew_time" */
+    getter_output_t output;
+    uint32_t        outputSize;     /*!< Bytes the getter may write */
+    getter_rule_t   rule;
+    int             varying;        /*!< Output legitimately changes between calls (timers, FSM state) */
+    const char     *pPositiveTest;  /*!< Registered test names, kept from the hand-written tests */
+    const char     *pNegativeTest;
+} test_getter_t;
+
+/**
+* @brief Returns the dhcp4cApi getter table
+*
+* @param[out] pCount - Receives the number of entries
+*/
+const test_getter_t *test_getters_dhcp4cApi( uint32_t *pCount );
+
+/**
+* @brief Returns the dhcpv4c_api getter table
+*
+* @param[out] pCount - Receives the number of entries
+*/
+const test_getter_t *test_getters_dhcpv4c_api( uint32_t *pCount );
+
+/*
+* Helpers for the family tables, which are written as
+* X(interface, field, C type, element count, output, rule, varying, positive test, negative test).
+* GETTER_CALL defines the wrapper giving every getter the same signature and
+* GETTER_ENTRY the table entry using it.
+*/
+#define GETTER_CALL(prefix, iface, field, type, count, output, rule, varying, positive, negative) \
+    static int getter_##iface##_##field( void *pOut ) \
+    { \
+        return prefix##iface##_##field((type *)pOut); \
+    }
+
+#define GETTER_ENTRY(prefix, iface, field, type, count, output, rule, varying, positive, negative) \
+    { #prefix #iface "_" #field, getter_##iface##_##field, #iface, #field, GETTER_OUTPUT_##output, \
+      (uint32_t)(sizeof(type) * (count)), GETTER_RULE_##rule, varying, positive, negative },
+
+#endif /* __TEST_GETTERS_H__ */
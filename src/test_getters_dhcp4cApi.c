@@ -0,0 +1,132 @@
+/*
+* If not stated otherwise in this file or this component's LICENSE file the
+* following copyright and licenses apply:*
+* Copyright 2023 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+/**
+* @file test_getters_dhcp4cApi.c
+*
+* Getter table of the dhcp4cApi family, see test_getters.h.
+*
+* Rows are X(interface, field, C type, element count, output, rule, varying,
+* positive test, negative test), in the order of the test IDs: entry n is
+* tested by cases 2n+1 (positive) and 2n+2 (negative).
+*/
+
+#include <stddef.h>
+#include "dhcp4cApi.h"
+#include "test_getters.h"
+
+#define DHCP4C_GETTERS(X) \
+    X(ert, lease_time, unsigned int, 1, UNSIGNED, NONE, 0, \
+      "l1_dhcp4cApi_hal_positive1_dhcp4c_get_ert_lease_time", \
+      "l1_dhcp4cApi_hal_negative1_dhcp4c_get_ert_lease_time") \
+    X(ert, remain_lease_time, unsigned int, 1, UNSIGNED, NONE, 1, \
+      "l1_dhcp4cApi_hal_positive1_dhcp4c_get_ert_remain_lease_time", \
+      "l1_dhcp4cApi_hal_negative1_dhcp4c_get_ert_remain_lease_time") \
+    X(ert, remain_renew_time, unsigned int, 1, UNSIGNED, NONE, 1, \
+      "l1_dhcp4cApi_hal_positive1_get_ert_remain_renew_time", \
+      "l1_dhcp4cApi_hal_negative1_get_ert_remain_renew_time") \
+    X(ert, remain_rebind_time, unsigned int, 1, UNSIGNED, NONE, 1, \
+      "l1_dhcp4cApi_hal_positive1_dhcp4c_get_ert_remain_rebind_time", \
+      "l1_dhcp4cApi_hal_negative1_dhcp4c_get_ert_remain_rebind_time") \
+    X(ert, config_attempts, int, 1, SIGNED, NONE, 0, \
+      "l1_dhcp4cApi_hal_positive1_dhcp4c_get_ert_config_attempts", \
+      "l1_dhcp4cApi_hal_negative1_dhcp4c_get_ert_config_attempts") \
+    X(ert, ifname, char, 64, STRING, TERMINATED, 0, \
+      "l1_dhcp4cApi_hal_positive1_dhcp4c_get_ert_ifname", \
+      "l1_dhcp4cApi_hal_negative1_dhcp4c_get_ert_ifname") \
+    X(ert, fsm_state, int, 1, SIGNED, NONE, 1, \
+      "l1_dhcp4cApi_hal_positive1_GetErtFsmState", \
+      "l1_dhcp4cApi_hal_negative1_GetErtFsmState_NullPointer") \
+    X(ert, ip_addr, unsigned int, 1, IPV4, NONE, 0, \
+      "l1_dhcp4cApi_hal_positive1_dhcp4c_get_ert_ip_addr", \
+      "l1_dhcp4cApi_hal_negative1_dhcp4c_get_ert_ip_addr") \
+    X(ert, mask, unsigned int, 1, IPV4, NETMASK, 0, \
+      "l1_dhcp4cApi_hal_positive1_dhcp4c_get_ert_mask", \
+      "l1_dhcp4cApi_hal_negative1_dhcp4c_get_ert_mask") \
+    X(ert, gw, unsigned int, 1, IPV4, NONE, 0, \
+      "l1_dhcp4cApi_hal_positive1_get_ert_gw", \
+      "l1_dhcp4cApi_hal_negative1_get_ert_gw") \
+    X(ert, dns_svrs, ipv4AddrList_t, 1, IPV4_LIST, LIST_BOUNDS, 0, \
+      "l1_dhcp4cApi_hal_positive1_get_ert_dns_svrs", \
+      "l1_dhcp4cApi_hal_negative1_get_ert_dns_svrs") \
+    X(ert, dhcp_svr, unsigned int, 1, IPV4, NONE, 0, \
+      "l1_dhcp4cApi_hal_positive1_get_ert_dhcp_svr", \
+      "l1_dhcp4cApi_hal_negative1_get_ert_dhcp_svr") \
+    X(ecm, lease_time, unsigned int, 1, UNSIGNED, NONE, 0, \
+      "l1_dhcp4cApi_hal_positive1_dhcp4c_get_ecm_lease_time", \
+      "l1_dhcp4cApi_hal_negative1_dhcp4c_get_ecm_lease_time") \
+    X(ecm, remain_lease_time, unsigned int, 1, UNSIGNED, NONE, 1, \
+      "l1_dhcp4cApi_hal_positive1_dhcp4c_get_ecm_remain_lease_time", \
+      "l1_dhcp4cApi_hal_negative1_dhcp4c_get_ecm_remain_lease_time") \
+    X(ecm, remain_renew_time, unsigned int, 1, UNSIGNED, NONE, 1, \
+      "l1_dhcp4cApi_hal_positive1_dhcp4c_get_ecm_remain_renew_time", \
+      "l1_dhcp4cApi_hal_negative1_dhcp4c_get_ecm_remain_renew_time") \
+    X(ecm, remain_rebind_time, unsigned int, 1, UNSIGNED, NONE, 1, \
+      "l1_dhcp4c_get_ecm_remain_rebind_time_positive1", \
+      "l1_dhcp4c_get_ecm_remain_rebind_time_negative1") \
+    X(ecm, config_attempts, int, 1, SIGNED, NONE, 0, \
+      "l1_dhcp4cApi_hal_positive1_get_ecm_config_attempts", \
+      "l1_dhcp4cApi_hal_negative1_get_ecm_config_attempts") \
+    X(ecm, ifname, char, 64, STRING, TERMINATED, 0, \
+      "l1_dhcp4cApi_hal_positive1_dhcp4c_get_ecm_ifname", \
+      "l1_dhcp4cApi_hal_negative1_dhcp4c_get_ecm_ifname") \
+    X(ecm, fsm_state, int, 1, SIGNED, NONE, 1, \
+      "l1_dhcp4cApi_hal_positive1_dhcp4c_get_ecm_fsm_state", \
+      "l1_dhcp4cApi_hal_negative1_dhcp4c_get_ecm_fsm_state") \
+    X(ecm, ip_addr, unsigned int, 1, IPV4, NONE, 0, \
+      "l1_dhcp4cApi_hal_positive1_dhcp4c_get_ecm_ip_addr", \
+      "l1_dhcp4cApi_hal_negative1_dhcp4c_get_ecm_ip_addr") \
+    X(ecm, mask, unsigned int, 1, IPV4, NETMASK, 0, \
+      "l1_dhcp4cApi_hal_positive1_dhcp4c_get_ecm_mask", \
+      "l1_dhcp4cApi_hal_negative1_dhcp4c_get_ecm_mask") \
+    X(ecm, gw, unsigned int, 1, IPV4, NONE, 0, \
+      "l1_dhcp4cApi_hal_positive1_dhcp4c_get_ecm_gw", \
+      "l1_dhcp4cApi_hal_negative1_dhcp4c_get_ecm_gw") \
+    X(ecm, dns_svrs, ipv4AddrList_t, 1, IPV4_LIST, LIST_BOUNDS, 0, \
+      "l1_dhcp4cApi_hal_positive2_dhcp4c_get_ecm_dns_svrs", \
+      "l1_dhcp4cApi_hal_negative1_dhcp4c_get_ecm_dns_svrs") \
+    X(ecm, dhcp_svr, unsigned int, 1, IPV4, NONE, 0, \
+      "l1_dhcp4cApi_hal_positive1_dhcp4c_get_ecm_dhcp_svr", \
+      "l1_dhcp4cApi_hal_negative1_dhcp4c_get_ecm_dhcp_svr") \
+    X(emta, remain_lease_time, unsigned int, 1, UNSIGNED, NONE, 1, \
+      "l1_dhcp4cApi_hal_positive1_dhcp4c_get_emta_remain_lease_time", \
+      "l1_dhcp4cApi_hal_negative1_dhcp4c_get_emta_remain_lease_time") \
+    X(emta, remain_renew_time, unsigned int, 1, UNSIGNED, NONE, 1, \
+      "l1_dhcp4cApi_hal_positive1_get_emta_remain_renew_time", \
+      "l1_dhcp4cApi_hal_negative1_get_emta_remain_renew_time") \
+    X(emta, remain_rebind_time, unsigned int, 1, UNSIGNED, NONE, 1, \
+      "l1_dhcp4cApi_hal_positive1_dhcp4c_get_emta_remain_rebind_time", \
+      "l1_dhcp4cApi_hal_negative1_dhcp4c_get_emta_remain_rebind_time")
+
+#define DHCP4C_CALL(...)   GETTER_CALL(dhcp4c_get_, __VA_ARGS__)
+#define DHCP4C_ENTRY(...)  GETTER_ENTRY(dhcp4c_get_, __VA_ARGS__)
+
+/* The engine reads the count from the first member of a list and the addresses straight after it */
+typedef char getter_list_layout_check[(offsetof(ipv4AddrList_t, addrList) == sizeof(int)) ? 1 : -1];
+
+DHCP4C_GETTERS(DHCP4C_CALL)
+
+static const test_getter_t gDhcp4cGetters[] =
+{
+    DHCP4C_GETTERS(DHCP4C_ENTRY)
+};
+
+const test_getter_t *test_getters_dhcp4cApi( uint32_t *pCount )
+{
+    *pCount = sizeof(gDhcp4cGetters) / sizeof(gDhcp4cGetters[0]);
+    return gDhcp4cGetters;
+}
@@ -0,0 +1,132 @@
+/*
+* If not stated otherwise in this file or this component's LICENSE file the
+* following copyright and licenses apply:*
+* Copyright 2023 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+/**
+* @file test_getters_dhcpv4c_api.c
+*
+* Getter table of the dhcpv4c_api family, see test_getters.h.
+*
+* Rows are X(interface, field, C type, element count, output, rule, varying,
+* positive test, negative test), in the order of the test IDs: entry n is
+* tested by cases 2n+1 (positive) and 2n+2 (negative).
+*/
+
+#include <stddef.h>
+#include "dhcpv4c_api.h"
+#include "test_getters.h"
+
+#define DHCPV4C_GETTERS(X) \
+    X(ert, lease_time, UINT, 1, UNSIGNED, NONE, 0, \
+      "l1_dhcpv4c_api_positive1_dhcpv4c_get_ert_lease_time", \
+      "l1_dhcpv4c_api_negative1_dhcpv4c_get_ert_lease_time") \
+    X(ert, remain_lease_time, UINT, 1, UNSIGNED, NONE, 1, \
+      "l1_dhcpv4c_api_positive1_dhcpv4c_get_ert_remain_lease_time", \
+      "l1_dhcpv4c_api_negative1_dhcpv4c_get_ert_remain_lease_time") \
+    X(ert, remain_renew_time, UINT, 1, UNSIGNED, NONE, 1, \
+      "l1_dhcpv4c_api_positive1_dhcpv4c_get_ert_remain_renew_time", \
+      "l1_dhcpv4c_api_negative1_dhcpv4c_get_ert_remain_renew_time") \
+    X(ert, remain_rebind_time, UINT, 1, UNSIGNED, NONE, 1, \
+      "l1_dhcpv4c_api_positive1_dhcpv4c_get_ert_remain_rebind_time", \
+      "l1_dhcpv4c_api_negative1_dhcpv4c_get_ert_remain_rebind_time") \
+    X(ert, config_attempts, INT, 1, SIGNED, NONE, 0, \
+      "l1_dhcpv4c_api_positive1_dhcpv4c_get_ert_config_attempts", \
+      "l1_dhcpv4c_api_negative1_dhcpv4c_get_ert_config_attempts") \
+    X(ert, ifname, CHAR, 64, STRING, TERMINATED, 0, \
+      "l1_dhcpv4c_api_positive1_dhcpv4c_get_ert_ifname", \
+      "l1_dhcpv4c_api_negative1_dhcpv4c_get_ert_ifname") \
+    X(ert, fsm_state, INT, 1, SIGNED, NONE, 1, \
+      "l1_dhcpv4c_api_positive1_dhcpv4c_get_ert_fsm_state", \
+      "l1_dhcpv4c_api_negative1_dhcpv4c_get_ert_fsm_state") \
+    X(ert, ip_addr, UINT, 1, IPV4, NONE, 0, \
+      "l1_dhcpv4c_api_positive1_dhcpv4c_get_ert_ip_addr", \
+      "l1_dhcpv4c_api_negative1_dhcpv4c_get_ert_ip_addr") \
+    X(ert, mask, UINT, 1, IPV4, NETMASK, 0, \
+      "l1_dhcpv4c_api_positive1_dhcpv4c_get_ert_mask", \
+      "l1_dhcpv4c_api_negative1_dhcpv4c_dhcpv4c_get_ert_mask") \
+    X(ert, gw, UINT, 1, IPV4, NONE, 0, \
+      "l1_dhcpv4c_api_positive1_dhcpv4c_get_ert_gw", \
+      "l1_dhcpv4c_api_negative1_dhcpv4c_get_ert_gw") \
+    X(ert, dns_svrs, dhcpv4c_ip_list_t, 1, IPV4_LIST, LIST_BOUNDS, 0, \
+      "l1_dhcpv4c_api_positive1_dhcpv4c_get_ert_dns_svrs", \
+      "l1_dhcpv4c_api_negative1_dhcpv4c_get_ert_dns_svrs") \
+    X(ert, dhcp_svr, UINT, 1, IPV4, NONE, 0, \
+      "l1_dhcpv4c_api_positive1_dhcpv4c_get_ert_dhcp_svr", \
+      "l1_dhcpv4c_api_negative1_dhcpv4c_get_ert_dhcp_svr") \
+    X(ecm, lease_time, UINT, 1, UNSIGNED, NONE, 0, \
+      "l1_dhcpv4c_api_positive1_dhcpv4c_get_ecm_lease_time", \
+      "l1_dhcpv4c_api_negative1_dhcpv4c_get_ecm_lease_time") \
+    X(ecm, remain_lease_time, UINT, 1, UNSIGNED, NONE, 1, \
+      "l1_dhcpv4c_api_positive1_dhcpv4c_get_ecm_remain_lease_time", \
+      "l1_dhcpv4c_api_negative1_dhcpv4c_get_ecm_remain_lease_time") \
+    X(ecm, remain_renew_time, UINT, 1, UNSIGNED, NONE, 1, \
+      "l1_dhcpv4c_api_positive1_dhcpv4c_get_ecm_remain_renew_time", \
+      "l1_dhcpv4c_api_negative1_dhcpv4c_get_ecm_remain_renew_time") \
+    X(ecm, remain_rebind_time, UINT, 1, UNSIGNED, NONE, 1, \
+      "l1_dhcpv4c_api_positive1_dhcpv4c_ecm_remain_rebind_time", \
+      "l1_dhcpv4c_api_negative1_dhcpv4c_get_ecm_remain_rebind_time") \
+    X(ecm, config_attempts, INT, 1, SIGNED, NONE, 0, \
+      "l1_dhcpv4c_api_positive1_dhcpv4c_get_ecm_config_attempts", \
+      "l1_dhcpv4c_api_negative1_dhcpv4c_ecm_config_attempts") \
+    X(ecm, ifname, CHAR, 64, STRING, TERMINATED, 0, \
+      "l1_dhcpv4c_api_positive1_dhcpv4c_get_ecm_ifname", \
+      "l1_dhcpv4c_api_negative1_dhcpv4c_get_ecm_ifname") \
+    X(ecm, fsm_state, INT, 1, SIGNED, NONE, 1, \
+      "l1_dhcpv4c_api_positive1_dhcpv4c_get_ecm_fsm_state", \
+      "l1_dhcpv4c_api_negative1_dhcpv4c_get_ecm_fsm_state") \
+    X(ecm, ip_addr, UINT, 1, IPV4, NONE, 0, \
+      "l1_dhcpv4c_api_positive1_dhcpv4c_get_ecm_ip_addr", \
+      "l1_dhcpv4c_api_negative1_dhcpv4c_get_ecm_ip_addr") \
+    X(ecm, mask, UINT, 1, IPV4, NETMASK, 0, \
+      "l1_dhcpv4c_api_positive1_dhcpv4c_get_ecm_mask", \
+      "l1_dhcpv4c_api_negative1_dhcpv4c_get_ecm_mask") \
+    X(ecm, gw, UINT, 1, IPV4, NONE, 0, \
+      "l1_dhcpv4c_api_positive1_dhcpv4c_get_ecm_gw", \
+      "l1_dhcpv4c_api_negative1_dhcpv4c_get_ecm_gw") \
+    X(ecm, dns_svrs, dhcpv4c_ip_list_t, 1, IPV4_LIST, LIST_BOUNDS, 0, \
+      "l1_dhcpv4c_api_positive1_dhcpv4c_get_ecm_dns_svrs", \
+      "l1_dhcpv4c_api_negative1_dhcpv4c_get_ecm_dns_svrs") \
+    X(ecm, dhcp_svr, UINT, 1, IPV4, NONE, 0, \
+      "l1_dhcpv4c_api_positive1_dhcpv4c_get_ecm_dhcp_svr", \
+      "l1_dhcpv4c_api_negative1_dhcpv4c_get_ecm_dhcp_svr") \
+    X(emta, remain_lease_time, UINT, 1, UNSIGNED, NONE, 1, \
+      "l1_dhcpv4c_api_positive1_dhcpv4c_get_emta_remain_lease_time", \
+      "l1_dhcpv4c_api_negative1_dhcpv4c_get_emta_remain_lease_time") \
+    X(emta, remain_renew_time, UINT, 1, UNSIGNED, NONE, 1, \
+      "l1_dhcpv4c_api_positive1_dhcpv4c_get_emta_remain_renew_time", \
+      "l1_dhcpv4c_api_negative1_dhcpv4c_get_emta_remain_renew_time") \
+    X(emta, remain_rebind_time, UINT, 1, UNSIGNED, NONE, 1, \
+      "l1_dhcpv4c_api_positive1_dhcpv4c_get_emta_remain_rebind_time", \
+      "l1_dhcpv4c_api_negative1_dhcpv4c_get_emta_remain_rebind_time")
+
+#define DHCPV4C_CALL(...)   GETTER_CALL(dhcpv4c_get_, __VA_ARGS__)
+#define DHCPV4C_ENTRY(...)  GETTER_ENTRY(dhcpv4c_get_, __VA_ARGS__)
+
+/* The engine reads the count from the first member of a list and the addresses straight after it */
+typedef char getter_list_layout_check[(offsetof(dhcpv4c_ip_list_t, addrs) == sizeof(int)) ? 1 : -1];
+
+DHCPV4C_GETTERS(DHCPV4C_CALL)
+
+static const test_getter_t gDhcpv4cGetters[] =
+{
+    DHCPV4C_GETTERS(DHCPV4C_ENTRY)
+};
+
+const test_getter_t *test_getters_dhcpv4c_api( uint32_t *pCount )
+{
+    *pCount = sizeof(gDhcpv4cGetters) / sizeof(gDhcpv4cGetters[0]);
+    return gDhcpv4cGetters;
+}
@@ -0,0 +1,427 @@
+/*
+* If not stated otherwise in this file or this component's LICENSE file the
+* following copyright and licenses apply:*
+* Copyright 2023 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <signal.h>
+#include <setjmp.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#ifdef __GLIBC__
+#include <execinfo.h>
+#endif
+#include <ut.h>
+#include <CUnit/CUnit.h>
+#include "test_harness.h"
+#include "test_results.h"
+#include "test_log.h"
+
+#define HARNESS_SIGNAL      SIGALRM
+#define HARNESS_MAX_FRAMES  64
+
+/* Older C libraries define SIGEV_THREAD_ID but not the field name */
+#ifndef sigev_notify_thread_id
+#define sigev_notify_thread_id  _sigev_un._tid
+#endif
+
+typedef struct
+{
+    CU_pTest    pTest;
+    const char *pSuiteName;
+    CU_TestFunc pFunction;          /* What the test registered */
+    uint64_t    elapsed_ns;         /* Of the last call */
+    int         timedOut;
+    uint32_t    failuresBefore;     /* CUnit's failure count when the last call started */
+} harness_entry_t;
+
+static harness_entry_t *gEntries;
+static uint32_t gEntryCount;
+static uint32_t gDeadlineMs = TEST_HARNESS_DEFAULT_DEADLINE_MS;
+
+/* The watchdog belongs to the process that created it; a forked child makes its own */
+static timer_t gTimer;
+static pid_t gTimerPid;
+
+static sigjmp_buf gEscape;
+static harness_entry_t * volatile gpRunning;
+static uint64_t gStartNs;
+static int gIsolated;               /* A runner child: a timeout ends the process */
+static int gStopped;                /* A test was abandoned in place, the rest are not run */
+static uint32_t gNotRun;
+
+static uint64_t monotonic_ns( void )
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static void write_text( const char *pText )
+{
+    ssize_t ignored = write(STDERR_FILENO, pText, strlen(pText));
+
+    (void)ignored;
+}
+
+/*
+* Runs on the stuck thread. In a runner child the process is about to end,
+* so the backtrace is worth its risk: if backtrace() blocks on a lock the
+* stuck call holds, the runner's own --timeout kills the child. In place,
+* only async-signal-safe calls are made before the jump.
+*/
+static void watchdog_fired( int signal )
+{
+    harness_entry_t *pEntry = gpRunning;
+#ifdef __GLIBC__
+    void *frames[HARNESS_MAX_FRAMES];
+    int depth;
+#endif
+
+    (void)signal;
+    /* A timer left over from a test that never returned here is not ours to act on */
+    if (pEntry == NULL || pEntry->pTest != CU_get_current_test())
+    {
+        return;
+    }
+    write_text("\nharness: TIMEOUT ");
+    write_text(pEntry->pSuiteName);
+    write_text(" ");
+    write_text(pEntry->pTest->pName);
+    if (gIsolated)
+    {
+        write_text(", stuck in:\n");
+#ifdef __GLIBC__
+        depth = backtrace(frames, HARNESS_MAX_FRAMES);
+        backtrace_symbols_fd(frames, depth, STDERR_FILENO);
+#else
+        write_text("    (no backtrace support in this C library)\n");
+#endif
+        /* The records of the tests before it in this child; the runner writes this one's */
+        test_results_flush();
+        _exit(TEST_HARNESS_TIMEOUT_EXIT);
+    }
+    write_text(", abandoned (run with --jobs for its backtrace)\n");
+    siglongjmp(gEscape, 1);
+}
+
+static int watchdog_create( void )
+{
+    struct sigevent event;
+    struct sigaction action;
+
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = watchdog_fired;
+    sigemptyset(&action.sa_mask);
+    if (sigaction(HARNESS_SIGNAL, &action, NULL) != 0)
+    {
+        return -1;
+    }
+
+    /* Aimed at the thread running the tests, not whichever thread the kernel picks */
+    memset(&event, 0, sizeof(event));
+    event.sigev_notify = SIGEV_THREAD_ID;
+    event.sigev_signo = HARNESS_SIGNAL;
+    event.sigev_notify_thread_id = (pid_t)syscall(SYS_gettid);
+    if (timer_create(CLOCK_MONOTONIC, &event, &gTimer) != 0)
+    {
+        return -1;
+    }
+    gTimerPid = getpid();
+    return 0;
+}
+
+static void watchdog_set( uint32_t ms )
+{
+    struct itimerspec when;
+
+    memset(&when, 0, sizeof(when));
+    when.it_value.tv_sec = ms / 1000;
+    when.it_value.tv_nsec = (long)(ms % 1000) * 1000000L;
+    timer_settime(gTimer, 0, &when, NULL);
+}
+
+static harness_entry_t *find_entry( CU_pTest pTest )
+{
+    uint32_t i;
+
+    for (i = 0; i < gEntryCount; i++)
+    {
+        if (gEntries[i].pTest == pTest)
+        {
+            return &gEntries[i];
+        }
+    }
+    return NULL;
+}
+
+/* The first assertion the call failed, as "file:line: condition" */
+static void failure_message( const harness_entry_t *pEntry, char *pMessage, size_t size )
+{
+    CU_pFailureRecord pFailure = CU_get_failure_list();
+    uint32_t skipped;
+
+    /* Failures are listed in order, so those of earlier calls come first */
+    for (skipped = 0; pFailure != NULL && skipped < pEntry->failuresBefore; skipped++)
+    {
+        pFailure = pFailure->pNext;
+    }
+    while (pFailure != NULL && pFailure->pTest != pEntry->pTest)
+    {
+        pFailure = pFailure->pNext;
+    }
+    if (pFailure == NULL)
+    {
+        snprintf(pMessage, size, "failed");
+        return;
+    }
+    snprintf(pMessage, size, "%s:%u: %s", (pFailure->strFileName != NULL) ? pFailure->strFileName : "?",
+             pFailure->uiLineNumber, (pFailure->strCondition != NULL) ? pFailure->strCondition : "");
+}
+
+/* Writes the results record of the call that just ended */
+static void record_call( const harness_entry_t *pEntry )
+{
+    char message[256];
+
+    if (pEntry->timedOut)
+    {
+        test_results_end(pEntry->pSuiteName, pEntry->pTest->pName, "timeout", "Test timed out", pEntry->elapsed_ns);
+    }
+    else if (CU_get_number_of_failures() > pEntry->failuresBefore)
+    {
+        failure_message(pEntry, message, sizeof(message));
+        test_results_end(pEntry->pSuiteName, pEntry->pTest->pName, "fail", message, pEntry->elapsed_ns);
+    }
+    else
+    {
+        test_results_end(pEntry->pSuiteName, pEntry->pTest->pName, "pass", NULL, pEntry->elapsed_ns);
+    }
+}
+
+/* A fatal assertion jumps straight back into CUnit, past the end of the call it was in */
+static void settle_abandoned( void )
+{
+    harness_entry_t *pAbandoned = gpRunning;
+
+    if (pAbandoned != NULL)
+    {
+        pAbandoned->elapsed_ns = monotonic_ns() - gStartNs;
+        gpRunning = NULL;
+        if (gDeadlineMs != 0 && gTimerPid == getpid())
+        {
+            watchdog_set(0);
+        }
+        test_log_flush();
+        record_call(pAbandoned);
+    }
+}
+
+/* Registered in place of every test function */
+static void harness_run_test( void )
+{
+    harness_entry_t *pEntry = find_entry(CU_get_current_test());
+    int watched;
+
+    if (pEntry == NULL)
+    {
+        return;
+    }
+    settle_abandoned();
+    if (gStopped)
+    {
+        gNotRun++;
+        test_results_begin();
+        test_results_end(pEntry->pSuiteName, pEntry->pTest->pName, "fail", "Not run: an earlier test timed out", 0);
+        UT_FAIL("Not run: an earlier test timed out");
+        return;
+    }
+
+    watched = (gDeadlineMs != 0);
+    if (watched && gTimerPid != getpid() && watchdog_create() != 0)
+    {
+        fprintf(stderr, "harness: no watchdog, %s runs without a deadline\n", pEntry->pTest->pName);
+        watched = 0;
+    }
+
+    test_results_begin();
+    pEntry->timedOut = 0;
+    pEntry->failuresBefore = CU_get_number_of_failures();
+    gStartNs = monotonic_ns();
+    if (sigsetjmp(gEscape, 1) == 0)
+    {
+        gpRunning = pEntry;
+        if (watched)
+        {
+            watchdog_set(gDeadlineMs);
+        }
+        pEntry->pFunction();
+    }
+    else
+    {
+        pEntry->timedOut = 1;
+    }
+    gpRunning = NULL;
+    if (watched)
+    {
+        watchdog_set(0);
+    }
+    pEntry->elapsed_ns = monotonic_ns() - gStartNs;
+    /* Untimed: the test's queued log lines go out before anything reports on it */
+    test_log_flush();
+    record_call(pEntry);
+
+    if (pEntry->timedOut)
+    {
+        /* Locks the abandoned call held stay taken; the next test could block on one with no deadline to catch it */
+        fprintf(stderr, "harness: %s abandoned after %ums, the remaining tests are not run\n", pEntry->pTest->pName,
+                gDeadlineMs);
+        gStopped = 1;
+        UT_FAIL("Test timed out");
+    }
+}
+
+void test_harness_isolate( void )
+{
+    gIsolated = 1;
+}
+
+void test_harness_parse_args( int *pArgc, char **argv )
+{
+    int out = 1;
+    int i;
+
+    for (i = 1; i < *pArgc; i++)
+    {
+        if (strncmp(argv[i], "--deadline=", 11) == 0)
+        {
+            gDeadlineMs = (uint32_t)strtoul(&argv[i][11], NULL, 0);
+        }
+        else if (strcmp(argv[i], "--deadline") == 0 && i + 1 < *pArgc)
+        {
+            gDeadlineMs = (uint32_t)strtoul(argv[++i], NULL, 0);
+        }
+        else
+        {
+            argv[out++] = argv[i];
+        }
+    }
+    argv[out] = NULL;
+    *pArgc = out;
+}
+
+int test_harness_install( void )
+{
+    CU_pTestRegistry pRegistry = CU_get_registry();
+    CU_pSuite pSuite;
+    CU_pTest pTest;
+
+    if (pRegistry == NULL || gEntries != NULL)
+    {
+        return (pRegistry == NULL) ? -1 : 0;
+    }
+    gEntries = calloc(pRegistry->uiNumberOfTests + 1, sizeof(*gEntries));
+    if (gEntries == NULL)
+    {
+        return -1;
+    }
+    for (pSuite = pRegistry->pSuite; pSuite != NULL; pSuite = pSuite->pNext)
+    {
+        for (pTest = pSuite->pTest; pTest != NULL && gEntryCount < pRegistry->uiNumberOfTests; pTest = pTest->pNext)
+        {
+            gEntries[gEntryCount].pTest = pTest;
+            gEntries[gEntryCount].pSuiteName = pSuite->pName;
+            gEntries[gEntryCount].pFunction = pTest->pTestFunc;
+            pTest->pTestFunc = harness_run_test;
+            gEntryCount++;
+        }
+    }
+
+#ifdef __GLIBC__
+    /* backtrace() loads libgcc on first use, which is not safe from the signal handler */
+    {
+        void *frame;
+        backtrace(&frame, 1);
+    }
+#endif
+    return 0;
+}
+
+static int by_elapsed_desc( const void *pLeft, const void *pRight )
+{
+    const harness_entry_t *pA = *(const harness_entry_t * const *)pLeft;
+    const harness_entry_t *pB = *(const harness_entry_t * const *)pRight;
+
+    return (pA->elapsed_ns < pB->elapsed_ns) - (pA->elapsed_ns > pB->elapsed_ns);
+}
+
+void test_harness_complete( void )
+{
+    settle_abandoned();
+    test_log_flush();
+    test_results_flush();
+}
+
+void test_harness_report( void )
+{
+    harness_entry_t **ppSorted;
+    uint64_t total_ns = 0;
+    uint32_t timeouts = 0;
+    uint32_t i;
+
+    test_harness_complete();
+    if (gEntryCount == 0)
+    {
+        return;
+    }
+    ppSorted = malloc(gEntryCount * sizeof(*ppSorted));
+    if (ppSorted == NULL)
+    {
+        return;
+    }
+    for (i = 0; i < gEntryCount; i++)
+    {
+        ppSorted[i] = &gEntries[i];
+        total_ns += gEntries[i].elapsed_ns;
+        timeouts += (uint32_t)gEntries[i].timedOut;
+    }
+    qsort(ppSorted, gEntryCount, sizeof(*ppSorted), by_elapsed_desc);
+
+    printf("\nharness: %u tests, %.3fms in test functions, %u timed out (deadline %ums)\n",
+           gEntryCount, (double)total_ns / 1e6, timeouts, gDeadlineMs);
+    for (i = 0; i < gEntryCount && i < TEST_HARNESS_REPORT_SLOWEST; i++)
+    {
+        printf("harness: %12.3fms  %s %s%s\n", (double)ppSorted[i]->elapsed_ns / 1e6, ppSorted[i]->pSuiteName,
+               ppSorted[i]->pTest->pName, ppSorted[i]->timedOut ? " (TIMEOUT)" : "");
+    }
+    for (; i < gEntryCount; i++)
+    {
+        if (ppSorted[i]->timedOut)
+        {
+            printf("harness: %12.3fms  %s %s (TIMEOUT)\n", (double)ppSorted[i]->elapsed_ns / 1e6,
+                   ppSorted[i]->pSuiteName, ppSorted[i]->pTest->pName);
+        }
+    }
+    if (gNotRun > 0)
+    {
+        printf("harness: %u tests not run after the timeout; use --jobs to run each in a process of its own\n", gNotRun);
+    }
+    free(ppSorted);
+}
@@ -0,0 +1,95 @@
+/*
+* If not stated otherwise in this file or this component's LICENSE file the
+* following copyright and licenses apply:*
+* Copyright 2023 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+/**
+* @file test_harness.h
+*
+* Per-test timing and hang watchdog around the registered tests.
+*
+* test_harness_install() wraps the function of every test added with
+* UT_add_test() so far. Each call is timed on CLOCK_MONOTONIC, and a
+* watchdog timer aimed at the calling thread is armed for the deadline, so
+* that a getter blocked on sysevent or a lock does not hang the whole run.
+*
+* Each call also ends with a record for test_results.h: its status (a
+* failure being any assertion the call failed), the first failed assertion
+* and its duration.
+*
+* Log lines a call queued under "--log async" (test_log.h) are written out
+* when it returns, outside its timing.
+*
+* Under the parallel runner (test_runner.h), where tests run in children, a
+* test that overruns the deadline has the backtrace of its thread written to
+* stderr and its child ended with TEST_HARNESS_TIMEOUT_EXIT. In a serial run
+* the test is abandoned in place and failed as timed out. That does not
+* release what the stuck call held: the lease engine's mutex, a stdio or
+* malloc lock, a lock of the vendor HAL. As the next test could block on one
+* of them for good, the remaining tests are then failed without being run.
+*/
+
+#ifndef __TEST_HARNESS_H__
+#define __TEST_HARNESS_H__
+
+#include <stdint.h>
+
+#define TEST_HARNESS_DEFAULT_DEADLINE_MS  10000  /*!< Per test call; 0 disables the watchdog */
+#define TEST_HARNESS_REPORT_SLOWEST       10     /*!< Tests listed by test_harness_report() */
+#define TEST_HARNESS_TIMEOUT_EXIT         124    /*!< Exit status of an isolated child whose test timed out, as timeout(1) */
+
+/**
+* @brief Takes the harness options out of the command line
+*
+* Recognises "--deadline MS" (also --deadline=MS) and removes it, so that the
+* remaining arguments can be passed to UT_init() unchanged.
+*
+* @param[in,out] pArgc - Argument count, reduced by the options removed
+* @param[in,out] argv  - Arguments, compacted in place
+*/
+void test_harness_parse_args( int *pArgc, char **argv );
+
+/**
+* @brief Ends the calling process when a test overruns its deadline
+*
+* For a forked child that runs tests: the test is not abandoned in place,
+* the child exits with TEST_HARNESS_TIMEOUT_EXIT instead.
+*/
+void test_harness_isolate( void );
+
+/**
+* @brief Wraps every test registered so far
+*
+* Call once, after all suites have been registered and before they run.
+*
+* @return 0 on success, -1 if out of memory
+*/
+int test_harness_install( void );
+
+/**
+* @brief Accounts for the last test if a fatal assertion cut it short, and writes out its results
+*
+* test_harness_report() does this itself; a forked child that runs tests
+* must call it before it exits.
+*/
+void test_harness_complete( void );
+
+/**
+* @brief Prints the slowest tests, the total test time and any timeouts
+*/
+void test_harness_report( void );
+
+#endif /* __TEST_HARNESS_H__ */
@@ -0,0 +1,46 @@
+/*
+* If not stated otherwise in this file or this component's LICENSE file the
+* following copyright and licenses apply:*
+* Copyright 2023 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#include "test_ipv4.h"
+
+char *dhcp_ipv4_format( uint32_t addr, char *pBuf )
+{
+    /* Network byte order is the order of the octets in memory */
+    const unsigned char *pOctets = (const unsigned char *)&addr;
+    char *pOut = pBuf;
+    unsigned int octet;
+    int i;
+
+    for (i = 0; i < 4; i++)
+    {
+        octet = pOctets[i];
+        if (octet >= 100)
+        {
+            *pOut++ = (char)('0' + octet / 100);
+            octet %= 100;
+            *pOut++ = (char)('0' + octet / 10);
+        }
+        else if (octet >= 10)
+        {
+            *pOut++ = (char)('0' + octet / 10);
+        }
+        *pOut++ = (char)('0' + octet % 10);
+        *pOut++ = (i < 3) ? '.' : '\0';
+    }
+    return pBuf;
+}
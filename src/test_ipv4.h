@@ -0,0 +1,52 @@
+/*
+* If not stated otherwise in this file or this component's LICENSE file the
+* following copyright and licenses apply:*
+* Copyright 2023 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+/**
+* @file test_ipv4.h
+*
+* IPv4 address formatting for the L1 test logs.
+*
+* Replaces inet_ntoa(), which returns a pointer into static (at best
+* per-thread) storage and so needs copying out through a shared
+* struct in_addr before the next call. The helper writes into a buffer
+* owned by the caller, keeps no state and does not allocate, so it is safe
+* from any thread and cheap inside loops over DNS server lists.
+*
+* Call it directly in the log arguments, e.g.
+* UT_LOG_DEBUG("ip: %s", dhcp_ipv4_format(value, ip_str)), so that the
+* formatting is only done where the value is logged.
+*/
+
+#ifndef __TEST_IPV4_H__
+#define __TEST_IPV4_H__
+
+#include <stdint.h>
+
+#define DHCP_IPV4_STRLEN  16    /*!< "255.255.255.255" plus terminator, as INET_ADDRSTRLEN */
+
+/**
+* @brief Formats an IPv4 address in dotted-quad notation
+*
+* @param[in]  addr - Address in network byte order, as returned by the HAL getters
+* @param[out] pBuf - Receives the string, at least DHCP_IPV4_STRLEN bytes
+*
+* @return pBuf
+*/
+char *dhcp_ipv4_format( uint32_t addr, char *pBuf );
+
+#endif /* __TEST_IPV4_H__ */
@@ -0,0 +1,242 @@
+/*
+* If not stated otherwise in this file or this component's LICENSE file the
+* following copyright and licenses apply:*
+* Copyright 2023 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <arpa/inet.h>
+#include <ut.h>
+#include <ut_log.h>
+#include "test_log.h"
+#include <CUnit/CUnit.h>
+#include "test_ipv4.h"
+#include "test_l1_getters.h"
+#include "test_results.h"
+
+#ifndef STATUS_SUCCESS
+#define STATUS_SUCCESS   0
+#endif
+
+#ifndef STATUS_FAILURE
+#define STATUS_FAILURE   -1
+#endif
+
+#define GETTER_MAX_OUTPUT  256      /* Largest output an entry may declare */
+#define GETTER_GUARD       16       /* Bytes after the output checked for overruns */
+#define GETTER_GUARD_BYTE  0xA5
+
+/* One registered test */
+typedef struct
+{
+    const char          *pName;
+    const test_getter_t *pGetter;
+    int                  positive;
+    int                  group;
+    int                  id;
+} getter_case_t;
+
+static getter_case_t *gCases;
+static uint32_t gCaseCount;
+
+/* CUnit passes tests no argument, so the running test is found by its name */
+static const getter_case_t *current_case( void )
+{
+    CU_pTest pTest = CU_get_current_test();
+    uint32_t i;
+
+    for (i = 0; pTest != NULL && i < gCaseCount; i++)
+    {
+        if (strcmp(gCases[i].pName, pTest->pName) == 0)
+        {
+            return &gCases[i];
+        }
+    }
+    return NULL;
+}
+
+#define GETTER_VALUE_STRLEN  256  /* A formatted output: a string or a list of addresses */
+
+/* Formats what a getter wrote, a list as comma-separated addresses */
+static void format_output( const test_getter_t *pGetter, const void *pOut, char *pValue, size_t size )
+{
+    char ip_str[DHCP_IPV4_STRLEN];
+    const int *pNumber;
+    const uint32_t *pAddrs;
+    size_t used = 0;
+    int i;
+
+    pValue[0] = '\0';
+    switch (pGetter->output)
+    {
+        case GETTER_OUTPUT_UNSIGNED:
+            snprintf(pValue, size, "%u", *(const unsigned int *)pOut);
+            break;
+        case GETTER_OUTPUT_SIGNED:
+            snprintf(pValue, size, "%d", *(const int *)pOut);
+            break;
+        case GETTER_OUTPUT_STRING:
+            snprintf(pValue, size, "%.*s", (int)pGetter->outputSize, (const char *)pOut);
+            break;
+        case GETTER_OUTPUT_IPV4:
+            snprintf(pValue, size, "%s", dhcp_ipv4_format(*(const uint32_t *)pOut, ip_str));
+            break;
+        case GETTER_OUTPUT_IPV4_LIST:
+            pNumber = (const int *)pOut;
+            pAddrs = (const uint32_t *)(pNumber + 1);
+            for (i = 0; i < *pNumber && (uint32_t)i < (pGetter->outputSize - sizeof(int)) / sizeof(uint32_t) && used < size; i++)
+            {
+                used += (size_t)snprintf(&pValue[used], size - used, "%s%s", (i > 0) ? "," : "",
+                                         dhcp_ipv4_format(pAddrs[i], ip_str));
+            }
+            break;
+    }
+}
+
+static void check_rule( const test_getter_t *pGetter, const void *pOut )
+{
+    uint32_t mask;
+    int number;
+
+    switch (pGetter->rule)
+    {
+        case GETTER_RULE_TERMINATED:
+            UT_ASSERT_TRUE(memchr(pOut, '\0', pGetter->outputSize) != NULL);
+            break;
+        case GETTER_RULE_NETMASK:
+            /* Inverted, a contiguous mask is one less than a power of two */
+            mask = ~ntohl(*(const uint32_t *)pOut);
+            UT_ASSERT_EQUAL(mask & (mask + 1), 0);
+            break;
+        case GETTER_RULE_LIST_BOUNDS:
+            number = *(const int *)pOut;
+            UT_ASSERT_TRUE(number >= 0 && (uint32_t)number <= (pGetter->outputSize - sizeof(int)) / sizeof(uint32_t));
+            break;
+        case GETTER_RULE_NONE:
+            break;
+    }
+}
+
+static void test_l1_getter_positive( const getter_case_t *pCase )
+{
+    const test_getter_t *pGetter = pCase->pGetter;
+    union
+    {
+        unsigned char bytes[GETTER_MAX_OUTPUT + GETTER_GUARD];
+        uint32_t      align;
+    } output;
+    char value[GETTER_VALUE_STRLEN];
+    uint32_t i;
+    int status;
+
+    memset(output.bytes, 0, pGetter->outputSize);
+    memset(&output.bytes[pGetter->outputSize], GETTER_GUARD_BYTE, GETTER_GUARD);
+
+    UT_LOG_DEBUG("Invoking %s with a valid %u-byte buffer", pGetter->pFunction, pGetter->outputSize);
+    status = pGetter->call(output.bytes);
+    UT_LOG_DEBUG("Return status: %d", status);
+    test_results_add_value("status", "%d", status);
+    UT_ASSERT_EQUAL(status, STATUS_SUCCESS);
+    if (status == STATUS_SUCCESS)
+    {
+        format_output(pGetter, output.bytes, value, sizeof(value));
+        if (pGetter->output == GETTER_OUTPUT_IPV4_LIST)
+        {
+            UT_LOG_DEBUG("Number of IP addresses: %d", *(const int *)output.bytes);
+        }
+        UT_LOG_DEBUG("Return value: %s", value);
+        test_results_add_value("value", "%s", value);
+        check_rule(pGetter, output.bytes);
+    }
+    for (i = 0; i < GETTER_GUARD; i++)
+    {
+        if (output.bytes[pGetter->outputSize + i] != GETTER_GUARD_BYTE)
+        {
+            UT_FAIL("Getter wrote past the end of its output");
+            break;
+        }
+    }
+}
+
+static void test_l1_getter_negative( const getter_case_t *pCase )
+{
+    int status;
+
+    UT_LOG_DEBUG("Invoking %s with NULL pointer", pCase->pGetter->pFunction);
+    status = pCase->pGetter->call(NULL);
+    UT_LOG_DEBUG("Return status: %d", status);
+    test_results_add_value("status", "%d", status);
+    UT_ASSERT_EQUAL(status, STATUS_FAILURE);
+}
+
+/* Registered for every generated test */
+static void test_l1_getter( void )
+{
+    const getter_case_t *pCase = current_case();
+
+    if (pCase == NULL)
+    {
+        UT_FAIL("Test is not in a getter table");
+        return;
+    }
+    UT_LOG_INFO("In %s [%02d%03d]\n", pCase->pName, pCase->group, pCase->id);
+    test_results_set_id(pCase->group, pCase->id);
+    if (pCase->positive)
+    {
+        test_l1_getter_positive(pCase);
+    }
+    else
+    {
+        test_l1_getter_negative(pCase);
+    }
+    UT_LOG_INFO("Out %s\n", pCase->pName);
+}
+
+static int add_case( UT_test_suite_t *pSuite, const char *pName, const test_getter_t *pGetter, int positive, int group, int id )
+{
+    getter_case_t *pCases = realloc(gCases, (gCaseCount + 1) * sizeof(*gCases));
+
+    if (pCases == NULL)
+    {
+        return -1;
+    }
+    gCases = pCases;
+    gCases[gCaseCount].pName = pName;
+    gCases[gCaseCount].pGetter = pGetter;
+    gCases[gCaseCount].positive = positive;
+    gCases[gCaseCount].group = group;
+    gCases[gCaseCount].id = id;
+    gCaseCount++;
+    UT_add_test(pSuite, pName, test_l1_getter);
+    return 0;
+}
+
+int test_l1_getters_register( UT_test_suite_t *pSuite, const test_getter_t *pGetters, uint32_t count, int group, int firstId )
+{
+    uint32_t i;
+
+    for (i = 0; i < count; i++)
+    {
+        if (pGetters[i].outputSize > GETTER_MAX_OUTPUT ||
+            add_case(pSuite, pGetters[i].pPositiveTest, &pGetters[i], 1, group, firstId + (int)(2 * i)) != 0 ||
+            add_case(pSuite, pGetters[i].pNegativeTest, &pGetters[i], 0, group, firstId + (int)(2 * i) + 1) != 0)
+        {
+            return -1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,55 @@
+/*
+* If not stated otherwise in this file or this component's LICENSE file the
+* following copyright and licenses apply:*
+* Copyright 2023 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+/**
+* @file test_l1_getters.h
+*
+* L1 tests generated from a getter table (test_getters.h).
+*
+* Each entry yields two tests, registered under the entry's test names:
+*
+* | Case | Test Data | Expected Result |
+* | :--: | --------- | --------------- |
+* | positive | pValue = valid buffer of the output size | STATUS_SUCCESS, the output passes the entry's rule and nothing is written past its size |
+* | negative | pValue = NULL | STATUS_FAILURE |
+*
+* Test IDs follow the table: entry n is tested by IDs first + 2n (positive)
+* and first + 2n + 1 (negative).
+*/
+
+#ifndef __TEST_L1_GETTERS_H__
+#define __TEST_L1_GETTERS_H__
+
+#include <stdint.h>
+#include <ut.h>
+#include "test_getters.h"
+
+/**
+* @brief Adds the positive and negative test of every getter in a table to a suite
+*
+* @param[in] pSuite   - Suite to add the tests to
+* @param[in] pGetters - Getter table, which must outlive the run
+* @param[in] count    - Number of entries in pGetters
+* @param[in] group    - Test Group ID logged by every test
+* @param[in] firstId  - Test Case ID of the first entry's positive test
+*
+* @return 0 on success, -1 if out of memory or an entry's output is too large
+*/
+int test_l1_getters_register( UT_test_suite_t *pSuite, const test_getter_t *pGetters, uint32_t count, int group, int firstId );
+
+#endif /* __TEST_L1_GETTERS_H__ */
@@ -0,0 +1,2642 @@
+/*
+* If not stated otherwise in this file or this component's LICENSE file the
+* following copyright and licenses apply:*
+* Copyright 2023 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+/**
+* @file test_l1_skeleton.c
+* @page skeleton Level 1 Tests
+*
+* ## Module's Role
+* This module includes Level 1 tests of the components behind the linux
+* skeleton HAL implementations in skeletons/src: the lease engine and its
+* timers, and the lease sources the skeleton getters read. A vendor HAL has
+* none of these, so the module is built for TARGET=linux only, and the
+* [L1 dhcp4cApi] and [L1 dhcpv4c_api] suites hold only tests every vendor
+* implementation must pass. The harness's capture and asynchronous log are
+* tested here as well.
+*
+* **Pre-Conditions:**  Linux skeleton build@n
+* **Dependencies:** None@n
+*/
+#include <ut.h>
+#include <ut_log.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <limits.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sched.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <arpa/inet.h>
+#include "test_log.h"
+#include "test_results.h"
+#include "test_capture.h"
+#include "test_ipv4.h"
+#include "dhcp4cApi.h"
+#include "dhcp4cApi_ext.h"
+#include "dhcpv4c_api.h"
+#include "dhcpv4c_api_ext.h"
+#include "dhcp_lease_engine.h"
+#include "dhcp_lease_file.h"
+#include "dhcp_lease_notify.h"
+#include "dhcp_lease_shm.h"
+#include "dhcp_lease_replay.h"
+#include "dhcp_packet.h"
+#include "dhcp_timer_wheel.h"
+
+static int gTestGroup = 1;
+static int gTestID = 1;
+
+#ifndef STATUS_SUCCESS
+#define STATUS_SUCCESS   0
+#endif
+
+#ifndef STATUS_FAILURE
+#define STATUS_FAILURE   -1
+#endif
+
+#define WHEEL_PROBES    4096
+#define WHEEL_PERIODIC  64      /* The first probes re-arm themselves from their callback */
+
+typedef struct
+{
+    dhcp_timer_t timer;
+    uint64_t expires_ns;
+    uint32_t fired;
+    uint32_t fired_after_cancel;
+    int cancelled;
+} wheel_probe_t;
+
+static wheel_probe_t gProbes[WHEEL_PROBES];
+static dhcp_timer_wheel_t gTestWheel;
+static uint64_t gWheelNowNs;
+static uint64_t gWheelPrevNs;
+static uint32_t gWheelEarly;
+static uint32_t gWheelLate;
+
+static uint32_t next_random( uint32_t *pState )
+{
+    *pState = *pState * 1103515245U + 12345U;
+    return *pState >> 8;
+}
+
+static void probe_fired( dhcp_timer_t *pTimer, void *pUserData )
+{
+    wheel_probe_t *pProbe = (wheel_probe_t *)pUserData;
+    uint32_t index = (uint32_t)(pProbe - gProbes);
+
+    (void)pTimer;
+    pProbe->fired++;
+    pProbe->fired_after_cancel += pProbe->cancelled;
+    /* With 1 ns ticks a timer is due at exactly its time: not before, and not on a later advance */
+    gWheelEarly += (gWheelNowNs < pProbe->expires_ns);
+    gWheelLate += (gWheelPrevNs >= pProbe->expires_ns);
+    if (index < WHEEL_PERIODIC)
+    {
+        pProbe->expires_ns = gWheelNowNs + 1000 + index;
+        dhcp_timer_wheel_add(&gTestWheel, &pProbe->timer, pProbe->expires_ns);
+    }
+}
+
+/**
+* @brief Test case to verify that the lease timer wheel fires every timer once, on time, across all its levels
+*
+* The skeleton's lease engine drives T1, T2 and expiry from a hierarchical timing wheel. This test checks each level boundary, then arms timers from one tick to beyond the reach of the top level, advances the wheel in random steps of one tick to 2^35, cancels some on the way, and re-arms others from their callbacks.
+*
+* **Test Group ID:** Basic: 01 @n
+* **Test Case ID:** 001 @n
+* **Priority:** High @n@n
+*
+* **Pre-Conditions:** Linux skeleton build @n
+* **Dependencies:** None @n
+* **User Interaction:** If user chose to run the test in interactive mode, then the test case has to be selected via console @n
+*
+* **Test Procedure:** @n
+* | Variation / Step | Description | Test Data | Expected Result | Notes |
+* | :----: | --------- | ---------- |-------------- | ----- |
+* | 01 | Invoking dhcp_timer_wheel_init and dhcp_timer_wheel_add with invalid arguments | NULL wheel, 0 tick, NULL timer | -1 | |
+* | 02 | Arm a timer on either side of every level boundary in turn, advance to 1 ns before, then to its expiry | 64^n - 1, 64^n, 64^n + 1 ns | Each fires on the advance to its time | |
+* | 03 | Arm 4096 timers on a wheel with 1 ns ticks | expiries spread over 1 to 2^40 ns | All pending | 2^40 is past the top level |
+* | 04 | Advance the wheel in random steps, cancelling every fourth one-shot timer after 50 steps | 1 to 2^35 ns per step | Every timer fires on the first advance reaching its time | |
+* | 05 | Check the cancelled timers and the advance counts | | None fired after cancel, fired total matches | |
+*/
+void test_l1_skeleton_positive1_timer_wheel(void)
+{
+    gTestID = 1;
+    UT_LOG_INFO("In %s [%02d%03d]\n", __FUNCTION__, gTestGroup, gTestID);
+    test_results_set_id(gTestGroup, gTestID);
+
+    dhcp_timer_t spare;
+    uint64_t last_ns = 0;
+    uint64_t fired_total = 0;
+    uint64_t probe_total = 0;
+    uint32_t seed = 20231017;
+    uint32_t advances = 0;
+    uint32_t cancelled = 0;
+    uint32_t missed = 0;
+    uint32_t bits;
+    uint32_t i;
+
+    UT_ASSERT_EQUAL(dhcp_timer_wheel_init(NULL, 1, 0), -1);
+    UT_ASSERT_EQUAL(dhcp_timer_wheel_init(&gTestWheel, 0, 0), -1);
+    UT_ASSERT_EQUAL_FATAL(dhcp_timer_wheel_init(&gTestWheel, 1, 0), 0);
+    UT_ASSERT_EQUAL(dhcp_timer_wheel_add(&gTestWheel, NULL, 1), -1);
+    dhcp_timer_init(&spare, probe_fired, NULL);
+    UT_ASSERT_EQUAL(dhcp_timer_wheel_cancel(&gTestWheel, &spare), 0);
+
+    /* Level boundaries, where a timer lands in the slot under the current tick and waits a whole turn */
+    gWheelNowNs = gWheelPrevNs = 0;
+    gWheelEarly = gWheelLate = 0;
+    memset(gProbes, 0, sizeof(gProbes));
+    for (i = 0; i < 3 * DHCP_TIMER_WHEEL_LEVELS; i++)
+    {
+        gProbes[WHEEL_PERIODIC + i].expires_ns = gWheelNowNs + (1ULL << (DHCP_TIMER_WHEEL_BITS * (i / 3 + 1))) + (i % 3) - 1;
+        dhcp_timer_init(&gProbes[WHEEL_PERIODIC + i].timer, probe_fired, &gProbes[WHEEL_PERIODIC + i]);
+        UT_ASSERT_EQUAL(dhcp_timer_wheel_add(&gTestWheel, &gProbes[WHEEL_PERIODIC + i].timer, gProbes[WHEEL_PERIODIC + i].expires_ns), 0);
+        gWheelPrevNs = gWheelNowNs;
+        gWheelNowNs = gProbes[WHEEL_PERIODIC + i].expires_ns - 1;
+        UT_ASSERT_EQUAL(dhcp_timer_wheel_advance(&gTestWheel, gWheelNowNs), 0);
+        gWheelPrevNs = gWheelNowNs;
+        gWheelNowNs++;
+        UT_ASSERT_EQUAL(dhcp_timer_wheel_advance(&gTestWheel, gWheelNowNs), 1);
+        UT_ASSERT_EQUAL(gProbes[WHEEL_PERIODIC + i].fired, 1);
+    }
+    UT_ASSERT_EQUAL(gWheelEarly, 0);
+    UT_ASSERT_EQUAL(gWheelLate, 0);
+
+    gWheelNowNs = gWheelPrevNs = gProbes[WHEEL_PERIODIC + 3 * DHCP_TIMER_WHEEL_LEVELS - 1].expires_ns;
+    memset(gProbes, 0, sizeof(gProbes));
+    for (i = 0; i < WHEEL_PROBES; i++)
+    {
+        /* Uniform in the exponent, so that every level and the overflow get timers */
+        bits = next_random(&seed) % 41;
+        gProbes[i].expires_ns = gWheelNowNs + 1 + (((uint64_t)next_random(&seed) << 24 | next_random(&seed)) & ((1ULL << bits) - 1));
+        if (gProbes[i].expires_ns > last_ns)
+        {
+            last_ns = gProbes[i].expires_ns;
+        }
+        dhcp_timer_init(&gProbes[i].timer, probe_fired, &gProbes[i]);
+        UT_ASSERT_EQUAL(dhcp_timer_wheel_add(&gTestWheel, &gProbes[i].timer, gProbes[i].expires_ns), 0);
+    }
+
+    while (gWheelNowNs <= last_ns)
+    {
+        /* Mostly shorter than the spread of the timers, so that they fire over hundreds of advances */
+        bits = next_random(&seed) % 36;
+        gWheelPrevNs = gWheelNowNs;
+        gWheelNowNs += 1 + ((((uint64_t)next_random(&seed) << 24) | next_random(&seed)) & ((1ULL << bits) - 1));
+        fired_total += dhcp_timer_wheel_advance(&gTestWheel, gWheelNowNs);
+        if (++advances == 50)
+        {
+            for (i = WHEEL_PERIODIC; i < WHEEL_PROBES; i += 4)
+            {
+                if (dhcp_timer_wheel_cancel(&gTestWheel, &gProbes[i].timer))
+                {
+                    gProbes[i].cancelled = 1;
+                    cancelled++;
+                }
+                UT_ASSERT_FALSE(dhcp_timer_pending(&gProbes[i].timer));
+            }
+        }
+    }
+
+    for (i = 0; i < WHEEL_PROBES; i++)
+    {
+        probe_total += gProbes[i].fired;
+        UT_ASSERT_EQUAL(gProbes[i].fired_after_cancel, 0);
+        if (i >= WHEEL_PERIODIC && !gProbes[i].cancelled && gProbes[i].fired != 1)
+        {
+            missed++;
+        }
+        if (i < WHEEL_PERIODIC)
+        {
+            UT_ASSERT_TRUE(gProbes[i].fired > 0);
+            UT_ASSERT_TRUE(dhcp_timer_pending(&gProbes[i].timer));
+            UT_ASSERT_EQUAL(dhcp_timer_wheel_cancel(&gTestWheel, &gProbes[i].timer), 1);
+        }
+    }
+    UT_LOG_DEBUG("%u advances, %llu fired, %u cancelled, %u early, %u late, %u missed",
+                 advances, (unsigned long long)fired_total, cancelled, gWheelEarly, gWheelLate, missed);
+    test_results_add_value("advances", "%u", advances);
+    test_results_add_value("fired", "%llu", (unsigned long long)fired_total);
+    UT_ASSERT_TRUE(cancelled > 0);
+    UT_ASSERT_EQUAL(gWheelEarly, 0);
+    UT_ASSERT_EQUAL(gWheelLate, 0);
+    UT_ASSERT_EQUAL(missed, 0);
+    UT_ASSERT_EQUAL(fired_total, probe_total);
+    UT_ASSERT_EQUAL(gTestWheel.pending, 0);
+    UT_ASSERT_EQUAL(dhcp_timer_wheel_advance(&gTestWheel, gWheelNowNs + (1ULL << 41)), 0);
+
+    UT_LOG_INFO("Out %s\n", __FUNCTION__);
+}
+
+typedef struct
+{
+    pthread_mutex_t lock;
+    dhcp_lease_event_t events[8];
+    int count;
+} lease_events_t;
+
+static void record_lease_event( const dhcp_lease_event_t *pEvent, void *pUserData )
+{
+    lease_events_t *pEvents = (lease_events_t *)pUserData;
+
+    pthread_mutex_lock(&pEvents->lock);
+    if (pEvents->count < (int)(sizeof(pEvents->events) / sizeof(pEvents->events[0])))
+    {
+        pEvents->events[pEvents->count] = *pEvent;
+    }
+    pEvents->count++;
+    pthread_mutex_unlock(&pEvents->lock);
+}
+
+/* Waits up to timeout_ms for a number of events, returning how many arrived */
+static int wait_lease_events( lease_events_t *pEvents, int count, int timeout_ms )
+{
+    const struct timespec pause = { 0, 1000000 };
+    int seen = 0;
+    int waited;
+
+    for (waited = 0; waited <= timeout_ms; waited++)
+    {
+        pthread_mutex_lock(&pEvents->lock);
+        seen = pEvents->count;
+        pthread_mutex_unlock(&pEvents->lock);
+        if (seen >= count)
+        {
+            break;
+        }
+        nanosleep(&pause, NULL);
+    }
+    return seen;
+}
+
+static void timer_test_lease( uint32_t lease_time, uint32_t renew_time, uint32_t rebind_time, dhcp_lease_t *pLease )
+{
+    memset(pLease, 0, sizeof(*pLease));
+    strcpy(pLease->ifname, "erouter0");
+    pLease->ip_addr = inet_addr("203.0.113.64");
+    pLease->mask = inet_addr("255.255.255.0");
+    pLease->gw = inet_addr("203.0.113.1");
+    pLease->dhcp_svr = inet_addr("203.0.113.2");
+    pLease->lease_time = lease_time;
+    pLease->renew_time = renew_time;
+    pLease->rebind_time = rebind_time;
+}
+
+/**
+* @brief Test case to verify that the eRouter lease moves through T1, T2 and expiry on the engine's timers
+*
+* With simulated renewals disabled, the lease engine's T1, T2 and expiry timers move the client to RENEWING, REBINDING and INIT and announce each move. With renewals enabled, the server renews at every T1 and the client stays BOUND.
+*
+* **Test Group ID:** Basic: 01 @n
+* **Test Case ID:** 002 @n
+* **Priority:** High @n@n
+*
+* **Pre-Conditions:** Linux skeleton build, DHCP_LEASE_SHM and DHCP4C_ERT_LEASE_FILE unset @n
+* **Dependencies:** None @n
+* **User Interaction:** If user chose to run the test in interactive mode, then the test case has to be selected via console @n
+*
+* **Test Procedure:** @n
+* | Variation / Step | Description | Test Data | Expected Result | Notes |
+* | :----: | --------- | ---------- |-------------- | ----- |
+* | 01 | Disable renewals, subscribe to eRouter changes, bind a lease | 1000 s, T1 500 s, T2 875 s | BOUND announced | |
+* | 02 | Advance the engine clock 499 s, then 1 s | dhcp_lease_engine_advance | No event, then RENEWING announced; dhcp4c_get_ert_fsm_state agrees | |
+* | 03 | Advance 375 s, then 125 s | dhcp_lease_engine_advance | REBINDING, then INIT announced; dhcp4c_get_ert_fsm_state agrees | |
+* | 04 | Enable renewals, bind again and advance ten days | 864000 s | No event; BOUND with at most 1000 s left | Renewed at every T1 |
+*/
+void test_l1_skeleton_positive1_ert_lease_timers(void)
+{
+    gTestID = 2;
+    UT_LOG_INFO("In %s [%02d%03d]\n", __FUNCTION__, gTestGroup, gTestID);
+    test_results_set_id(gTestGroup, gTestID);
+
+    static const int expected[] = { DHCP_LEASE_FSM_BOUND, DHCP_LEASE_FSM_RENEWING, DHCP_LEASE_FSM_REBINDING, DHCP_LEASE_FSM_INIT };
+    lease_events_t events;
+    dhcp_lease_t lease;
+    unsigned int remaining = 0;
+    int handle = -1;
+    int state = 0;
+    int i;
+
+    memset(&events, 0, sizeof(events));
+    pthread_mutex_init(&events.lock, NULL);
+    dhcp_lease_engine_reset();
+    dhcp_lease_engine_set_auto_renew(0);
+    if (dhcp_lease_notify_subscribe(1U << DHCP_LEASE_IF_ERT, record_lease_event, &events, &handle) != 0)
+    {
+        UT_FAIL("Cannot subscribe to eRouter lease changes");
+        dhcp_lease_engine_set_auto_renew(1);
+        return;
+    }
+
+    timer_test_lease(1000, 0, 0, &lease);
+    UT_ASSERT_EQUAL(dhcp_lease_engine_bind(DHCP_LEASE_IF_ERT, &lease), 0);
+    UT_ASSERT_EQUAL(wait_lease_events(&events, 1, 1000), 1);
+    dhcp_lease_engine_advance(499);
+    UT_ASSERT_EQUAL(dhcp4c_get_ert_fsm_state(&state), STATUS_SUCCESS);
+    UT_ASSERT_EQUAL(state, DHCP_LEASE_FSM_BOUND);
+    dhcp_lease_engine_advance(1);
+    UT_ASSERT_EQUAL(wait_lease_events(&events, 2, 1000), 2);
+    UT_ASSERT_EQUAL(dhcp4c_get_ert_fsm_state(&state), STATUS_SUCCESS);
+    UT_ASSERT_EQUAL(state, DHCP_LEASE_FSM_RENEWING);
+    dhcp_lease_engine_advance(375);
+    UT_ASSERT_EQUAL(wait_lease_events(&events, 3, 1000), 3);
+    UT_ASSERT_EQUAL(dhcp4c_get_ert_fsm_state(&state), STATUS_SUCCESS);
+    UT_ASSERT_EQUAL(state, DHCP_LEASE_FSM_REBINDING);
+    dhcp_lease_engine_advance(125);
+    UT_ASSERT_EQUAL(wait_lease_events(&events, 4, 1000), 4);
+    UT_ASSERT_EQUAL(dhcp4c_get_ert_fsm_state(&state), STATUS_SUCCESS);
+    UT_ASSERT_EQUAL(state, DHCP_LEASE_FSM_INIT);
+    for (i = 0; i < 4 && i < events.count; i++)
+    {
+        UT_LOG_DEBUG("event %d: state %d", i, events.events[i].fsm_state);
+        UT_ASSERT_EQUAL(events.events[i].fsm_state, expected[i]);
+    }
+
+    dhcp_lease_engine_set_auto_renew(1);
+    UT_ASSERT_EQUAL(dhcp_lease_engine_bind(DHCP_LEASE_IF_ERT, &lease), 0);
+    UT_ASSERT_EQUAL(wait_lease_events(&events, 5, 1000), 5);
+    dhcp_lease_engine_advance(864000);
+    UT_ASSERT_EQUAL(dhcp4c_get_ert_fsm_state(&state), STATUS_SUCCESS);
+    UT_ASSERT_EQUAL(state, DHCP_LEASE_FSM_BOUND);
+    UT_ASSERT_EQUAL(dhcp4c_get_ert_remain_lease_time(&remaining), STATUS_SUCCESS);
+    UT_LOG_DEBUG("remain_lease_time after ten days: %u", remaining);
+    UT_ASSERT_TRUE(remaining > 500 && remaining <= 1000);
+    UT_ASSERT_EQUAL(wait_lease_events(&events, 6, 50), 5);
+
+    dhcp_lease_notify_unsubscribe(handle, NULL);
+    dhcp_lease_engine_reset();
+    pthread_mutex_destroy(&events.lock);
+    UT_LOG_INFO("Out %s\n", __FUNCTION__);
+}
+
+/**
+* @brief Test case to verify that T1 is announced on time with nobody reading the lease
+*
+* The notification thread sleeps until the engine's next lease timer, so a subscriber hears of T1 without any getter being called.
+*
+* **Test Group ID:** Basic: 01 @n
+* **Test Case ID:** 003 @n
+* **Priority:** High @n@n
+*
+* **Pre-Conditions:** Linux skeleton build @n
+* **Dependencies:** None @n
+* **User Interaction:** If user chose to run the test in interactive mode, then the test case has to be selected via console @n
+*
+* **Test Procedure:** @n
+* | Variation / Step | Description | Test Data | Expected Result | Notes |
+* | :----: | --------- | ---------- |-------------- | ----- |
+* | 01 | Disable renewals, subscribe to eRouter changes, bind a lease | 8 s, T1 1 s, T2 7 s | BOUND announced | |
+* | 02 | Wait without calling any getter | up to 3 s | RENEWING announced within 250 ms of T1 | Lateness logged |
+*/
+void test_l1_skeleton_positive2_ert_lease_timers(void)
+{
+    gTestID = 3;
+    UT_LOG_INFO("In %s [%02d%03d]\n", __FUNCTION__, gTestGroup, gTestID);
+    test_results_set_id(gTestGroup, gTestID);
+
+    lease_events_t events;
+    dhcp_lease_t lease;
+    uint64_t t1_ns;
+    int64_t late_ns;
+    int handle = -1;
+
+    memset(&events, 0, sizeof(events));
+    pthread_mutex_init(&events.lock, NULL);
+    dhcp_lease_engine_reset();
+    dhcp_lease_engine_set_auto_renew(0);
+    if (dhcp_lease_notify_subscribe(1U << DHCP_LEASE_IF_ERT, record_lease_event, &events, &handle) != 0)
+    {
+        UT_FAIL("Cannot subscribe to eRouter lease changes");
+        dhcp_lease_engine_set_auto_renew(1);
+        return;
+    }
+
+    timer_test_lease(8, 1, 7, &lease);
+    UT_ASSERT_EQUAL(dhcp_lease_engine_bind(DHCP_LEASE_IF_ERT, &lease), 0);
+    UT_ASSERT_EQUAL(dhcp_lease_engine_get(DHCP_LEASE_IF_ERT, &lease), 0);
+    t1_ns = lease.bound_ns + 1000000000ULL;
+    UT_ASSERT_EQUAL(wait_lease_events(&events, 2, 3000), 2);
+    if (events.count >= 2)
+    {
+        /* No clock offset after the reset, so engine time is CLOCK_MONOTONIC like the event */
+        late_ns = (int64_t)(events.events[1].timestamp_ns - t1_ns);
+        UT_LOG_DEBUG("T1 announced %lld us after it was due", (long long)(late_ns / 1000));
+        test_results_add_value("t1_late_us", "%lld", (long long)(late_ns / 1000));
+        UT_ASSERT_EQUAL(events.events[1].fsm_state, DHCP_LEASE_FSM_RENEWING);
+        UT_ASSERT_TRUE(late_ns >= 0 && late_ns < 250000000LL);
+    }
+
+    dhcp_lease_notify_unsubscribe(handle, NULL);
+    dhcp_lease_engine_set_auto_renew(1);
+    dhcp_lease_engine_reset();
+    pthread_mutex_destroy(&events.lock);
+    UT_LOG_INFO("Out %s\n", __FUNCTION__);
+}
+
+static void test_ack( dhcp_packet_t *pAck )
+{
+    int i;
+
+    memset(pAck, 0, sizeof(*pAck));
+    pAck->op = DHCP_BOOTREPLY;
+    pAck->xid = 0x12345678U;
+    pAck->secs = 3;
+    pAck->flags = DHCP_PACKET_FLAG_BROADCAST;
+    for (i = 0; i < 6; i++)
+    {
+        pAck->chaddr[i] = (uint8_t)(0x02 + i);
+    }
+    pAck->msg_type = DHCPACK;
+    pAck->yiaddr = inet_addr("203.0.113.100");
+    pAck->server_id = inet_addr("203.0.113.1");
+    pAck->mask = inet_addr("255.255.255.0");
+    pAck->router = inet_addr("203.0.113.254");
+    pAck->dns_count = DHCP_PACKET_MAX_DNS;
+    for (i = 0; i < DHCP_PACKET_MAX_DNS; i++)
+    {
+        pAck->dns[i] = htonl(ntohl(inet_addr("203.0.113.53")) + (uint32_t)i);
+    }
+    pAck->lease_time = 7200;
+    pAck->renewal_time = 3000;
+    pAck->rebinding_time = 6000;
+}
+
+/* Field by field, so that struct padding cannot matter */
+static int same_packet( const dhcp_packet_t *pA, const dhcp_packet_t *pB )
+{
+    return pA->op == pB->op && pA->hops == pB->hops && pA->flags == pB->flags && pA->xid == pB->xid &&
+           pA->secs == pB->secs && pA->ciaddr == pB->ciaddr && pA->yiaddr == pB->yiaddr &&
+           pA->siaddr == pB->siaddr && pA->giaddr == pB->giaddr && memcmp(pA->chaddr, pB->chaddr, sizeof(pA->chaddr)) == 0 &&
+           pA->msg_type == pB->msg_type && pA->requested_ip == pB->requested_ip && pA->server_id == pB->server_id &&
+           pA->mask == pB->mask && pA->router == pB->router && pA->dns_count == pB->dns_count &&
+           memcmp(pA->dns, pB->dns, sizeof(pA->dns[0]) * (size_t)pA->dns_count) == 0 &&
+           pA->lease_time == pB->lease_time && pA->renewal_time == pB->renewal_time &&
+           pA->rebinding_time == pB->rebinding_time && pA->param_count == pB->param_count &&
+           memcmp(pA->params, pB->params, (size_t)pA->param_count) == 0;
+}
+
+/* Offset of the END option of an encoded message */
+static size_t options_end( const uint8_t *pBuf )
+{
+    size_t offset = DHCP_PACKET_OPTIONS_OFFSET;
+
+    while (pBuf[offset] != DHCP_OPT_END)
+    {
+        offset += 2 + pBuf[offset + 1];
+    }
+    return offset;
+}
+
+/**
+* @brief Test case to verify that the DHCP packet codec round-trips every field and feeds the getters
+*
+* The skeleton and the DHCP server stand-in share one codec. Messages it encodes decode to the same fields, options overloaded into the file and sname fields are found, and an ACK turned into a lease is what the indexed getters return.
+*
+* **Test Group ID:** Basic: 01 @n
+* **Test Case ID:** 004 @n
+* **Priority:** High @n@n
+*
+* **Pre-Conditions:** Linux skeleton build @n
+* **Dependencies:** None @n
+* **User Interaction:** If user chose to run the test in interactive mode, then the test case has to be selected via console @n
+*
+* **Test Procedure:** @n
+* | Variation / Step | Description | Test Data | Expected Result | Notes |
+* | :----: | --------- | ---------- |-------------- | ----- |
+* | 01 | Encode a DISCOVER with a parameter request list, then decode it | 576-byte buffer | 300 bytes, magic cookie at 236, same fields back | BOOTP minimum |
+* | 02 | Encode an ACK carrying options 1, 3, 6, 51, 54, 58 and 59, then decode it | four DNS servers | Same fields back | |
+* | 03 | Move the DNS servers into the file field and the router into sname, flagged by option 52 | overload 3 | Both found | |
+* | 04 | Split option 6 over two instances | two addresses each | Four DNS servers, in order | RFC 3396 |
+* | 05 | Turn the ACK into a lease and bind an added interface with it | dhcp_packet_to_lease | The dhcp4c_get_if_* getters return the ACK's values | T1 within the lease |
+* | 06 | Turn an OFFER into a lease | | -1, lease unchanged | |
+*/
+void test_l1_skeleton_positive1_dhcp_packet(void)
+{
+    gTestID = 4;
+    UT_LOG_INFO("In %s [%02d%03d]\n", __FUNCTION__, gTestGroup, gTestID);
+    test_results_set_id(gTestGroup, gTestID);
+
+    static const uint8_t params[] = { DHCP_OPT_SUBNET_MASK, DHCP_OPT_ROUTER, DHCP_OPT_DNS, DHCP_OPT_LEASE_TIME,
+                                      DHCP_OPT_SERVER_ID, DHCP_OPT_RENEWAL, DHCP_OPT_REBINDING };
+    uint8_t buf[DHCP_PACKET_MIN_SIZE];
+    dhcp_packet_t packet;
+    dhcp_packet_t decoded;
+    dhcp_lease_t lease;
+    dhcp_lease_if_t iface;
+    ipv4AddrList_t dns;
+    unsigned int value;
+    size_t length;
+    size_t end;
+    int i;
+
+    UT_LOG_DEBUG("Round trip of a DISCOVER");
+    memset(&packet, 0, sizeof(packet));
+    packet.op = DHCP_BOOTREQUEST;
+    packet.xid = 0xdeadbeefU;
+    packet.hops = 1;
+    packet.giaddr = inet_addr("192.0.2.1");
+    packet.msg_type = DHCPDISCOVER;
+    packet.param_count = (int)sizeof(params);
+    memcpy(packet.params, params, sizeof(params));
+    UT_ASSERT_EQUAL_FATAL(dhcp_packet_encode(&packet, buf, sizeof(buf), &length), 0);
+    UT_ASSERT_EQUAL(length, DHCP_PACKET_BOOTP_SIZE);
+    UT_ASSERT_EQUAL(buf[DHCP_PACKET_FIXED_SIZE], 0x63);
+    UT_ASSERT_EQUAL(buf[DHCP_PACKET_FIXED_SIZE + 3], 0x63);
+    UT_ASSERT_EQUAL(dhcp_packet_decode(buf, length, &decoded), 0);
+    UT_ASSERT_TRUE(same_packet(&packet, &decoded));
+    UT_ASSERT_STRING_EQUAL(dhcp_packet_type_name(decoded.msg_type), "DISCOVER");
+
+    UT_LOG_DEBUG("Round trip of an ACK");
+    test_ack(&packet);
+    UT_ASSERT_EQUAL_FATAL(dhcp_packet_encode(&packet, buf, sizeof(buf), &length), 0);
+    UT_ASSERT_EQUAL(dhcp_packet_decode(buf, length, &decoded), 0);
+    UT_ASSERT_TRUE(same_packet(&packet, &decoded));
+
+    UT_LOG_DEBUG("Options overloaded into file and sname");
+    packet.dns_count = 0;
+    packet.router = 0;
+    UT_ASSERT_EQUAL_FATAL(dhcp_packet_encode(&packet, buf, sizeof(buf), &length), 0);
+    end = options_end(buf);
+    buf[end] = DHCP_OPT_OVERLOAD;
+    buf[end + 1] = 1;
+    buf[end + 2] = 3;
+    buf[end + 3] = DHCP_OPT_END;
+    buf[108] = DHCP_OPT_DNS;
+    buf[109] = 16;
+    test_ack(&packet);
+    memcpy(buf + 110, packet.dns, 16);
+    buf[126] = DHCP_OPT_END;
+    buf[44] = DHCP_OPT_ROUTER;
+    buf[45] = 4;
+    memcpy(buf + 46, &packet.router, 4);
+    buf[50] = DHCP_OPT_END;
+    UT_ASSERT_EQUAL(dhcp_packet_decode(buf, length, &decoded), 0);
+    UT_ASSERT_TRUE(same_packet(&packet, &decoded));
+
+    UT_LOG_DEBUG("Option 6 split over two instances");
+    packet.dns_count = 0;
+    UT_ASSERT_EQUAL_FATAL(dhcp_packet_encode(&packet, buf, sizeof(buf), &length), 0);
+    end = options_end(buf);
+    for (i = 0; i < 2; i++)
+    {
+        buf[end] = DHCP_OPT_DNS;
+        buf[end + 1] = 8;
+        memcpy(buf + end + 2, &packet.dns[i * 2], 8);
+        end += 10;
+    }
+    buf[end] = DHCP_OPT_END;
+    packet.dns_count = DHCP_PACKET_MAX_DNS;
+    UT_ASSERT_EQUAL(dhcp_packet_decode(buf, length, &decoded), 0);
+    UT_ASSERT_TRUE(same_packet(&packet, &decoded));
+
+    UT_LOG_DEBUG("An ACK through the lease engine to the getters");
+    memset(&lease, 0, sizeof(lease));
+    strcpy(lease.ifname, "pkt0");
+    UT_ASSERT_EQUAL(dhcp_packet_to_lease(&packet, &lease), 0);
+    UT_ASSERT_EQUAL_FATAL(dhcp_lease_engine_add_iface("pkt0", &iface), 0);
+    UT_ASSERT_EQUAL_FATAL(dhcp_lease_engine_bind(iface, &lease), 0);
+    UT_ASSERT_EQUAL(dhcp4c_get_if_ip_addr(iface, &value), STATUS_SUCCESS);
+    UT_ASSERT_EQUAL(value, packet.yiaddr);
+    UT_ASSERT_EQUAL(dhcp4c_get_if_mask(iface, &value), STATUS_SUCCESS);
+    UT_ASSERT_EQUAL(value, packet.mask);
+    UT_ASSERT_EQUAL(dhcp4c_get_if_gw(iface, &value), STATUS_SUCCESS);
+    UT_ASSERT_EQUAL(value, packet.router);
+    UT_ASSERT_EQUAL(dhcp4c_get_if_dhcp_svr(iface, &value), STATUS_SUCCESS);
+    UT_ASSERT_EQUAL(value, packet.server_id);
+    UT_ASSERT_EQUAL(dhcp4c_get_if_lease_time(iface, &value), STATUS_SUCCESS);
+    UT_ASSERT_EQUAL(value, packet.lease_time);
+    UT_ASSERT_EQUAL(dhcp4c_get_if_remain_renew_time(iface, &value), STATUS_SUCCESS);
+    UT_ASSERT_TRUE(value <= packet.renewal_time && value + 1 >= packet.renewal_time);
+    UT_ASSERT_EQUAL(dhcp4c_get_if_dns_svrs(iface, &dns), STATUS_SUCCESS);
+    UT_ASSERT_EQUAL(dns.number, DHCP_PACKET_MAX_DNS);
+    for (i = 0; i < dns.number && i < DHCP_PACKET_MAX_DNS; i++)
+    {
+        UT_ASSERT_EQUAL(dns.addrList[i], packet.dns[i]);
+    }
+    dhcp_lease_engine_reset();
+
+    UT_LOG_DEBUG("An OFFER is not a lease");
+    packet.msg_type = DHCPOFFER;
+    lease.ip_addr = 0;
+    UT_ASSERT_EQUAL(dhcp_packet_to_lease(&packet, &lease), -1);
+    UT_ASSERT_EQUAL(lease.ip_addr, 0);
+
+    UT_LOG_INFO("Out %s\n", __FUNCTION__);
+}
+
+/**
+* @brief Test case to verify that the DHCP packet codec rejects malformed input and never overruns a buffer
+*
+* Every length the decoder reads is checked against the end of its area, and the encoder fails instead of truncating. A short run of random mutations checks that whatever decodes also survives a round trip.
+*
+* **Test Group ID:** Basic: 01 @n
+* **Test Case ID:** 005 @n
+* **Priority:** High @n@n
+*
+* **Pre-Conditions:** Linux skeleton build @n
+* **Dependencies:** None @n
+* **User Interaction:** If user chose to run the test in interactive mode, then the test case has to be selected via console @n
+*
+* **Test Procedure:** @n
+* | Variation / Step | Description | Test Data | Expected Result | Notes |
+* | :----: | --------- | ---------- |-------------- | ----- |
+* | 01 | Invoking dhcp_packet_decode and dhcp_packet_encode with NULL | | -1 | |
+* | 02 | Decode every prefix of an encoded ACK, copied to an exactly sized buffer | 0 to 299 bytes | -1 up to the message type, then -1 or success | No read past the prefix |
+* | 03 | Decode with a bad magic cookie, no message type, a message type of the wrong length | | -1 | |
+* | 04 | Decode with an option running past the end, in the options and in an overloaded file field | length 255 | -1 | |
+* | 05 | Encode with no message type, too many DNS servers or parameters, a buffer below the options | | -1 | |
+* | 06 | Encode an ACK into every buffer size from 240 to the size it needs | guard bytes after the buffer | -1 until it fits, guard bytes untouched | |
+* | 07 | Mutate an encoded ACK at random and decode it | 20000 inputs | Whatever decodes encodes and decodes to the same fields | |
+*/
+void test_l1_skeleton_negative1_dhcp_packet(void)
+{
+    gTestID = 5;
+    UT_LOG_INFO("In %s [%02d%03d]\n", __FUNCTION__, gTestGroup, gTestID);
+    test_results_set_id(gTestGroup, gTestID);
+
+    uint8_t buf[DHCP_PACKET_MIN_SIZE];
+    uint8_t mutated[DHCP_PACKET_MIN_SIZE];
+    uint8_t encoded[DHCP_PACKET_MIN_SIZE];
+    dhcp_packet_t packet;
+    dhcp_packet_t decoded;
+    dhcp_packet_t again;
+    uint8_t *pPrefix;
+    uint32_t seed = 20231018;
+    uint32_t failures = 0;
+    uint32_t decodes = 0;
+    size_t length;
+    size_t needed;
+    size_t size;
+    size_t end;
+    uint32_t i;
+    uint32_t j;
+
+    test_ack(&packet);
+    UT_ASSERT_EQUAL_FATAL(dhcp_packet_encode(&packet, buf, sizeof(buf), &length), 0);
+    end = options_end(buf);
+
+    UT_LOG_DEBUG("Invoking the codec with NULL");
+    UT_ASSERT_EQUAL(dhcp_packet_decode(NULL, length, &decoded), -1);
+    UT_ASSERT_EQUAL(dhcp_packet_decode(buf, length, NULL), -1);
+    UT_ASSERT_EQUAL(dhcp_packet_encode(NULL, buf, sizeof(buf), &size), -1);
+    UT_ASSERT_EQUAL(dhcp_packet_encode(&packet, NULL, sizeof(buf), &size), -1);
+    UT_ASSERT_EQUAL(dhcp_packet_encode(&packet, buf, sizeof(buf), NULL), -1);
+    UT_ASSERT_EQUAL(dhcp_packet_to_lease(NULL, NULL), -1);
+
+    UT_LOG_DEBUG("Every prefix of an ACK");
+    for (size = 0; size < length; size++)
+    {
+        pPrefix = malloc(size ? size : 1);
+        UT_ASSERT_EQUAL_FATAL(pPrefix != NULL, 1);
+        memcpy(pPrefix, buf, size);
+        if (size < DHCP_PACKET_OPTIONS_OFFSET + 3)
+        {
+            UT_ASSERT_EQUAL(dhcp_packet_decode(pPrefix, size, &decoded), -1);
+        }
+        else
+        {
+            /* A cut inside an option fails; one between options decodes what came before */
+            UT_ASSERT_TRUE(dhcp_packet_decode(pPrefix, size, &decoded) == -1 || size >= end || decoded.msg_type == DHCPACK);
+        }
+        free(pPrefix);
+    }
+
+    UT_LOG_DEBUG("Bad cookie and message types");
+    memcpy(mutated, buf, length);
+    mutated[DHCP_PACKET_FIXED_SIZE] ^= 1;
+    UT_ASSERT_EQUAL(dhcp_packet_decode(mutated, length, &decoded), -1);
+    memcpy(mutated, buf, length);
+    mutated[DHCP_PACKET_OPTIONS_OFFSET] = DHCP_OPT_PAD;
+    mutated[DHCP_PACKET_OPTIONS_OFFSET + 1] = DHCP_OPT_PAD;
+    mutated[DHCP_PACKET_OPTIONS_OFFSET + 2] = DHCP_OPT_PAD;
+    UT_ASSERT_EQUAL(dhcp_packet_decode(mutated, length, &decoded), -1);
+    memcpy(mutated, buf, length);
+    mutated[DHCP_PACKET_OPTIONS_OFFSET + 1] = 0;
+    UT_ASSERT_EQUAL(dhcp_packet_decode(mutated, length, &decoded), -1);
+
+    UT_LOG_DEBUG("Options running past their area");
+    memcpy(mutated, buf, length);
+    mutated[end] = DHCP_OPT_DNS;
+    mutated[end + 1] = 255;
+    UT_ASSERT_EQUAL(dhcp_packet_decode(mutated, length, &decoded), -1);
+    memcpy(mutated, buf, length);
+    mutated[end] = DHCP_OPT_OVERLOAD;
+    mutated[end + 1] = 1;
+    mutated[end + 2] = 1;
+    mutated[end + 3] = DHCP_OPT_END;
+    mutated[108] = DHCP_OPT_DNS;
+    mutated[109] = 127;
+    UT_ASSERT_EQUAL(dhcp_packet_decode(mutated, length, &decoded), -1);
+    mutated[109] = 126;
+    UT_ASSERT_EQUAL(dhcp_packet_decode(mutated, length, &decoded), 0);
+
+    UT_LOG_DEBUG("Invalid messages to encode");
+    decoded = packet;
+    decoded.msg_type = 0;
+    UT_ASSERT_EQUAL(dhcp_packet_encode(&decoded, encoded, sizeof(encoded), &size), -1);
+    decoded = packet;
+    decoded.dns_count = DHCP_PACKET_MAX_DNS + 1;
+    UT_ASSERT_EQUAL(dhcp_packet_encode(&decoded, encoded, sizeof(encoded), &size), -1);
+    decoded = packet;
+    decoded.param_count = -1;
+    UT_ASSERT_EQUAL(dhcp_packet_encode(&decoded, encoded, sizeof(encoded), &size), -1);
+    UT_ASSERT_EQUAL(dhcp_packet_encode(&packet, encoded, DHCP_PACKET_OPTIONS_OFFSET - 1, &size), -1);
+
+    UT_LOG_DEBUG("Encoding into every buffer size up to the one needed");
+    needed = end + 1;
+    for (size = DHCP_PACKET_OPTIONS_OFFSET; size <= needed; size++)
+    {
+        memset(encoded, 0xa5, sizeof(encoded));
+        if (size < needed)
+        {
+            UT_ASSERT_EQUAL(dhcp_packet_encode(&packet, encoded, size, &length), -1);
+        }
+        else
+        {
+            UT_ASSERT_EQUAL(dhcp_packet_encode(&packet, encoded, size, &length), 0);
+            UT_ASSERT_EQUAL(length, needed);
+        }
+        for (i = (uint32_t)size; i < sizeof(encoded); i++)
+        {
+            failures += (encoded[i] != 0xa5);
+        }
+    }
+    UT_ASSERT_EQUAL(failures, 0);
+
+    UT_LOG_DEBUG("Random mutations of an ACK");
+    UT_ASSERT_EQUAL_FATAL(dhcp_packet_encode(&packet, buf, sizeof(buf), &length), 0);
+    for (i = 0; i < 20000; i++)
+    {
+        memcpy(mutated, buf, length);
+        size = length;
+        for (j = 0; j < 1 + next_random(&seed) % 4; j++)
+        {
+            mutated[DHCP_PACKET_FIXED_SIZE + next_random(&seed) % (uint32_t)(length - DHCP_PACKET_FIXED_SIZE)] = (uint8_t)next_random(&seed);
+        }
+        if (next_random(&seed) % 4 == 0)
+        {
+            size = DHCP_PACKET_OPTIONS_OFFSET + next_random(&seed) % (uint32_t)(length - DHCP_PACKET_OPTIONS_OFFSET);
+        }
+        if (dhcp_packet_decode(mutated, size, &decoded) != 0)
+        {
+            continue;
+        }
+        decodes++;
+        if (dhcp_packet_encode(&decoded, encoded, sizeof(encoded), &needed) != 0 ||
+            dhcp_packet_decode(encoded, needed, &again) != 0 || !same_packet(&decoded, &again))
+        {
+            failures++;
+        }
+    }
+    UT_LOG_DEBUG("%u of 20000 mutations decoded", decodes);
+    UT_ASSERT_TRUE(decodes > 0);
+    UT_ASSERT_EQUAL(failures, 0);
+
+    UT_LOG_INFO("Out %s\n", __FUNCTION__);
+}
+
+/* Random option area: PAD runs, options of any length, sometimes END or a cut inside an option */
+
+static size_t random_area( uint8_t *pArea, size_t capacity, uint32_t *pSeed )
+{
+    size_t size = 0;
+    size_t run;
+    size_t length;
+
+    while (size < capacity)
+    {
+        switch (next_random(pSeed) % 8)
+        {
+            case 0:
+            case 1:
+                run = next_random(pSeed) % 48;
+                run = (run < capacity - size) ? run : capacity - size;
+                memset(pArea + size, DHCP_OPT_PAD, run);
+                size += run;
+                break;
+            case 2:
+                if (next_random(pSeed) % 4 == 0)
+                {
+                    pArea[size++] = DHCP_OPT_END;
+                }
+                break;
+            case 3:
+                if (next_random(pSeed) % 8 == 0)
+                {
+                    /* Ends the area here, possibly inside an option */
+                    return size;
+                }
+                break;
+            default:
+                pArea[size++] = (uint8_t)(1 + next_random(pSeed) % 254);
+                if (size == capacity)
+                {
+                    break;
+                }
+                length = (next_random(pSeed) % 4 == 0) ? next_random(pSeed) % 256 : next_random(pSeed) % 8;
+                pArea[size++] = (uint8_t)length;
+                length = (length < capacity - size) ? length : capacity - size;
+                for (run = 0; run < length; run++)
+                {
+                    pArea[size++] = (uint8_t)next_random(pSeed);
+                }
+                break;
+        }
+    }
+    return size;
+}
+
+/* Scans an area in batches of max with one scanner, keeping every option found */
+static int scan_all( dhcp_packet_scanner_t scanner, const uint8_t *pArea, size_t size, uint32_t max,
+                     dhcp_option_ref_t *pRefs, uint32_t capacity, uint32_t *pCount, size_t *pOffset )
+{
+    int found;
+
+    dhcp_packet_set_scanner(scanner);
+    *pCount = 0;
+    *pOffset = 0;
+    while ((found = dhcp_packet_scan(pArea, size, pOffset, pRefs + *pCount, max)) > 0)
+    {
+        *pCount += (uint32_t)found;
+        if (*pCount + max > capacity)
+        {
+            return -2;
+        }
+    }
+    return found;
+}
+
+/**
+* @brief Test case to verify that the vectorized option scanner finds exactly what the scalar one does
+*
+* The codec locates options with a scanner chosen at run time. On random option areas, at every alignment and batch size, the vectorized scanner must return the same options, offsets and errors as the scalar one, and decoding must give the same fields with either.
+*
+* **Test Group ID:** Basic: 01 @n
+* **Test Case ID:** 006 @n
+* **Priority:** High @n@n
+*
+* **Pre-Conditions:** Linux skeleton build @n
+* **Dependencies:** None @n
+* **User Interaction:** If user chose to run the test in interactive mode, then the test case has to be selected via console @n
+*
+* **Test Procedure:** @n
+* | Variation / Step | Description | Test Data | Expected Result | Notes |
+* | :----: | --------- | ---------- |-------------- | ----- |
+* | 01 | Invoking dhcp_packet_scanner_name for each scanner | | "scalar", and "sse2" or "neon" where built | Vectorized steps are skipped without one |
+* | 02 | Scan random areas with both scanners | 5000 areas up to 1500 bytes, start offsets 0 to 15, batches of 1, 3 and 32 | Same return values, options and final offsets | |
+* | 03 | Scan an area that is only PAD, of every size to 64 bytes | | 0 options, offset at the end | Vector and tail loops |
+* | 04 | Decode a message whose options are PAD-aligned and overloaded into file and sname, with both scanners | | Same fields | |
+*/
+void test_l1_skeleton_positive1_dhcp_packet_scan(void)
+{
+    gTestID = 6;
+    UT_LOG_INFO("In %s [%02d%03d]\n", __FUNCTION__, gTestGroup, gTestID);
+    test_results_set_id(gTestGroup, gTestID);
+
+    static const uint32_t batches[] = { 1, 3, 32 };
+    static uint8_t area[1500 + 16];
+    static dhcp_option_ref_t scalarRefs[800];
+    static dhcp_option_ref_t vectorRefs[800];
+    dhcp_packet_scanner_t previous = dhcp_packet_get_scanner();
+    uint8_t buf[DHCP_PACKET_MIN_SIZE];
+    dhcp_packet_t packet;
+    dhcp_packet_t scalarPacket;
+    dhcp_packet_t vectorPacket;
+    uint32_t seed = 20231019;
+    uint32_t scalarCount;
+    uint32_t vectorCount;
+    uint32_t mismatches = 0;
+    uint32_t errors = 0;
+    uint32_t i;
+    uint32_t j;
+    size_t scalarOffset;
+    size_t vectorOffset;
+    size_t start;
+    size_t size;
+    size_t length;
+    size_t end;
+    int scalarFound;
+    int vectorFound;
+
+    UT_ASSERT_STRING_EQUAL(dhcp_packet_scanner_name(DHCP_PACKET_SCANNER_SCALAR), "scalar");
+    if (dhcp_packet_scanner_name(DHCP_PACKET_SCANNER_SIMD) == NULL)
+    {
+        UT_LOG_INFO("No vectorized scanner in this build, only the scalar one is checked");
+        UT_ASSERT_EQUAL(dhcp_packet_set_scanner(DHCP_PACKET_SCANNER_SIMD), -1);
+        UT_LOG_INFO("Out %s\n", __FUNCTION__);
+        return;
+    }
+    UT_LOG_DEBUG("Vectorized scanner: %s", dhcp_packet_scanner_name(DHCP_PACKET_SCANNER_SIMD));
+
+    UT_LOG_DEBUG("Random areas, every alignment and batch size");
+    for (i = 0; i < 5000; i++)
+    {
+        start = i % 16;
+        size = random_area(area + start, sizeof(area) - 16, &seed);
+        for (j = 0; j < sizeof(batches) / sizeof(batches[0]); j++)
+        {
+            scalarFound = scan_all(DHCP_PACKET_SCANNER_SCALAR, area + start, size, batches[j], scalarRefs, 800, &scalarCount, &scalarOffset);
+            vectorFound = scan_all(DHCP_PACKET_SCANNER_SIMD, area + start, size, batches[j], vectorRefs, 800, &vectorCount, &vectorOffset);
+            errors += (scalarFound == -1);
+            if (scalarFound != vectorFound || scalarCount != vectorCount || scalarOffset != vectorOffset ||
+                memcmp(scalarRefs, vectorRefs, sizeof(scalarRefs[0]) * scalarCount) != 0)
+            {
+                mismatches++;
+            }
+        }
+    }
+    UT_LOG_DEBUG("%u scans ended on a truncated option", errors);
+    UT_ASSERT_TRUE(errors > 0);
+    UT_ASSERT_EQUAL(mismatches, 0);
+
+    UT_LOG_DEBUG("Areas of PAD only");
+    memset(area, DHCP_OPT_PAD, 64);
+    for (size = 0; size <= 64; size++)
+    {
+        UT_ASSERT_EQUAL(scan_all(DHCP_PACKET_SCANNER_SIMD, area, size, 32, vectorRefs, 800, &vectorCount, &vectorOffset), 0);
+        UT_ASSERT_EQUAL(vectorCount, 0);
+        UT_ASSERT_EQUAL(vectorOffset, size);
+    }
+
+    UT_LOG_DEBUG("Decoding with either scanner");
+    test_ack(&packet);
+    packet.router = 0;
+    packet.dns_count = 0;
+    UT_ASSERT_EQUAL_FATAL(dhcp_packet_encode(&packet, buf, sizeof(buf), &length), 0);
+    end = options_end(buf);
+    memset(buf + end, DHCP_OPT_PAD, 21);
+    end += 21;
+    buf[end] = DHCP_OPT_OVERLOAD;
+    buf[end + 1] = 1;
+    buf[end + 2] = 3;
+    buf[end + 3] = DHCP_OPT_END;
+    memset(buf + 44, DHCP_OPT_PAD, 64 + 128);
+    test_ack(&packet);
+    buf[108 + 40] = DHCP_OPT_DNS;
+    buf[108 + 41] = 16;
+    memcpy(buf + 108 + 42, packet.dns, 16);
+    buf[44 + 17] = DHCP_OPT_ROUTER;
+    buf[44 + 18] = 4;
+    memcpy(buf + 44 + 19, &packet.router, 4);
+    dhcp_packet_set_scanner(DHCP_PACKET_SCANNER_SCALAR);
+    UT_ASSERT_EQUAL(dhcp_packet_decode(buf, length, &scalarPacket), 0);
+    dhcp_packet_set_scanner(DHCP_PACKET_SCANNER_SIMD);
+    UT_ASSERT_EQUAL(dhcp_packet_decode(buf, length, &vectorPacket), 0);
+    UT_ASSERT_TRUE(same_packet(&scalarPacket, &packet));
+    UT_ASSERT_TRUE(same_packet(&vectorPacket, &packet));
+
+    dhcp_packet_set_scanner(previous);
+    UT_LOG_INFO("Out %s\n", __FUNCTION__);
+}
+
+/**
+* @brief Test case to verify that the option scanner rejects invalid arguments
+*
+* **Test Group ID:** Basic: 01 @n
+* **Test Case ID:** 007 @n
+* **Priority:** High @n@n
+*
+* **Pre-Conditions:** Linux skeleton build @n
+* **Dependencies:** None @n
+* **User Interaction:** If user chose to run the test in interactive mode, then the test case has to be selected via console @n
+*
+* **Test Procedure:** @n
+* | Variation / Step | Description | Test Data | Expected Result | Notes |
+* | :----: | --------- | ---------- |-------------- | ----- |
+* | 01 | Invoking dhcp_packet_scan with NULL pointers, no room for options, an offset past the end | | -1 | |
+* | 02 | Invoking dhcp_packet_set_scanner and dhcp_packet_scanner_name with an unknown scanner | 7 | -1 and NULL, scanner unchanged | |
+* | 03 | Select each scanner and read it back | | dhcp_packet_get_scanner returns it | Restored after |
+*/
+void test_l1_skeleton_negative1_dhcp_packet_scan(void)
+{
+    gTestID = 7;
+    UT_LOG_INFO("In %s [%02d%03d]\n", __FUNCTION__, gTestGroup, gTestID);
+    test_results_set_id(gTestGroup, gTestID);
+
+    static const uint8_t area[] = { DHCP_OPT_MSG_TYPE, 1, DHCPACK, DHCP_OPT_END };
+    dhcp_packet_scanner_t previous = dhcp_packet_get_scanner();
+    dhcp_option_ref_t ref;
+    size_t offset = 0;
+
+    UT_ASSERT_EQUAL(dhcp_packet_scan(NULL, sizeof(area), &offset, &ref, 1), -1);
+    UT_ASSERT_EQUAL(dhcp_packet_scan(area, sizeof(area), NULL, &ref, 1), -1);
+    UT_ASSERT_EQUAL(dhcp_packet_scan(area, sizeof(area), &offset, NULL, 1), -1);
+    UT_ASSERT_EQUAL(dhcp_packet_scan(area, sizeof(area), &offset, &ref, 0), -1);
+    offset = sizeof(area) + 1;
+    UT_ASSERT_EQUAL(dhcp_packet_scan(area, sizeof(area), &offset, &ref, 1), -1);
+    offset = 0;
+    UT_ASSERT_EQUAL(dhcp_packet_scan(area, sizeof(area), &offset, &ref, 1), 1);
+    UT_ASSERT_EQUAL(ref.code, DHCP_OPT_MSG_TYPE);
+    UT_ASSERT_EQUAL(ref.offset, 2);
+    UT_ASSERT_EQUAL(dhcp_packet_scan(area, sizeof(area), &offset, &ref, 1), 0);
+    UT_ASSERT_EQUAL(offset, sizeof(area));
+
+    UT_ASSERT_EQUAL(dhcp_packet_set_scanner((dhcp_packet_scanner_t)7), -1);
+    UT_ASSERT_PTR_NULL(dhcp_packet_scanner_name((dhcp_packet_scanner_t)7));
+    UT_ASSERT_EQUAL(dhcp_packet_get_scanner(), previous);
+
+    UT_ASSERT_EQUAL(dhcp_packet_set_scanner(DHCP_PACKET_SCANNER_SCALAR), 0);
+    UT_ASSERT_EQUAL(dhcp_packet_get_scanner(), DHCP_PACKET_SCANNER_SCALAR);
+    if (dhcp_packet_scanner_name(DHCP_PACKET_SCANNER_SIMD) != NULL)
+    {
+        UT_ASSERT_EQUAL(dhcp_packet_set_scanner(DHCP_PACKET_SCANNER_SIMD), 0);
+        UT_ASSERT_EQUAL(dhcp_packet_get_scanner(), DHCP_PACKET_SCANNER_SIMD);
+    }
+    dhcp_packet_set_scanner(previous);
+
+    UT_LOG_INFO("Out %s\n", __FUNCTION__);
+}
+
+/* A lease whose fields all derive from n, so that a mix of two leases shows */
+static void pattern_lease( uint32_t n, dhcp_lease_t *pLease )
+{
+    memset(pLease, 0, sizeof(*pLease));
+    snprintf(pLease->ifname, sizeof(pLease->ifname), "erouter%u", n % 10);
+    pLease->ip_addr = htonl(0xcb007100U | (n & 0xffU));     /* 203.0.113.x */
+    pLease->mask = htonl(0xffffff00U);
+    pLease->gw = pLease->ip_addr ^ n;
+    pLease->dhcp_svr = ~pLease->ip_addr;
+    pLease->dns_svrs[0] = n;
+    pLease->dns_count = 1;
+    pLease->lease_time = 3600 + n;
+    pLease->renew_time = 1800;
+    pLease->rebind_time = 3150;
+    pLease->config_attempts = (int)(n & 0xffffU);
+    pLease->bound = 1;
+    pLease->bound_ns = n;
+}
+
+static int pattern_intact( const dhcp_lease_t *pLease )
+{
+    uint32_t n = pLease->dns_svrs[0];
+    dhcp_lease_t expected;
+
+    pattern_lease(n, &expected);
+    return memcmp(pLease, &expected, sizeof(expected)) == 0;
+}
+
+/* A page name no other run uses */
+static void lease_page_name( char *pName, size_t size )
+{
+    snprintf(pName, size, "/dhcp4c_l1_%d_%d", (int)getpid(), gTestID);
+}
+
+/**
+* @brief Test case to verify that the getters serve every lease from a shared-memory lease page
+*
+* With DHCP_LEASE_SHM set, the skeleton reads the leases a DHCP client publishes into a shared memory page. This test publishes leases as the client would and reads them back through the getters.
+*
+* **Test Group ID:** Basic: 01 @n
+* **Test Case ID:** 008 @n
+* **Priority:** High @n@n
+*
+* **Pre-Conditions:** Linux skeleton build @n
+* **Dependencies:** None @n
+* **User Interaction:** If user chose to run the test in interactive mode, then the test case has to be selected via console @n
+*
+* **Test Procedure:** @n
+* | Variation / Step | Description | Test Data | Expected Result | Notes |
+* | :----: | --------- | ---------- |-------------- | ----- |
+* | 01 | Create a lease page, publish eRouter and eCM leases, point DHCP_LEASE_SHM at it | 203.0.113.77 and 192.0.2.33 | Page created | |
+* | 02 | Invoking dhcp4c_get_ert_ifname, ip_addr, mask, gw, dhcp_svr, lease_time and dns_svrs | valid pointers | STATUS_SUCCESS and the published values | |
+* | 03 | Invoking dhcp4c_get_ert_fsm_state and dhcp4c_get_ert_remain_lease_time | valid pointers | BOUND, remaining time <= 7200 | Bound now |
+* | 04 | Invoking dhcp4c_get_ecm_ip_addr | valid pointer | STATUS_SUCCESS and the published address | |
+* | 05 | Publish a new eRouter lease, then release it | 203.0.113.78, then bound = 0 | The getter reports the new address at once, then INIT | No caching between the client and the getter |
+*/
+void test_l1_skeleton_positive1_lease_page(void)
+{
+    gTestID = 8;
+    UT_LOG_INFO("In %s [%02d%03d]\n", __FUNCTION__, gTestGroup, gTestID);
+    test_results_set_id(gTestGroup, gTestID);
+
+    dhcp_lease_shm_page_t *pPage;
+    char name[64];
+    char ifname[64] = "";
+    ipv4AddrList_t ip_list;
+    dhcp_lease_t lease;
+    unsigned int value = 0;
+    int state = 0;
+
+    lease_page_name(name, sizeof(name));
+    pPage = dhcp_lease_shm_create(name);
+    if (pPage == NULL)
+    {
+        UT_FAIL("Cannot create the lease page");
+        return;
+    }
+    memset(&lease, 0, sizeof(lease));
+    strcpy(lease.ifname, "erouter0");
+    lease.ip_addr = inet_addr("203.0.113.77");
+    lease.mask = inet_addr("255.255.255.0");
+    lease.gw = inet_addr("203.0.113.1");
+    lease.dhcp_svr = inet_addr("203.0.113.5");
+    lease.dns_svrs[0] = inet_addr("203.0.113.53");
+    lease.dns_svrs[1] = inet_addr("203.0.113.54");
+    lease.dns_count = 2;
+    lease.lease_time = 7200;
+    dhcp_lease_apply_defaults(&lease);
+    lease.bound = 1;
+    lease.bound_ns = dhcp_lease_engine_now_ns();
+    UT_ASSERT_EQUAL(dhcp_lease_shm_publish(pPage, DHCP_LEASE_IF_ERT, &lease), 0);
+    lease.ip_addr = inet_addr("192.0.2.33");
+    UT_ASSERT_EQUAL(dhcp_lease_shm_publish(pPage, DHCP_LEASE_IF_ECM, &lease), 0);
+    setenv(DHCP_LEASE_SHM_ENV, name, 1);
+    UT_LOG_DEBUG("Lease page: %s", name);
+
+    UT_ASSERT_EQUAL(dhcp4c_get_ert_ifname(ifname), STATUS_SUCCESS);
+    UT_ASSERT_EQUAL(strcmp(ifname, "erouter0"), 0);
+    UT_ASSERT_EQUAL(dhcp4c_get_ert_ip_addr(&value), STATUS_SUCCESS);
+    UT_ASSERT_EQUAL(value, inet_addr("203.0.113.77"));
+    UT_ASSERT_EQUAL(dhcp4c_get_ert_mask(&value), STATUS_SUCCESS);
+    UT_ASSERT_EQUAL(value, inet_addr("255.255.255.0"));
+    UT_ASSERT_EQUAL(dhcp4c_get_ert_gw(&value), STATUS_SUCCESS);
+    UT_ASSERT_EQUAL(value, inet_addr("203.0.113.1"));
+    UT_ASSERT_EQUAL(dhcp4c_get_ert_dhcp_svr(&value), STATUS_SUCCESS);
+    UT_ASSERT_EQUAL(value, inet_addr("203.0.113.5"));
+    UT_ASSERT_EQUAL(dhcp4c_get_ert_lease_time(&value), STATUS_SUCCESS);
+    UT_ASSERT_EQUAL(value, 7200);
+    memset(&ip_list, 0, sizeof(ip_list));
+    UT_ASSERT_EQUAL(dhcp4c_get_ert_dns_svrs(&ip_list), STATUS_SUCCESS);
+    UT_ASSERT_EQUAL(ip_list.number, 2);
+    UT_ASSERT_EQUAL(ip_list.addrList[1], inet_addr("203.0.113.54"));
+
+    UT_ASSERT_EQUAL(dhcp4c_get_ert_fsm_state(&state), STATUS_SUCCESS);
+    UT_ASSERT_EQUAL(state, DHCP_LEASE_FSM_BOUND);
+    UT_ASSERT_EQUAL(dhcp4c_get_ert_remain_lease_time(&value), STATUS_SUCCESS);
+    UT_LOG_DEBUG("remain_lease_time: %u", value);
+    UT_ASSERT_TRUE(value <= 7200 && value >= 7190);
+
+    UT_ASSERT_EQUAL(dhcp4c_get_ecm_ip_addr(&value), STATUS_SUCCESS);
+    UT_ASSERT_EQUAL(value, inet_addr("192.0.2.33"));
+
+    lease.ip_addr = inet_addr("203.0.113.78");
+    UT_ASSERT_EQUAL(dhcp_lease_shm_publish(pPage, DHCP_LEASE_IF_ERT, &lease), 0);
+    UT_ASSERT_EQUAL(dhcp4c_get_ert_ip_addr(&value), STATUS_SUCCESS);
+    UT_ASSERT_EQUAL(value, inet_addr("203.0.113.78"));
+    lease.bound = 0;
+    UT_ASSERT_EQUAL(dhcp_lease_shm_publish(pPage, DHCP_LEASE_IF_ERT, &lease), 0);
+    UT_ASSERT_EQUAL(dhcp4c_get_ert_fsm_state(&state), STATUS_SUCCESS);
+    UT_ASSERT_EQUAL(state, DHCP_LEASE_FSM_INIT);
+
+    unsetenv(DHCP_LEASE_SHM_ENV);
+    dhcp_lease_shm_close(pPage);
+    shm_unlink(name);
+    UT_LOG_INFO("Out %s\n", __FUNCTION__);
+}
+
+typedef struct
+{
+    const dhcp_lease_shm_page_t *pPage;
+    dhcp_lease_t lease;
+    int retries;
+    int done;
+} torn_reader_t;
+
+static void *torn_reader( void *pArg )
+{
+    torn_reader_t *pReader = (torn_reader_t *)pArg;
+
+    pReader->retries = dhcp_lease_shm_read(pReader->pPage, DHCP_LEASE_IF_ERT, &pReader->lease);
+    __atomic_store_n(&pReader->done, 1, __ATOMIC_RELEASE);
+    return NULL;
+}
+
+/**
+* @brief Test case to verify that a lease page read retries rather than return a lease the writer is still updating
+*
+* The test acts as a DHCP client caught half way through an update: the slot's sequence is odd and only part of the new lease is written. A reader started then must wait, and return the whole new lease once the update completes.
+*
+* **Test Group ID:** Basic: 01 @n
+* **Test Case ID:** 009 @n
+* **Priority:** High @n@n
+*
+* **Pre-Conditions:** Linux skeleton build @n
+* **Dependencies:** None @n
+* **User Interaction:** If user chose to run the test in interactive mode, then the test case has to be selected via console @n
+*
+* **Test Procedure:** @n
+* | Variation / Step | Description | Test Data | Expected Result | Notes |
+* | :----: | --------- | ---------- |-------------- | ----- |
+* | 01 | Publish lease 1, then make the sequence odd and write half of lease 2 | writable page | | Writer mid-update |
+* | 02 | Start a reader through a read-only mapping, wait 50 ms | dhcp_lease_shm_read | Still retrying | Does not return a torn lease |
+* | 03 | Write the rest of lease 2 and make the sequence even | | Reader returns lease 2 intact, retries > 0 | |
+* | 04 | Read lease 2 again with no writer | dhcp_lease_shm_read | Lease 2, 0 retries | |
+*/
+void test_l1_skeleton_positive2_lease_page_torn_read(void)
+{
+    gTestID = 9;
+    UT_LOG_INFO("In %s [%02d%03d]\n", __FUNCTION__, gTestGroup, gTestID);
+    test_results_set_id(gTestGroup, gTestID);
+
+    const size_t words = sizeof(dhcp_lease_t) / sizeof(uint32_t);
+    struct timespec pause = { 0, 50 * 1000000L };
+    dhcp_lease_shm_page_t *pPage;
+    dhcp_lease_shm_slot_t *pSlot;
+    dhcp_lease_shm_slot_t next;
+    torn_reader_t reader;
+    pthread_t thread;
+    char name[64];
+    uint32_t sequence;
+    size_t i;
+
+    lease_page_name(name, sizeof(name));
+    pPage = dhcp_lease_shm_create(name);
+    memset(&reader, 0, sizeof(reader));
+    reader.pPage = dhcp_lease_shm_open(name);
+    if (pPage == NULL || reader.pPage == NULL)
+    {
+        UT_FAIL("Cannot create the lease page");
+        dhcp_lease_shm_close(pPage);
+        shm_unlink(name);
+        return;
+    }
+    pattern_lease(1, &next.data.lease);
+    UT_ASSERT_EQUAL(dhcp_lease_shm_publish(pPage, DHCP_LEASE_IF_ERT, &next.data.lease), 0);
+
+    /* Half way through publishing lease 2 */
+    pSlot = &pPage->slots[DHCP_LEASE_IF_ERT];
+    pattern_lease(2, &next.data.lease);
+    sequence = __atomic_load_n(&pSlot->sequence, __ATOMIC_RELAXED);
+    __atomic_store_n(&pSlot->sequence, sequence + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    for (i = 0; i < words / 2; i++)
+    {
+        __atomic_store_n(&pSlot->data.words[i], next.data.words[i], __ATOMIC_RELAXED);
+    }
+
+    UT_ASSERT_EQUAL_FATAL(pthread_create(&thread, NULL, torn_reader, &reader), 0);
+    nanosleep(&pause, NULL);
+    UT_LOG_DEBUG("Reader done during the update: %d", __atomic_load_n(&reader.done, __ATOMIC_ACQUIRE));
+    UT_ASSERT_EQUAL(__atomic_load_n(&reader.done, __ATOMIC_ACQUIRE), 0);
+
+    for (; i < words; i++)
+    {
+        __atomic_store_n(&pSlot->data.words[i], next.data.words[i], __ATOMIC_RELAXED);
+    }
+    __atomic_store_n(&pSlot->sequence, sequence + 2, __ATOMIC_RELEASE);
+    pthread_join(thread, NULL);
+
+    UT_LOG_DEBUG("Reader retried %d times", reader.retries);
+    test_results_add_value("retries", "%d", reader.retries);
+    UT_ASSERT_TRUE(reader.retries > 0);
+    UT_ASSERT_TRUE(pattern_intact(&reader.lease));
+    UT_ASSERT_EQUAL(reader.lease.dns_svrs[0], 2);
+
+    memset(&reader.lease, 0, sizeof(reader.lease));
+    UT_ASSERT_EQUAL(dhcp_lease_shm_read(reader.pPage, DHCP_LEASE_IF_ERT, &reader.lease), 0);
+    UT_ASSERT_EQUAL(reader.lease.dns_svrs[0], 2);
+
+    dhcp_lease_shm_close(reader.pPage);
+    dhcp_lease_shm_close(pPage);
+    shm_unlink(name);
+    UT_LOG_INFO("Out %s\n", __FUNCTION__);
+}
+
+typedef struct
+{
+    dhcp_lease_shm_page_t *pPage;
+    int stop;
+    uint32_t published;
+} page_writer_t;
+
+static void *page_writer( void *pArg )
+{
+    page_writer_t *pWriter = (page_writer_t *)pArg;
+    dhcp_lease_t lease;
+    uint32_t n = 1;
+
+    while (!__atomic_load_n(&pWriter->stop, __ATOMIC_ACQUIRE))
+    {
+        pattern_lease(++n, &lease);
+        dhcp_lease_shm_publish(pWriter->pPage, DHCP_LEASE_IF_ERT, &lease);
+    }
+    pWriter->published = n - 1;
+    return NULL;
+}
+
+/**
+* @brief Test case to verify that lease page reads are never torn while the client rewrites the lease continuously
+*
+* A writer thread publishes a new lease as fast as it can for 200 ms while the test reads the slot in a loop. Every field of each lease derives from one counter, so a read mixing two leases shows.
+*
+* **Test Group ID:** Basic: 01 @n
+* **Test Case ID:** 010 @n
+* **Priority:** High @n@n
+*
+* **Pre-Conditions:** Linux skeleton build @n
+* **Dependencies:** None @n
+* **User Interaction:** If user chose to run the test in interactive mode, then the test case has to be selected via console @n
+*
+* **Test Procedure:** @n
+* | Variation / Step | Description | Test Data | Expected Result | Notes |
+* | :----: | --------- | ---------- |-------------- | ----- |
+* | 01 | Start a writer publishing new leases back to back | writable page | | |
+* | 02 | Read through a read-only mapping for 200 ms | dhcp_lease_shm_read | Every lease intact, counter never going back | Retries logged |
+* | 03 | Stop the writer, read once more | | The writer's last lease | |
+*/
+void test_l1_skeleton_positive3_lease_page_concurrent(void)
+{
+    gTestID = 10;
+    UT_LOG_INFO("In %s [%02d%03d]\n", __FUNCTION__, gTestGroup, gTestID);
+    test_results_set_id(gTestGroup, gTestID);
+
+    const dhcp_lease_shm_page_t *pReader;
+    page_writer_t writer;
+    pthread_t thread;
+    dhcp_lease_t lease;
+    struct timespec start;
+    struct timespec now;
+    char name[64];
+    unsigned long long reads = 0;
+    unsigned long long retried = 0;
+    unsigned long long torn = 0;
+    unsigned long long backwards = 0;
+    uint32_t last = 0;
+    int retries;
+
+    lease_page_name(name, sizeof(name));
+    memset(&writer, 0, sizeof(writer));
+    writer.pPage = dhcp_lease_shm_create(name);
+    pReader = dhcp_lease_shm_open(name);
+    if (writer.pPage == NULL || pReader == NULL)
+    {
+        UT_FAIL("Cannot create the lease page");
+        dhcp_lease_shm_close(writer.pPage);
+        shm_unlink(name);
+        return;
+    }
+    pattern_lease(1, &lease);
+    UT_ASSERT_EQUAL(dhcp_lease_shm_publish(writer.pPage, DHCP_LEASE_IF_ERT, &lease), 0);
+    UT_ASSERT_EQUAL_FATAL(pthread_create(&thread, NULL, page_writer, &writer), 0);
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    do
+    {
+        retries = dhcp_lease_shm_read(pReader, DHCP_LEASE_IF_ERT, &lease);
+        reads++;
+        retried += (retries > 0) ? (unsigned long long)retries : 0;
+        torn += !pattern_intact(&lease);
+        backwards += (lease.dns_svrs[0] < last);
+        last = lease.dns_svrs[0];
+        clock_gettime(CLOCK_MONOTONIC, &now);
+    } while ((now.tv_sec - start.tv_sec) * 1000000000LL + (now.tv_nsec - start.tv_nsec) < 200000000LL);
+
+    __atomic_store_n(&writer.stop, 1, __ATOMIC_RELEASE);
+    pthread_join(thread, NULL);
+    UT_LOG_DEBUG("%llu reads, %llu retries, %llu torn, %u leases published", reads, retried, torn, writer.published);
+    test_results_add_value("reads", "%llu", reads);
+    test_results_add_value("retries", "%llu", retried);
+    test_results_add_value("published", "%u", writer.published);
+    UT_ASSERT_EQUAL(torn, 0);
+    UT_ASSERT_EQUAL(backwards, 0);
+    UT_ASSERT_TRUE(writer.published > 0);
+
+    UT_ASSERT_EQUAL(dhcp_lease_shm_read(pReader, DHCP_LEASE_IF_ERT, &lease), 0);
+    UT_ASSERT_EQUAL(lease.dns_svrs[0], writer.published + 1);
+
+    dhcp_lease_shm_close(pReader);
+    dhcp_lease_shm_close(writer.pPage);
+    shm_unlink(name);
+    UT_LOG_INFO("Out %s\n", __FUNCTION__);
+}
+
+/**
+* @brief Test case to verify that the getters fail when the lease page is missing, foreign or unpublished
+*
+* **Test Group ID:** Basic: 01 @n
+* **Test Case ID:** 011 @n
+* **Priority:** High @n@n
+*
+* **Pre-Conditions:** Linux skeleton build @n
+* **Dependencies:** None @n
+* **User Interaction:** If user chose to run the test in interactive mode, then the test case has to be selected via console @n
+*
+* **Test Procedure:** @n
+* | Variation / Step | Description | Test Data | Expected Result | Notes |
+* | :----: | --------- | ---------- |-------------- | ----- |
+* | 01 | Point DHCP_LEASE_SHM at an object that does not exist and invoke dhcp4c_get_ert_ip_addr | valid pointer | STATUS_FAILURE | |
+* | 02 | Create a page, publish only the eRouter lease, invoke dhcp4c_get_emta_remain_lease_time | valid pointer | STATUS_FAILURE | Never published |
+* | 03 | Publish an eRouter lease whose name fills its field with no NUL, invoke dhcp4c_get_ert_ifname | 64-byte buffer | STATUS_SUCCESS, the DHCP_LEASE_IFNAME_LEN characters, terminated | A client's bad write |
+* | 04 | Invoking dhcp_lease_shm_read and dhcp_lease_shm_publish with invalid arguments | NULL page, NULL lease, DHCP_LEASE_IF_MAX | -1 | |
+* | 05 | Leave the eRouter slot mid-update, as a client that died there would | odd sequence | dhcp_lease_shm_read returns DHCP_LEASE_SHM_STALLED | After DHCP_LEASE_SHM_STALL_MS |
+* | 06 | Invoking dhcp4c_get_ert_ip_addr with DHCP_LEASE_SHM still set | valid pointer | STATUS_SUCCESS and the lease engine's address | Next source |
+* | 07 | Map an object of the wrong size and one with another magic | dhcp_lease_shm_open | NULL | |
+*/
+void test_l1_skeleton_negative1_lease_page(void)
+{
+    gTestID = 11;
+    UT_LOG_INFO("In %s [%02d%03d]\n", __FUNCTION__, gTestGroup, gTestID);
+    test_results_set_id(gTestGroup, gTestID);
+
+    dhcp_lease_shm_page_t *pPage;
+    dhcp_lease_t lease;
+    char name[64];
+    char ifname[64];
+    unsigned int value = 0;
+    uint32_t engine = 0;
+    uint32_t junk[32];
+    int fd;
+
+    lease_page_name(name, sizeof(name));
+    shm_unlink(name);
+    setenv(DHCP_LEASE_SHM_ENV, name, 1);
+    UT_ASSERT_EQUAL(dhcp4c_get_ert_ip_addr(&value), STATUS_FAILURE);
+
+    pPage = dhcp_lease_shm_create(name);
+    if (pPage == NULL)
+    {
+        UT_FAIL("Cannot create the lease page");
+        unsetenv(DHCP_LEASE_SHM_ENV);
+        return;
+    }
+    pattern_lease(7, &lease);
+    UT_ASSERT_EQUAL(dhcp_lease_shm_publish(pPage, DHCP_LEASE_IF_ERT, &lease), 0);
+    UT_ASSERT_EQUAL(dhcp4c_get_ert_ip_addr(&value), STATUS_SUCCESS);
+    UT_ASSERT_EQUAL(dhcp4c_get_emta_remain_lease_time(&value), STATUS_FAILURE);
+
+    /* The page belongs to another process, which need not terminate the name */
+    memset(lease.ifname, 'w', sizeof(lease.ifname));
+    UT_ASSERT_EQUAL(dhcp_lease_shm_publish(pPage, DHCP_LEASE_IF_ERT, &lease), 0);
+    memset(ifname, 'x', sizeof(ifname));
+    UT_ASSERT_EQUAL(dhcp4c_get_ert_ifname(ifname), STATUS_SUCCESS);
+    UT_ASSERT_EQUAL(strnlen(ifname, sizeof(ifname)), DHCP_LEASE_IFNAME_LEN);
+    unsetenv(DHCP_LEASE_SHM_ENV);
+
+    UT_ASSERT_EQUAL(dhcp_lease_shm_read(NULL, DHCP_LEASE_IF_ERT, &lease), -1);
+    UT_ASSERT_EQUAL(dhcp_lease_shm_read(pPage, DHCP_LEASE_IF_MAX, &lease), -1);
+    UT_ASSERT_EQUAL(dhcp_lease_shm_read(pPage, DHCP_LEASE_IF_ERT, NULL), -1);
+    UT_ASSERT_EQUAL(dhcp_lease_shm_publish(pPage, DHCP_LEASE_IF_MAX, &lease), -1);
+    UT_ASSERT_EQUAL(dhcp_lease_shm_publish(pPage, DHCP_LEASE_IF_ERT, NULL), -1);
+
+    /* The writer died with the sequence odd */
+    __atomic_add_fetch(&pPage->slots[DHCP_LEASE_IF_ERT].sequence, 1, __ATOMIC_RELEASE);
+    UT_ASSERT_EQUAL(dhcp_lease_shm_read(pPage, DHCP_LEASE_IF_ERT, &lease), DHCP_LEASE_SHM_STALLED);
+    setenv(DHCP_LEASE_SHM_ENV, name, 1);
+    UT_ASSERT_EQUAL(dhcp_lease_engine_field(DHCP_LEASE_IF_ERT, DHCP_LEASE_FIELD_IP_ADDR, &engine), 0);
+    UT_ASSERT_EQUAL(dhcp4c_get_ert_ip_addr(&value), STATUS_SUCCESS);
+    UT_ASSERT_EQUAL(value, engine);
+    unsetenv(DHCP_LEASE_SHM_ENV);
+    dhcp_lease_shm_close(pPage);
+    shm_unlink(name);
+
+    /* Something else owns the name: too small, then the right size with another magic */
+    memset(junk, 0x5a, sizeof(junk));
+    fd = shm_open(name, O_RDWR | O_CREAT | O_EXCL, 0600);
+    if (fd < 0)
+    {
+        UT_FAIL("Cannot create the foreign object");
+        return;
+    }
+    UT_ASSERT_EQUAL(write(fd, junk, sizeof(junk)), (ssize_t)sizeof(junk));
+    UT_ASSERT_PTR_NULL(dhcp_lease_shm_open(name));
+    UT_ASSERT_PTR_NULL(dhcp_lease_shm_create(name));
+    UT_ASSERT_EQUAL(ftruncate(fd, sizeof(dhcp_lease_shm_page_t)), 0);
+    UT_ASSERT_PTR_NULL(dhcp_lease_shm_open(name));
+    UT_ASSERT_PTR_NULL(dhcp_lease_shm_create(name));
+    close(fd);
+    shm_unlink(name);
+
+    UT_LOG_INFO("Out %s\n", __FUNCTION__);
+}
+
+/**
+* @brief Test case to verify that the eMTA snapshot reads the same lease source as the eMTA getters
+*
+* dhcpv4c_get_emta_snapshot() must serve the lease page, the replay trace or the lease engine exactly as dhcpv4c_get_emta_remain_*_time() do. The lease engine holds a shorter eMTA lease than the page, so a snapshot taken from the wrong source shows.
+*
+* **Test Group ID:** Basic: 01 @n
+* **Test Case ID:** 012 @n
+* **Priority:** High @n@n
+*
+* **Pre-Conditions:** Linux skeleton build @n
+* **Dependencies:** None @n
+* **User Interaction:** If user chose to run the test in interactive mode, then the test case has to be selected via console @n
+*
+* **Test Procedure:** @n
+* | Variation / Step | Description | Test Data | Expected Result | Notes |
+* | :----: | --------- | ---------- |-------------- | ----- |
+* | 01 | Bind the lease engine's eMTA lease, publish a longer one on a lease page, point DHCP_LEASE_SHM at it | 600 s and 3600 s | | |
+* | 02 | Invoking dhcpv4c_get_emta_snapshot | valid pointer | STATUS_SUCCESS, remaining times of the page's lease | Not the engine's |
+* | 03 | Invoking dhcpv4c_get_emta_remain_lease_time, remain_renew_time and remain_rebind_time | valid pointers | STATUS_SUCCESS, each within a second of the snapshot | |
+* | 04 | Unset DHCP_LEASE_SHM and repeat 02 and 03 | | The engine's lease from both | |
+*/
+void test_l1_skeleton_positive1_emta_snapshot(void)
+{
+    gTestID = 12;
+    UT_LOG_INFO("In %s [%02d%03d]\n", __FUNCTION__, gTestGroup, gTestID);
+    test_results_set_id(gTestGroup, gTestID);
+
+    dhcpv4c_emta_snapshot_t snapshot;
+    dhcp_lease_shm_page_t *pPage;
+    char name[64];
+    dhcp_lease_t lease;
+    UINT lease_remain = 0;
+    UINT renew_remain = 0;
+    UINT rebind_remain = 0;
+    int pass;
+
+    memset(&lease, 0, sizeof(lease));
+    strcpy(lease.ifname, "mta0");
+    lease.ip_addr = inet_addr("198.51.100.20");
+    lease.mask = inet_addr("255.255.255.0");
+    lease.lease_time = 600;
+    dhcp_lease_apply_defaults(&lease);
+    UT_ASSERT_EQUAL_FATAL(dhcp_lease_engine_bind(DHCP_LEASE_IF_EMTA, &lease), 0);
+
+    lease_page_name(name, sizeof(name));
+    pPage = dhcp_lease_shm_create(name);
+    if (pPage == NULL)
+    {
+        UT_FAIL("Cannot create the lease page");
+        dhcp_lease_engine_reset();
+        return;
+    }
+    lease.lease_time = 3600;
+    lease.renew_time = 0;
+    lease.rebind_time = 0;
+    dhcp_lease_apply_defaults(&lease);
+    lease.bound = 1;
+    lease.bound_ns = dhcp_lease_engine_now_ns();
+    UT_ASSERT_EQUAL(dhcp_lease_shm_publish(pPage, DHCP_LEASE_IF_EMTA, &lease), 0);
+    setenv(DHCP_LEASE_SHM_ENV, name, 1);
+
+    for (pass = 0; pass < 2; pass++)
+    {
+        UT_LOG_DEBUG("eMTA lease from the %s", (pass == 0) ? "lease page" : "lease engine");
+        memset(&snapshot, 0, sizeof(snapshot));
+        UT_ASSERT_EQUAL(dhcpv4c_get_emta_snapshot(&snapshot), STATUS_SUCCESS);
+        UT_ASSERT_EQUAL(dhcpv4c_get_emta_remain_lease_time(&lease_remain), STATUS_SUCCESS);
+        UT_ASSERT_EQUAL(dhcpv4c_get_emta_remain_renew_time(&renew_remain), STATUS_SUCCESS);
+        UT_ASSERT_EQUAL(dhcpv4c_get_emta_remain_rebind_time(&rebind_remain), STATUS_SUCCESS);
+        UT_LOG_DEBUG("snapshot %u/%u/%u, getters %u/%u/%u", snapshot.remain_lease_time, snapshot.remain_renew_time,
+                     snapshot.remain_rebind_time, lease_remain, renew_remain, rebind_remain);
+        if (pass == 0)
+        {
+            UT_ASSERT_TRUE(snapshot.remain_lease_time > 600 && snapshot.remain_lease_time <= 3600);
+        }
+        else
+        {
+            UT_ASSERT_TRUE(snapshot.remain_lease_time <= 600);
+        }
+        UT_ASSERT_TRUE(snapshot.remain_lease_time >= lease_remain && snapshot.remain_lease_time <= lease_remain + 1);
+        UT_ASSERT_TRUE(snapshot.remain_renew_time >= renew_remain && snapshot.remain_renew_time <= renew_remain + 1);
+        UT_ASSERT_TRUE(snapshot.remain_rebind_time >= rebind_remain && snapshot.remain_rebind_time <= rebind_remain + 1);
+        unsetenv(DHCP_LEASE_SHM_ENV);
+    }
+
+    dhcp_lease_shm_close(pPage);
+    shm_unlink(name);
+    dhcp_lease_engine_reset();
+    UT_LOG_INFO("Out %s\n", __FUNCTION__);
+}
+
+/**
+* @brief Test case to verify the lease engine's interface table beyond the three base interfaces
+*
+* Added interfaces get the next indices and a default lease, are read through the indexed getters like the base ones, run their own lease timers and are dropped again by a reset. A scan of one field over the whole table agrees with the getters.
+*
+* **Test Group ID:** Basic: 01 @n
+* **Test Case ID:** 013 @n
+* **Priority:** High @n@n
+*
+* **Pre-Conditions:** Linux skeleton build, DHCP_LEASE_SHM unset @n
+* **Dependencies:** None @n
+* **User Interaction:** If user chose to run the test in interactive mode, then the test case has to be selected via console @n
+*
+* **Test Procedure:** @n
+* | Variation / Step | Description | Test Data | Expected Result | Notes |
+* | :----: | --------- | ---------- |-------------- | ----- |
+* | 01 | Add two interfaces after a reset with DHCP_LEASE_ENGINE_IFACES unset | "wan1", "lte0" | Indices 3 and 4; dhcp4c_get_if_count returns 5 | |
+* | 02 | Add invalid and duplicate names | "", 16 characters, "wan1" | -1 | |
+* | 03 | Read the first added interface through the indexed getters | index 3 | 198.18.0.14/30 via 198.18.0.13, BOUND, one-hour lease, "wan1" | Default lease |
+* | 04 | Bind, then release the second added interface | 203.0.113.64, 1000 s | Getters follow; INIT after release, name kept | |
+* | 05 | Fill the table | DHCP_LEASE_MAX_IFACES | Adding one more fails | |
+* | 06 | Scan ip_addr and remain_lease over the whole table | dhcp_lease_engine_scan | Same values as the indexed getters; a start past the end fails | |
+* | 07 | Disable renewals and advance one hour | 3600 s | Every added interface INIT in a scan, the eRouter still BOUND | |
+* | 08 | Reset with DHCP_LEASE_ENGINE_IFACES set | "wan1,,lte0" | Count 5, names found by dhcp4c_get_if_index | Then restored |
+*/
+void test_l1_skeleton_positive1_lease_table(void)
+{
+    gTestID = 13;
+    UT_LOG_INFO("In %s [%02d%03d]\n", __FUNCTION__, gTestGroup, gTestID);
+    test_results_set_id(gTestGroup, gTestID);
+
+    static uint32_t values[DHCP_LEASE_MAX_IFACES];
+    const char *pPrevious = getenv(DHCP_LEASE_ENGINE_IFACES_ENV);
+    char *pSaved = (pPrevious != NULL) ? strdup(pPrevious) : NULL;
+    dhcp_lease_if_t iface = DHCP_LEASE_IF_MAX;
+    dhcp_lease_t lease;
+    char name[DHCP4C_IFNAME_SIZE];
+    unsigned int count = 0;
+    unsigned int index = 0;
+    unsigned int value = 0;
+    int state = 0;
+    uint32_t mismatches;
+    uint32_t i;
+
+    unsetenv(DHCP_LEASE_ENGINE_IFACES_ENV);
+    dhcp_lease_engine_reset();
+    UT_ASSERT_EQUAL(dhcp4c_get_if_count(&count), STATUS_SUCCESS);
+    UT_ASSERT_EQUAL(count, DHCP_LEASE_IF_MAX);
+    UT_ASSERT_EQUAL(dhcp_lease_engine_add_iface("wan1", &iface), 0);
+    UT_ASSERT_EQUAL(iface, DHCP_LEASE_IF_MAX);
+    UT_ASSERT_EQUAL(dhcp_lease_engine_add_iface("lte0", &iface), 0);
+    UT_ASSERT_EQUAL(iface, DHCP_LEASE_IF_MAX + 1);
+    UT_ASSERT_EQUAL(dhcp4c_get_if_count(&count), STATUS_SUCCESS);
+    UT_ASSERT_EQUAL(count, DHCP_LEASE_IF_MAX + 2);
+
+    UT_LOG_DEBUG("Adding invalid and duplicate names");
+    UT_ASSERT_EQUAL(dhcp_lease_engine_add_iface("", NULL), -1);
+    UT_ASSERT_EQUAL(dhcp_lease_engine_add_iface("0123456789abcdef", NULL), -1);
+    UT_ASSERT_EQUAL(dhcp_lease_engine_add_iface("wan1", NULL), -1);
+    UT_ASSERT_EQUAL(dhcp_lease_engine_add_iface(NULL, NULL), -1);
+    UT_ASSERT_EQUAL(dhcp_lease_engine_iface_count(), DHCP_LEASE_IF_MAX + 2);
+
+    UT_ASSERT_EQUAL(dhcp4c_get_if_ip_addr(DHCP_LEASE_IF_MAX, &value), STATUS_SUCCESS);
+    UT_ASSERT_EQUAL(value, inet_addr("198.18.0.14"));
+    UT_ASSERT_EQUAL(dhcp4c_get_if_mask(DHCP_LEASE_IF_MAX, &value), STATUS_SUCCESS);
+    UT_ASSERT_EQUAL(value, inet_addr("255.255.255.252"));
+    UT_ASSERT_EQUAL(dhcp4c_get_if_gw(DHCP_LEASE_IF_MAX, &value), STATUS_SUCCESS);
+    UT_ASSERT_EQUAL(value, inet_addr("198.18.0.13"));
+    UT_ASSERT_EQUAL(dhcp4c_get_if_lease_time(DHCP_LEASE_IF_MAX, &value), STATUS_SUCCESS);
+    UT_ASSERT_EQUAL(value, 3600);
+    UT_ASSERT_EQUAL(dhcp4c_get_if_fsm_state(DHCP_LEASE_IF_MAX, &state), STATUS_SUCCESS);
+    UT_ASSERT_EQUAL(state, DHCP_LEASE_FSM_BOUND);
+    UT_ASSERT_EQUAL(dhcp4c_get_if_ifname(DHCP_LEASE_IF_MAX, name), STATUS_SUCCESS);
+    UT_ASSERT_STRING_EQUAL(name, "wan1");
+    UT_ASSERT_EQUAL(dhcp4c_get_if_index("lte0", &index), STATUS_SUCCESS);
+    UT_ASSERT_EQUAL(index, DHCP_LEASE_IF_MAX + 1);
+
+    UT_LOG_DEBUG("Binding and releasing lte0");
+    timer_test_lease(1000, 0, 0, &lease);
+    strcpy(lease.ifname, "lte0");
+    UT_ASSERT_EQUAL(dhcp_lease_engine_bind(iface, &lease), 0);
+    UT_ASSERT_EQUAL(dhcp4c_get_if_ip_addr(iface, &value), STATUS_SUCCESS);
+    UT_ASSERT_EQUAL(value, inet_addr("203.0.113.64"));
+    UT_ASSERT_EQUAL(dhcp4c_get_if_remain_renew_time(iface, &value), STATUS_SUCCESS);
+    UT_ASSERT_TRUE(value <= 500 && value >= 499);
+    UT_ASSERT_EQUAL(dhcp_lease_engine_release(iface), 0);
+    UT_ASSERT_EQUAL(dhcp4c_get_if_fsm_state(iface, &state), STATUS_SUCCESS);
+    UT_ASSERT_EQUAL(state, DHCP_LEASE_FSM_INIT);
+    UT_ASSERT_EQUAL(dhcp4c_get_if_index("lte0", &index), STATUS_SUCCESS);
+    UT_ASSERT_EQUAL(dhcp_lease_engine_bind(iface, &lease), 0);
+
+    UT_LOG_DEBUG("Filling the table");
+    for (i = DHCP_LEASE_IF_MAX + 2; i < DHCP_LEASE_MAX_IFACES; i++)
+    {
+        snprintf(name, sizeof(name), "wan%u", i);
+        if (dhcp_lease_engine_add_iface(name, NULL) != 0)
+        {
+            break;
+        }
+    }
+    UT_ASSERT_EQUAL(i, DHCP_LEASE_MAX_IFACES);
+    UT_ASSERT_EQUAL(dhcp_lease_engine_add_iface("full0", NULL), -1);
+    UT_ASSERT_EQUAL(dhcp4c_get_if_count(&count), STATUS_SUCCESS);
+    UT_ASSERT_EQUAL(count, DHCP_LEASE_MAX_IFACES);
+
+    UT_ASSERT_EQUAL(dhcp_lease_engine_scan(DHCP_LEASE_FIELD_IP_ADDR, 0, DHCP_LEASE_MAX_IFACES + 10, values), DHCP_LEASE_MAX_IFACES);
+    mismatches = 0;
+    for (i = 0; i < DHCP_LEASE_MAX_IFACES; i++)
+    {
+        mismatches += (dhcp4c_get_if_ip_addr(i, &value) != STATUS_SUCCESS || value != values[i]);
+    }
+    UT_ASSERT_EQUAL(mismatches, 0);
+    UT_ASSERT_EQUAL(values[DHCP_LEASE_MAX_IFACES - 1], inet_addr("198.18.15.254"));
+    UT_ASSERT_EQUAL(dhcp_lease_engine_scan(DHCP_LEASE_FIELD_IP_ADDR, 3, 1, values), 1);
+    UT_ASSERT_EQUAL(values[0], inet_addr("198.18.0.14"));
+    UT_ASSERT_EQUAL(dhcp_lease_engine_scan(DHCP_LEASE_FIELD_REMAIN_LEASE, 3, 2, values), 2);
+    UT_ASSERT_TRUE(values[0] <= 3600 && values[0] >= 3599);
+    UT_ASSERT_TRUE(values[1] <= 1000 && values[1] >= 999);
+    UT_ASSERT_EQUAL(dhcp_lease_engine_scan(DHCP_LEASE_FIELD_GW, DHCP_LEASE_MAX_IFACES, 1, values), 0);
+    UT_ASSERT_EQUAL(dhcp_lease_engine_scan(DHCP_LEASE_FIELD_GW, DHCP_LEASE_MAX_IFACES + 1, 1, values), -1);
+    UT_ASSERT_EQUAL(dhcp_lease_engine_scan(DHCP_LEASE_FIELD_MAX, 0, 1, values), -1);
+    UT_ASSERT_EQUAL(dhcp_lease_engine_scan(DHCP_LEASE_FIELD_GW, 0, 1, NULL), -1);
+
+    UT_LOG_DEBUG("Letting every added lease expire");
+    dhcp_lease_engine_set_auto_renew(0);
+    dhcp_lease_engine_advance(3600);
+    UT_ASSERT_EQUAL(dhcp_lease_engine_scan(DHCP_LEASE_FIELD_FSM_STATE, 0, DHCP_LEASE_MAX_IFACES, values), DHCP_LEASE_MAX_IFACES);
+    UT_ASSERT_EQUAL(values[DHCP_LEASE_IF_ERT], DHCP_LEASE_FSM_BOUND);
+    mismatches = 0;
+    for (i = DHCP_LEASE_IF_MAX; i < DHCP_LEASE_MAX_IFACES; i++)
+    {
+        mismatches += (values[i] != DHCP_LEASE_FSM_INIT);
+    }
+    UT_ASSERT_EQUAL(mismatches, 0);
+    dhcp_lease_engine_set_auto_renew(1);
+
+    UT_LOG_DEBUG("Resetting with DHCP_LEASE_ENGINE_IFACES set");
+    setenv(DHCP_LEASE_ENGINE_IFACES_ENV, "wan1,,lte0", 1);
+    dhcp_lease_engine_reset();
+    UT_ASSERT_EQUAL(dhcp4c_get_if_count(&count), STATUS_SUCCESS);
+    UT_ASSERT_EQUAL(count, DHCP_LEASE_IF_MAX + 2);
+    UT_ASSERT_EQUAL(dhcp4c_get_if_index("lte0", &index), STATUS_SUCCESS);
+    UT_ASSERT_EQUAL(index, DHCP_LEASE_IF_MAX + 1);
+
+    if (pSaved != NULL)
+    {
+        setenv(DHCP_LEASE_ENGINE_IFACES_ENV, pSaved, 1);
+    }
+    else
+    {
+        unsetenv(DHCP_LEASE_ENGINE_IFACES_ENV);
+    }
+    free(pSaved);
+    dhcp_lease_engine_reset();
+    UT_LOG_INFO("Out %s\n", __FUNCTION__);
+}
+
+/* Runs a capture on a thread of its own while the test changes the lease under it */
+static void *capture_thread( void *pArg )
+{
+    static int status;
+
+    status = test_capture_run((const test_capture_config_t *)pArg);
+    return &status;
+}
+
+/**
+* @brief Test case to verify that a captured trace is served back by the getters
+*
+* dhcp4_hal_test --capture records the dhcpv4c_api getters; with DHCP_LEASE_REPLAY naming the trace, the dhcp4cApi getters of the skeleton return the recorded values at the recorded times, scaled by DHCP_LEASE_REPLAY_SPEED.
+*
+* **Test Group ID:** Basic: 01 @n
+* **Test Case ID:** 014 @n
+* **Priority:** High @n@n
+*
+* **Pre-Conditions:** Linux skeleton build @n
+* **Dependencies:** None @n
+* **User Interaction:** If user chose to run the test in interactive mode, then the test case has to be selected via console @n
+*
+* **Test Procedure:** @n
+* | Variation / Step | Description | Test Data | Expected Result | Notes |
+* | :----: | --------- | ---------- |-------------- | ----- |
+* | 01 | Capture 4 polls 50 ms apart, rebinding the eRouter lease after 75 ms | 203.0.113.77 with 2 DNS servers, then 203.0.113.78 with 1 | test_capture_run returns 0 | |
+* | 02 | Restore the engine's default leases, set DHCP_LEASE_REPLAY and DHCP_LEASE_REPLAY_SPEED=10 | | | The engine no longer holds either lease |
+* | 03 | Invoking dhcp4c_get_ert_ifname, ip_addr, mask, lease_time, fsm_state and dns_svrs | valid pointers | STATUS_SUCCESS and the first lease | Start of the trace |
+* | 04 | Wait 300 ms, invoking dhcp4c_get_ert_ip_addr and dhcp4c_get_ert_dns_svrs | valid pointers | STATUS_SUCCESS and the second lease | 3 s into the trace, past its end |
+*/
+void test_l1_skeleton_positive1_lease_replay(void)
+{
+    gTestID = 14;
+    UT_LOG_INFO("In %s [%02d%03d]\n", __FUNCTION__, gTestGroup, gTestID);
+    test_results_set_id(gTestGroup, gTestID);
+
+    const char *pDir = getenv("TMPDIR");
+    test_capture_config_t config;
+    char path[PATH_MAX];
+    char name[64] = "";
+    ipv4AddrList_t ip_list;
+    dhcp_lease_t lease;
+    pthread_t thread;
+    void *pResult = NULL;
+    unsigned int value = 0;
+    int state = 0;
+
+    snprintf(path, sizeof(path), "%s/dhcp4c_replay_%d.bin", (pDir != NULL) ? pDir : "/tmp", (int)getpid());
+    memset(&lease, 0, sizeof(lease));
+    strcpy(lease.ifname, "erouter0");
+    lease.ip_addr = inet_addr("203.0.113.77");
+    lease.mask = inet_addr("255.255.255.0");
+    lease.gw = inet_addr("203.0.113.1");
+    lease.dhcp_svr = inet_addr("203.0.113.5");
+    lease.dns_svrs[0] = inet_addr("203.0.113.53");
+    lease.dns_svrs[1] = inet_addr("203.0.113.54");
+    lease.dns_count = 2;
+    lease.lease_time = 7200;
+    dhcp_lease_engine_reset();
+    UT_ASSERT_EQUAL(dhcp_lease_engine_bind(DHCP_LEASE_IF_ERT, &lease), 0);
+
+    config.enabled = 1;
+    config.pPath = path;
+    config.interval_ms = 50;
+    config.count = 4;
+    if (pthread_create(&thread, NULL, capture_thread, &config) != 0)
+    {
+        UT_FAIL("Cannot start the capture");
+        return;
+    }
+    usleep(75000);
+    lease.ip_addr = inet_addr("203.0.113.78");
+    lease.dns_count = 1;
+    UT_ASSERT_EQUAL(dhcp_lease_engine_bind(DHCP_LEASE_IF_ERT, &lease), 0);
+    pthread_join(thread, &pResult);
+    UT_ASSERT_EQUAL(*(int *)pResult, 0);
+
+    dhcp_lease_engine_reset();
+    setenv(DHCP_LEASE_REPLAY_ENV, path, 1);
+    setenv(DHCP_LEASE_REPLAY_SPEED_ENV, "10", 1);
+    dhcp_lease_replay_reset();
+    UT_LOG_DEBUG("Trace: %s", path);
+
+    UT_ASSERT_EQUAL(dhcp4c_get_ert_ifname(name), STATUS_SUCCESS);
+    UT_ASSERT_EQUAL(strcmp(name, "erouter0"), 0);
+    UT_ASSERT_EQUAL(dhcp4c_get_ert_ip_addr(&value), STATUS_SUCCESS);
+    UT_ASSERT_EQUAL(value, inet_addr("203.0.113.77"));
+    UT_ASSERT_EQUAL(dhcp4c_get_ert_mask(&value), STATUS_SUCCESS);
+    UT_ASSERT_EQUAL(value, inet_addr("255.255.255.0"));
+    UT_ASSERT_EQUAL(dhcp4c_get_ert_lease_time(&value), STATUS_SUCCESS);
+    UT_ASSERT_EQUAL(value, 7200);
+    UT_ASSERT_EQUAL(dhcp4c_get_ert_fsm_state(&state), STATUS_SUCCESS);
+    UT_ASSERT_EQUAL(state, DHCP_LEASE_FSM_BOUND);
+    memset(&ip_list, 0, sizeof(ip_list));
+    UT_ASSERT_EQUAL(dhcp4c_get_ert_dns_svrs(&ip_list), STATUS_SUCCESS);
+    UT_ASSERT_EQUAL(ip_list.number, 2);
+    UT_ASSERT_EQUAL(ip_list.addrList[1], inet_addr("203.0.113.54"));
+
+    usleep(300000);
+    UT_ASSERT_EQUAL(dhcp4c_get_ert_ip_addr(&value), STATUS_SUCCESS);
+    UT_ASSERT_EQUAL(value, inet_addr("203.0.113.78"));
+    memset(&ip_list, 0, sizeof(ip_list));
+    UT_ASSERT_EQUAL(dhcp4c_get_ert_dns_svrs(&ip_list), STATUS_SUCCESS);
+    UT_ASSERT_EQUAL(ip_list.number, 1);
+    UT_ASSERT_EQUAL(ip_list.addrList[0], inet_addr("203.0.113.53"));
+
+    unsetenv(DHCP_LEASE_REPLAY_ENV);
+    unsetenv(DHCP_LEASE_REPLAY_SPEED_ENV);
+    dhcp_lease_replay_reset();
+    unlink(path);
+    UT_LOG_INFO("Out %s\n", __FUNCTION__);
+}
+
+static const char gNotTrace[] = "interface=erouter0\nip=203.0.113.10\n";
+
+/* Writes length bytes to a new file in TMPDIR, returning its name at pPath */
+static int write_fixture( const void *pData, size_t length, char *pPath, size_t size )
+{
+    int fd;
+
+    snprintf(pPath, size, "%s/dhcp4c_fixture_XXXXXX", (getenv("TMPDIR") != NULL) ? getenv("TMPDIR") : "/tmp");
+    fd = mkstemp(pPath);
+    if (fd < 0)
+    {
+        return -1;
+    }
+    if (write(fd, pData, length) != (ssize_t)length)
+    {
+        close(fd);
+        unlink(pPath);
+        return -1;
+    }
+    close(fd);
+    return 0;
+}
+
+/*
+* Writes a trace of two eRouter getters, ip_addr succeeding and gw failing, with a record cut short at the end.
+* A corrupt trace has the gw record name a channel the header does not declare.
+*/
+static int write_replay_fixture( int corrupt, char *pPath, size_t size )
+{
+    static const dhcp_lease_replay_channel_t channels[] =
+    {
+        { DHCP_LEASE_IF_ERT, DHCP_LEASE_FIELD_IP_ADDR },
+        { DHCP_LEASE_IF_ERT, DHCP_LEASE_FIELD_GW },
+    };
+    dhcp_lease_replay_header_t header;
+    uint8_t trace[sizeof(header) + sizeof(channels) + 64];
+    uint32_t address = inet_addr("198.51.100.20");
+    uint32_t used = 0;
+
+    memset(&header, 0, sizeof(header));
+    header.magic = DHCP_LEASE_REPLAY_MAGIC;
+    header.version = DHCP_LEASE_REPLAY_VERSION;
+    header.channelCount = 2;
+    header.intervalUs = 1000000;
+    memcpy(&trace[used], &header, sizeof(header));
+    used += sizeof(header);
+    memcpy(&trace[used], channels, sizeof(channels));
+    used += sizeof(channels);
+    trace[used++] = 0;                                          /* ip_addr at 0 us, 200 ns, status 0, 4 bytes */
+    used += dhcp_lease_replay_put_varint(&trace[used], 0);
+    used += dhcp_lease_replay_put_varint(&trace[used], 200);
+    used += dhcp_lease_replay_put_varint(&trace[used], 0);
+    used += dhcp_lease_replay_put_varint(&trace[used], sizeof(address));
+    memcpy(&trace[used], &address, sizeof(address));
+    used += sizeof(address);
+    trace[used++] = corrupt ? 2 : 1;                            /* gw at 10 us, status -1 (zigzag 1), no output */
+    used += dhcp_lease_replay_put_varint(&trace[used], 10);
+    used += dhcp_lease_replay_put_varint(&trace[used], 200);
+    used += dhcp_lease_replay_put_varint(&trace[used], 1);
+    used += dhcp_lease_replay_put_varint(&trace[used], 0);
+    trace[used++] = 0 | DHCP_LEASE_REPLAY_SAME;                 /* Cut short after its channel */
+    return write_fixture(trace, used, pPath, size);
+}
+
+/**
+* @brief Test case to verify that the replayed getters fail as recorded and on traces that cannot be served
+*
+* **Test Group ID:** Basic: 01 @n
+* **Test Case ID:** 015 @n
+* **Priority:** High @n@n
+*
+* **Pre-Conditions:** Linux skeleton build @n
+* **Dependencies:** None @n
+* **User Interaction:** If user chose to run the test in interactive mode, then the test case has to be selected via console @n
+*
+* **Test Procedure:** @n
+* | Variation / Step | Description | Test Data | Expected Result | Notes |
+* | :----: | --------- | ---------- |-------------- | ----- |
+* | 01 | Point DHCP_LEASE_REPLAY at a missing file, then at a file that is not a trace, invoking dhcp4c_get_ert_ip_addr | valid pointer | STATUS_FAILURE | |
+* | 02 | Point it at a trace whose second record names an undeclared channel, invoking dhcp4c_get_ert_ip_addr | valid pointer | STATUS_FAILURE | The whole trace is refused |
+* | 03 | Write a trace recording ip_addr succeeding and gw failing, ending in a record cut short | | File written | |
+* | 04 | Invoking dhcp4c_get_ert_ip_addr | valid pointer, then NULL | STATUS_SUCCESS and the recorded address, then STATUS_FAILURE | The cut record is ignored |
+* | 05 | Invoking dhcp4c_get_ert_gw and dhcp4c_get_ert_mask | valid pointers | STATUS_FAILURE | Recorded failure, not captured |
+*/
+void test_l1_skeleton_negative1_lease_replay(void)
+{
+    gTestID = 15;
+    UT_LOG_INFO("In %s [%02d%03d]\n", __FUNCTION__, gTestGroup, gTestID);
+    test_results_set_id(gTestGroup, gTestID);
+
+    char path[PATH_MAX];
+    unsigned int value = 0;
+
+    setenv(DHCP_LEASE_REPLAY_ENV, "/nonexistent/dhcp4c_replay.bin", 1);
+    dhcp_lease_replay_reset();
+    UT_ASSERT_EQUAL(dhcp4c_get_ert_ip_addr(&value), STATUS_FAILURE);
+
+    if (write_fixture(gNotTrace, strlen(gNotTrace), path, sizeof(path)) != 0)
+    {
+        UT_FAIL("Cannot write the fixture");
+        return;
+    }
+    setenv(DHCP_LEASE_REPLAY_ENV, path, 1);
+    dhcp_lease_replay_reset();
+    UT_ASSERT_EQUAL(dhcp4c_get_ert_ip_addr(&value), STATUS_FAILURE);
+    unlink(path);
+
+    if (write_replay_fixture(1, path, sizeof(path)) != 0)
+    {
+        UT_FAIL("Cannot write the trace fixture");
+        return;
+    }
+    setenv(DHCP_LEASE_REPLAY_ENV, path, 1);
+    dhcp_lease_replay_reset();
+    UT_ASSERT_EQUAL(dhcp4c_get_ert_ip_addr(&value), STATUS_FAILURE);
+    unlink(path);
+
+    if (write_replay_fixture(0, path, sizeof(path)) != 0)
+    {
+        UT_FAIL("Cannot write the trace fixture");
+        return;
+    }
+    setenv(DHCP_LEASE_REPLAY_ENV, path, 1);
+    dhcp_lease_replay_reset();
+    UT_ASSERT_EQUAL(dhcp4c_get_ert_ip_addr(&value), STATUS_SUCCESS);
+    UT_ASSERT_EQUAL(value, inet_addr("198.51.100.20"));
+    UT_ASSERT_EQUAL(dhcp4c_get_ert_ip_addr(NULL), STATUS_FAILURE);
+    UT_ASSERT_EQUAL(dhcp4c_get_ert_gw(&value), STATUS_FAILURE);
+    UT_ASSERT_EQUAL(dhcp4c_get_ert_mask(&value), STATUS_FAILURE);
+
+    unsetenv(DHCP_LEASE_REPLAY_ENV);
+    dhcp_lease_replay_reset();
+    unlink(path);
+    UT_LOG_INFO("Out %s\n", __FUNCTION__);
+}
+
+/* udhcpc environment dump, as written by its default.script on bound */
+static const char gUdhcpcLease[] =
+    "interface=erouter0\n"
+    "ip=203.0.113.77\n"
+    "siaddr=0.0.0.0\n"
+    "subnet=255.255.255.0\n"
+    "mask=24\n"
+    "broadcast=203.0.113.255\n"
+    "router=203.0.113.1 203.0.113.2\n"
+    "dns='203.0.113.53 203.0.113.54'\n"
+    "domain=example.net\n"
+    "serverid=203.0.113.5\n"
+    "lease=7200\n";
+
+/* udhcpc environment dump with no address in it */
+static const char gNoAddressLease[] = "interface=erouter0\nlease=3600\n";
+
+/* dhclient lease file holding an older and a current lease */
+static const char gDhclientLease[] =
+    "lease {\n"
+    "  interface \"erouter0\";\n"
+    "  fixed-address 198.51.100.19;\n"
+    "  option subnet-mask 255.255.255.0;\n"
+    "  option routers 198.51.100.254;\n"
+    "  option dhcp-lease-time 86400;\n"
+    "  option domain-name-servers 198.51.100.99;\n"
+    "}\n"
+    "lease {\n"
+    "  interface \"erouter0\";\n"
+    "  fixed-address 198.51.100.20;\n"
+    "  option subnet-mask 255.255.255.128;\n"
+    "  option routers 198.51.100.1;\n"
+    "  option dhcp-lease-time 600;\n"
+    "  option dhcp-message-type 5;\n"
+    "  option domain-name-servers 198.51.100.53,198.51.100.54,198.51.100.55;\n"
+    "  option dhcp-server-identifier 198.51.100.2;\n"
+    "  option dhcp-renewal-time 300;\n"
+    "  option dhcp-rebinding-time 525;\n"
+    "  renew 4 2023/06/01 10:00:00;\n"
+    "  rebind 4 2023/06/01 10:08:45;\n"
+    "  expire 4 2023/06/01 10:10:00;\n"
+    "}\n";
+
+/* Dates a fixture as if the client wrote it secondsAgo seconds ago */
+static int age_lease_fixture( const char *pPath, time_t secondsAgo )
+{
+    struct timespec times[2];
+
+    clock_gettime(CLOCK_REALTIME, &times[0]);
+    times[0].tv_sec -= secondsAgo;
+    times[1] = times[0];
+    return utimensat(AT_FDCWD, pPath, times, 0);
+}
+
+/**
+* @brief Test case to verify that the eRouter getters report a udhcpc lease file
+*
+* With DHCP4C_ERT_LEASE_FILE set, the skeleton serves the eRouter lease from that file. This test writes a udhcpc environment dump and checks every field read back through the getters.
+*
+* **Test Group ID:** Basic: 01 @n
+* **Test Case ID:** 016 @n
+* **Priority:** High @n@n
+*
+* **Pre-Conditions:** Linux skeleton build @n
+* **Dependencies:** None @n
+* **User Interaction:** If user chose to run the test in interactive mode, then the test case has to be selected via console @n
+*
+* **Test Procedure:** @n
+* | Variation / Step | Description | Test Data | Expected Result | Notes |
+* | :----: | --------- | ---------- |-------------- | ----- |
+* | 01 | Write a udhcpc lease file and point DHCP4C_ERT_LEASE_FILE at it | interface, ip, subnet, router, dns, serverid, lease | File written | |
+* | 02 | Invoking dhcp4c_get_ert_ifname, ip_addr, mask, gw, dhcp_svr and lease_time | valid pointers | STATUS_SUCCESS and the file's values | First router only |
+* | 03 | Invoking dhcp4c_get_ert_dns_svrs | valid pointer | STATUS_SUCCESS, 2 servers in file order | |
+* | 04 | Invoking dhcp4c_get_ert_fsm_state and dhcp4c_get_ert_remain_lease_time | valid pointers | BOUND, remaining time <= 7200 | Lease just written |
+*/
+void test_l1_skeleton_positive1_ert_lease_file(void)
+{
+    gTestID = 16;
+    UT_LOG_INFO("In %s [%02d%03d]\n", __FUNCTION__, gTestGroup, gTestID);
+    test_results_set_id(gTestGroup, gTestID);
+
+    char path[PATH_MAX];
+    char ip_str[DHCP_IPV4_STRLEN];
+    char name[64] = "";
+    ipv4AddrList_t ip_list;
+    unsigned int value = 0;
+    int state = 0;
+
+    if (write_fixture(gUdhcpcLease, strlen(gUdhcpcLease), path, sizeof(path)) != 0)
+    {
+        UT_FAIL("Cannot write the lease file fixture");
+        return;
+    }
+    setenv(DHCP_LEASE_FILE_ENV, path, 1);
+    UT_LOG_DEBUG("Lease file: %s", path);
+
+    UT_ASSERT_EQUAL(dhcp4c_get_ert_ifname(name), STATUS_SUCCESS);
+    UT_ASSERT_EQUAL(strcmp(name, "erouter0"), 0);
+    UT_ASSERT_EQUAL(dhcp4c_get_ert_ip_addr(&value), STATUS_SUCCESS);
+    UT_LOG_DEBUG("ip_addr: %s", dhcp_ipv4_format(value, ip_str));
+    UT_ASSERT_EQUAL(value, inet_addr("203.0.113.77"));
+    UT_ASSERT_EQUAL(dhcp4c_get_ert_mask(&value), STATUS_SUCCESS);
+    UT_ASSERT_EQUAL(value, inet_addr("255.255.255.0"));
+    UT_ASSERT_EQUAL(dhcp4c_get_ert_gw(&value), STATUS_SUCCESS);
+    UT_ASSERT_EQUAL(value, inet_addr("203.0.113.1"));
+    UT_ASSERT_EQUAL(dhcp4c_get_ert_dhcp_svr(&value), STATUS_SUCCESS);
+    UT_ASSERT_EQUAL(value, inet_addr("203.0.113.5"));
+    UT_ASSERT_EQUAL(dhcp4c_get_ert_lease_time(&value), STATUS_SUCCESS);
+    UT_ASSERT_EQUAL(value, 7200);
+
+    memset(&ip_list, 0, sizeof(ip_list));
+    UT_ASSERT_EQUAL(dhcp4c_get_ert_dns_svrs(&ip_list), STATUS_SUCCESS);
+    UT_ASSERT_EQUAL(ip_list.number, 2);
+    UT_ASSERT_EQUAL(ip_list.addrList[0], inet_addr("203.0.113.53"));
+    UT_ASSERT_EQUAL(ip_list.addrList[1], inet_addr("203.0.113.54"));
+
+    UT_ASSERT_EQUAL(dhcp4c_get_ert_fsm_state(&state), STATUS_SUCCESS);
+    UT_ASSERT_EQUAL(state, DHCP_LEASE_FSM_BOUND);
+    UT_ASSERT_EQUAL(dhcp4c_get_ert_remain_lease_time(&value), STATUS_SUCCESS);
+    UT_LOG_DEBUG("remain_lease_time: %u", value);
+    UT_ASSERT_TRUE(value <= 7200 && value >= 7190);
+
+    unsetenv(DHCP_LEASE_FILE_ENV);
+    unlink(path);
+    UT_LOG_INFO("Out %s\n", __FUNCTION__);
+}
+
+/**
+* @brief Test case to verify that the eRouter getters report the current lease of a dhclient lease file
+*
+* dhclient appends a lease block on every ACK, so only the last block describes the current lease.
+*
+* **Test Group ID:** Basic: 01 @n
+* **Test Case ID:** 017 @n
+* **Priority:** High @n@n
+*
+* **Pre-Conditions:** Linux skeleton build @n
+* **Dependencies:** None @n
+* **User Interaction:** If user chose to run the test in interactive mode, then the test case has to be selected via console @n
+*
+* **Test Procedure:** @n
+* | Variation / Step | Description | Test Data | Expected Result | Notes |
+* | :----: | --------- | ---------- |-------------- | ----- |
+* | 01 | Write a dhclient lease file with two lease blocks | older and current lease | File written | |
+* | 02 | Invoking dhcp4c_get_ert_ip_addr, mask, gw and dhcp_svr | valid pointers | STATUS_SUCCESS and the current block's values | |
+* | 03 | Invoking dhcp4c_get_ert_dns_svrs | valid pointer | STATUS_SUCCESS, 3 servers | Comma separated |
+* | 04 | Invoking dhcp4c_get_ert_remain_renew_time and remain_rebind_time | valid pointers | At most the file's T1 (300) and T2 (525) | |
+*/
+void test_l1_skeleton_positive2_ert_lease_file(void)
+{
+    gTestID = 17;
+    UT_LOG_INFO("In %s [%02d%03d]\n", __FUNCTION__, gTestGroup, gTestID);
+    test_results_set_id(gTestGroup, gTestID);
+
+    char path[PATH_MAX];
+    ipv4AddrList_t ip_list;
+    unsigned int value = 0;
+
+    if (write_fixture(gDhclientLease, strlen(gDhclientLease), path, sizeof(path)) != 0)
+    {
+        UT_FAIL("Cannot write the lease file fixture");
+        return;
+    }
+    setenv(DHCP_LEASE_FILE_ENV, path, 1);
+    UT_LOG_DEBUG("Lease file: %s", path);
+
+    UT_ASSERT_EQUAL(dhcp4c_get_ert_ip_addr(&value), STATUS_SUCCESS);
+    UT_ASSERT_EQUAL(value, inet_addr("198.51.100.20"));
+    UT_ASSERT_EQUAL(dhcp4c_get_ert_mask(&value), STATUS_SUCCESS);
+    UT_ASSERT_EQUAL(value, inet_addr("255.255.255.128"));
+    UT_ASSERT_EQUAL(dhcp4c_get_ert_gw(&value), STATUS_SUCCESS);
+    UT_ASSERT_EQUAL(value, inet_addr("198.51.100.1"));
+    UT_ASSERT_EQUAL(dhcp4c_get_ert_dhcp_svr(&value), STATUS_SUCCESS);
+    UT_ASSERT_EQUAL(value, inet_addr("198.51.100.2"));
+
+    memset(&ip_list, 0, sizeof(ip_list));
+    UT_ASSERT_EQUAL(dhcp4c_get_ert_dns_svrs(&ip_list), STATUS_SUCCESS);
+    UT_ASSERT_EQUAL(ip_list.number, 3);
+    UT_ASSERT_EQUAL(ip_list.addrList[2], inet_addr("198.51.100.55"));
+
+    UT_ASSERT_EQUAL(dhcp4c_get_ert_remain_renew_time(&value), STATUS_SUCCESS);
+    UT_ASSERT_TRUE(value <= 300);
+    UT_ASSERT_EQUAL(dhcp4c_get_ert_remain_rebind_time(&value), STATUS_SUCCESS);
+    UT_ASSERT_TRUE(value <= 525 && value > 300);
+
+    unsetenv(DHCP_LEASE_FILE_ENV);
+    unlink(path);
+    UT_LOG_INFO("Out %s\n", __FUNCTION__);
+}
+
+/**
+* @brief Test case to verify that a lease file is parsed once and again only after it changes
+*
+* Repeated getter calls must be served from the cached parse; replacing the file, as clients do with rename(), must be picked up on the next call.
+*
+* **Test Group ID:** Basic: 01 @n
+* **Test Case ID:** 018 @n
+* **Priority:** High @n@n
+*
+* **Pre-Conditions:** Linux skeleton build @n
+* **Dependencies:** None @n
+* **User Interaction:** If user chose to run the test in interactive mode, then the test case has to be selected via console @n
+*
+* **Test Procedure:** @n
+* | Variation / Step | Description | Test Data | Expected Result | Notes |
+* | :----: | --------- | ---------- |-------------- | ----- |
+* | 01 | Invoking dhcp4c_get_ert_ip_addr 100 times on an unchanged udhcpc lease file | valid pointer | One parse in total | |
+* | 02 | Rename a dhclient lease file over it | new file, new inode | File replaced | |
+* | 03 | Invoking dhcp4c_get_ert_ip_addr 100 times | valid pointer | The new address, one further parse | |
+*/
+void test_l1_skeleton_positive3_ert_lease_file(void)
+{
+    gTestID = 18;
+    UT_LOG_INFO("In %s [%02d%03d]\n", __FUNCTION__, gTestGroup, gTestID);
+    test_results_set_id(gTestGroup, gTestID);
+
+    char path[PATH_MAX];
+    char update[PATH_MAX];
+    unsigned int value = 0;
+    uint32_t parses;
+    int i;
+
+    if (write_fixture(gUdhcpcLease, strlen(gUdhcpcLease), path, sizeof(path)) != 0 ||
+        write_fixture(gDhclientLease, strlen(gDhclientLease), update, sizeof(update)) != 0)
+    {
+        UT_FAIL("Cannot write the lease file fixtures");
+        return;
+    }
+    setenv(DHCP_LEASE_FILE_ENV, path, 1);
+
+    parses = dhcp_lease_file_parse_count();
+    for (i = 0; i < 100; i++)
+    {
+        UT_ASSERT_EQUAL(dhcp4c_get_ert_ip_addr(&value), STATUS_SUCCESS);
+    }
+    UT_ASSERT_EQUAL(value, inet_addr("203.0.113.77"));
+    UT_LOG_DEBUG("Parses for 100 reads: %u", dhcp_lease_file_parse_count() - parses);
+    UT_ASSERT_EQUAL(dhcp_lease_file_parse_count() - parses, 1);
+
+    UT_ASSERT_EQUAL(rename(update, path), 0);
+    parses = dhcp_lease_file_parse_count();
+    for (i = 0; i < 100; i++)
+    {
+        UT_ASSERT_EQUAL(dhcp4c_get_ert_ip_addr(&value), STATUS_SUCCESS);
+    }
+    UT_ASSERT_EQUAL(value, inet_addr("198.51.100.20"));
+    UT_LOG_DEBUG("Parses for 100 reads after rename: %u", dhcp_lease_file_parse_count() - parses);
+    UT_ASSERT_EQUAL(dhcp_lease_file_parse_count() - parses, 1);
+
+    unsetenv(DHCP_LEASE_FILE_ENV);
+    unlink(path);
+    UT_LOG_INFO("Out %s\n", __FUNCTION__);
+}
+
+/**
+* @brief Test case to verify that the eRouter lease timers count from the lease file's mtime
+*
+* The lease is taken to start when the client last wrote the file, so an old file walks the client through RENEWING and expiry.
+*
+* **Test Group ID:** Basic: 01 @n
+* **Test Case ID:** 019 @n
+* **Priority:** High @n@n
+*
+* **Pre-Conditions:** Linux skeleton build @n
+* **Dependencies:** None @n
+* **User Interaction:** If user chose to run the test in interactive mode, then the test case has to be selected via console @n
+*
+* **Test Procedure:** @n
+* | Variation / Step | Description | Test Data | Expected Result | Notes |
+* | :----: | --------- | ---------- |-------------- | ----- |
+* | 01 | Date a udhcpc lease file (lease 7200) 4000 seconds back | utimensat | mtime changed | T1 3600, T2 6300 |
+* | 02 | Invoking dhcp4c_get_ert_remain_renew_time, remain_rebind_time, remain_lease_time and fsm_state | valid pointers | 0, about 2300, about 3200, RENEWING | |
+* | 03 | Date the file 8000 seconds back | utimensat | mtime changed | Past expiry |
+* | 04 | Invoking dhcp4c_get_ert_remain_lease_time and fsm_state | valid pointers | 0, INIT | |
+*/
+void test_l1_skeleton_positive4_ert_lease_file(void)
+{
+    gTestID = 19;
+    UT_LOG_INFO("In %s [%02d%03d]\n", __FUNCTION__, gTestGroup, gTestID);
+    test_results_set_id(gTestGroup, gTestID);
+
+    char path[PATH_MAX];
+    unsigned int value = 0;
+    int state = 0;
+
+    if (write_fixture(gUdhcpcLease, strlen(gUdhcpcLease), path, sizeof(path)) != 0 || age_lease_fixture(path, 4000) != 0)
+    {
+        UT_FAIL("Cannot write the lease file fixture");
+        return;
+    }
+    setenv(DHCP_LEASE_FILE_ENV, path, 1);
+
+    UT_ASSERT_EQUAL(dhcp4c_get_ert_remain_renew_time(&value), STATUS_SUCCESS);
+    UT_ASSERT_EQUAL(value, 0);
+    UT_ASSERT_EQUAL(dhcp4c_get_ert_remain_rebind_time(&value), STATUS_SUCCESS);
+    UT_LOG_DEBUG("remain_rebind_time: %u", value);
+    UT_ASSERT_TRUE(value <= 2300 && value >= 2290);
+    UT_ASSERT_EQUAL(dhcp4c_get_ert_remain_lease_time(&value), STATUS_SUCCESS);
+    UT_LOG_DEBUG("remain_lease_time: %u", value);
+    UT_ASSERT_TRUE(value <= 3200 && value >= 3190);
+    UT_ASSERT_EQUAL(dhcp4c_get_ert_fsm_state(&state), STATUS_SUCCESS);
+    UT_ASSERT_EQUAL(state, DHCP_LEASE_FSM_RENEWING);
+
+    UT_ASSERT_EQUAL(age_lease_fixture(path, 8000), 0);
+    UT_ASSERT_EQUAL(dhcp4c_get_ert_remain_lease_time(&value), STATUS_SUCCESS);
+    UT_ASSERT_EQUAL(value, 0);
+    UT_ASSERT_EQUAL(dhcp4c_get_ert_fsm_state(&state), STATUS_SUCCESS);
+    UT_ASSERT_EQUAL(state, DHCP_LEASE_FSM_INIT);
+
+    unsetenv(DHCP_LEASE_FILE_ENV);
+    unlink(path);
+    UT_LOG_INFO("Out %s\n", __FUNCTION__);
+}
+
+/**
+* @brief Test case to verify that the eRouter getters fail when the lease file is missing or holds no lease
+*
+* **Test Group ID:** Basic: 01 @n
+* **Test Case ID:** 020 @n
+* **Priority:** High @n@n
+*
+* **Pre-Conditions:** Linux skeleton build @n
+* **Dependencies:** None @n
+* **User Interaction:** If user chose to run the test in interactive mode, then the test case has to be selected via console @n
+*
+* **Test Procedure:** @n
+* | Variation / Step | Description | Test Data | Expected Result | Notes |
+* | :----: | --------- | ---------- |-------------- | ----- |
+* | 01 | Point DHCP4C_ERT_LEASE_FILE at a file that does not exist and invoke dhcp4c_get_ert_ip_addr | valid pointer | STATUS_FAILURE | |
+* | 02 | Point it at a file without an address and invoke dhcp4c_get_ert_ip_addr | valid pointer | STATUS_FAILURE | |
+* | 03 | Point it at an empty file and invoke dhcp4c_get_ert_lease_time | valid pointer | STATUS_FAILURE | |
+*/
+void test_l1_skeleton_negative1_ert_lease_file(void)
+{
+    gTestID = 20;
+    UT_LOG_INFO("In %s [%02d%03d]\n", __FUNCTION__, gTestGroup, gTestID);
+    test_results_set_id(gTestGroup, gTestID);
+
+    char path[PATH_MAX];
+    unsigned int value = 0;
+
+    if (write_fixture(gNoAddressLease, strlen(gNoAddressLease), path, sizeof(path)) != 0)
+    {
+        UT_FAIL("Cannot write the lease file fixture");
+        return;
+    }
+
+    setenv(DHCP_LEASE_FILE_ENV, "/nonexistent/dhcp4c.lease", 1);
+    UT_ASSERT_EQUAL(dhcp4c_get_ert_ip_addr(&value), STATUS_FAILURE);
+
+    setenv(DHCP_LEASE_FILE_ENV, path, 1);
+    UT_ASSERT_EQUAL(dhcp4c_get_ert_ip_addr(&value), STATUS_FAILURE);
+
+    UT_ASSERT_EQUAL(truncate(path, 0), 0);
+    UT_ASSERT_EQUAL(dhcp4c_get_ert_lease_time(&value), STATUS_FAILURE);
+
+    unsetenv(DHCP_LEASE_FILE_ENV);
+    unlink(path);
+    UT_LOG_INFO("Out %s\n", __FUNCTION__);
+}
+
+#define LOG_ORDER_THREADS  4
+#define LOG_ORDER_TURNS    64      /* Lines each thread logs in turn with the others */
+#define LOG_ORDER_LINES    1000    /* Lines each thread then logs freely, several rings' worth */
+
+typedef struct
+{
+    uint32_t  index;
+    uint32_t *pTurn;      /* Shared; the thread whose turn it is logs the next line */
+    uint32_t  logged;     /* Free lines queued so far */
+} log_order_worker_t;
+
+static void *log_order_thread( void *pArg )
+{
+    log_order_worker_t *pWorker = (log_order_worker_t *)pArg;
+    uint32_t current;
+    uint32_t turn;
+    uint32_t i;
+
+    for (turn = pWorker->index; turn < LOG_ORDER_THREADS * LOG_ORDER_TURNS; turn += LOG_ORDER_THREADS)
+    {
+        while ((current = __atomic_load_n(pWorker->pTurn, __ATOMIC_ACQUIRE)) != turn)
+        {
+            /* The test gave up on the turns, as a thread could not be started */
+            if (current >= LOG_ORDER_THREADS * LOG_ORDER_TURNS)
+            {
+                return NULL;
+            }
+            sched_yield();
+        }
+        UT_LOG_INFO("log_order turn %u\n", turn);
+        __atomic_store_n(pWorker->pTurn, turn + 1, __ATOMIC_RELEASE);
+    }
+    for (i = 0; i < LOG_ORDER_LINES; i++)
+    {
+        UT_LOG_INFO("log_order free %u %u\n", pWorker->index, i);
+        __atomic_store_n(&pWorker->logged, i + 1, __ATOMIC_RELEASE);
+    }
+    return NULL;
+}
+
+/*
+* Reads the lines the test logged from the captured output. pTurns receives how many turn lines came out
+* in order from 0, and pFree, per thread, how many free lines came out in order from 0; either stops at
+* the first line out of order. Returns the number of lines out of order.
+*/
+static uint32_t read_log_order( const char *pPath, uint32_t *pTurns, uint32_t *pFree )
+{
+    char text[TEST_LOG_LINE_MAX + 256];
+    uint32_t misplaced = 0;
+    unsigned int index;
+    unsigned int value;
+    const char *pLine;
+    FILE *pFile;
+
+    *pTurns = 0;
+    memset(pFree, 0, sizeof(uint32_t) * LOG_ORDER_THREADS);
+    pFile = fopen(pPath, "r");
+    if (pFile == NULL)
+    {
+        return 1;
+    }
+    while (fgets(text, sizeof(text), pFile) != NULL)
+    {
+        if ((pLine = strstr(text, "log_order turn ")) != NULL && sscanf(pLine, "log_order turn %u", &value) == 1)
+        {
+            if (value != *pTurns)
+            {
+                misplaced++;
+                continue;
+            }
+            (*pTurns)++;
+        }
+        else if ((pLine = strstr(text, "log_order free ")) != NULL &&
+                 sscanf(pLine, "log_order free %u %u", &index, &value) == 2 && index < LOG_ORDER_THREADS)
+        {
+            if (value != pFree[index])
+            {
+                misplaced++;
+                continue;
+            }
+            pFree[index]++;
+        }
+    }
+    fclose(pFile);
+    return misplaced;
+}
+
+/**
+* @brief Test case to verify that asynchronous log lines from several threads come out in order once flushed
+*
+* With "--log async" every thread queues its UT_LOG_DEBUG and UT_LOG_INFO lines in a ring of its own, and a background thread writes them out in the order they were queued. This test logs from four threads, first taking turns and then all at once, captures the output, and checks its order after each flush.
+*
+* **Test Group ID:** Basic: 01 @n
+* **Test Case ID:** 021 @n
+* **Priority:** High @n@n
+*
+* **Pre-Conditions:** Linux skeleton build @n
+* **Dependencies:** None @n
+* **User Interaction:** If user chose to run the test in interactive mode, then the test case has to be selected via console @n
+*
+* **Test Procedure:** @n
+* | Variation / Step | Description | Test Data | Expected Result | Notes |
+* | :----: | --------- | ---------- |-------------- | ----- |
+* | 01 | Switch to async logging and send the output to a file | test_log_set_mode(TEST_LOG_ASYNC) | 0 | |
+* | 02 | Start four threads that log 64 lines each in turn, then 1000 each freely | one turn counter | threads started | 1000 lines are several rings |
+* | 03 | While they log freely, note how many lines each has queued and invoke test_log_flush | | At least those lines are out, each thread's in order | |
+* | 04 | Join the threads and invoke test_log_flush | | 256 turn lines in turn order, 1000 lines of each thread in order, none misplaced | |
+* | 05 | Read the counters | test_log_stats | written equals queued | |
+*/
+void test_l1_skeleton_positive1_log_order(void)
+{
+    gTestID = 21;
+    UT_LOG_INFO("In %s [%02d%03d]\n", __FUNCTION__, gTestGroup, gTestID);
+    test_results_set_id(gTestGroup, gTestID);
+
+    log_order_worker_t workers[LOG_ORDER_THREADS];
+    pthread_t threads[LOG_ORDER_THREADS];
+    uint32_t queued[LOG_ORDER_THREADS];
+    uint32_t written[LOG_ORDER_THREADS];
+    test_log_mode_t mode = test_log_get_mode();
+    test_log_stats_t stats;
+    char path[PATH_MAX];
+    uint32_t misplaced;
+    uint32_t turn = 0;
+    uint32_t turns;
+    uint32_t started;
+    uint32_t i;
+    int capture;
+    int console;
+
+    if (write_fixture("", 0, path, sizeof(path)) != 0)
+    {
+        UT_FAIL("Cannot create the log capture file");
+        return;
+    }
+    UT_ASSERT_EQUAL_FATAL(test_log_set_mode(TEST_LOG_ASYNC), 0);
+
+    /* Lines of the harness and of earlier tests go to the console, not the capture */
+    test_log_flush();
+    fflush(stdout);
+    capture = open(path, O_WRONLY);
+    console = dup(STDOUT_FILENO);
+    if (capture < 0 || console < 0 || dup2(capture, STDOUT_FILENO) < 0)
+    {
+        UT_FAIL("Cannot send the output to the capture file");
+        if (capture >= 0)
+        {
+            close(capture);
+        }
+        if (console >= 0)
+        {
+            close(console);
+        }
+        test_log_set_mode(mode);
+        unlink(path);
+        return;
+    }
+    close(capture);
+
+    for (started = 0; started < LOG_ORDER_THREADS; started++)
+    {
+        workers[started].index = started;
+        workers[started].pTurn = &turn;
+        workers[started].logged = 0;
+        if (pthread_create(&threads[started], NULL, log_order_thread, &workers[started]) != 0)
+        {
+            break;
+        }
+    }
+
+    /* Flush once the turns are over, while the threads are logging freely */
+    if (started == LOG_ORDER_THREADS)
+    {
+        while (__atomic_load_n(&turn, __ATOMIC_ACQUIRE) != LOG_ORDER_THREADS * LOG_ORDER_TURNS)
+        {
+            sched_yield();
+        }
+    }
+    else
+    {
+        __atomic_store_n(&turn, LOG_ORDER_THREADS * LOG_ORDER_TURNS, __ATOMIC_RELEASE);
+    }
+    for (i = 0; i < started; i++)
+    {
+        queued[i] = __atomic_load_n(&workers[i].logged, __ATOMIC_ACQUIRE);
+    }
+    test_log_flush();
+    fflush(stdout);
+    misplaced = read_log_order(path, &turns, written);
+
+    for (i = 0; i < started; i++)
+    {
+        pthread_join(threads[i], NULL);
+    }
+    test_log_flush();
+    fflush(stdout);
+    test_log_stats(&stats);
+
+    /* The console back before asserting, so that a failure is reported there */
+    dup2(console, STDOUT_FILENO);
+    close(console);
+    clearerr(stdout);
+
+    UT_ASSERT_EQUAL_FATAL(started, LOG_ORDER_THREADS);
+    UT_ASSERT_EQUAL(misplaced, 0);
+    for (i = 0; i < LOG_ORDER_THREADS; i++)
+    {
+        UT_LOG_DEBUG("Thread %u: %u lines queued before the flush, %u out after it", i, queued[i], written[i]);
+        UT_ASSERT_TRUE(written[i] >= queued[i]);
+    }
+
+    misplaced = read_log_order(path, &turns, written);
+    UT_ASSERT_EQUAL(misplaced, 0);
+    UT_ASSERT_EQUAL(turns, LOG_ORDER_THREADS * LOG_ORDER_TURNS);
+    for (i = 0; i < LOG_ORDER_THREADS; i++)
+    {
+        UT_ASSERT_EQUAL(written[i], LOG_ORDER_LINES);
+    }
+    UT_ASSERT_EQUAL(stats.written, stats.queued);
+
+    test_log_set_mode(mode);
+    unlink(path);
+    UT_LOG_INFO("Out %s\n", __FUNCTION__);
+}
+
+static UT_test_suite_t * pSuite = NULL;
+
+/**
+* @brief Register the skeleton tests
+*
+* @return int - 0 on success, otherwise failure
+*/
+int test_skeleton_l1_register(void)
+{
+    // Create the test suite
+    pSuite = UT_add_suite("[L1 skeleton]", NULL, NULL);
+    if (pSuite == NULL)
+    {
+        return -1;
+    }
+    UT_add_test( pSuite, "l1_skeleton_positive1_timer_wheel", test_l1_skeleton_positive1_timer_wheel);
+    UT_add_test( pSuite, "l1_skeleton_positive1_ert_lease_timers", test_l1_skeleton_positive1_ert_lease_timers);
+    UT_add_test( pSuite, "l1_skeleton_positive2_ert_lease_timers", test_l1_skeleton_positive2_ert_lease_timers);
+    UT_add_test( pSuite, "l1_skeleton_positive1_dhcp_packet", test_l1_skeleton_positive1_dhcp_packet);
+    UT_add_test( pSuite, "l1_skeleton_negative1_dhcp_packet", test_l1_skeleton_negative1_dhcp_packet);
+    UT_add_test( pSuite, "l1_skeleton_positive1_dhcp_packet_scan", test_l1_skeleton_positive1_dhcp_packet_scan);
+    UT_add_test( pSuite, "l1_skeleton_negative1_dhcp_packet_scan", test_l1_skeleton_negative1_dhcp_packet_scan);
+    UT_add_test( pSuite, "l1_skeleton_positive1_lease_page", test_l1_skeleton_positive1_lease_page);
+    UT_add_test( pSuite, "l1_skeleton_positive2_lease_page_torn_read", test_l1_skeleton_positive2_lease_page_torn_read);
+    UT_add_test( pSuite, "l1_skeleton_positive3_lease_page_concurrent", test_l1_skeleton_positive3_lease_page_concurrent);
+    UT_add_test( pSuite, "l1_skeleton_negative1_lease_page", test_l1_skeleton_negative1_lease_page);
+    UT_add_test( pSuite, "l1_skeleton_positive1_emta_snapshot", test_l1_skeleton_positive1_emta_snapshot);
+    UT_add_test( pSuite, "l1_skeleton_positive1_lease_table", test_l1_skeleton_positive1_lease_table);
+    UT_add_test( pSuite, "l1_skeleton_positive1_lease_replay", test_l1_skeleton_positive1_lease_replay);
+    UT_add_test( pSuite, "l1_skeleton_negative1_lease_replay", test_l1_skeleton_negative1_lease_replay);
+    UT_add_test( pSuite, "l1_skeleton_positive1_ert_lease_file", test_l1_skeleton_positive1_ert_lease_file);
+    UT_add_test( pSuite, "l1_skeleton_positive2_ert_lease_file", test_l1_skeleton_positive2_ert_lease_file);
+    UT_add_test( pSuite, "l1_skeleton_positive3_ert_lease_file", test_l1_skeleton_positive3_ert_lease_file);
+    UT_add_test( pSuite, "l1_skeleton_positive4_ert_lease_file", test_l1_skeleton_positive4_ert_lease_file);
+    UT_add_test( pSuite, "l1_skeleton_negative1_ert_lease_file", test_l1_skeleton_negative1_ert_lease_file);
+    UT_add_test( pSuite, "l1_skeleton_positive1_log_order", test_l1_skeleton_positive1_log_order);
+    return 0;
+}
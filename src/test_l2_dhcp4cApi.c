@@ -0,0 +1,245 @@
+/*
+* If not stated otherwise in this file or this component's LICENSE file the
+* following copyright and licenses apply:*
+* Copyright 2023 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+/**
+* @file test_l2_dhcp4cApi.c
+* @page dhcp4cApi Level 2 Tests
+*
+* ## Module's Role
+* This module includes Level 2 functional tests: the eRouter getters are checked
+* end to end against a lease handed out by a DHCPv4 server stand-in.
+*
+* **Pre-Conditions:** Root privileges, the dhcp_standin tool (see test_l2_standin.h)@n
+* **Dependencies:** None@n
+*
+* Ref to API Definition specification documentation : [DHCPv4ChalSpec.md](../../../docs/DHCPv4ChalSpec.md)
+*/
+#include <stdlib.h>
+#include <string.h>
+#include <arpa/inet.h>
+#include <ut.h>
+#include <ut_log.h>
+#include "test_log.h"
+#include "dhcp4cApi.h"
+#include "test_ipv4.h"
+#include "test_l2_standin.h"
+#include "test_results.h"
+
+static int gTestGroup = 2;
+static int gTestID = 1;
+
+#ifndef STATUS_SUCCESS
+#define STATUS_SUCCESS   0
+#endif
+
+#define L2_DEFAULT_ITERATIONS       5
+#define L2_DEFAULT_LATENCY_BOUND_MS 1000
+
+static int get_ert_ip( uint32_t *pAddr )
+{
+    unsigned int value = 0;
+    int status = dhcp4c_get_ert_ip_addr(&value);
+
+    *pAddr = value;
+    return (status == STATUS_SUCCESS) ? 0 : -1;
+}
+
+static int compare_u64( const void *pA, const void *pB )
+{
+    uint64_t a = *(const uint64_t *)pA;
+    uint64_t b = *(const uint64_t *)pB;
+
+    return (a > b) - (a < b);
+}
+
+/**
+* @brief Test case to verify that the eRouter getters report the lease the server handed out
+*
+* A client acquires a lease from the stand-in server, then every eRouter getter is compared with the server's offer.
+*
+* **Test Group ID:** Module: 02
+* **Test Case ID:** 001
+* **Priority:** High
+*
+* **Pre-Conditions:** Root privileges, dhcp_standin available
+* **Dependencies:** None
+* **User Interaction:** If user chose to run the test in interactive mode, then the test case has to be selected via console
+*
+* **Test Procedure:**
+* | Variation / Step | Description | Test Data | Expected Result | Notes |
+* | :----: | --------- | ---------- |-------------- | ----- |
+* | 01 | Acquire a lease and wait for dhcp4c_get_ert_ip_addr to report it | stand-in offer | An address the server acknowledged, within the pool | |
+* | 02 | Invoking dhcp4c_get_ert_mask, gw, dhcp_svr and lease_time | valid pointers | STATUS_SUCCESS and the offered values | options 1, 3, 54, 51 |
+* | 03 | Invoking dhcp4c_get_ert_dns_svrs | valid pointer | STATUS_SUCCESS, the offered servers in order | option 6 |
+* | 04 | Invoking dhcp4c_get_ert_remain_lease_time, remain_renew_time and remain_rebind_time | valid pointers | Within 10 s below lease time, T1 and T2 | options 58, 59 |
+*/
+void test_l2_dhcp4cApi_hal_ert_lease_matches_offer(void)
+{
+    gTestID = 1;
+    UT_LOG_INFO("In %s [%02d%03d]\n", __FUNCTION__, gTestGroup, gTestID);
+    test_results_set_id(gTestGroup, gTestID);
+
+    const l2_standin_offer_t *pOffer = l2_standin_offer();
+    char ip_str[DHCP_IPV4_STRLEN];
+    ipv4AddrList_t ip_list;
+    unsigned int value = 0;
+    uint64_t latencyNs = 0;
+    uint32_t addr = 0;
+    int i;
+
+    if (!l2_standin_ready())
+    {
+        UT_LOG_INFO("Skipped, the DHCP server stand-in is not available\n");
+        return;
+    }
+    if (l2_standin_acquire(get_ert_ip, &addr, &latencyNs) != 0)
+    {
+        UT_FAIL("No lease was acquired from the stand-in server");
+        return;
+    }
+    UT_LOG_DEBUG("ip_addr: %s", dhcp_ipv4_format(addr, ip_str));
+    test_results_add_value("ip_addr", "%s", ip_str);
+    UT_ASSERT_TRUE(ntohl(addr) - ntohl(pOffer->pool_first) < pOffer->pool_size);
+
+    UT_ASSERT_EQUAL(dhcp4c_get_ert_mask(&value), STATUS_SUCCESS);
+    UT_ASSERT_EQUAL(value, pOffer->mask);
+    UT_ASSERT_EQUAL(dhcp4c_get_ert_gw(&value), STATUS_SUCCESS);
+    UT_ASSERT_EQUAL(value, pOffer->router);
+    UT_ASSERT_EQUAL(dhcp4c_get_ert_dhcp_svr(&value), STATUS_SUCCESS);
+    UT_ASSERT_EQUAL(value, pOffer->server_ip);
+    UT_ASSERT_EQUAL(dhcp4c_get_ert_lease_time(&value), STATUS_SUCCESS);
+    UT_ASSERT_EQUAL(value, pOffer->lease_time);
+
+    memset(&ip_list, 0, sizeof(ip_list));
+    UT_ASSERT_EQUAL(dhcp4c_get_ert_dns_svrs(&ip_list), STATUS_SUCCESS);
+    UT_ASSERT_EQUAL(ip_list.number, pOffer->dns_count);
+    for (i = 0; i < pOffer->dns_count && i < ip_list.number; i++)
+    {
+        UT_LOG_DEBUG("dns[%d]: %s", i, dhcp_ipv4_format(ip_list.addrList[i], ip_str));
+        UT_ASSERT_EQUAL(ip_list.addrList[i], pOffer->dns[i]);
+    }
+
+    UT_ASSERT_EQUAL(dhcp4c_get_ert_remain_lease_time(&value), STATUS_SUCCESS);
+    UT_LOG_DEBUG("remain_lease_time: %u", value);
+    UT_ASSERT_TRUE(value <= pOffer->lease_time && value + 10 >= pOffer->lease_time);
+    UT_ASSERT_EQUAL(dhcp4c_get_ert_remain_renew_time(&value), STATUS_SUCCESS);
+    UT_LOG_DEBUG("remain_renew_time: %u", value);
+    UT_ASSERT_TRUE(value <= pOffer->renewal_time && value + 10 >= pOffer->renewal_time);
+    UT_ASSERT_EQUAL(dhcp4c_get_ert_remain_rebind_time(&value), STATUS_SUCCESS);
+    UT_LOG_DEBUG("remain_rebind_time: %u", value);
+    UT_ASSERT_TRUE(value <= pOffer->rebinding_time && value + 10 >= pOffer->rebinding_time);
+
+    UT_LOG_INFO("Out %s\n", __FUNCTION__);
+}
+
+/**
+* @brief Test case to measure how long the eRouter getters take to reflect a new lease
+*
+* Acquires DHCP_L2_ITERATIONS leases in turn, each for a different address of the pool, and measures the time from the server sending the ACK to dhcp4c_get_ert_ip_addr first reporting the new address.
+*
+* **Test Group ID:** Module: 02
+* **Test Case ID:** 002
+* **Priority:** Medium
+*
+* **Pre-Conditions:** Root privileges, dhcp_standin available
+* **Dependencies:** None
+* **User Interaction:** If user chose to run the test in interactive mode, then the test case has to be selected via console
+*
+* **Test Procedure:**
+* | Variation / Step | Description | Test Data | Expected Result | Notes |
+* | :----: | --------- | ---------- |-------------- | ----- |
+* | 01 | Acquire a lease and poll dhcp4c_get_ert_ip_addr until it changes | stand-in offer | A new address the server acknowledged | Repeated DHCP_L2_ITERATIONS times |
+* | 02 | Log min, median and max ACK-to-getter latency | | Max below DHCP_L2_LATENCY_BOUND_MS | Default 1000 ms |
+*/
+void test_l2_dhcp4cApi_hal_ert_ack_to_getter_latency(void)
+{
+    gTestID = 2;
+    UT_LOG_INFO("In %s [%02d%03d]\n", __FUNCTION__, gTestGroup, gTestID);
+    test_results_set_id(gTestGroup, gTestID);
+
+    const char *pIterations = getenv("DHCP_L2_ITERATIONS");
+    const char *pBound = getenv("DHCP_L2_LATENCY_BOUND_MS");
+    int iterations = (pIterations != NULL && atoi(pIterations) > 0) ? atoi(pIterations) : L2_DEFAULT_ITERATIONS;
+    uint64_t bound_ns = (uint64_t)((pBound != NULL && atoi(pBound) > 0) ? atoi(pBound) : L2_DEFAULT_LATENCY_BOUND_MS) * 1000000ULL;
+    uint64_t *pLatencies;
+    uint32_t previous = 0;
+    uint32_t addr = 0;
+    int count = 0;
+    int i;
+
+    if (!l2_standin_ready())
+    {
+        UT_LOG_INFO("Skipped, the DHCP server stand-in is not available\n");
+        return;
+    }
+    pLatencies = calloc((size_t)iterations, sizeof(*pLatencies));
+    if (pLatencies == NULL)
+    {
+        UT_FAIL("Out of memory");
+        return;
+    }
+    for (i = 0; i < iterations; i++)
+    {
+        if (l2_standin_acquire(get_ert_ip, &addr, &pLatencies[count]) != 0)
+        {
+            UT_FAIL("No lease was acquired from the stand-in server");
+            break;
+        }
+            UT_ASSERT_NOT_EQUAL(addr, previous);
+        UT_LOG_DEBUG("lease %d: ACK to getter %llu us", i, (unsigned long long)(pLatencies[count] / 1000));
+        previous = addr;
+        count++;
+    }
+    if (count > 0)
+    {
+        qsort(pLatencies, (size_t)count, sizeof(*pLatencies), compare_u64);
+        UT_LOG_INFO("ACK to getter over %d leases: min %llu us, median %llu us, max %llu us\n", count,
+                    (unsigned long long)(pLatencies[0] / 1000), (unsigned long long)(pLatencies[count / 2] / 1000),
+                    (unsigned long long)(pLatencies[count - 1] / 1000));
+        test_results_add_value("leases", "%d", count);
+        test_results_add_value("ack_to_getter_min_us", "%llu", (unsigned long long)(pLatencies[0] / 1000));
+        test_results_add_value("ack_to_getter_median_us", "%llu", (unsigned long long)(pLatencies[count / 2] / 1000));
+        test_results_add_value("ack_to_getter_max_us", "%llu", (unsigned long long)(pLatencies[count - 1] / 1000));
+        UT_ASSERT_TRUE(pLatencies[count - 1] < bound_ns);
+    }
+    free(pLatencies);
+
+    UT_LOG_INFO("Out %s\n", __FUNCTION__);
+}
+
+static UT_test_suite_t * pSuite = NULL;
+
+/**
+ * @brief Register the main tests for this module
+ *
+ * @return int - 0 on success, otherwise failure
+ */
+int test_dhcp4cApi_hal_l2_register(void)
+{
+    // Create the test suite; the stand-in is started and stopped around it
+    pSuite = UT_add_suite("[L2 dhcp4cApi]", l2_standin_setup, l2_standin_cleanup);
+    if (pSuite == NULL)
+    {
+        return -1;
+    }
+    // List of test function names and strings
+
+    UT_add_test( pSuite, "l2_dhcp4cApi_hal_ert_lease_matches_offer", test_l2_dhcp4cApi_hal_ert_lease_matches_offer);
+    UT_add_test( pSuite, "l2_dhcp4cApi_hal_ert_ack_to_getter_latency", test_l2_dhcp4cApi_hal_ert_ack_to_getter_latency);
+    return 0;
+}
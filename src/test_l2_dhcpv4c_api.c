@@ -0,0 +1,440 @@
+/*
+* If not stated otherwise in this file or this component's LICENSE file the
+* following copyright and licenses apply:*
+* Copyright 2023 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+/**
+* @file test_l2_dhcpv4c_api.c
+* @page dhcpv4c_api Level 2 Tests
+*
+* ## Module's Role
+* This module includes Level 2 functional tests: the eRouter getters are checked
+* end to end against a lease handed out by a DHCPv4 server stand-in, and the
+* lease notifications against polling them.
+*
+* **Pre-Conditions:** Root privileges, the dhcp_standin tool (see test_l2_standin.h)@n
+* **Dependencies:** None@n
+*
+* Ref to API Definition specification documentation : [DHCPv4ChalSpec.md](../../../docs/DHCPv4ChalSpec.md)
+*/
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+#include <arpa/inet.h>
+#include <ut.h>
+#include <ut_log.h>
+#include "test_log.h"
+#include "dhcpv4c_api.h"
+#include "test_ipv4.h"
+#include "test_l2_standin.h"
+#include "test_results.h"
+#ifdef DHCPV4C_API_EXT
+#include "dhcpv4c_api_ext.h"
+#endif
+
+static int gTestGroup = 2;
+static int gTestID = 1;
+
+#ifndef STATUS_SUCCESS
+#define STATUS_SUCCESS   0
+#endif
+
+#define L2_DEFAULT_ITERATIONS       5
+#define L2_DEFAULT_LATENCY_BOUND_MS 1000
+#define L2_POLL_PERIOD_NS           1000000000ULL   /* The polling loop lease notifications replace */
+
+static int get_ert_ip( uint32_t *pAddr )
+{
+    UINT value = 0;
+    int status = dhcpv4c_get_ert_ip_addr(&value);
+
+    *pAddr = value;
+    return (status == STATUS_SUCCESS) ? 0 : -1;
+}
+
+static int compare_u64( const void *pA, const void *pB )
+{
+    uint64_t a = *(const uint64_t *)pA;
+    uint64_t b = *(const uint64_t *)pB;
+
+    return (a > b) - (a < b);
+}
+
+/**
+* @brief Test case to verify that the eRouter getters report the lease the server handed out
+*
+* A client acquires a lease from the stand-in server, then every eRouter getter is compared with the server's offer.
+*
+* **Test Group ID:** Module: 02
+* **Test Case ID:** 001
+* **Priority:** High
+*
+* **Pre-Conditions:** Root privileges, dhcp_standin available
+* **Dependencies:** None
+* **User Interaction:** If user chose to run the test in interactive mode, then the test case has to be selected via console
+*
+* **Test Procedure:**
+* | Variation / Step | Description | Test Data | Expected Result | Notes |
+* | :----: | --------- | ---------- |-------------- | ----- |
+* | 01 | Acquire a lease and wait for dhcpv4c_get_ert_ip_addr to report it | stand-in offer | An address the server acknowledged, within the pool | |
+* | 02 | Invoking dhcpv4c_get_ert_mask, gw, dhcp_svr and lease_time | valid pointers | STATUS_SUCCESS and the offered values | options 1, 3, 54, 51 |
+* | 03 | Invoking dhcpv4c_get_ert_dns_svrs | valid pointer | STATUS_SUCCESS, the offered servers in order | option 6 |
+* | 04 | Invoking dhcpv4c_get_ert_remain_lease_time, remain_renew_time and remain_rebind_time | valid pointers | Within 10 s below lease time, T1 and T2 | options 58, 59 |
+*/
+void test_l2_dhcpv4c_api_ert_lease_matches_offer(void)
+{
+    gTestID = 1;
+    UT_LOG_INFO("In %s [%02d%03d]\n", __FUNCTION__, gTestGroup, gTestID);
+    test_results_set_id(gTestGroup, gTestID);
+
+    const l2_standin_offer_t *pOffer = l2_standin_offer();
+    char ip_str[DHCP_IPV4_STRLEN];
+    dhcpv4c_ip_list_t ip_list;
+    UINT value = 0;
+    uint64_t latencyNs = 0;
+    uint32_t addr = 0;
+    int i;
+
+    if (!l2_standin_ready())
+    {
+        UT_LOG_INFO("Skipped, the DHCP server stand-in is not available\n");
+        return;
+    }
+    if (l2_standin_acquire(get_ert_ip, &addr, &latencyNs) != 0)
+    {
+        UT_FAIL("No lease was acquired from the stand-in server");
+        return;
+    }
+    UT_LOG_DEBUG("ip_addr: %s", dhcp_ipv4_format(addr, ip_str));
+    test_results_add_value("ip_addr", "%s", ip_str);
+    UT_ASSERT_TRUE(ntohl(addr) - ntohl(pOffer->pool_first) < pOffer->pool_size);
+
+    UT_ASSERT_EQUAL(dhcpv4c_get_ert_mask(&value), STATUS_SUCCESS);
+    UT_ASSERT_EQUAL(value, pOffer->mask);
+    UT_ASSERT_EQUAL(dhcpv4c_get_ert_gw(&value), STATUS_SUCCESS);
+    UT_ASSERT_EQUAL(value, pOffer->router);
+    UT_ASSERT_EQUAL(dhcpv4c_get_ert_dhcp_svr(&value), STATUS_SUCCESS);
+    UT_ASSERT_EQUAL(value, pOffer->server_ip);
+    UT_ASSERT_EQUAL(dhcpv4c_get_ert_lease_time(&value), STATUS_SUCCESS);
+    UT_ASSERT_EQUAL(value, pOffer->lease_time);
+
+    memset(&ip_list, 0, sizeof(ip_list));
+    UT_ASSERT_EQUAL(dhcpv4c_get_ert_dns_svrs(&ip_list), STATUS_SUCCESS);
+    UT_ASSERT_EQUAL(ip_list.number, pOffer->dns_count);
+    for (i = 0; i < pOffer->dns_count && i < ip_list.number; i++)
+    {
+        UT_LOG_DEBUG("dns[%d]: %s", i, dhcp_ipv4_format(ip_list.addrs[i], ip_str));
+        UT_ASSERT_EQUAL(ip_list.addrs[i], pOffer->dns[i]);
+    }
+
+    UT_ASSERT_EQUAL(dhcpv4c_get_ert_remain_lease_time(&value), STATUS_SUCCESS);
+    UT_LOG_DEBUG("remain_lease_time: %u", value);
+    UT_ASSERT_TRUE(value <= pOffer->lease_time && value + 10 >= pOffer->lease_time);
+    UT_ASSERT_EQUAL(dhcpv4c_get_ert_remain_renew_time(&value), STATUS_SUCCESS);
+    UT_LOG_DEBUG("remain_renew_time: %u", value);
+    UT_ASSERT_TRUE(value <= pOffer->renewal_time && value + 10 >= pOffer->renewal_time);
+    UT_ASSERT_EQUAL(dhcpv4c_get_ert_remain_rebind_time(&value), STATUS_SUCCESS);
+    UT_LOG_DEBUG("remain_rebind_time: %u", value);
+    UT_ASSERT_TRUE(value <= pOffer->rebinding_time && value + 10 >= pOffer->rebinding_time);
+
+    UT_LOG_INFO("Out %s\n", __FUNCTION__);
+}
+
+/**
+* @brief Test case to measure how long the eRouter getters take to reflect a new lease
+*
+* Acquires DHCP_L2_ITERATIONS leases in turn, each for a different address of the pool, and measures the time from the server sending the ACK to dhcpv4c_get_ert_ip_addr first reporting the new address.
+*
+* **Test Group ID:** Module: 02
+* **Test Case ID:** 002
+* **Priority:** Medium
+*
+* **Pre-Conditions:** Root privileges, dhcp_standin available
+* **Dependencies:** None
+* **User Interaction:** If user chose to run the test in interactive mode, then the test case has to be selected via console
+*
+* **Test Procedure:**
+* | Variation / Step | Description | Test Data | Expected Result | Notes |
+* | :----: | --------- | ---------- |-------------- | ----- |
+* | 01 | Acquire a lease and poll dhcpv4c_get_ert_ip_addr until it changes | stand-in offer | A new address the server acknowledged | Repeated DHCP_L2_ITERATIONS times |
+* | 02 | Log min, median and max ACK-to-getter latency | | Max below DHCP_L2_LATENCY_BOUND_MS | Default 1000 ms |
+*/
+void test_l2_dhcpv4c_api_ert_ack_to_getter_latency(void)
+{
+    gTestID = 2;
+    UT_LOG_INFO("In %s [%02d%03d]\n", __FUNCTION__, gTestGroup, gTestID);
+    test_results_set_id(gTestGroup, gTestID);
+
+    const char *pIterations = getenv("DHCP_L2_ITERATIONS");
+    const char *pBound = getenv("DHCP_L2_LATENCY_BOUND_MS");
+    int iterations = (pIterations != NULL && atoi(pIterations) > 0) ? atoi(pIterations) : L2_DEFAULT_ITERATIONS;
+    uint64_t bound_ns = (uint64_t)((pBound != NULL && atoi(pBound) > 0) ? atoi(pBound) : L2_DEFAULT_LATENCY_BOUND_MS) * 1000000ULL;
+    uint64_t *pLatencies;
+    uint32_t previous = 0;
+    uint32_t addr = 0;
+    int count = 0;
+    int i;
+
+    if (!l2_standin_ready())
+    {
+        UT_LOG_INFO("Skipped, the DHCP server stand-in is not available\n");
+        return;
+    }
+    pLatencies = calloc((size_t)iterations, sizeof(*pLatencies));
+    if (pLatencies == NULL)
+    {
+        UT_FAIL("Out of memory");
+        return;
+    }
+    for (i = 0; i < iterations; i++)
+    {
+        if (l2_standin_acquire(get_ert_ip, &addr, &pLatencies[count]) != 0)
+        {
+            UT_FAIL("No lease was acquired from the stand-in server");
+            break;
+        }
+            UT_ASSERT_NOT_EQUAL(addr, previous);
+        UT_LOG_DEBUG("lease %d: ACK to getter %llu us", i, (unsigned long long)(pLatencies[count] / 1000));
+        previous = addr;
+        count++;
+    }
+    if (count > 0)
+    {
+        qsort(pLatencies, (size_t)count, sizeof(*pLatencies), compare_u64);
+        UT_LOG_INFO("ACK to getter over %d leases: min %llu us, median %llu us, max %llu us\n", count,
+                    (unsigned long long)(pLatencies[0] / 1000), (unsigned long long)(pLatencies[count / 2] / 1000),
+                    (unsigned long long)(pLatencies[count - 1] / 1000));
+        test_results_add_value("leases", "%d", count);
+        test_results_add_value("ack_to_getter_min_us", "%llu", (unsigned long long)(pLatencies[0] / 1000));
+        test_results_add_value("ack_to_getter_median_us", "%llu", (unsigned long long)(pLatencies[count / 2] / 1000));
+        test_results_add_value("ack_to_getter_max_us", "%llu", (unsigned long long)(pLatencies[count - 1] / 1000));
+        UT_ASSERT_TRUE(pLatencies[count - 1] < bound_ns);
+    }
+    free(pLatencies);
+
+    UT_LOG_INFO("Out %s\n", __FUNCTION__);
+}
+
+#ifdef DHCPV4C_API_EXT
+/* What a lease subscriber and a 1 s polling loop saw of one acquisition */
+typedef struct
+{
+    pthread_mutex_t lock;
+    uint32_t before;                /* eRouter address before the acquisition */
+    uint32_t notified_addr;         /* From the last eRouter event, under lock */
+    uint64_t notified_ns;           /* When that event was delivered, under lock */
+    uint64_t next_poll_ns;
+    uint64_t polled_ns;             /* When the polling loop first saw the new lease */
+    uint32_t polled_addr;
+} l2_watch_t;
+
+static uint64_t monotonic_ns( void )
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static void on_lease_event( const dhcpv4c_lease_event_t *pEvent, void *pUserData )
+{
+    l2_watch_t *pWatch = (l2_watch_t *)pUserData;
+    uint64_t now_ns = monotonic_ns();
+
+    if (pEvent->iface != DHCPV4C_LEASE_EVENT_ERT || pEvent->ip_addr == 0)
+    {
+        return;
+    }
+    pthread_mutex_lock(&pWatch->lock);
+    if (pEvent->ip_addr != pWatch->before && pWatch->notified_ns == 0)
+    {
+        pWatch->notified_addr = pEvent->ip_addr;
+        pWatch->notified_ns = now_ns;
+    }
+    pthread_mutex_unlock(&pWatch->lock);
+}
+
+/* Polls the getter once a second, as a manager without notifications would, and waits for the event too */
+static int lease_seen( void *pContext, uint32_t *pAddr )
+{
+    l2_watch_t *pWatch = (l2_watch_t *)pContext;
+    uint64_t now_ns = monotonic_ns();
+    uint64_t notified_ns;
+    uint32_t addr = 0;
+
+    if (pWatch->polled_ns == 0 && now_ns >= pWatch->next_poll_ns)
+    {
+        if (get_ert_ip(&addr) == 0 && addr != 0 && addr != pWatch->before)
+        {
+            pWatch->polled_ns = now_ns;
+            pWatch->polled_addr = addr;
+        }
+        pWatch->next_poll_ns += L2_POLL_PERIOD_NS;
+    }
+    pthread_mutex_lock(&pWatch->lock);
+    notified_ns = pWatch->notified_ns;
+    pthread_mutex_unlock(&pWatch->lock);
+    if (pWatch->polled_ns == 0 || (notified_ns == 0 && now_ns < pWatch->polled_ns + L2_POLL_PERIOD_NS))
+    {
+        return 0;
+    }
+    *pAddr = pWatch->polled_addr;
+    return 1;
+}
+
+/**
+* @brief Test case to compare lease notifications with polling the eRouter getters
+*
+* Subscribes to eRouter lease events, then acquires DHCP_L2_ITERATIONS leases in turn. For each, measures the time from the server sending the ACK to the callback running, and to a loop that polls dhcpv4c_get_ert_ip_addr once a second, at a random phase, first seeing the new address.
+*
+* **Test Group ID:** Module: 02
+* **Test Case ID:** 003
+* **Priority:** Medium
+*
+* **Pre-Conditions:** Root privileges, dhcp_standin and sysevent_standin available
+* **Dependencies:** None
+* **User Interaction:** If user chose to run the test in interactive mode, then the test case has to be selected via console
+*
+* **Test Procedure:**
+* | Variation / Step | Description | Test Data | Expected Result | Notes |
+* | :----: | --------- | ---------- |-------------- | ----- |
+* | 01 | Invoke dhcpv4c_lease_subscribe for the eRouter | ifaceMask = DHCPV4C_LEASE_EVENT_ERT | STATUS_SUCCESS | |
+* | 02 | Acquire a lease, poll dhcpv4c_get_ert_ip_addr every second until it changes | stand-in offer | The callback reported the address the poll found | Repeated DHCP_L2_ITERATIONS times |
+* | 03 | Log min, median and max ACK-to-callback and ACK-to-poll latency | | Median ACK-to-callback below median ACK-to-poll | |
+* | 04 | Invoke dhcpv4c_lease_unsubscribe | handle from 01 | STATUS_SUCCESS | |
+*/
+void test_l2_dhcpv4c_api_ert_notify_vs_poll_latency(void)
+{
+    gTestID = 3;
+    UT_LOG_INFO("In %s [%02d%03d]\n", __FUNCTION__, gTestGroup, gTestID);
+    test_results_set_id(gTestGroup, gTestID);
+
+    const char *pIterations = getenv("DHCP_L2_ITERATIONS");
+    int iterations = (pIterations != NULL && atoi(pIterations) > 0) ? atoi(pIterations) : L2_DEFAULT_ITERATIONS;
+    l2_standin_timeline_t timeline;
+    l2_watch_t watch;
+    uint64_t *pNotify;
+    uint64_t *pPoll;
+    uint64_t now_ns;
+    INT handle = -1;
+    int count = 0;
+    int i;
+
+    if (!l2_standin_notifies())
+    {
+        UT_LOG_INFO("Skipped, no lease notifications: the DHCP server or sysevent stand-in is not available\n");
+        return;
+    }
+    memset(&watch, 0, sizeof(watch));
+    pthread_mutex_init(&watch.lock, NULL);
+    pNotify = calloc((size_t)iterations, sizeof(*pNotify));
+    pPoll = calloc((size_t)iterations, sizeof(*pPoll));
+    if (pNotify == NULL || pPoll == NULL)
+    {
+        UT_FAIL("Out of memory");
+        free(pNotify);
+        free(pPoll);
+        return;
+    }
+    UT_ASSERT_EQUAL_FATAL(dhcpv4c_lease_subscribe(DHCPV4C_LEASE_EVENT_ERT, on_lease_event, &watch, &handle), STATUS_SUCCESS);
+
+    for (i = 0; i < iterations; i++)
+    {
+        now_ns = monotonic_ns();
+        pthread_mutex_lock(&watch.lock);
+        if (get_ert_ip(&watch.before) != 0)
+        {
+            watch.before = 0;
+        }
+        watch.notified_addr = 0;
+        watch.notified_ns = 0;
+        pthread_mutex_unlock(&watch.lock);
+        watch.next_poll_ns = now_ns + now_ns % L2_POLL_PERIOD_NS;
+        watch.polled_ns = 0;
+        if (l2_standin_timeline(lease_seen, &watch, &timeline) != 0)
+        {
+            UT_FAIL("No lease was acquired from the stand-in server");
+            break;
+        }
+        pthread_mutex_lock(&watch.lock);
+        UT_ASSERT_TRUE(watch.notified_ns != 0);
+        UT_ASSERT_EQUAL(watch.notified_addr, watch.polled_addr);
+        if (watch.notified_ns == 0 || watch.notified_ns < timeline.ack_ns || watch.polled_ns < timeline.ack_ns)
+        {
+            pthread_mutex_unlock(&watch.lock);
+            continue;
+        }
+        pNotify[count] = watch.notified_ns - timeline.ack_ns;
+        pthread_mutex_unlock(&watch.lock);
+        pPoll[count] = watch.polled_ns - timeline.ack_ns;
+        UT_LOG_DEBUG("lease %d: ACK to callback %llu us, ACK to poll %llu us", i,
+                     (unsigned long long)(pNotify[count] / 1000), (unsigned long long)(pPoll[count] / 1000));
+        count++;
+    }
+    UT_ASSERT_EQUAL(dhcpv4c_lease_unsubscribe(handle), STATUS_SUCCESS);
+
+    if (count > 0)
+    {
+        qsort(pNotify, (size_t)count, sizeof(*pNotify), compare_u64);
+        qsort(pPoll, (size_t)count, sizeof(*pPoll), compare_u64);
+        UT_LOG_INFO("ACK to callback over %d leases: min %llu us, median %llu us, max %llu us\n", count,
+                    (unsigned long long)(pNotify[0] / 1000), (unsigned long long)(pNotify[count / 2] / 1000),
+                    (unsigned long long)(pNotify[count - 1] / 1000));
+        UT_LOG_INFO("ACK to 1 s poll over %d leases: min %llu us, median %llu us, max %llu us\n", count,
+                    (unsigned long long)(pPoll[0] / 1000), (unsigned long long)(pPoll[count / 2] / 1000),
+                    (unsigned long long)(pPoll[count - 1] / 1000));
+        test_results_add_value("leases", "%d", count);
+        test_results_add_value("ack_to_callback_min_us", "%llu", (unsigned long long)(pNotify[0] / 1000));
+        test_results_add_value("ack_to_callback_median_us", "%llu", (unsigned long long)(pNotify[count / 2] / 1000));
+        test_results_add_value("ack_to_callback_max_us", "%llu", (unsigned long long)(pNotify[count - 1] / 1000));
+        test_results_add_value("ack_to_poll_min_us", "%llu", (unsigned long long)(pPoll[0] / 1000));
+        test_results_add_value("ack_to_poll_median_us", "%llu", (unsigned long long)(pPoll[count / 2] / 1000));
+        test_results_add_value("ack_to_poll_max_us", "%llu", (unsigned long long)(pPoll[count - 1] / 1000));
+        UT_ASSERT_TRUE(pNotify[count / 2] < pPoll[count / 2]);
+    }
+    free(pNotify);
+    free(pPoll);
+    pthread_mutex_destroy(&watch.lock);
+
+    UT_LOG_INFO("Out %s\n", __FUNCTION__);
+}
+#endif /* DHCPV4C_API_EXT */
+
+static UT_test_suite_t * pSuite = NULL;
+
+/**
+ * @brief Register the main tests for this module
+ *
+ * @return int - 0 on success, otherwise failure
+ */
+int test_dhcpv4c_api_hal_l2_register(void)
+{
+    // Create the test suite; the stand-in is started and stopped around it
+    pSuite = UT_add_suite("[L2 dhcpv4c_api]", l2_standin_setup, l2_standin_cleanup);
+    if (pSuite == NULL)
+    {
+        return -1;
+    }
+    // List of test function names and strings
+
+    UT_add_test( pSuite, "l2_dhcpv4c_api_ert_lease_matches_offer", test_l2_dhcpv4c_api_ert_lease_matches_offer);
+    UT_add_test( pSuite, "l2_dhcpv4c_api_ert_ack_to_getter_latency", test_l2_dhcpv4c_api_ert_ack_to_getter_latency);
+#ifdef DHCPV4C_API_EXT
+    UT_add_test( pSuite, "l2_dhcpv4c_api_ert_notify_vs_poll_latency", test_l2_dhcpv4c_api_ert_notify_vs_poll_latency);
+#endif
+    return 0;
+}
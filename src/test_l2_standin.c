@@ -0,0 +1,636 @@
+/*
+* If not stated otherwise in this file or this component's LICENSE file the
+* following copyright and licenses apply:*
+* Copyright 2023 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <errno.h>
+#include <limits.h>
+#include <signal.h>
+#include <time.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <arpa/inet.h>
+#include <ut_log.h>
+#include "test_log.h"
+#include "test_l2_standin.h"
+#ifdef BUILD_LINUX
+#include "dhcp_lease_file.h"
+#include "dhcp_lease_notify.h"
+#include "dhcp_sysevent.h"
+#endif
+
+#define L2_DEFAULT_STANDIN      "./dhcp_standin"
+#define L2_DEFAULT_SYSEVENT     "./sysevent_standin"
+#define L2_DEFAULT_NETNS        "dhcpl2"
+#define L2_DEFAULT_CLIENT_IF    "dhcpl2c"
+#define L2_SERVER_IF            "dhcpl2s"
+#define L2_SERVER_PREFIX        "192.0.2.1/24"
+#define L2_SERVER_START_MS      2000
+#define L2_ACQUIRE_TIMEOUT_MS   10000
+#define L2_CLIENT_TIMEOUT_MS    "5000"
+#define L2_CLIENT_EXIT_MS       200         /* For a client to exit by itself, then after SIGTERM */
+#define L2_POLL_INTERVAL_NS     100000      /* 100us between getter calls */
+
+static l2_standin_offer_t gOffer;
+static int gReady = 0;
+static pid_t gServerPid = -1;
+static char gDir[PATH_MAX - 32];              /* Leaves room for the file names below it */
+static char gLogPath[PATH_MAX];
+static char gLeasePath[PATH_MAX];
+#ifdef BUILD_LINUX
+static char *gpSavedLeaseEnv = NULL;
+static pid_t gSyseventPid = -1;
+static char gSyseventPath[PATH_MAX];
+static char gSyseventLogPath[PATH_MAX];
+static char *gpSavedSyseventEnv = NULL;
+#endif
+
+static const char *env_or( const char *pName, const char *pDefault )
+{
+    const char *pValue = getenv(pName);
+
+    return (pValue != NULL && pValue[0] != '\0') ? pValue : pDefault;
+}
+
+static uint64_t monotonic_ns( void )
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static void sleep_ns( long ns )
+{
+    struct timespec ts = { 0, ns };
+
+    nanosleep(&ts, NULL);
+}
+
+static int run_cmd( const char *pFormat, ... )
+{
+    char cmd[512];
+    va_list args;
+    int status;
+
+    va_start(args, pFormat);
+    vsnprintf(cmd, sizeof(cmd), pFormat, args);
+    va_end(args);
+    UT_LOG_DEBUG("l2: %s", cmd);
+    status = system(cmd);
+    return (status != -1 && WIFEXITED(status)) ? WEXITSTATUS(status) : -1;
+}
+
+/* Returns 0 once the server log has a line for pEvent */
+static int find_event( const char *pEvent )
+{
+    char line[160];
+    char event[16];
+    unsigned long long timeNs;
+    int found = 0;
+    FILE *pFile;
+
+    pFile = fopen(gLogPath, "r");
+    if (pFile == NULL)
+    {
+        return -1;
+    }
+    while (!found && fgets(line, sizeof(line), pFile) != NULL)
+    {
+        found = (sscanf(line, "%llu %15s", &timeNs, event) == 2 && strcmp(event, pEvent) == 0);
+    }
+    fclose(pFile);
+    return found ? 0 : -1;
+}
+
+static int start_server( const char *pStandin, const char *pNetns )
+{
+    char pool[16];
+    char lease[16];
+    char t1[16];
+    char t2[16];
+    uint64_t deadline_ns = monotonic_ns() + L2_SERVER_START_MS * 1000000ULL;
+    int status;
+
+    snprintf(pool, sizeof(pool), "%u", gOffer.pool_size);
+    snprintf(lease, sizeof(lease), "%u", gOffer.lease_time);
+    snprintf(t1, sizeof(t1), "%u", gOffer.renewal_time);
+    snprintf(t2, sizeof(t2), "%u", gOffer.rebinding_time);
+
+    gServerPid = fork();
+    if (gServerPid < 0)
+    {
+        return -1;
+    }
+    if (gServerPid == 0)
+    {
+        execlp("ip", "ip", "netns", "exec", pNetns, pStandin, "server", "-i", L2_SERVER_IF,
+               "-s", "192.0.2.1", "-a", "192.0.2.100", "-n", pool, "-m", "255.255.255.0", "-r", "192.0.2.1",
+               "-d", "192.0.2.53,192.0.2.54", "-l", lease, "-t", t1, "-T", t2, "-L", gLogPath, (char *)NULL);
+        _exit(127);
+    }
+
+    /* The server logs READY once its socket is bound */
+    while (monotonic_ns() < deadline_ns)
+    {
+        if (find_event("READY") == 0)
+        {
+            return 0;
+        }
+        if (waitpid(gServerPid, &status, WNOHANG) == gServerPid)
+        {
+            gServerPid = -1;
+            return -1;
+        }
+        sleep_ns(10 * 1000000L);
+    }
+    return -1;
+}
+
+#ifdef BUILD_LINUX
+/* Starts the sysevent stand-in the stand-in client announces its leases through */
+static int start_sysevent( const char *pSysevent )
+{
+    uint64_t deadline_ns = monotonic_ns() + L2_SERVER_START_MS * 1000000ULL;
+    dhcp_sysevent_t conn;
+    int status;
+    int fd;
+
+    gSyseventPid = fork();
+    if (gSyseventPid < 0)
+    {
+        return -1;
+    }
+    if (gSyseventPid == 0)
+    {
+        fd = open(gSyseventLogPath, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (fd >= 0)
+        {
+            dup2(fd, STDOUT_FILENO);
+            dup2(fd, STDERR_FILENO);
+        }
+        execl(pSysevent, pSysevent, "daemon", "-s", gSyseventPath, (char *)NULL);
+        _exit(127);
+    }
+
+    while (monotonic_ns() < deadline_ns)
+    {
+        if (dhcp_sysevent_open(&conn, gSyseventPath) == 0)
+        {
+            dhcp_sysevent_close(&conn);
+            return 0;
+        }
+        if (waitpid(gSyseventPid, &status, WNOHANG) == gSyseventPid)
+        {
+            gSyseventPid = -1;
+            return -1;
+        }
+        sleep_ns(10 * 1000000L);
+    }
+    return -1;
+}
+
+static void restore_env( const char *pName, char **ppSaved )
+{
+    if (*ppSaved != NULL)
+    {
+        setenv(pName, *ppSaved, 1);
+    }
+    else
+    {
+        unsetenv(pName);
+    }
+    free(*ppSaved);
+    *ppSaved = NULL;
+}
+#endif
+
+int l2_standin_setup( void )
+{
+    const char *pStandin = env_or("DHCP_L2_STANDIN", L2_DEFAULT_STANDIN);
+    const char *pNetns = env_or("DHCP_L2_NETNS", L2_DEFAULT_NETNS);
+    const char *pClientIf = env_or("DHCP_L2_CLIENT_IF", L2_DEFAULT_CLIENT_IF);
+    const char *pSysevent;
+    const char *pPrevious;
+
+    gReady = 0;
+    memset(&gOffer, 0, sizeof(gOffer));
+    gOffer.server_ip = inet_addr("192.0.2.1");
+    gOffer.pool_first = inet_addr("192.0.2.100");
+    gOffer.pool_size = 8;
+    gOffer.mask = inet_addr("255.255.255.0");
+    gOffer.router = inet_addr("192.0.2.1");
+    gOffer.dns[0] = inet_addr("192.0.2.53");
+    gOffer.dns[1] = inet_addr("192.0.2.54");
+    gOffer.dns_count = 2;
+    gOffer.lease_time = 600;
+    gOffer.renewal_time = 300;
+    gOffer.rebinding_time = 525;
+
+#ifndef BUILD_LINUX
+    if (getenv("DHCP_L2_CLIENT_CMD") == NULL)
+    {
+        UT_LOG_INFO("l2: DHCP_L2_CLIENT_CMD is not set, the stand-in client only feeds the linux skeleton");
+        return 0;
+    }
+#endif
+    if (access(pStandin, X_OK) != 0)
+    {
+        UT_LOG_INFO("l2: %s not found, set DHCP_L2_STANDIN", pStandin);
+        return 0;
+    }
+
+    snprintf(gDir, sizeof(gDir), "%s/dhcp_l2_XXXXXX", env_or("TMPDIR", "/tmp"));
+    if (mkdtemp(gDir) == NULL)
+    {
+        UT_LOG_INFO("l2: cannot create %s: %s", gDir, strerror(errno));
+        gDir[0] = '\0';
+        return 0;
+    }
+    snprintf(gLogPath, sizeof(gLogPath), "%s/server.log", gDir);
+    snprintf(gLeasePath, sizeof(gLeasePath), "%s/erouter.lease", gDir);
+#ifdef BUILD_LINUX
+    snprintf(gSyseventPath, sizeof(gSyseventPath), "%s/sysevent.sock", gDir);
+    snprintf(gSyseventLogPath, sizeof(gSyseventLogPath), "%s/sysevent.log", gDir);
+#endif
+
+    /* Leftovers of an interrupted run */
+    run_cmd("ip link del %s >/dev/null 2>&1", pClientIf);
+    run_cmd("ip netns del %s >/dev/null 2>&1", pNetns);
+
+    if (run_cmd("ip netns add %s", pNetns) != 0 ||
+        run_cmd("ip link add %s type veth peer name %s", pClientIf, L2_SERVER_IF) != 0 ||
+        run_cmd("ip link set %s netns %s", L2_SERVER_IF, pNetns) != 0 ||
+        run_cmd("ip -n %s addr add %s dev %s", pNetns, L2_SERVER_PREFIX, L2_SERVER_IF) != 0 ||
+        run_cmd("ip -n %s link set %s up", pNetns, L2_SERVER_IF) != 0 ||
+        run_cmd("ip link set %s up", pClientIf) != 0)
+    {
+        UT_LOG_INFO("l2: cannot create the %s namespace, the L2 tests need root", pNetns);
+        l2_standin_cleanup();
+        return 0;
+    }
+    if (start_server(pStandin, pNetns) != 0)
+    {
+        UT_LOG_INFO("l2: the stand-in server did not start, see %s", gLogPath);
+        l2_standin_cleanup();
+        return 0;
+    }
+
+#ifdef BUILD_LINUX
+    if (getenv("DHCP_L2_CLIENT_CMD") == NULL)
+    {
+        pPrevious = getenv(DHCP_LEASE_FILE_ENV);
+        gpSavedLeaseEnv = (pPrevious != NULL) ? strdup(pPrevious) : NULL;
+        setenv(DHCP_LEASE_FILE_ENV, gLeasePath, 1);
+
+        /* Without it the lease tests still run; only the notification ones skip */
+        pSysevent = env_or("DHCP_L2_SYSEVENT", L2_DEFAULT_SYSEVENT);
+        if (access(pSysevent, X_OK) != 0)
+        {
+            UT_LOG_INFO("l2: %s not found, set DHCP_L2_SYSEVENT", pSysevent);
+        }
+        else if (start_sysevent(pSysevent) != 0)
+        {
+            UT_LOG_INFO("l2: the sysevent stand-in did not start, see %s", gSyseventLogPath);
+        }
+        else
+        {
+            pPrevious = getenv(DHCP_SYSEVENT_ENV);
+            gpSavedSyseventEnv = (pPrevious != NULL) ? strdup(pPrevious) : NULL;
+            setenv(DHCP_SYSEVENT_ENV, gSyseventPath, 1);
+        }
+    }
+#else
+    (void)pPrevious;
+    (void)pSysevent;
+#endif
+    gReady = 1;
+    return 0;
+}
+
+int l2_standin_cleanup( void )
+{
+    char path[PATH_MAX + 8];
+
+    if (gServerPid > 0)
+    {
+        kill(gServerPid, SIGTERM);
+        waitpid(gServerPid, NULL, 0);
+        gServerPid = -1;
+    }
+    run_cmd("ip link del %s >/dev/null 2>&1", env_or("DHCP_L2_CLIENT_IF", L2_DEFAULT_CLIENT_IF));
+    run_cmd("ip netns del %s >/dev/null 2>&1", env_or("DHCP_L2_NETNS", L2_DEFAULT_NETNS));
+
+#ifdef BUILD_LINUX
+    if (gSyseventPid > 0)
+    {
+        kill(gSyseventPid, SIGTERM);
+        waitpid(gSyseventPid, NULL, 0);
+        gSyseventPid = -1;
+        restore_env(DHCP_SYSEVENT_ENV, &gpSavedSyseventEnv);
+    }
+    if (gReady && getenv("DHCP_L2_CLIENT_CMD") == NULL)
+    {
+        restore_env(DHCP_LEASE_FILE_ENV, &gpSavedLeaseEnv);
+    }
+#endif
+    if (gDir[0] != '\0')
+    {
+#ifdef BUILD_LINUX
+        unlink(gSyseventPath);
+        unlink(gSyseventLogPath);
+#endif
+        unlink(gLogPath);
+        unlink(gLeasePath);
+        snprintf(path, sizeof(path), "%s.tmp", gLeasePath);
+        unlink(path);
+        rmdir(gDir);
+        gDir[0] = '\0';
+    }
+    gReady = 0;
+    return 0;
+}
+
+int l2_standin_ready( void )
+{
+    return gReady;
+}
+
+const l2_standin_offer_t *l2_standin_offer( void )
+{
+    return &gOffer;
+}
+
+int l2_standin_notifies( void )
+{
+    if (!gReady)
+    {
+        return 0;
+    }
+    if (getenv("DHCP_L2_CLIENT_CMD") != NULL)
+    {
+        return 1;
+    }
+#ifdef BUILD_LINUX
+    return gSyseventPid > 0;
+#else
+    return 0;
+#endif
+}
+
+static pid_t start_client( void )
+{
+    const char *pStandin = env_or("DHCP_L2_STANDIN", L2_DEFAULT_STANDIN);
+    const char *pClientIf = env_or("DHCP_L2_CLIENT_IF", L2_DEFAULT_CLIENT_IF);
+    const char *pCmd = getenv("DHCP_L2_CLIENT_CMD");
+    pid_t pid;
+
+    pid = fork();
+    if (pid == 0)
+    {
+        if (pCmd != NULL)
+        {
+            execl("/bin/sh", "sh", "-c", pCmd, (char *)NULL);
+        }
+#ifdef BUILD_LINUX
+        else if (gSyseventPid > 0)
+        {
+            execl(pStandin, pStandin, "client", "-i", pClientIf, "-o", gLeasePath, "-e", DHCP_LEASE_NOTIFY_KEY_ERT,
+                  "-w", L2_CLIENT_TIMEOUT_MS, (char *)NULL);
+        }
+#endif
+        else
+        {
+            execl(pStandin, pStandin, "client", "-i", pClientIf, "-o", gLeasePath, "-w", L2_CLIENT_TIMEOUT_MS, (char *)NULL);
+        }
+        _exit(127);
+    }
+    return pid;
+}
+
+/* Reads the exchange that ended in the last ACK of addr from the server log; returns 0 once that ACK is there */
+static int read_exchange( uint32_t addr, uint64_t startNs, l2_standin_timeline_t *pTimeline )
+{
+    char line[160];
+    char event[16];
+    char ip[INET_ADDRSTRLEN];
+    unsigned long long timeNs;
+    unsigned int lineXid;
+    unsigned int xid = 0;
+    uint64_t *pSlot;
+    FILE *pFile;
+
+    pTimeline->ack_ns = 0;
+    pFile = fopen(gLogPath, "r");
+    if (pFile == NULL)
+    {
+        return -1;
+    }
+    while (fgets(line, sizeof(line), pFile) != NULL)
+    {
+        if (sscanf(line, "%llu %15s xid=%x ip=%15s", &timeNs, event, &lineXid, ip) == 4 &&
+            strcmp(event, "ACK") == 0 && inet_addr(ip) == addr && timeNs >= startNs)
+        {
+            pTimeline->ack_ns = timeNs;
+            xid = lineXid;
+        }
+    }
+    if (pTimeline->ack_ns == 0)
+    {
+        fclose(pFile);
+        return -1;
+    }
+
+    /* First of each message of that transaction, retransmissions are ignored */
+    pTimeline->discover_ns = pTimeline->offer_ns = pTimeline->request_ns = 0;
+    rewind(pFile);
+    while (fgets(line, sizeof(line), pFile) != NULL)
+    {
+        if (sscanf(line, "%llu %15s xid=%x ip=%15s", &timeNs, event, &lineXid, ip) != 4 || lineXid != xid || timeNs < startNs)
+        {
+            continue;
+        }
+        pSlot = (strcmp(event, "DISCOVER") == 0) ? &pTimeline->discover_ns :
+                (strcmp(event, "OFFER") == 0) ? &pTimeline->offer_ns :
+                (strcmp(event, "REQUEST") == 0) ? &pTimeline->request_ns : NULL;
+        if (pSlot != NULL && *pSlot == 0)
+        {
+            *pSlot = timeNs;
+        }
+    }
+    fclose(pFile);
+    return 0;
+}
+
+/* Polls for the client's exit for up to timeoutMs */
+static int reap_client( pid_t pid, int timeoutMs )
+{
+    uint64_t deadline_ns = monotonic_ns() + (uint64_t)timeoutMs * 1000000ULL;
+
+    do
+    {
+        if (waitpid(pid, NULL, WNOHANG) == pid)
+        {
+            return 0;
+        }
+        sleep_ns(L2_POLL_INTERVAL_NS);
+    } while (monotonic_ns() < deadline_ns);
+    return -1;
+}
+
+/*
+* Ends a client still running once the lease is in or the wait is over. One that
+* stays in the foreground, such as udhcpc -f, would otherwise never be reaped.
+*/
+static void stop_client( pid_t pid, int leaseSeen )
+{
+    if (leaseSeen && reap_client(pid, L2_CLIENT_EXIT_MS) == 0)
+    {
+        return;
+    }
+    kill(pid, SIGTERM);
+    if (reap_client(pid, L2_CLIENT_EXIT_MS) == 0)
+    {
+        return;
+    }
+    kill(pid, SIGKILL);
+    waitpid(pid, NULL, 0);
+}
+
+int l2_standin_timeline( l2_visible_t isVisible, void *pContext, l2_standin_timeline_t *pTimeline )
+{
+    uint64_t deadline_ns;
+    uint32_t addr = 0;
+    int clientDone = 0;
+    int status = 0;
+    pid_t pid;
+
+    if (!gReady || isVisible == NULL || pTimeline == NULL)
+    {
+        return -1;
+    }
+    memset(pTimeline, 0, sizeof(*pTimeline));
+
+    pTimeline->start_ns = monotonic_ns();
+    deadline_ns = pTimeline->start_ns + L2_ACQUIRE_TIMEOUT_MS * 1000000ULL;
+    pid = start_client();
+    if (pid < 0)
+    {
+        return -1;
+    }
+    while (monotonic_ns() < deadline_ns)
+    {
+        if (isVisible(pContext, &addr))
+        {
+            pTimeline->visible_ns = monotonic_ns();
+            break;
+        }
+        if (!clientDone && waitpid(pid, &status, WNOHANG) == pid)
+        {
+            clientDone = 1;
+            if (!WIFEXITED(status) || WEXITSTATUS(status) != 0)
+            {
+                UT_LOG_INFO("l2: the DHCP client failed, status %d", status);
+                return -1;
+            }
+        }
+        sleep_ns(L2_POLL_INTERVAL_NS);
+    }
+    if (!clientDone)
+    {
+        stop_client(pid, pTimeline->visible_ns != 0);
+    }
+    if (pTimeline->visible_ns == 0)
+    {
+        UT_LOG_INFO("l2: the HAL did not report a new lease within %d ms", L2_ACQUIRE_TIMEOUT_MS);
+        return -1;
+    }
+    pTimeline->addr = addr;
+
+    /* The server logs the ACK after sending it, so the HAL may be quicker than the log */
+    deadline_ns = monotonic_ns() + L2_SERVER_START_MS * 1000000ULL;
+    while (read_exchange(addr, pTimeline->start_ns, pTimeline) != 0)
+    {
+        if (monotonic_ns() >= deadline_ns)
+        {
+            UT_LOG_INFO("l2: the server log has no ACK for the address the HAL reports");
+            return -1;
+        }
+        sleep_ns(L2_POLL_INTERVAL_NS);
+    }
+    return 0;
+}
+
+typedef struct
+{
+    l2_get_ip_t getIp;
+    uint32_t before;
+} ip_change_t;
+
+static int ip_changed( void *pContext, uint32_t *pAddr )
+{
+    ip_change_t *pChange = (ip_change_t *)pContext;
+
+    return pChange->getIp(pAddr) == 0 && *pAddr != 0 && *pAddr != pChange->before;
+}
+
+int l2_standin_acquire( l2_get_ip_t getIp, uint32_t *pAddr, uint64_t *pLatencyNs )
+{
+    l2_standin_timeline_t timeline;
+    ip_change_t change;
+
+    if (getIp == NULL || pAddr == NULL || pLatencyNs == NULL)
+    {
+        return -1;
+    }
+    change.getIp = getIp;
+    if (getIp(&change.before) != 0)
+    {
+        change.before = 0;
+    }
+    if (l2_standin_timeline(ip_changed, &change, &timeline) != 0)
+    {
+        return -1;
+    }
+    *pAddr = timeline.addr;
+    *pLatencyNs = (timeline.visible_ns > timeline.ack_ns) ? timeline.visible_ns - timeline.ack_ns : 0;
+    return 0;
+}
+
+int l2_standin_release( void )
+{
+    const char *pCmd = getenv("DHCP_L2_RELEASE_CMD");
+
+    if (!gReady)
+    {
+        return -1;
+    }
+    if (pCmd != NULL)
+    {
+        return (run_cmd("%s", pCmd) == 0) ? 0 : -1;
+    }
+    if (getenv("DHCP_L2_CLIENT_CMD") == NULL && unlink(gLeasePath) != 0 && errno != ENOENT)
+    {
+        return -1;
+    }
+    return 0;
+}
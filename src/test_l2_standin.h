@@ -0,0 +1,164 @@
+/*
+* If not stated otherwise in this file or this component's LICENSE file the
+* following copyright and licenses apply:*
+* Copyright 2023 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+/**
+* @file test_l2_standin.h
+*
+* DHCPv4 server stand-in environment for the L2 tests.
+*
+* Creates a network namespace joined to the host by a veth pair, runs
+* tools/dhcp_standin as the server inside it, and drives a client on the
+* host end. By default the client is the stand-in's own one-shot client
+* writing the lease file the linux skeleton reads (DHCP4C_ERT_LEASE_FILE);
+* a platform sets DHCP_L2_CLIENT_CMD to its own client instead, bound to
+* the interface its eRouter getters report.
+*
+* On the linux skeleton the stand-in client also announces each lease
+* through tools/sysevent_standin, which l2_standin_setup() starts and points
+* DHCP_SYSEVENT_SOCKET at, so that the lease notification tests have a
+* source of events. A platform client is expected to notify as the platform does.
+*
+* Environment overrides:
+* - DHCP_L2_STANDIN    - stand-in binary, default ./dhcp_standin
+* - DHCP_L2_SYSEVENT   - sysevent stand-in binary, default ./sysevent_standin
+* - DHCP_L2_NETNS      - namespace name, default dhcpl2
+* - DHCP_L2_CLIENT_IF  - host end of the veth pair, default dhcpl2c
+* - DHCP_L2_CLIENT_CMD - shell command acquiring a lease on DHCP_L2_CLIENT_IF
+* - DHCP_L2_RELEASE_CMD - shell command dropping that lease again
+*
+* Needs root (CAP_NET_ADMIN) and the ip utility. When the environment cannot
+* be created, l2_standin_ready() returns 0 and the tests log that they were skipped.
+*/
+
+#ifndef __TEST_L2_STANDIN_H__
+#define __TEST_L2_STANDIN_H__
+
+#include <stdint.h>
+
+#define L2_STANDIN_MAX_DNS  2
+
+/* What the stand-in server offers; addresses in network byte order */
+typedef struct
+{
+    uint32_t server_ip;
+    uint32_t pool_first;                    /* Each DISCOVER gets the next of pool_size addresses */
+    uint32_t pool_size;
+    uint32_t mask;
+    uint32_t router;
+    uint32_t dns[L2_STANDIN_MAX_DNS];
+    int      dns_count;
+    uint32_t lease_time;
+    uint32_t renewal_time;                  /* T1, option 58 */
+    uint32_t rebinding_time;                /* T2, option 59 */
+} l2_standin_offer_t;
+
+/* When one acquisition reached each step, on CLOCK_MONOTONIC in nanoseconds */
+typedef struct
+{
+    uint64_t start_ns;                      /* Client started */
+    uint64_t discover_ns;                   /* Server received the first DISCOVER of the transaction */
+    uint64_t offer_ns;                      /* Server sent the OFFER */
+    uint64_t request_ns;                    /* Server received the REQUEST */
+    uint64_t ack_ns;                        /* Server sent the ACK */
+    uint64_t visible_ns;                    /* The HAL first reported the lease */
+    uint32_t addr;                          /* Address the HAL reported */
+} l2_standin_timeline_t;
+
+/* Reads the eRouter address through the HAL under test */
+typedef int (*l2_get_ip_t)( uint32_t *pAddr );
+
+/* Returns non-zero once the HAL under test reports the new lease, whose address it stores in pAddr */
+typedef int (*l2_visible_t)( void *pContext, uint32_t *pAddr );
+
+/**
+* @brief Creates the namespace and veth pair and starts the server
+*
+* Suitable as a UT suite initialise function: always returns 0, so that an
+* unprivileged run skips the L2 tests instead of failing the suite.
+*/
+int l2_standin_setup( void );
+
+/**
+* @brief Stops the server and removes the namespace, veth pair and files
+*
+* @return 0
+*/
+int l2_standin_cleanup( void );
+
+/**
+* @brief Returns 1 if l2_standin_setup() succeeded
+*/
+int l2_standin_ready( void );
+
+/**
+* @brief Returns what the server offers
+*/
+const l2_standin_offer_t *l2_standin_offer( void );
+
+/**
+* @brief Returns 1 if acquiring a lease also notifies lease subscribers
+*
+* True with DHCP_L2_CLIENT_CMD, and on the linux skeleton once the sysevent stand-in is running.
+*/
+int l2_standin_notifies( void );
+
+/**
+* @brief Acquires a new lease and waits for the HAL to report it
+*
+* Starts the client and polls getIp until it returns an address other than
+* the one it returned before the call, then looks up the server's ACK of
+* that address in its log.
+*
+* @param[in]  getIp      - eRouter address getter of the HAL under test
+* @param[out] pAddr      - Receives the address the HAL reports
+* @param[out] pLatencyNs - Receives the time from the ACK leaving the server
+*                          to the getter first reporting the new address
+*
+* @return 0 on success, -1 if no lease was acquired, the HAL did not report
+*         it within the timeout, or the server never acknowledged that address
+*/
+int l2_standin_acquire( l2_get_ip_t getIp, uint32_t *pAddr, uint64_t *pLatencyNs );
+
+/**
+* @brief Acquires a new lease and records when each step of the exchange happened
+*
+* Starts the client and polls isVisible until it reports the lease, then
+* reads the DISCOVER, OFFER, REQUEST and ACK of the transaction that
+* acknowledged that address from the server log. Server-side times are
+* when the server received or sent each message, so client processing
+* shows up in the start-to-DISCOVER and OFFER-to-REQUEST steps.
+*
+* @param[in]  isVisible - Polled every 100us until it returns non-zero
+* @param[in]  pContext  - Passed to isVisible
+* @param[out] pTimeline - Receives the timestamps
+*
+* @return 0 on success, -1 as l2_standin_acquire()
+*/
+int l2_standin_timeline( l2_visible_t isVisible, void *pContext, l2_standin_timeline_t *pTimeline );
+
+/**
+* @brief Drops the current eRouter lease, so that the next acquisition starts unbound
+*
+* Removes the lease file the linux skeleton reads, or runs DHCP_L2_RELEASE_CMD
+* when that is set.
+*
+* @return 0 on success, otherwise -1
+*/
+int l2_standin_release( void );
+
+#endif /* __TEST_L2_STANDIN_H__ */
@@ -0,0 +1,404 @@
+/*
+* If not stated otherwise in this file or this component's LICENSE file the
+* following copyright and licenses apply:*
+* Copyright 2023 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <errno.h>
+#include <time.h>
+#include <sched.h>
+#include <pthread.h>
+#include <semaphore.h>
+#include <ut_log.h>
+
+/* ut-core's own prefixes, taken from its macros before test_log.h replaces them, so that both modes print the same */
+#define UT_logPrefix(pFile, line, pPrefix, ...)  (pPrefix)
+static const char *const gPrefixes[] =     /* In test_log_level_t order */
+{
+    UT_LOG_DEBUG(""),
+    UT_LOG_INFO(""),
+};
+#undef UT_logPrefix
+
+#include "test_log.h"
+
+#define CACHE_LINE  64
+
+typedef struct
+{
+    uint64_t    seq;                        /* Order across all threads */
+    const char *pFile;
+    int32_t     line;
+    uint8_t     level;
+    char        text[TEST_LOG_LINE_MAX];
+} log_slot_t;
+
+/* One producer, its thread; one consumer at a time, under gWriteLock */
+typedef struct log_ring
+{
+    uint64_t         head __attribute__((aligned(CACHE_LINE)));   /* Lines queued, written by the owner */
+    uint64_t         tail __attribute__((aligned(CACHE_LINE)));   /* Lines written out */
+    int              owned;                                       /* A live thread queues here */
+    struct log_ring *pNext;
+    log_slot_t       slots[TEST_LOG_RING_SLOTS];
+} log_ring_t;
+
+int gTestLogAsync = 0;
+
+static log_ring_t *gRings;
+static uint32_t gRingCount;
+static uint64_t gSequence;
+static uint64_t gNextWrite;     /* Sequence of the next line to write out, under gWriteLock */
+static uint64_t gWaits;
+static uint64_t gTruncated;
+
+static __thread log_ring_t *tRing;
+static pthread_key_t gRingKey;
+static pthread_once_t gRingKeyOnce = PTHREAD_ONCE_INIT;
+
+static pthread_mutex_t gStartLock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_mutex_t gWriteLock = PTHREAD_MUTEX_INITIALIZER;
+static sem_t gWake;
+static int gWriterStarted;
+static int gHooksInstalled;
+
+/* Lets a later thread take over the ring; lines still queued in it go out as usual */
+static void release_ring( void *pRing )
+{
+    __atomic_store_n(&((log_ring_t *)pRing)->owned, 0, __ATOMIC_RELEASE);
+}
+
+static void make_ring_key( void )
+{
+    pthread_key_create(&gRingKey, release_ring);
+}
+
+static log_ring_t *claim_ring( void )
+{
+    log_ring_t *pRing;
+    void *pMemory;
+    int unowned;
+
+    for (pRing = __atomic_load_n(&gRings, __ATOMIC_ACQUIRE); pRing != NULL; pRing = pRing->pNext)
+    {
+        unowned = 0;
+        if (__atomic_compare_exchange_n(&pRing->owned, &unowned, 1, 0, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
+        {
+            break;
+        }
+    }
+    if (pRing == NULL)
+    {
+        if (posix_memalign(&pMemory, CACHE_LINE, sizeof(log_ring_t)) != 0)
+        {
+            return NULL;
+        }
+        pRing = pMemory;
+        memset(pRing, 0, sizeof(*pRing));
+        pRing->owned = 1;
+        pRing->pNext = __atomic_load_n(&gRings, __ATOMIC_RELAXED);
+        while (!__atomic_compare_exchange_n(&gRings, &pRing->pNext, pRing, 1, __ATOMIC_RELEASE, __ATOMIC_RELAXED))
+        {
+        }
+        __atomic_add_fetch(&gRingCount, 1, __ATOMIC_RELAXED);
+    }
+    pthread_once(&gRingKeyOnce, make_ring_key);
+    pthread_setspecific(gRingKey, pRing);
+    tRing = pRing;
+    return pRing;
+}
+
+/*
+ * Writes out the line numbered gNextWrite, if it is below limit and queued. A caller numbers its
+ * line before filling the slot, so the next number can still be on its way while later ones are
+ * queued; the writer then stops rather than let them overtake it.
+ */
+static int write_oldest( uint64_t limit )
+{
+    log_ring_t *pRing;
+    const log_slot_t *pSlot;
+    uint64_t tail;
+
+    if (gNextWrite >= limit)
+    {
+        return 0;
+    }
+    for (pRing = __atomic_load_n(&gRings, __ATOMIC_ACQUIRE); pRing != NULL; pRing = pRing->pNext)
+    {
+        tail = __atomic_load_n(&pRing->tail, __ATOMIC_RELAXED);
+        if (tail != __atomic_load_n(&pRing->head, __ATOMIC_ACQUIRE) &&
+            pRing->slots[tail % TEST_LOG_RING_SLOTS].seq == gNextWrite)
+        {
+            break;
+        }
+    }
+    if (pRing == NULL)
+    {
+        return 0;
+    }
+    pSlot = &pRing->slots[tail % TEST_LOG_RING_SLOTS];
+    UT_logPrefix(pSlot->pFile, pSlot->line, gPrefixes[pSlot->level], "%s", pSlot->text);
+    __atomic_store_n(&pRing->tail, tail + 1, __ATOMIC_RELEASE);
+    gNextWrite++;
+    return 1;
+}
+
+static void *writer_thread( void *pArg )
+{
+    struct timespec deadline;
+
+    (void)pArg;
+    for (;;)
+    {
+        clock_gettime(CLOCK_REALTIME, &deadline);
+        deadline.tv_nsec += TEST_LOG_DRAIN_MS * 1000000L;
+        if (deadline.tv_nsec >= 1000000000L)
+        {
+            deadline.tv_sec++;
+            deadline.tv_nsec -= 1000000000L;
+        }
+        while (sem_timedwait(&gWake, &deadline) != 0 && errno == EINTR)
+        {
+        }
+        pthread_mutex_lock(&gWriteLock);
+        while (write_oldest(UINT64_MAX))
+        {
+        }
+        pthread_mutex_unlock(&gWriteLock);
+    }
+    return NULL;
+}
+
+/* Nothing may be queued across a fork: the child would write the parent's lines again */
+static void before_fork( void )
+{
+    pthread_mutex_lock(&gStartLock);
+    pthread_mutex_lock(&gWriteLock);
+    while (write_oldest(UINT64_MAX))
+    {
+    }
+}
+
+static void after_fork_parent( void )
+{
+    pthread_mutex_unlock(&gWriteLock);
+    pthread_mutex_unlock(&gStartLock);
+}
+
+/* The writer did not come along, nor did threads with a numbered line on its way; the next line starts another */
+static void after_fork_child( void )
+{
+    log_ring_t *pRing;
+
+    for (pRing = gRings; pRing != NULL; pRing = pRing->pNext)
+    {
+        pRing->tail = pRing->head;
+        if (pRing != tRing)
+        {
+            pRing->owned = 0;
+        }
+    }
+    gNextWrite = gSequence;
+    gWriterStarted = 0;
+    pthread_mutex_unlock(&gWriteLock);
+    pthread_mutex_unlock(&gStartLock);
+}
+
+static void flush_at_exit( void )
+{
+    test_log_flush();
+}
+
+static int start_writer( void )
+{
+    pthread_attr_t attr;
+    pthread_t thread;
+    int status = 0;
+
+    pthread_mutex_lock(&gStartLock);
+    if (!gWriterStarted)
+    {
+        if (!gHooksInstalled)
+        {
+            pthread_atfork(before_fork, after_fork_parent, after_fork_child);
+            atexit(flush_at_exit);
+            gHooksInstalled = 1;
+        }
+        sem_init(&gWake, 0, 0);
+        pthread_attr_init(&attr);
+        pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+        status = (pthread_create(&thread, &attr, writer_thread, NULL) == 0) ? 0 : -1;
+        pthread_attr_destroy(&attr);
+        __atomic_store_n(&gWriterStarted, (status == 0), __ATOMIC_RELEASE);
+    }
+    pthread_mutex_unlock(&gStartLock);
+    return status;
+}
+
+int test_log_parse_args( int *pArgc, char **argv )
+{
+    const char *pMode = NULL;
+    int out = 1;
+    int i;
+
+    for (i = 1; i < *pArgc; i++)
+    {
+        if (strncmp(argv[i], "--log=", 6) == 0)
+        {
+            pMode = &argv[i][6];
+        }
+        else if (strcmp(argv[i], "--log") == 0 && i + 1 < *pArgc)
+        {
+            pMode = argv[++i];
+        }
+        else
+        {
+            argv[out++] = argv[i];
+        }
+    }
+    argv[out] = NULL;
+    *pArgc = out;
+
+    if (pMode == NULL || strcmp(pMode, "sync") == 0)
+    {
+        return test_log_set_mode(TEST_LOG_SYNC);
+    }
+    if (strcmp(pMode, "async") == 0)
+    {
+        return test_log_set_mode(TEST_LOG_ASYNC);
+    }
+    fprintf(stderr, "test_log: unknown --log mode %s, expected sync or async\n", pMode);
+    return -1;
+}
+
+int test_log_set_mode( test_log_mode_t mode )
+{
+    if (mode == TEST_LOG_ASYNC)
+    {
+        if (!__atomic_load_n(&gWriterStarted, __ATOMIC_ACQUIRE) && start_writer() != 0)
+        {
+            return -1;
+        }
+        __atomic_store_n(&gTestLogAsync, 1, __ATOMIC_RELAXED);
+        return 0;
+    }
+    __atomic_store_n(&gTestLogAsync, 0, __ATOMIC_RELAXED);
+    test_log_flush();
+    return 0;
+}
+
+test_log_mode_t test_log_get_mode( void )
+{
+    return __atomic_load_n(&gTestLogAsync, __ATOMIC_RELAXED) ? TEST_LOG_ASYNC : TEST_LOG_SYNC;
+}
+
+const char *test_log_prefix( test_log_level_t level )
+{
+    return gPrefixes[((unsigned)level < TEST_LOG_LEVEL_COUNT) ? level : TEST_LOG_LEVEL_INFO];
+}
+
+void test_log_enqueue( const char *pFile, int line, test_log_level_t level, const char *pFormat, ... )
+{
+    log_ring_t *pRing = tRing;
+    log_slot_t *pSlot;
+    uint64_t head;
+    va_list args;
+    int length;
+
+    if ((unsigned)level >= TEST_LOG_LEVEL_COUNT)
+    {
+        level = TEST_LOG_LEVEL_INFO;
+    }
+    /* After a fork, or if the writer or a ring cannot be had, the line is written here */
+    if ((!__atomic_load_n(&gWriterStarted, __ATOMIC_ACQUIRE) && start_writer() != 0) ||
+        (pRing == NULL && (pRing = claim_ring()) == NULL))
+    {
+        char text[TEST_LOG_LINE_MAX];
+
+        va_start(args, pFormat);
+        vsnprintf(text, sizeof(text), pFormat, args);
+        va_end(args);
+        UT_logPrefix(pFile, line, gPrefixes[level], "%s", text);
+        return;
+    }
+
+    head = pRing->head;
+    if (head - __atomic_load_n(&pRing->tail, __ATOMIC_ACQUIRE) == TEST_LOG_RING_SLOTS)
+    {
+        __atomic_add_fetch(&gWaits, 1, __ATOMIC_RELAXED);
+        sem_post(&gWake);
+        while (head - __atomic_load_n(&pRing->tail, __ATOMIC_ACQUIRE) == TEST_LOG_RING_SLOTS)
+        {
+            sched_yield();
+        }
+    }
+
+    pSlot = &pRing->slots[head % TEST_LOG_RING_SLOTS];
+    pSlot->seq = __atomic_fetch_add(&gSequence, 1, __ATOMIC_RELAXED);
+    pSlot->pFile = pFile;
+    pSlot->line = line;
+    pSlot->level = (uint8_t)level;
+    va_start(args, pFormat);
+    length = vsnprintf(pSlot->text, sizeof(pSlot->text), pFormat, args);
+    va_end(args);
+    if (length >= (int)sizeof(pSlot->text))
+    {
+        __atomic_add_fetch(&gTruncated, 1, __ATOMIC_RELAXED);
+    }
+    __atomic_store_n(&pRing->head, head + 1, __ATOMIC_RELEASE);
+}
+
+void test_log_flush( void )
+{
+    uint64_t limit;
+
+    if (!__atomic_load_n(&gWriterStarted, __ATOMIC_ACQUIRE))
+    {
+        return;
+    }
+    /* Lines queued from here on are left to the writer, so a busy logger cannot hold the caller */
+    limit = __atomic_load_n(&gSequence, __ATOMIC_RELAXED);
+    pthread_mutex_lock(&gWriteLock);
+    while (gNextWrite < limit)
+    {
+        if (!write_oldest(limit))
+        {
+            /* Another thread has numbered a line below the limit and is still filling its slot */
+            pthread_mutex_unlock(&gWriteLock);
+            sched_yield();
+            pthread_mutex_lock(&gWriteLock);
+        }
+    }
+    pthread_mutex_unlock(&gWriteLock);
+}
+
+void test_log_stats( test_log_stats_t *pStats )
+{
+    const log_ring_t *pRing;
+
+    memset(pStats, 0, sizeof(*pStats));
+    for (pRing = __atomic_load_n(&gRings, __ATOMIC_ACQUIRE); pRing != NULL; pRing = pRing->pNext)
+    {
+        pStats->queued += __atomic_load_n(&pRing->head, __ATOMIC_ACQUIRE);
+        pStats->written += __atomic_load_n(&pRing->tail, __ATOMIC_ACQUIRE);
+    }
+    pStats->waits = __atomic_load_n(&gWaits, __ATOMIC_RELAXED);
+    pStats->truncated = __atomic_load_n(&gTruncated, __ATOMIC_RELAXED);
+    pStats->rings = __atomic_load_n(&gRingCount, __ATOMIC_RELAXED);
+}
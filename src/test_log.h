@@ -0,0 +1,186 @@
+/*
+* If not stated otherwise in this file or this component's LICENSE file the
+* following copyright and licenses apply:*
+* Copyright 2023 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+/**
+* @file test_log.h
+*
+* Asynchronous backend for UT_LOG_DEBUG and UT_LOG_INFO, and a build that
+* strips UT_LOG_DEBUG.
+*
+* A test file includes this after ut_log.h, and its UT_LOG_DEBUG and
+* UT_LOG_INFO calls then go one of two ways, chosen at run time:
+*
+* - sync (the default): the same UT_logPrefix() call ut-core makes, written
+*   out before the macro returns.
+* - async ("--log async"): the line is formatted into a ring of the calling
+*   thread and a background thread writes it out through UT_logPrefix(). The
+*   caller never takes a lock or makes a system call unless its ring is
+*   full, in which case it waits for the writer.
+*
+* Async lines come out in the order they were queued, across threads as
+* well as within one: a line numbered while another thread is still filling
+* an earlier one waits for it. They keep the same prefix, file and line, but
+* come out later than they were logged and cut to TEST_LOG_LINE_MAX - 1
+* characters. The harness flushes them at the end of every test, so they
+* never run into the next test's output. Warnings and errors stay
+* synchronous.
+*
+* Built with TEST_LOG_STRIP_DEBUG (make nodebug), UT_LOG_DEBUG compiles to
+* nothing: neither the call nor its arguments are evaluated, though the
+* compiler still checks them against the format. A test must therefore not
+* rely on a side effect of a UT_LOG_DEBUG argument.
+*/
+
+#ifndef __TEST_LOG_H__
+#define __TEST_LOG_H__
+
+#include <stdint.h>
+#include <ut_log.h>
+
+#define TEST_LOG_RING_SLOTS    256     /*!< Lines a thread can have queued */
+#define TEST_LOG_LINE_MAX      240     /*!< Bytes of one queued line, terminator included */
+#define TEST_LOG_DRAIN_MS      2       /*!< Longest the writer sleeps while lines are queued */
+
+/**
+* @brief Where UT_LOG_DEBUG and UT_LOG_INFO lines go
+*/
+typedef enum
+{
+    TEST_LOG_SYNC = 0,    /*!< Written by the caller */
+    TEST_LOG_ASYNC        /*!< Queued, written by a background thread */
+} test_log_mode_t;
+
+/**
+* @brief Levels the backend handles
+*/
+typedef enum
+{
+    TEST_LOG_LEVEL_DEBUG = 0,
+    TEST_LOG_LEVEL_INFO,
+    TEST_LOG_LEVEL_COUNT
+} test_log_level_t;
+
+/**
+* @brief Counters of the async backend, since the start of the process
+*/
+typedef struct
+{
+    uint64_t queued;      /*!< Lines queued */
+    uint64_t written;     /*!< Lines written out */
+    uint64_t waits;       /*!< Lines whose caller found its ring full and waited */
+    uint64_t truncated;   /*!< Lines cut to TEST_LOG_LINE_MAX - 1 characters */
+    uint32_t rings;       /*!< Rings allocated, one per thread that logged at a time */
+} test_log_stats_t;
+
+/** Non-zero in async mode; read by the macros below */
+extern int gTestLogAsync;
+
+/**
+* @brief Takes "--log sync|async" (also --log=MODE) out of the command line and applies it
+*
+* @param[in,out] pArgc - Argument count, reduced by the options removed
+* @param[in,out] argv  - Arguments, compacted in place
+*
+* @return 0 on success, -1 on an unknown mode or if the writer thread cannot start
+*/
+int test_log_parse_args( int *pArgc, char **argv );
+
+/**
+* @brief Switches mode
+*
+* Lines already queued are written out before switching to sync.
+*
+* @return 0 on success, -1 if the writer thread cannot start
+*/
+int test_log_set_mode( test_log_mode_t mode );
+
+/**
+* @brief Returns the mode in use
+*/
+test_log_mode_t test_log_get_mode( void );
+
+/**
+* @brief Returns the prefix ut-core gives a level's lines
+*/
+const char *test_log_prefix( test_log_level_t level );
+
+/**
+* @brief Queues a line for the writer thread
+*
+* The line is formatted now, so the arguments need not outlive the call.
+*
+* @param[in] pFile   - Source file, which must stay valid, as __FILE__ does
+* @param[in] line    - Source line
+* @param[in] level   - Level of the line
+* @param[in] pFormat - printf format
+*/
+void test_log_enqueue( const char *pFile, int line, test_log_level_t level, const char *pFormat, ... )
+    __attribute__((format(printf, 4, 5)));
+
+/**
+* @brief Writes out every line queued before the call, then returns
+*
+* A line another thread began to queue before the call is waited for.
+* Does nothing in sync mode or before the first async line.
+*/
+void test_log_flush( void );
+
+/**
+* @brief Reads the async counters
+*/
+void test_log_stats( test_log_stats_t *pStats );
+
+/**
+* @brief Logs a line at a level through the backend in use
+*/
+#define TEST_LOG(level, format, ...) \
+    do \
+    { \
+        if (__atomic_load_n(&gTestLogAsync, __ATOMIC_RELAXED)) \
+        { \
+            test_log_enqueue(__FILE__, __LINE__, (level), format, ## __VA_ARGS__); \
+        } \
+        else \
+        { \
+            UT_logPrefix(__FILE__, __LINE__, test_log_prefix(level), format, ## __VA_ARGS__); \
+        } \
+    } while (0)
+
+#undef UT_LOG_DEBUG
+#undef UT_LOG_INFO
+#ifdef TEST_LOG_STRIP_DEBUG
+/* Never called; referencing the arguments here keeps them type-checked and their variables used */
+static inline void test_log_discard( const char *pFormat, ... ) __attribute__((format(printf, 1, 2)));
+static inline void test_log_discard( const char *pFormat, ... )
+{
+    (void)pFormat;
+}
+#define UT_LOG_DEBUG(format, ...) \
+    do \
+    { \
+        if (0) \
+        { \
+            test_log_discard(format, ## __VA_ARGS__); \
+        } \
+    } while (0)
+#else
+#define UT_LOG_DEBUG(format, ...)  TEST_LOG(TEST_LOG_LEVEL_DEBUG, format, ## __VA_ARGS__)
+#endif
+#define UT_LOG_INFO(format, ...)   TEST_LOG(TEST_LOG_LEVEL_INFO, format, ## __VA_ARGS__)
+
+#endif /* __TEST_LOG_H__ */
@@ -23,6 +23,10 @@ extern int test_dhcp4cApi_hal_l1_register(void);
 #ifdef DHCPV4C_API
 extern int test_dhcpv4c_api_hal_l1_register(void);
 #endif
+/* Components of the linux skeletons, which a vendor HAL does not have */
+#ifdef BUILD_LINUX
+extern int test_skeleton_l1_register(void);
+#endif
 
 int register_hal_l1_tests( void )
 {
@@ -32,6 +36,29 @@ int register_hal_l1_tests( void )
 #endif
 #ifdef DHCPV4C_API
     registerstatus |= test_dhcpv4c_api_hal_l1_register();
+#endif
+#ifdef BUILD_LINUX
+    registerstatus |= test_skeleton_l1_register();
+#endif
+    return registerstatus;
+}
+
+/* L2 Testing Functions */
+#ifdef DHCP4CAPI
+extern int test_dhcp4cApi_hal_l2_register(void);
+#endif
+#ifdef DHCPV4C_API
+extern int test_dhcpv4c_api_hal_l2_register(void);
+#endif
+
+int register_hal_l2_tests( void )
+{
+    int registerstatus=0;
+#ifdef DHCP4CAPI
+    registerstatus |= test_dhcp4cApi_hal_l2_register();
+#endif
+#ifdef DHCPV4C_API
+    registerstatus |= test_dhcpv4c_api_hal_l2_register();
 #endif
     return registerstatus;
-}
\ No newline at end of file
+}
@@ -0,0 +1,581 @@
+/*
+* If not stated otherwise in this file or this component's LICENSE file the
+* following copyright and licenses apply:*
+* Copyright 2023 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include "test_results.h"
+
+#define RESULTS_RECORD_MAX   8192   /* Bounds a record: names, message and values are all capped below */
+#define RESULTS_VALUES_MAX   2048   /* Bytes of the "values" object */
+#define RESULTS_TEXT_MAX     256    /* Characters kept of a name or message */
+
+typedef struct
+{
+    char  *pText;
+    size_t size;
+    size_t used;
+} text_t;
+
+/* One record read back for the JUnit file */
+typedef struct
+{
+    char  *pSuite;
+    char  *pTest;
+    char  *pStatus;
+    char  *pMessage;
+    double duration_ms;
+} junit_case_t;
+
+static int gFd = -1;                /* JSON Lines, a temporary file when only JUnit was asked for */
+static FILE *gpScratch;
+static const char *gpJunitPath;
+static int gWriteFailed;
+
+static char gBuffer[TEST_RESULTS_BUFFER];
+static size_t gBuffered;
+
+static int gGroup;
+static int gId;
+static int gHaveId;
+static char gValues[RESULTS_VALUES_MAX];
+static text_t gValueText = { gValues, sizeof(gValues), 0 };
+
+/* Appends formatted text; on overflow leaves the text as it was and returns -1 */
+static int text_printf( text_t *pText, const char *pFormat, ... )
+{
+    va_list args;
+    int length;
+
+    va_start(args, pFormat);
+    length = vsnprintf(&pText->pText[pText->used], pText->size - pText->used, pFormat, args);
+    va_end(args);
+    if (length < 0 || (size_t)length >= pText->size - pText->used)
+    {
+        pText->pText[pText->used] = '\0';
+        return -1;
+    }
+    pText->used += (size_t)length;
+    return 0;
+}
+
+/* Appends pValue as a JSON string, cut at RESULTS_TEXT_MAX characters */
+static int text_json_string( text_t *pText, const char *pValue )
+{
+    size_t start = pText->used;
+    size_t i;
+    int result = text_printf(pText, "\"");
+
+    for (i = 0; result == 0 && pValue[i] != '\0' && i < RESULTS_TEXT_MAX; i++)
+    {
+        unsigned char c = (unsigned char)pValue[i];
+
+        if (c == '"' || c == '\\')
+        {
+            result = text_printf(pText, "\\%c", c);
+        }
+        else if (c == '\n')
+        {
+            result = text_printf(pText, "\\n");
+        }
+        else if (c == '\t')
+        {
+            result = text_printf(pText, "\\t");
+        }
+        else if (c < 0x20)
+        {
+            result = text_printf(pText, "\\u%04x", c);
+        }
+        else
+        {
+            result = text_printf(pText, "%c", c);
+        }
+    }
+    if (result == 0)
+    {
+        result = text_printf(pText, "\"");
+    }
+    if (result != 0)
+    {
+        pText->used = start;
+        pText->pText[start] = '\0';
+    }
+    return result;
+}
+
+static void write_all( const char *pData, size_t length )
+{
+    ssize_t written;
+
+    while (length > 0)
+    {
+        written = write(gFd, pData, length);
+        if (written < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (written <= 0)
+        {
+            gWriteFailed = 1;
+            return;
+        }
+        pData += written;
+        length -= (size_t)written;
+    }
+}
+
+/* Matches "--name value" or "--name=value"; returns the number of arguments used, 0 if argv[i] is not the option */
+static int match_option( const char *pName, int argc, char **argv, int i, const char **ppValue )
+{
+    size_t length = strlen(pName);
+
+    if (strncmp(argv[i], pName, length) != 0)
+    {
+        return 0;
+    }
+    if (argv[i][length] == '=')
+    {
+        *ppValue = &argv[i][length + 1];
+        return 1;
+    }
+    if (argv[i][length] == '\0' && i + 1 < argc)
+    {
+        *ppValue = argv[i + 1];
+        return 2;
+    }
+    return 0;
+}
+
+int test_results_parse_args( int *pArgc, char **argv )
+{
+    const char *pJsonlPath = NULL;
+    int used;
+    int out = 1;
+    int i;
+
+    for (i = 1; i < *pArgc; i += (used > 0) ? used : 1)
+    {
+        used = match_option("--results-jsonl", *pArgc, argv, i, &pJsonlPath);
+        if (used == 0)
+        {
+            used = match_option("--results-junit", *pArgc, argv, i, &gpJunitPath);
+        }
+        if (used == 0)
+        {
+            argv[out++] = argv[i];
+        }
+    }
+    argv[out] = NULL;
+    *pArgc = out;
+
+    /* Appending keeps each write whole when the runner's children share the file */
+    if (pJsonlPath != NULL)
+    {
+        gFd = open(pJsonlPath, O_RDWR | O_CREAT | O_TRUNC | O_APPEND, 0644);
+    }
+    else if (gpJunitPath != NULL)
+    {
+        gpScratch = tmpfile();
+        gFd = (gpScratch != NULL) ? fileno(gpScratch) : -1;
+        if (gFd >= 0 && fcntl(gFd, F_SETFL, fcntl(gFd, F_GETFL) | O_APPEND) != 0)
+        {
+            gFd = -1;
+        }
+    }
+    else
+    {
+        return 0;
+    }
+    if (gFd < 0)
+    {
+        fprintf(stderr, "results: cannot create %s: %s\n", (pJsonlPath != NULL) ? pJsonlPath : "a temporary file",
+                strerror(errno));
+        gpJunitPath = NULL;
+        return -1;
+    }
+    return 0;
+}
+
+void test_results_begin( void )
+{
+    gHaveId = 0;
+    gValueText.used = 0;
+    gValues[0] = '\0';
+}
+
+void test_results_set_id( int group, int id )
+{
+    gGroup = group;
+    gId = id;
+    gHaveId = 1;
+}
+
+void test_results_add_value( const char *pKey, const char *pFormat, ... )
+{
+    char value[RESULTS_TEXT_MAX + 1];
+    size_t start = gValueText.used;
+    va_list args;
+
+    if (gFd < 0)
+    {
+        return;
+    }
+    va_start(args, pFormat);
+    vsnprintf(value, sizeof(value), pFormat, args);
+    va_end(args);
+    if ((start > 0 && text_printf(&gValueText, ",") != 0) ||
+        text_json_string(&gValueText, pKey) != 0 ||
+        text_printf(&gValueText, ":") != 0 ||
+        text_json_string(&gValueText, value) != 0)
+    {
+        gValueText.used = start;
+        gValues[start] = '\0';
+    }
+}
+
+void test_results_end( const char *pSuite, const char *pTest, const char *pStatus, const char *pMessage, uint64_t elapsed_ns )
+{
+    char record[RESULTS_RECORD_MAX];
+    text_t text = { record, sizeof(record), 0 };
+
+    if (gFd < 0)
+    {
+        return;
+    }
+    text_printf(&text, "{\"suite\":");
+    text_json_string(&text, pSuite);
+    text_printf(&text, ",\"test\":");
+    text_json_string(&text, pTest);
+    if (gHaveId)
+    {
+        text_printf(&text, ",\"group\":%d,\"id\":%d", gGroup, gId);
+    }
+    else
+    {
+        text_printf(&text, ",\"group\":null,\"id\":null");
+    }
+    text_printf(&text, ",\"status\":");
+    text_json_string(&text, pStatus);
+    text_printf(&text, ",\"duration_ms\":%.6f", (double)elapsed_ns / 1e6);
+    if (pMessage != NULL)
+    {
+        text_printf(&text, ",\"message\":");
+        text_json_string(&text, pMessage);
+    }
+    text_printf(&text, ",\"values\":{%s}}\n", gValues);
+
+    if (gBuffered + text.used > sizeof(gBuffer))
+    {
+        test_results_flush();
+    }
+    memcpy(&gBuffer[gBuffered], record, text.used);
+    gBuffered += text.used;
+    test_results_begin();
+}
+
+void test_results_flush( void )
+{
+    if (gFd >= 0 && gBuffered > 0)
+    {
+        write_all(gBuffer, gBuffered);
+    }
+    gBuffered = 0;
+}
+
+/* Finds "key": in a record we wrote and returns what follows it */
+static const char *json_field( const char *pRecord, const char *pKey )
+{
+    char pattern[32];
+    const char *pFound;
+
+    snprintf(pattern, sizeof(pattern), "\"%s\":", pKey);
+    pFound = strstr(pRecord, pattern);
+    return (pFound != NULL) ? pFound + strlen(pattern) : NULL;
+}
+
+/* Decodes a JSON string as text_json_string() wrote it */
+static char *json_string( const char *pRecord, const char *pKey )
+{
+    const char *pIn = json_field(pRecord, pKey);
+    char hex[3] = { 0 };
+    char *pOut;
+    char *pValue;
+
+    if (pIn == NULL || *pIn != '"' || (pValue = malloc(strlen(pIn))) == NULL)
+    {
+        return NULL;
+    }
+    pOut = pValue;
+    for (pIn++; *pIn != '\0' && *pIn != '"'; pIn++)
+    {
+        if (*pIn != '\\')
+        {
+            *pOut++ = *pIn;
+            continue;
+        }
+        pIn++;
+        if (*pIn == 'n')
+        {
+            *pOut++ = '\n';
+        }
+        else if (*pIn == 't')
+        {
+            *pOut++ = '\t';
+        }
+        else if (*pIn == 'u' && strlen(pIn) >= 5)
+        {
+            /* Only control characters are written this way: \u00XX */
+            hex[0] = pIn[3];
+            hex[1] = pIn[4];
+            *pOut++ = (char)strtol(hex, NULL, 16);
+            pIn += 4;
+        }
+        else if (*pIn != '\0')
+        {
+            *pOut++ = *pIn;
+        }
+        else
+        {
+            break;
+        }
+    }
+    *pOut = '\0';
+    return pValue;
+}
+
+static void xml_attribute( FILE *pFile, const char *pName, const char *pValue )
+{
+    fprintf(pFile, " %s=\"", pName);
+    for (; *pValue != '\0'; pValue++)
+    {
+        switch (*pValue)
+        {
+            case '&':  fputs("&amp;", pFile);  break;
+            case '<':  fputs("&lt;", pFile);   break;
+            case '>':  fputs("&gt;", pFile);   break;
+            case '"':  fputs("&quot;", pFile); break;
+            case '\n': fputs("&#10;", pFile);  break;
+            case '\t': fputs("&#9;", pFile);   break;
+            default:
+                /* XML 1.0 has no representation for the other control characters */
+                fputc(((unsigned char)*pValue < 0x20) ? '?' : *pValue, pFile);
+                break;
+        }
+    }
+    fputc('"', pFile);
+}
+
+/* Reads back every record of the run, including those written by the runner's children */
+static junit_case_t *read_records( uint32_t *pCount )
+{
+    junit_case_t *pCases = NULL;
+    junit_case_t *pGrown;
+    const char *pDuration;
+    struct stat info;
+    char *pData;
+    char *pLine;
+    char *pEnd;
+    uint32_t count = 0;
+    ssize_t got;
+    size_t total = 0;
+
+    *pCount = 0;
+    if (fstat(gFd, &info) != 0 || (pData = malloc((size_t)info.st_size + 1)) == NULL)
+    {
+        return NULL;
+    }
+    while (total < (size_t)info.st_size &&
+           (got = pread(gFd, &pData[total], (size_t)info.st_size - total, (off_t)total)) > 0)
+    {
+        total += (size_t)got;
+    }
+    pData[total] = '\0';
+
+    for (pLine = pData; *pLine != '\0'; pLine = pEnd + 1)
+    {
+        pEnd = strchr(pLine, '\n');
+        if (pEnd == NULL)
+        {
+            break;
+        }
+        *pEnd = '\0';
+        pGrown = realloc(pCases, (count + 1) * sizeof(*pCases));
+        if (pGrown == NULL)
+        {
+            break;
+        }
+        pCases = pGrown;
+        pCases[count].pSuite = json_string(pLine, "suite");
+        pCases[count].pTest = json_string(pLine, "test");
+        pCases[count].pStatus = json_string(pLine, "status");
+        pCases[count].pMessage = json_string(pLine, "message");
+        pDuration = json_field(pLine, "duration_ms");
+        pCases[count].duration_ms = (pDuration != NULL) ? strtod(pDuration, NULL) : 0.0;
+        if (pCases[count].pSuite == NULL || pCases[count].pTest == NULL || pCases[count].pStatus == NULL)
+        {
+            free(pCases[count].pSuite);
+            free(pCases[count].pTest);
+            free(pCases[count].pStatus);
+            free(pCases[count].pMessage);
+            continue;
+        }
+        count++;
+    }
+    free(pData);
+    *pCount = count;
+    return pCases;
+}
+
+static void write_junit_suite( FILE *pFile, const junit_case_t *pCases, uint32_t count, const char *pSuite )
+{
+    uint32_t tests = 0;
+    uint32_t failures = 0;
+    uint32_t errors = 0;
+    double time_ms = 0.0;
+    uint32_t i;
+
+    for (i = 0; i < count; i++)
+    {
+        if (strcmp(pCases[i].pSuite, pSuite) == 0)
+        {
+            tests++;
+            failures += (strcmp(pCases[i].pStatus, "fail") == 0 || strcmp(pCases[i].pStatus, "timeout") == 0);
+            errors += (strcmp(pCases[i].pStatus, "crash") == 0);
+            time_ms += pCases[i].duration_ms;
+        }
+    }
+    fprintf(pFile, "  <testsuite");
+    xml_attribute(pFile, "name", pSuite);
+    fprintf(pFile, " tests=\"%u\" failures=\"%u\" errors=\"%u\" time=\"%.6f\">\n", tests, failures, errors, time_ms / 1e3);
+    for (i = 0; i < count; i++)
+    {
+        if (strcmp(pCases[i].pSuite, pSuite) != 0)
+        {
+            continue;
+        }
+        fprintf(pFile, "    <testcase");
+        xml_attribute(pFile, "classname", pSuite);
+        xml_attribute(pFile, "name", pCases[i].pTest);
+        fprintf(pFile, " time=\"%.6f\"", pCases[i].duration_ms / 1e3);
+        if (strcmp(pCases[i].pStatus, "pass") == 0)
+        {
+            fprintf(pFile, "/>\n");
+            continue;
+        }
+        fprintf(pFile, ">\n      <%s", (strcmp(pCases[i].pStatus, "crash") == 0) ? "error" : "failure");
+        xml_attribute(pFile, "type", pCases[i].pStatus);
+        xml_attribute(pFile, "message", (pCases[i].pMessage != NULL) ? pCases[i].pMessage : pCases[i].pStatus);
+        fprintf(pFile, "/>\n    </testcase>\n");
+    }
+    fprintf(pFile, "  </testsuite>\n");
+}
+
+static int write_junit( void )
+{
+    junit_case_t *pCases;
+    uint32_t count;
+    uint32_t failures = 0;
+    uint32_t errors = 0;
+    double time_ms = 0.0;
+    uint32_t i;
+    uint32_t j;
+    FILE *pFile;
+    int result;
+
+    pFile = fopen(gpJunitPath, "w");
+    if (pFile == NULL)
+    {
+        fprintf(stderr, "results: cannot create %s: %s\n", gpJunitPath, strerror(errno));
+        return -1;
+    }
+    setvbuf(pFile, NULL, _IOFBF, TEST_RESULTS_BUFFER);
+    pCases = read_records(&count);
+    for (i = 0; i < count; i++)
+    {
+        failures += (strcmp(pCases[i].pStatus, "fail") == 0 || strcmp(pCases[i].pStatus, "timeout") == 0);
+        errors += (strcmp(pCases[i].pStatus, "crash") == 0);
+        time_ms += pCases[i].duration_ms;
+    }
+
+    fprintf(pFile, "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n");
+    fprintf(pFile, "<testsuites tests=\"%u\" failures=\"%u\" errors=\"%u\" time=\"%.6f\">\n", count, failures, errors,
+            time_ms / 1e3);
+    /* Parallel runs interleave suites; each is written once, where it first appears */
+    for (i = 0; i < count; i++)
+    {
+        for (j = 0; j < i && strcmp(pCases[j].pSuite, pCases[i].pSuite) != 0; j++)
+        {
+        }
+        if (j == i)
+        {
+            write_junit_suite(pFile, pCases, count, pCases[i].pSuite);
+        }
+    }
+    fprintf(pFile, "</testsuites>\n");
+
+    for (i = 0; i < count; i++)
+    {
+        free(pCases[i].pSuite);
+        free(pCases[i].pTest);
+        free(pCases[i].pStatus);
+        free(pCases[i].pMessage);
+    }
+    free(pCases);
+    result = (ferror(pFile) != 0) ? -1 : 0;
+    if (fclose(pFile) != 0)
+    {
+        result = -1;
+    }
+    return result;
+}
+
+int test_results_finish( void )
+{
+    int result = 0;
+
+    if (gFd < 0)
+    {
+        return 0;
+    }
+    test_results_flush();
+    if (gWriteFailed)
+    {
+        fprintf(stderr, "results: writing the JSON Lines records failed\n");
+        result = -1;
+    }
+    if (gpJunitPath != NULL && write_junit() != 0)
+    {
+        result = -1;
+    }
+    if (gpScratch != NULL)
+    {
+        fclose(gpScratch);
+    }
+    else
+    {
+        close(gFd);
+    }
+    gpScratch = NULL;
+    gFd = -1;
+    return result;
+}
@@ -0,0 +1,111 @@
+/*
+* If not stated otherwise in this file or this component's LICENSE file the
+* following copyright and licenses apply:*
+* Copyright 2023 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+/**
+* @file test_results.h
+*
+* Machine-readable test results: JSON Lines while the run goes, JUnit XML at the end.
+*
+* The harness (test_harness.h) writes one record per test call as it
+* returns, in this fixed form:
+*
+* {"suite":"...","test":"...","group":1,"id":5,"status":"pass","duration_ms":0.012,"message":"...","values":{"status":"0",...}}
+*
+* status is "pass", "fail" or "timeout", or "crash" for a test whose child
+* process the parallel runner saw die. group and id are what the test gave
+* test_results_set_id(), or null. message, present on failures only, is the
+* first failed assertion. values holds what the test passed to
+* test_results_add_value(), as strings.
+*
+* Records are gathered in memory and written in whole records, in blocks of
+* up to TEST_RESULTS_BUFFER bytes, so the writes do not land inside timed test
+* calls on slow storage. The file is opened for appending, which keeps records
+* from the children of a parallel run whole.
+*/
+
+#ifndef __TEST_RESULTS_H__
+#define __TEST_RESULTS_H__
+
+#include <stdint.h>
+
+#define TEST_RESULTS_BUFFER  65536   /*!< Bytes of records held before a write */
+
+/**
+* @brief Takes the results options out of the command line and opens the outputs
+*
+* Recognises "--results-jsonl PATH" and "--results-junit PATH" (also as
+* --results-jsonl=PATH and --results-junit=PATH) and removes them, so that
+* the remaining arguments can be passed to UT_init() unchanged. With neither
+* option the other calls do nothing.
+*
+* @param[in,out] pArgc - Argument count, reduced by the options removed
+* @param[in,out] argv  - Arguments, compacted in place
+*
+* @return 0 on success, -1 if an output cannot be created
+*/
+int test_results_parse_args( int *pArgc, char **argv );
+
+/**
+* @brief Starts the record of a test call, dropping what the previous one gathered
+*/
+void test_results_begin( void );
+
+/**
+* @brief Sets the Test Group and Test Case ID of the running test
+*
+* @param[in] group - gTestGroup of the test's file
+* @param[in] id    - gTestID of the test
+*/
+void test_results_set_id( int group, int id );
+
+/**
+* @brief Adds a value the running test observed, such as a getter's output
+*
+* Values past what a record holds are dropped.
+*
+* @param[in] pKey    - Name of the value
+* @param[in] pFormat - printf() format of the value
+*/
+void test_results_add_value( const char *pKey, const char *pFormat, ... );
+
+/**
+* @brief Ends the record of a test call
+*
+* @param[in] pSuite     - Suite name
+* @param[in] pTest      - Test name
+* @param[in] pStatus    - "pass", "fail", "timeout" or "crash"
+* @param[in] pMessage   - Why the test did not pass, or NULL
+* @param[in] elapsed_ns - Duration of the call
+*/
+void test_results_end( const char *pSuite, const char *pTest, const char *pStatus, const char *pMessage, uint64_t elapsed_ns );
+
+/**
+* @brief Writes the records held in memory
+*
+* A forked child must call this before it exits.
+*/
+void test_results_flush( void );
+
+/**
+* @brief Writes the remaining records and, if requested, the JUnit XML file
+*
+* @return 0 on success, -1 if an output could not be written
+*/
+int test_results_finish( void );
+
+#endif /* __TEST_RESULTS_H__ */
@@ -0,0 +1,383 @@
+/*
+* If not stated otherwise in this file or this component's LICENSE file the
+* following copyright and licenses apply:*
+* Copyright 2023 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <signal.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <CUnit/CUnit.h>
+#include "test_runner.h"
+#include "test_harness.h"
+#include "test_results.h"
+
+#define RUNNER_POLL_NS  1000000L    /* 1ms between checks for finished or overdue children */
+
+typedef enum
+{
+    UNIT_PENDING = 0,
+    UNIT_RUNNING,
+    UNIT_PASS,
+    UNIT_FAIL,
+    UNIT_CRASH,
+    UNIT_TIMEOUT
+} unit_state_t;
+
+/* A test, or a whole suite when its tests share fixtures, run in one child */
+typedef struct
+{
+    CU_pSuite    pSuite;
+    CU_pTest     pTest;             /* NULL to run the whole suite */
+    uint32_t     tests;
+    unit_state_t state;
+    pid_t        pid;
+    int          signal;
+    int          overdue;
+    FILE        *pOutput;
+    uint64_t     start_ns;
+    uint64_t     elapsed_ns;
+} test_unit_t;
+
+static uint64_t monotonic_ns( void )
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/* Matches "--name value" or "--name=value"; returns the number of arguments used, 0 if argv[i] is not the option */
+static int match_option( const char *pName, int argc, char **argv, int i, uint32_t *pValue )
+{
+    size_t length = strlen(pName);
+
+    if (strncmp(argv[i], pName, length) != 0)
+    {
+        return 0;
+    }
+    if (argv[i][length] == '=')
+    {
+        *pValue = (uint32_t)strtoul(&argv[i][length + 1], NULL, 0);
+        return 1;
+    }
+    if (argv[i][length] == '\0' && i + 1 < argc)
+    {
+        *pValue = (uint32_t)strtoul(argv[i + 1], NULL, 0);
+        return 2;
+    }
+    return 0;
+}
+
+void test_runner_parse_args( int *pArgc, char **argv, test_runner_config_t *pConfig )
+{
+    int used;
+    int out = 1;
+    int i;
+
+    pConfig->enabled = 0;
+    pConfig->jobs = 0;
+    pConfig->timeout_s = TEST_RUNNER_DEFAULT_TIMEOUT_S;
+    for (i = 1; i < *pArgc; i += (used > 0) ? used : 1)
+    {
+        used = match_option("--jobs", *pArgc, argv, i, &pConfig->jobs);
+        if (used > 0)
+        {
+            pConfig->enabled = 1;
+            continue;
+        }
+        used = match_option("--timeout", *pArgc, argv, i, &pConfig->timeout_s);
+        if (used == 0)
+        {
+            argv[out++] = argv[i];
+        }
+    }
+    argv[out] = NULL;
+    *pArgc = out;
+}
+
+/* Lists what to run: every active test, or whole suites where they have init or cleanup */
+static test_unit_t *collect_units( uint32_t *pCount )
+{
+    CU_pTestRegistry pRegistry = CU_get_registry();
+    test_unit_t *pUnits;
+    CU_pSuite pSuite;
+    CU_pTest pTest;
+    uint32_t count = 0;
+
+    *pCount = 0;
+    if (pRegistry == NULL)
+    {
+        return NULL;
+    }
+    pUnits = calloc(pRegistry->uiNumberOfTests + 1, sizeof(*pUnits));
+    if (pUnits == NULL)
+    {
+        return NULL;
+    }
+    for (pSuite = pRegistry->pSuite; pSuite != NULL; pSuite = pSuite->pNext)
+    {
+        if (!pSuite->fActive || pSuite->pTest == NULL)
+        {
+            continue;
+        }
+        if (pSuite->pInitializeFunc != NULL || pSuite->pCleanupFunc != NULL)
+        {
+            pUnits[count].pSuite = pSuite;
+            pUnits[count].tests = pSuite->uiNumberOfTests;
+            count++;
+            continue;
+        }
+        for (pTest = pSuite->pTest; pTest != NULL; pTest = pTest->pNext)
+        {
+            if (pTest->fActive)
+            {
+                pUnits[count].pSuite = pSuite;
+                pUnits[count].pTest = pTest;
+                pUnits[count].tests = 1;
+                count++;
+            }
+        }
+    }
+    *pCount = count;
+    return pUnits;
+}
+
+static int start_unit( test_unit_t *pUnit )
+{
+    int failed;
+
+    pUnit->pOutput = tmpfile();
+    if (pUnit->pOutput == NULL)
+    {
+        return -1;
+    }
+    /* Anything still buffered would otherwise be printed again by the child */
+    fflush(NULL);
+    test_results_flush();
+    pUnit->start_ns = monotonic_ns();
+    pUnit->pid = fork();
+    if (pUnit->pid < 0)
+    {
+        fclose(pUnit->pOutput);
+        pUnit->pOutput = NULL;
+        return -1;
+    }
+    if (pUnit->pid == 0)
+    {
+        dup2(fileno(pUnit->pOutput), STDOUT_FILENO);
+        dup2(fileno(pUnit->pOutput), STDERR_FILENO);
+        test_harness_isolate();
+        if (pUnit->pTest != NULL)
+        {
+            CU_run_test(pUnit->pSuite, pUnit->pTest);
+        }
+        else
+        {
+            CU_run_suite(pUnit->pSuite);
+        }
+        failed = (CU_get_number_of_tests_failed() != 0 || CU_get_number_of_suites_failed() != 0);
+        test_harness_complete();
+        fflush(NULL);
+        _exit(failed ? 1 : 0);
+    }
+    pUnit->state = UNIT_RUNNING;
+    return 0;
+}
+
+static const char *state_name( const test_unit_t *pUnit )
+{
+    switch (pUnit->state)
+    {
+        case UNIT_PASS:    return "PASS";
+        case UNIT_FAIL:    return "FAIL";
+        case UNIT_CRASH:   return "CRASH";
+        case UNIT_TIMEOUT: return "TIMEOUT";
+        default:           return "?";
+    }
+}
+
+/* A child that died or was killed wrote no record for the test it was in */
+static void record_lost_unit( const test_unit_t *pUnit, uint32_t timeout_s )
+{
+    char message[128];
+
+    if (pUnit->state == UNIT_CRASH)
+    {
+        snprintf(message, sizeof(message), "Killed by %s", strsignal(pUnit->signal));
+    }
+    else if (pUnit->overdue)
+    {
+        snprintf(message, sizeof(message), "Killed after %us", timeout_s * pUnit->tests);
+    }
+    else
+    {
+        snprintf(message, sizeof(message), "Test timed out");
+    }
+    test_results_begin();
+    test_results_end(pUnit->pSuite->pName, (pUnit->pTest != NULL) ? pUnit->pTest->pName : "(whole suite)",
+                     (pUnit->state == UNIT_CRASH) ? "crash" : "timeout", message, pUnit->elapsed_ns);
+    test_results_flush();
+}
+
+static void finish_unit( test_unit_t *pUnit, int status, uint32_t timeout_s )
+{
+    char line[512];
+
+    pUnit->elapsed_ns = monotonic_ns() - pUnit->start_ns;
+    if (pUnit->overdue)
+    {
+        pUnit->state = UNIT_TIMEOUT;
+    }
+    else if (WIFSIGNALED(status))
+    {
+        pUnit->state = UNIT_CRASH;
+        pUnit->signal = WTERMSIG(status);
+    }
+    else if (WIFEXITED(status) && WEXITSTATUS(status) == TEST_HARNESS_TIMEOUT_EXIT)
+    {
+        pUnit->state = UNIT_TIMEOUT;
+    }
+    else
+    {
+        pUnit->state = (WIFEXITED(status) && WEXITSTATUS(status) == 0) ? UNIT_PASS : UNIT_FAIL;
+    }
+
+    printf("%-7s %9.3fs  %s %s", state_name(pUnit), (double)pUnit->elapsed_ns / 1e9, pUnit->pSuite->pName,
+           (pUnit->pTest != NULL) ? pUnit->pTest->pName : "(whole suite)");
+    if (pUnit->state == UNIT_CRASH)
+    {
+        printf(" (%s)", strsignal(pUnit->signal));
+    }
+    printf("\n");
+    if (pUnit->state == UNIT_CRASH || pUnit->state == UNIT_TIMEOUT)
+    {
+        record_lost_unit(pUnit, timeout_s);
+    }
+    if (pUnit->state != UNIT_PASS)
+    {
+        rewind(pUnit->pOutput);
+        while (fgets(line, sizeof(line), pUnit->pOutput) != NULL)
+        {
+            printf("    | %s", line);
+        }
+    }
+    fclose(pUnit->pOutput);
+    pUnit->pOutput = NULL;
+    fflush(stdout);
+}
+
+int test_runner_run( const test_runner_config_t *pConfig )
+{
+    struct timespec pause = { 0, RUNNER_POLL_NS };
+    uint32_t counts[UNIT_TIMEOUT + 1] = { 0 };
+    uint64_t unit_ns = 0;
+    uint64_t wall_ns;
+    uint64_t now_ns;
+    test_unit_t *pUnits;
+    uint32_t jobs = pConfig->jobs;
+    uint32_t running = 0;
+    int fixtureRunning = 0;
+    uint32_t done = 0;
+    uint32_t count;
+    uint32_t tests = 0;
+    uint32_t i;
+    pid_t pid;
+    int status;
+
+    if (jobs == 0)
+    {
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        jobs = (cpus > 0) ? (uint32_t)cpus : 1;
+    }
+    pUnits = collect_units(&count);
+    if (pUnits == NULL)
+    {
+        fprintf(stderr, "runner: cannot list the registered tests\n");
+        return -1;
+    }
+    printf("\nrunner: %u units, %u jobs, %us timeout per test\n", count, jobs, pConfig->timeout_s);
+
+    wall_ns = monotonic_ns();
+    while (done < count)
+    {
+        /* Suites with fixtures may set up system-wide state (the L2 network namespace), so they run one at a time */
+        for (i = 0; i < count && running < jobs; i++)
+        {
+            if (pUnits[i].state != UNIT_PENDING || (pUnits[i].pTest == NULL && fixtureRunning))
+            {
+                continue;
+            }
+            if (start_unit(&pUnits[i]) != 0)
+            {
+                fprintf(stderr, "runner: cannot start %s\n", pUnits[i].pSuite->pName);
+                pUnits[i].state = UNIT_FAIL;
+                done++;
+                continue;
+            }
+            running++;
+            fixtureRunning |= (pUnits[i].pTest == NULL);
+        }
+
+        pid = waitpid(-1, &status, WNOHANG);
+        if (pid > 0)
+        {
+            for (i = 0; i < count; i++)
+            {
+                if (pUnits[i].state == UNIT_RUNNING && pUnits[i].pid == pid)
+                {
+                    finish_unit(&pUnits[i], status, pConfig->timeout_s);
+                    fixtureRunning &= (pUnits[i].pTest != NULL);
+                    running--;
+                    done++;
+                    break;
+                }
+            }
+            continue;
+        }
+
+        now_ns = monotonic_ns();
+        for (i = 0; i < count; i++)
+        {
+            if (pUnits[i].state == UNIT_RUNNING && !pUnits[i].overdue &&
+                now_ns - pUnits[i].start_ns > (uint64_t)pConfig->timeout_s * pUnits[i].tests * 1000000000ULL)
+            {
+                kill(pUnits[i].pid, SIGKILL);
+                pUnits[i].overdue = 1;
+            }
+        }
+        nanosleep(&pause, NULL);
+    }
+    wall_ns = monotonic_ns() - wall_ns;
+
+    for (i = 0; i < count; i++)
+    {
+        counts[pUnits[i].state]++;
+        unit_ns += pUnits[i].elapsed_ns;
+        tests += pUnits[i].tests;
+    }
+    printf("\nrunner: %u tests in %u units: %u passed, %u failed, %u crashed, %u timed out\n", tests, count,
+           counts[UNIT_PASS], counts[UNIT_FAIL], counts[UNIT_CRASH], counts[UNIT_TIMEOUT]);
+    /* Units slow each other down when they share CPUs, so this sum is not what a --jobs 1 run takes */
+    printf("runner: wall time %.3fs, sum of unit times %.3fs\n", (double)wall_ns / 1e9, (double)unit_ns / 1e9);
+
+    free(pUnits);
+    return (counts[UNIT_PASS] == count) ? 0 : -1;
+}
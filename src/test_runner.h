@@ -0,0 +1,79 @@
+/*
+* If not stated otherwise in this file or this component's LICENSE file the
+* following copyright and licenses apply:*
+* Copyright 2023 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+/**
+* @file test_runner.h
+*
+* Fork-isolated parallel runner for the registered test suites.
+*
+* Instead of UT_run_tests() running everything in one process, each test
+* runs in a child process of its own, up to a configurable number at a
+* time. A vendor getter that crashes on a NULL pointer then fails only its
+* own test, and a hung one is killed when its deadline passes. Suites with
+* init or cleanup functions share fixture state between their tests, so such
+* a suite runs as one unit, in one child, and never alongside another such
+* suite.
+*
+* A child's output is captured and printed only when it does not pass.
+*/
+
+#ifndef __TEST_RUNNER_H__
+#define __TEST_RUNNER_H__
+
+#include <stdint.h>
+
+#define TEST_RUNNER_DEFAULT_TIMEOUT_S  60   /*!< Per test; a suite run as one unit gets this per test it holds */
+
+/**
+* @brief Runner options
+*/
+typedef struct
+{
+    int      enabled;       /*!< Non-zero when --jobs was given */
+    uint32_t jobs;          /*!< Children running at once, 0 for one per online CPU */
+    uint32_t timeout_s;     /*!< Per-test deadline in seconds */
+} test_runner_config_t;
+
+/**
+* @brief Takes the runner's options out of the command line
+*
+* Recognises "--jobs N" and "--timeout SECONDS" (also as --jobs=N and
+* --timeout=SECONDS) and removes them, so that the remaining arguments can be
+* passed to UT_init() unchanged.
+*
+* @param[in,out] pArgc   - Argument count, reduced by the options removed
+* @param[in,out] argv    - Arguments, compacted in place
+* @param[out]    pConfig - Receives the options
+*/
+void test_runner_parse_args( int *pArgc, char **argv, test_runner_config_t *pConfig );
+
+/**
+* @brief Runs every active registered test in child processes
+*
+* Prints one line per test as it finishes (PASS, FAIL, CRASH or TIMEOUT and
+* its duration), then totals, the wall time and the sum of all unit
+* durations. Units measured side by side contend for the CPUs, so that sum
+* overstates a serial run; time a --jobs 1 run to compare.
+*
+* @param[in] pConfig - Options from test_runner_parse_args()
+*
+* @return 0 if every test passed, otherwise -1
+*/
+int test_runner_run( const test_runner_config_t *pConfig );
+
+#endif /* __TEST_RUNNER_H__ */
@@ -0,0 +1,387 @@
+/*
+* If not stated otherwise in this file or this component's LICENSE file the
+* following copyright and licenses apply:*
+* Copyright 2023 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+/**
+* @file dhcp_packet_fuzz.c
+*
+* In-process fuzz target for the DHCP packet codec (skeletons/include/dhcp_packet.h).
+*
+* Every input is decoded; one that decodes must encode again, decode to the
+* same fields, and encode into a short buffer without writing past it. Where
+* the build has a vectorized option scanner, its options area is also scanned
+* and decoded with both scanners, which must agree.
+* Any other outcome aborts, after saving the input as crash-<n>.bin.
+* Built with address and undefined behaviour sanitizers (make fuzz), so a
+* read or write out of bounds aborts too.
+*
+* LLVMFuzzerTestOneInput() is the libFuzzer entry point (FUZZ_LIBFUZZER=1,
+* clang only). Otherwise main() runs a built-in mutator over a seed corpus
+* of DISCOVER, OFFER, ACK (plain and with overloaded options) and NAK:
+*
+*     dhcp_packet_fuzz [-n iterations] [-s seed]    mutate the seeds
+*     dhcp_packet_fuzz file...                      replay saved inputs
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include "dhcp_packet.h"
+
+#define FUZZ_MAX_INPUT   1500    /* One Ethernet MTU, as the stand-in receives */
+#define FUZZ_SEEDS       5
+#define FUZZ_SCAN_REFS   8       /* Small, so that scans resume mid-area */
+
+static uint64_t gIteration = 0;
+static uint64_t gDecoded = 0;
+
+static void fail( const uint8_t *pData, size_t size, const char *pWhy )
+{
+    char path[64];
+    FILE *pFile;
+
+    snprintf(path, sizeof(path), "crash-%llu.bin", (unsigned long long)gIteration);
+    pFile = fopen(path, "wb");
+    if (pFile != NULL)
+    {
+        fwrite(pData, 1, size, pFile);
+        fclose(pFile);
+    }
+    fprintf(stderr, "dhcp_packet_fuzz: %s, input saved as %s\n", pWhy, path);
+    abort();
+}
+
+/* Field by field, so that struct padding cannot matter */
+static int same_packet( const dhcp_packet_t *pA, const dhcp_packet_t *pB )
+{
+    return pA->op == pB->op && pA->hops == pB->hops && pA->flags == pB->flags && pA->xid == pB->xid &&
+           pA->secs == pB->secs && pA->ciaddr == pB->ciaddr && pA->yiaddr == pB->yiaddr &&
+           pA->siaddr == pB->siaddr && pA->giaddr == pB->giaddr && memcmp(pA->chaddr, pB->chaddr, sizeof(pA->chaddr)) == 0 &&
+           pA->msg_type == pB->msg_type && pA->requested_ip == pB->requested_ip && pA->server_id == pB->server_id &&
+           pA->mask == pB->mask && pA->router == pB->router && pA->dns_count == pB->dns_count &&
+           memcmp(pA->dns, pB->dns, sizeof(pA->dns[0]) * (size_t)pA->dns_count) == 0 &&
+           pA->lease_time == pB->lease_time && pA->renewal_time == pB->renewal_time &&
+           pA->rebinding_time == pB->rebinding_time && pA->param_count == pB->param_count &&
+           memcmp(pA->params, pB->params, (size_t)pA->param_count) == 0;
+}
+
+/* The scalar and vectorized scanners must find the same options and stop at the same place */
+static void same_scan( const uint8_t *pData, size_t size )
+{
+    dhcp_option_ref_t scalarRefs[FUZZ_SCAN_REFS];
+    dhcp_option_ref_t vectorRefs[FUZZ_SCAN_REFS];
+    dhcp_packet_t scalarPacket;
+    dhcp_packet_t vectorPacket;
+    const uint8_t *pOptions;
+    size_t optionsSize;
+    size_t scalarOffset = 0;
+    size_t vectorOffset = 0;
+    int scalarFound;
+    int vectorFound;
+    int scalarStatus;
+    int vectorStatus;
+
+    if (dhcp_packet_scanner_name(DHCP_PACKET_SCANNER_SIMD) == NULL || size < DHCP_PACKET_OPTIONS_OFFSET)
+    {
+        return;
+    }
+    pOptions = pData + DHCP_PACKET_OPTIONS_OFFSET;
+    optionsSize = size - DHCP_PACKET_OPTIONS_OFFSET;
+    do
+    {
+        dhcp_packet_set_scanner(DHCP_PACKET_SCANNER_SCALAR);
+        scalarFound = dhcp_packet_scan(pOptions, optionsSize, &scalarOffset, scalarRefs, FUZZ_SCAN_REFS);
+        dhcp_packet_set_scanner(DHCP_PACKET_SCANNER_SIMD);
+        vectorFound = dhcp_packet_scan(pOptions, optionsSize, &vectorOffset, vectorRefs, FUZZ_SCAN_REFS);
+        if (scalarFound != vectorFound || scalarOffset != vectorOffset ||
+            (scalarFound > 0 && memcmp(scalarRefs, vectorRefs, sizeof(scalarRefs[0]) * (size_t)scalarFound) != 0))
+        {
+            fail(pData, size, "the scanners disagree");
+        }
+    } while (scalarFound > 0);
+
+    dhcp_packet_set_scanner(DHCP_PACKET_SCANNER_SCALAR);
+    scalarStatus = dhcp_packet_decode(pData, size, &scalarPacket);
+    dhcp_packet_set_scanner(DHCP_PACKET_SCANNER_SIMD);
+    vectorStatus = dhcp_packet_decode(pData, size, &vectorPacket);
+    if (scalarStatus != vectorStatus || (scalarStatus == 0 && !same_packet(&scalarPacket, &vectorPacket)))
+    {
+        fail(pData, size, "the scanners decode differently");
+    }
+}
+
+int LLVMFuzzerTestOneInput( const uint8_t *pData, size_t size )
+{
+    static const size_t shortSizes[] = { DHCP_PACKET_OPTIONS_OFFSET, DHCP_PACKET_OPTIONS_OFFSET + 3, 260, DHCP_PACKET_BOOTP_SIZE - 1 };
+    uint8_t encoded[DHCP_PACKET_MIN_SIZE];
+    dhcp_packet_t packet;
+    dhcp_packet_t again;
+    dhcp_lease_t lease;
+    uint8_t *pShort;
+    size_t length;
+    size_t shortLength;
+    uint32_t i;
+
+    same_scan(pData, size);
+    if (dhcp_packet_decode(pData, size, &packet) != 0)
+    {
+        return 0;
+    }
+    gDecoded++;
+    if (dhcp_packet_encode(&packet, encoded, sizeof(encoded), &length) != 0 || length > sizeof(encoded))
+    {
+        fail(pData, size, "a decoded message does not encode");
+    }
+    if (dhcp_packet_decode(encoded, length, &again) != 0 || !same_packet(&packet, &again))
+    {
+        fail(pData, size, "a re-encoded message decodes differently");
+    }
+    memset(&lease, 0, sizeof(lease));
+    if (dhcp_packet_to_lease(&packet, &lease) == 0 && (lease.ip_addr != packet.yiaddr || lease.dns_count != packet.dns_count))
+    {
+        fail(pData, size, "an ACK does not carry over to its lease");
+    }
+
+    /* Exactly sized heap buffers, so that the sanitizer sees the first byte past the end */
+    for (i = 0; i < sizeof(shortSizes) / sizeof(shortSizes[0]); i++)
+    {
+        pShort = malloc(shortSizes[i]);
+        if (pShort == NULL)
+        {
+            continue;
+        }
+        if (dhcp_packet_encode(&packet, pShort, shortSizes[i], &shortLength) == 0 && shortLength > shortSizes[i])
+        {
+            free(pShort);
+            fail(pData, size, "encode reported more than the buffer holds");
+        }
+        free(pShort);
+    }
+    return 0;
+}
+
+#ifndef DHCP_PACKET_LIBFUZZER
+
+static uint32_t next_random( uint32_t *pState )
+{
+    /* xorshift32 */
+    *pState ^= *pState << 13;
+    *pState ^= *pState >> 17;
+    *pState ^= *pState << 5;
+    return *pState;
+}
+
+static size_t build_seed( uint32_t index, uint8_t *pBuf, size_t size )
+{
+    static const uint8_t params[] = { DHCP_OPT_SUBNET_MASK, DHCP_OPT_ROUTER, DHCP_OPT_DNS, DHCP_OPT_LEASE_TIME,
+                                      DHCP_OPT_SERVER_ID, DHCP_OPT_RENEWAL, DHCP_OPT_REBINDING };
+    dhcp_packet_t packet;
+    size_t length = 0;
+    size_t end;
+    int i;
+
+    memset(&packet, 0, sizeof(packet));
+    packet.xid = 0x5eed0000U + index;
+    packet.flags = DHCP_PACKET_FLAG_BROADCAST;
+    for (i = 0; i < 6; i++)
+    {
+        packet.chaddr[i] = (uint8_t)(0x02 + i);
+    }
+    if (index == 0)
+    {
+        packet.op = DHCP_BOOTREQUEST;
+        packet.msg_type = DHCPDISCOVER;
+        packet.param_count = (int)sizeof(params);
+        memcpy(packet.params, params, sizeof(params));
+    }
+    else
+    {
+        packet.op = DHCP_BOOTREPLY;
+        packet.msg_type = (index == 1) ? DHCPOFFER : (index == 4) ? DHCPNAK : DHCPACK;
+        packet.server_id = htonl(0x0a000001U);
+        if (packet.msg_type != DHCPNAK)
+        {
+            packet.yiaddr = htonl(0x0a000064U);
+            packet.mask = htonl(0xffffff00U);
+            packet.router = htonl(0x0a000001U);
+            /* The overloaded seed carries its DNS servers in the file field instead */
+            packet.dns_count = (index == 3) ? 0 : DHCP_PACKET_MAX_DNS;
+            for (i = 0; i < DHCP_PACKET_MAX_DNS; i++)
+            {
+                packet.dns[i] = htonl(0x08080800U + (uint32_t)i);
+            }
+            packet.lease_time = 3600;
+            packet.renewal_time = 1800;
+            packet.rebinding_time = 3150;
+        }
+    }
+    dhcp_packet_encode(&packet, pBuf, size, &length);
+    if (index == 3)
+    {
+        /* Option 52 over END, which the padding leaves room to move */
+        for (end = DHCP_PACKET_OPTIONS_OFFSET; pBuf[end] != DHCP_OPT_END; end += 2 + pBuf[end + 1])
+        {
+        }
+        pBuf[end] = DHCP_OPT_OVERLOAD;
+        pBuf[end + 1] = 1;
+        pBuf[end + 2] = 1;
+        pBuf[end + 3] = DHCP_OPT_END;
+        pBuf[108] = DHCP_OPT_DNS;
+        pBuf[109] = 8;
+        memcpy(pBuf + 110, packet.dns, 8);
+        pBuf[118] = DHCP_OPT_END;
+    }
+    return length;
+}
+
+/* One to eight mutations, weighted towards the option bytes where the parser branches */
+static size_t mutate( uint8_t *pBuf, size_t length, uint32_t *pState )
+{
+    static const uint8_t interesting[] = { 0, 1, 3, 4, 6, 51, 52, 53, 55, 255, 0x7f, 0x80 };
+    uint32_t count = 1 + next_random(pState) % 8;
+    uint32_t position;
+    uint32_t kind;
+
+    while (count-- > 0 && length > 0)
+    {
+        kind = next_random(pState) % 6;
+        position = (next_random(pState) % 4 != 0 && length > DHCP_PACKET_OPTIONS_OFFSET)
+                 ? DHCP_PACKET_OPTIONS_OFFSET + next_random(pState) % (uint32_t)(length - DHCP_PACKET_OPTIONS_OFFSET)
+                 : next_random(pState) % (uint32_t)length;
+        switch (kind)
+        {
+            case 0:
+                pBuf[position] ^= (uint8_t)(1U << (next_random(pState) % 8));
+                break;
+            case 1:
+                pBuf[position] = (uint8_t)next_random(pState);
+                break;
+            case 2:
+                /* Option codes and lengths the parser treats specially */
+                pBuf[position] = interesting[next_random(pState) % sizeof(interesting)];
+                break;
+            case 3:
+                length = position;
+                break;
+            case 4:
+                if (length < FUZZ_MAX_INPUT)
+                {
+                    memmove(pBuf + position + 1, pBuf + position, length - position);
+                    pBuf[position] = (uint8_t)next_random(pState);
+                    length++;
+                }
+                break;
+            default:
+                memmove(pBuf + position, pBuf + position + 1, length - position - 1);
+                length--;
+                break;
+        }
+    }
+    return length;
+}
+
+static int replay( const char *pPath )
+{
+    uint8_t buf[FUZZ_MAX_INPUT];
+    size_t size;
+    FILE *pFile = fopen(pPath, "rb");
+
+    if (pFile == NULL)
+    {
+        fprintf(stderr, "dhcp_packet_fuzz: cannot open %s\n", pPath);
+        return -1;
+    }
+    size = fread(buf, 1, sizeof(buf), pFile);
+    fclose(pFile);
+    LLVMFuzzerTestOneInput(buf, size);
+    return 0;
+}
+
+int main( int argc, char **argv )
+{
+    uint8_t seeds[FUZZ_SEEDS][DHCP_PACKET_MIN_SIZE];
+    size_t seedLengths[FUZZ_SEEDS];
+    uint8_t input[FUZZ_MAX_INPUT];
+    dhcp_packet_t packet;
+    struct timespec start;
+    struct timespec end;
+    uint64_t iterations = 1000000;
+    uint32_t state = 1;
+    uint32_t seed;
+    size_t length;
+    double seconds;
+    int opt;
+    int i;
+
+    while ((opt = getopt(argc, argv, "n:s:")) != -1)
+    {
+        switch (opt)
+        {
+            case 'n': iterations = strtoull(optarg, NULL, 0); break;
+            case 's': state = (uint32_t)strtoul(optarg, NULL, 0); break;
+            default:
+                fprintf(stderr, "Usage: dhcp_packet_fuzz [-n iterations] [-s seed] [file...]\n");
+                return 2;
+        }
+    }
+    if (optind < argc)
+    {
+        for (i = optind; i < argc; i++)
+        {
+            if (replay(argv[i]) != 0)
+            {
+                return 1;
+            }
+        }
+        printf("dhcp_packet_fuzz: %d inputs replayed, no failures\n", argc - optind);
+        return 0;
+    }
+    if (state == 0)
+    {
+        state = 1;
+    }
+
+    for (seed = 0; seed < FUZZ_SEEDS; seed++)
+    {
+        seedLengths[seed] = build_seed(seed, seeds[seed], sizeof(seeds[seed]));
+        if (dhcp_packet_decode(seeds[seed], seedLengths[seed], &packet) != 0)
+        {
+            fprintf(stderr, "dhcp_packet_fuzz: seed %u does not decode\n", seed);
+            return 1;
+        }
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (gIteration = 0; gIteration < iterations; gIteration++)
+    {
+        seed = next_random(&state) % FUZZ_SEEDS;
+        memcpy(input, seeds[seed], seedLengths[seed]);
+        length = mutate(input, seedLengths[seed], &state);
+        LLVMFuzzerTestOneInput(input, length);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    seconds = (double)(end.tv_sec - start.tv_sec) + (double)(end.tv_nsec - start.tv_nsec) / 1e9;
+    printf("dhcp_packet_fuzz: %llu inputs, %llu decoded, no failures, %.0f inputs/s\n",
+           (unsigned long long)iterations, (unsigned long long)gDecoded, (double)iterations / (seconds > 0 ? seconds : 1e-9));
+    return 0;
+}
+
+#endif /* DHCP_PACKET_LIBFUZZER */
@@ -0,0 +1,593 @@
+/*
+* If not stated otherwise in this file or this component's LICENSE file the
+* following copyright and licenses apply:*
+* Copyright 2023 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+/**
+* @file dhcp_standin.c
+*
+* Minimal DHCPv4 server and client for the L2 tests.
+*
+* server: answers DISCOVER/REQUEST on one interface with a configurable
+*         lease (lease time, T1/T2, options 1, 3, 6 and 54), offering
+*         the addresses of a small pool in turn. Meant to run inside a network namespace on one end of
+*         a veth pair, so it can never answer a real network.
+* client: one-shot DISCOVER/OFFER/REQUEST/ACK exchange on the other end,
+*         writing the lease as a udhcpc environment dump, which the linux
+*         skeleton reads through DHCP4C_ERT_LEASE_FILE. With -e it also
+*         sets the lease change tuple of that key on the sysevent stand-in
+*         at $DHCP_SYSEVENT_SOCKET, as a platform's client script would.
+*         Platforms with their own client only need the server.
+*
+* Both log one line per protocol event, "<CLOCK_MONOTONIC ns> <EVENT> xid=<xid> ...",
+* so the tests can line up the exchange with what the HAL reports.
+* CLOCK_MONOTONIC is shared by every network namespace on a host.
+*
+* Messages go through the skeleton's packet codec (skeletons/include/dhcp_packet.h),
+* so the stand-in and the skeleton agree on every byte.
+*
+* Replies are always broadcast and the client always sets the broadcast
+* flag, so neither side needs raw sockets or an address on the client
+* interface.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <errno.h>
+#include <time.h>
+#include <signal.h>
+#include <unistd.h>
+#include <poll.h>
+#include <net/if.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include "dhcp_packet.h"
+
+#define CLIENT_RETRY_MS       1000
+
+/* What the server hands out */
+typedef struct
+{
+    const char *pIfname;
+    uint32_t server_ip;
+    uint32_t offer_ip;              /* First address of the pool */
+    uint32_t pool_size;             /* Each DISCOVER is offered the next address of the pool */
+    uint32_t mask;
+    uint32_t router;
+    uint32_t dns[DHCP_PACKET_MAX_DNS];
+    int      dns_count;
+    uint32_t lease_time;
+    uint32_t renewal_time;
+    uint32_t rebinding_time;
+} server_config_t;
+
+static volatile sig_atomic_t gStop = 0;
+static FILE *gLog = NULL;
+
+static void on_signal( int signum )
+{
+    (void)signum;
+    gStop = 1;
+}
+
+static uint64_t monotonic_ns( void )
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static void log_event_at( uint64_t time_ns, const char *pEvent, const dhcp_packet_t *pMsg, uint32_t addr )
+{
+    char ip[INET_ADDRSTRLEN];
+    struct in_addr in;
+
+    if (gLog == NULL)
+    {
+        return;
+    }
+    in.s_addr = addr;
+    inet_ntop(AF_INET, &in, ip, sizeof(ip));
+    fprintf(gLog, "%llu %s xid=%08x ip=%s\n", (unsigned long long)time_ns, pEvent, pMsg->xid, ip);
+    fflush(gLog);
+}
+
+static void log_event( const char *pEvent, const dhcp_packet_t *pMsg, uint32_t addr )
+{
+    log_event_at(monotonic_ns(), pEvent, pMsg, addr);
+}
+
+static int parse_ip( const char *pText, uint32_t *pAddr )
+{
+    struct in_addr in;
+
+    if (inet_pton(AF_INET, pText, &in) != 1)
+    {
+        fprintf(stderr, "dhcp_standin: bad address '%s'\n", pText);
+        return -1;
+    }
+    *pAddr = in.s_addr;
+    return 0;
+}
+
+/* Comma separated list, at most DHCP_PACKET_MAX_DNS entries */
+static int parse_ip_list( const char *pText, uint32_t *pAddrs, int *pCount )
+{
+    char buf[128];
+    char *pSave = NULL;
+    char *pToken;
+
+    snprintf(buf, sizeof(buf), "%s", pText);
+    *pCount = 0;
+    for (pToken = strtok_r(buf, ",", &pSave); pToken != NULL && *pCount < DHCP_PACKET_MAX_DNS; pToken = strtok_r(NULL, ",", &pSave))
+    {
+        if (parse_ip(pToken, &pAddrs[*pCount]) != 0)
+        {
+            return -1;
+        }
+        (*pCount)++;
+    }
+    return 0;
+}
+
+static int open_socket( const char *pIfname, uint16_t port )
+{
+    struct sockaddr_in addr;
+    int one = 1;
+    int fd;
+
+    fd = socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+    if (fd < 0)
+    {
+        perror("dhcp_standin: socket");
+        return -1;
+    }
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+    setsockopt(fd, SOL_SOCKET, SO_BROADCAST, &one, sizeof(one));
+    if (setsockopt(fd, SOL_SOCKET, SO_BINDTODEVICE, pIfname, (socklen_t)strlen(pIfname) + 1) != 0)
+    {
+        fprintf(stderr, "dhcp_standin: cannot bind to %s: %s\n", pIfname, strerror(errno));
+        close(fd);
+        return -1;
+    }
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+    if (bind(fd, (struct sockaddr *)&addr, sizeof(addr)) != 0)
+    {
+        fprintf(stderr, "dhcp_standin: cannot bind port %u: %s\n", port, strerror(errno));
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+static int send_broadcast( int fd, uint16_t port, const dhcp_packet_t *pMsg )
+{
+    uint8_t buf[DHCP_PACKET_MIN_SIZE];
+    struct sockaddr_in to;
+    size_t length;
+
+    if (dhcp_packet_encode(pMsg, buf, sizeof(buf), &length) != 0)
+    {
+        return -1;
+    }
+    memset(&to, 0, sizeof(to));
+    to.sin_family = AF_INET;
+    to.sin_port = htons(port);
+    to.sin_addr.s_addr = htonl(INADDR_BROADCAST);
+    return (sendto(fd, buf, length, 0, (struct sockaddr *)&to, sizeof(to)) == (ssize_t)length) ? 0 : -1;
+}
+
+/* Waits up to timeout_ms for a message; returns 1 if one was decoded, 0 on timeout, -1 on error */
+static int receive( int fd, int timeout_ms, dhcp_packet_t *pMsg )
+{
+    uint8_t buf[1500];
+    struct pollfd pfd;
+    ssize_t length;
+    int ready;
+
+    pfd.fd = fd;
+    pfd.events = POLLIN;
+    ready = poll(&pfd, 1, timeout_ms);
+    if (ready <= 0)
+    {
+        return (ready == 0 || errno == EINTR) ? 0 : -1;
+    }
+    length = recv(fd, buf, sizeof(buf), 0);
+    if (length < 0)
+    {
+        return (errno == EINTR) ? 0 : -1;
+    }
+    return (dhcp_packet_decode(buf, (size_t)length, pMsg) == 0) ? 1 : 0;
+}
+
+/* Returns the index of addr in the pool, or -1 if it is not part of it */
+static int pool_index( const server_config_t *pConfig, uint32_t addr )
+{
+    uint32_t offset = ntohl(addr) - ntohl(pConfig->offer_ip);
+
+    return (offset < pConfig->pool_size) ? (int)offset : -1;
+}
+
+static uint32_t pool_address( const server_config_t *pConfig, uint32_t index )
+{
+    return htonl(ntohl(pConfig->offer_ip) + index);
+}
+
+static void fill_reply( const server_config_t *pConfig, const dhcp_packet_t *pRequest, int type, uint32_t addr, dhcp_packet_t *pReply )
+{
+    memset(pReply, 0, sizeof(*pReply));
+    pReply->op = DHCP_BOOTREPLY;
+    pReply->xid = pRequest->xid;
+    pReply->flags = pRequest->flags;
+    memcpy(pReply->chaddr, pRequest->chaddr, sizeof(pReply->chaddr));
+    pReply->msg_type = type;
+    pReply->server_id = pConfig->server_ip;
+    if (type == DHCPNAK)
+    {
+        return;
+    }
+    pReply->yiaddr = addr;
+    pReply->mask = pConfig->mask;
+    pReply->router = pConfig->router;
+    memcpy(pReply->dns, pConfig->dns, sizeof(pReply->dns));
+    pReply->dns_count = pConfig->dns_count;
+    pReply->lease_time = pConfig->lease_time;
+    pReply->renewal_time = pConfig->renewal_time;
+    pReply->rebinding_time = pConfig->rebinding_time;
+}
+
+static int run_server( const server_config_t *pConfig )
+{
+    dhcp_packet_t request;
+    dhcp_packet_t reply;
+    uint64_t sent_ns;
+    uint32_t next = 0;
+    uint32_t addr;
+    int fd;
+    int status;
+
+    fd = open_socket(pConfig->pIfname, DHCP_PACKET_SERVER_PORT);
+    if (fd < 0)
+    {
+        return 1;
+    }
+    memset(&request, 0, sizeof(request));
+    log_event("READY", &request, pConfig->offer_ip);
+
+    while (!gStop)
+    {
+        status = receive(fd, 500, &request);
+        if (status < 0)
+        {
+            perror("dhcp_standin: recv");
+            break;
+        }
+        if (status == 0 || request.op != DHCP_BOOTREQUEST)
+        {
+            continue;
+        }
+        log_event(dhcp_packet_type_name(request.msg_type), &request, request.requested_ip ? request.requested_ip : request.ciaddr);
+
+        switch (request.msg_type)
+        {
+            case DHCPDISCOVER:
+                fill_reply(pConfig, &request, DHCPOFFER, pool_address(pConfig, next), &reply);
+                next = (next + 1) % pConfig->pool_size;
+                break;
+            case DHCPREQUEST:
+                /* SELECTING carries our server id; INIT-REBOOT, RENEWING and REBINDING do not */
+                if (request.server_id != 0 && request.server_id != pConfig->server_ip)
+                {
+                    continue;
+                }
+                addr = request.requested_ip ? request.requested_ip : request.ciaddr;
+                fill_reply(pConfig, &request, (pool_index(pConfig, addr) >= 0) ? DHCPACK : DHCPNAK, addr, &reply);
+                break;
+            default:
+                continue;
+        }
+        /* Stamped before sending, so that the client side can never appear to precede it */
+        sent_ns = monotonic_ns();
+        if (send_broadcast(fd, DHCP_PACKET_CLIENT_PORT, &reply) != 0)
+        {
+            perror("dhcp_standin: send");
+            continue;
+        }
+        log_event_at(sent_ns, dhcp_packet_type_name(reply.msg_type), &reply, reply.yiaddr);
+    }
+    close(fd);
+    return 0;
+}
+
+static int write_lease( const char *pPath, const char *pIfname, const dhcp_packet_t *pAck )
+{
+    char tmpPath[512];
+    char ip[INET_ADDRSTRLEN];
+    struct in_addr in;
+    FILE *pFile;
+    int i;
+
+    snprintf(tmpPath, sizeof(tmpPath), "%s.tmp", pPath);
+    pFile = fopen(tmpPath, "w");
+    if (pFile == NULL)
+    {
+        fprintf(stderr, "dhcp_standin: cannot write %s: %s\n", tmpPath, strerror(errno));
+        return -1;
+    }
+    fprintf(pFile, "interface=%s\n", pIfname);
+    in.s_addr = pAck->yiaddr;
+    fprintf(pFile, "ip=%s\n", inet_ntop(AF_INET, &in, ip, sizeof(ip)));
+    in.s_addr = pAck->mask;
+    fprintf(pFile, "subnet=%s\n", inet_ntop(AF_INET, &in, ip, sizeof(ip)));
+    in.s_addr = pAck->router;
+    fprintf(pFile, "router=%s\n", inet_ntop(AF_INET, &in, ip, sizeof(ip)));
+    fprintf(pFile, "dns=");
+    for (i = 0; i < pAck->dns_count; i++)
+    {
+        in.s_addr = pAck->dns[i];
+        fprintf(pFile, "%s%s", (i > 0) ? " " : "", inet_ntop(AF_INET, &in, ip, sizeof(ip)));
+    }
+    fprintf(pFile, "\n");
+    in.s_addr = pAck->server_id;
+    fprintf(pFile, "serverid=%s\n", inet_ntop(AF_INET, &in, ip, sizeof(ip)));
+    fprintf(pFile, "lease=%u\n", pAck->lease_time);
+    /* As udhcpc, which has no names for options 58 and 59 */
+    if (pAck->renewal_time != 0)
+    {
+        fprintf(pFile, "opt58=%08x\n", pAck->renewal_time);
+    }
+    if (pAck->rebinding_time != 0)
+    {
+        fprintf(pFile, "opt59=%08x\n", pAck->rebinding_time);
+    }
+    if (fclose(pFile) != 0 || rename(tmpPath, pPath) != 0)
+    {
+        fprintf(stderr, "dhcp_standin: cannot replace %s: %s\n", pPath, strerror(errno));
+        unlink(tmpPath);
+        return -1;
+    }
+    return 0;
+}
+
+/* Sets pKey to "<BOUND> <ip> <ns>" as skeletons/include/dhcp_lease_notify.h describes */
+static int announce_lease( const char *pKey, const dhcp_packet_t *pAck )
+{
+    const char *pPath = getenv("DHCP_SYSEVENT_SOCKET");
+    struct sockaddr_un address;
+    struct in_addr in;
+    char ip[INET_ADDRSTRLEN];
+    char line[256];
+    char reply[16];
+    ssize_t got;
+    int length;
+    int fd;
+
+    in.s_addr = pAck->yiaddr;
+    length = snprintf(line, sizeof(line), "SET %s %d %s %llu\n", pKey, DHCP_LEASE_FSM_BOUND,
+                      inet_ntop(AF_INET, &in, ip, sizeof(ip)), (unsigned long long)monotonic_ns());
+    if (pPath == NULL || strlen(pPath) >= sizeof(address.sun_path) || length >= (int)sizeof(line))
+    {
+        fprintf(stderr, "dhcp_standin: DHCP_SYSEVENT_SOCKET is not a usable socket path\n");
+        return -1;
+    }
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    strcpy(address.sun_path, pPath);
+    fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0 || connect(fd, (struct sockaddr *)&address, sizeof(address)) != 0 ||
+        send(fd, line, (size_t)length, MSG_NOSIGNAL) != length || (got = recv(fd, reply, sizeof(reply) - 1, 0)) < 3 ||
+        strncmp(reply, "OK\n", 3) != 0)
+    {
+        fprintf(stderr, "dhcp_standin: cannot set %s on %s\n", pKey, pPath);
+        if (fd >= 0)
+        {
+            close(fd);
+        }
+        return -1;
+    }
+    close(fd);
+    return 0;
+}
+
+/* Sends pRequest until a reply of one of the wanted types arrives */
+static int exchange( int fd, const dhcp_packet_t *pRequest, int wanted1, int wanted2, uint64_t deadline_ns, dhcp_packet_t *pReply )
+{
+    uint64_t retry_ns = 0;
+    uint64_t now_ns;
+    int status;
+
+    while ((now_ns = monotonic_ns()) < deadline_ns && !gStop)
+    {
+        if (now_ns >= retry_ns)
+        {
+            /* A freshly created veth drops packets until its carrier is up, so send errors are retried */
+            if (send_broadcast(fd, DHCP_PACKET_SERVER_PORT, pRequest) == 0)
+            {
+                log_event(dhcp_packet_type_name(pRequest->msg_type), pRequest, pRequest->requested_ip);
+            }
+            retry_ns = now_ns + CLIENT_RETRY_MS * 1000000ULL;
+        }
+        status = receive(fd, 50, pReply);
+        if (status < 0)
+        {
+            return -1;
+        }
+        if (status == 1 && pReply->op == DHCP_BOOTREPLY && pReply->xid == pRequest->xid &&
+            (pReply->msg_type == wanted1 || pReply->msg_type == wanted2))
+        {
+            log_event(dhcp_packet_type_name(pReply->msg_type), pReply, pReply->yiaddr);
+            return 0;
+        }
+    }
+    return -1;
+}
+
+static int run_client( const char *pIfname, const char *pLeaseFile, const char *pEventKey, int timeout_ms )
+{
+    uint64_t deadline_ns = monotonic_ns() + (uint64_t)timeout_ms * 1000000ULL;
+    dhcp_packet_t request;
+    dhcp_packet_t offer;
+    dhcp_packet_t ack;
+    struct ifreq ifr;
+    static const uint8_t params[] = { DHCP_OPT_SUBNET_MASK, DHCP_OPT_ROUTER, DHCP_OPT_DNS, DHCP_OPT_LEASE_TIME,
+                                      DHCP_OPT_SERVER_ID, DHCP_OPT_RENEWAL, DHCP_OPT_REBINDING };
+    int fd;
+
+    fd = open_socket(pIfname, DHCP_PACKET_CLIENT_PORT);
+    if (fd < 0)
+    {
+        return 1;
+    }
+
+    memset(&request, 0, sizeof(request));
+    request.op = DHCP_BOOTREQUEST;
+    request.flags = DHCP_PACKET_FLAG_BROADCAST;
+    request.xid = (uint32_t)(monotonic_ns() ^ ((uint64_t)getpid() << 16));
+    memset(&ifr, 0, sizeof(ifr));
+    snprintf(ifr.ifr_name, sizeof(ifr.ifr_name), "%s", pIfname);
+    if (ioctl(fd, SIOCGIFHWADDR, &ifr) == 0)
+    {
+        memcpy(request.chaddr, ifr.ifr_hwaddr.sa_data, 6);
+    }
+
+    request.msg_type = DHCPDISCOVER;
+    request.param_count = (int)sizeof(params);
+    memcpy(request.params, params, sizeof(params));
+    if (exchange(fd, &request, DHCPOFFER, DHCPOFFER, deadline_ns, &offer) != 0)
+    {
+        fprintf(stderr, "dhcp_standin: no OFFER on %s\n", pIfname);
+        close(fd);
+        return 1;
+    }
+
+    request.msg_type = DHCPREQUEST;
+    request.requested_ip = offer.yiaddr;
+    request.server_id = offer.server_id;
+    if (exchange(fd, &request, DHCPACK, DHCPNAK, deadline_ns, &ack) != 0 || ack.msg_type != DHCPACK)
+    {
+        fprintf(stderr, "dhcp_standin: no ACK on %s\n", pIfname);
+        close(fd);
+        return 1;
+    }
+    close(fd);
+
+    if (write_lease(pLeaseFile, pIfname, &ack) != 0)
+    {
+        return 1;
+    }
+    log_event("BOUND", &ack, ack.yiaddr);
+    if (pEventKey != NULL && announce_lease(pEventKey, &ack) != 0)
+    {
+        return 1;
+    }
+    return 0;
+}
+
+static void usage( void )
+{
+    fprintf(stderr,
+            "Usage: dhcp_standin server -i ifname -s server_ip -a offer_ip [-n pool_size] [-m mask] [-r router]\n"
+            "                           [-d dns[,dns...]] [-l lease_s] [-t t1_s] [-T t2_s] [-L logfile]\n"
+            "       dhcp_standin client -i ifname -o lease_file [-e sysevent_key] [-w timeout_ms] [-L logfile]\n");
+}
+
+int main( int argc, char **argv )
+{
+    server_config_t config;
+    const char *pLeaseFile = NULL;
+    const char *pEventKey = NULL;
+    const char *pLogFile = NULL;
+    struct sigaction sa;
+    int timeout_ms = 5000;
+    int server;
+    int opt;
+    int status;
+
+    if (argc < 2 || (strcmp(argv[1], "server") != 0 && strcmp(argv[1], "client") != 0))
+    {
+        usage();
+        return 2;
+    }
+    server = (strcmp(argv[1], "server") == 0);
+
+    memset(&config, 0, sizeof(config));
+    config.lease_time = 3600;
+    config.pool_size = 1;
+    optind = 2;
+    while ((opt = getopt(argc, argv, "i:s:a:n:m:r:d:l:t:T:o:e:w:L:")) != -1)
+    {
+        status = 0;
+        switch (opt)
+        {
+            case 'i': config.pIfname = optarg; break;
+            case 's': status = parse_ip(optarg, &config.server_ip); break;
+            case 'a': status = parse_ip(optarg, &config.offer_ip); break;
+            case 'n': config.pool_size = (uint32_t)strtoul(optarg, NULL, 0); break;
+            case 'm': status = parse_ip(optarg, &config.mask); break;
+            case 'r': status = parse_ip(optarg, &config.router); break;
+            case 'd': status = parse_ip_list(optarg, config.dns, &config.dns_count); break;
+            case 'l': config.lease_time = (uint32_t)strtoul(optarg, NULL, 0); break;
+            case 't': config.renewal_time = (uint32_t)strtoul(optarg, NULL, 0); break;
+            case 'T': config.rebinding_time = (uint32_t)strtoul(optarg, NULL, 0); break;
+            case 'o': pLeaseFile = optarg; break;
+            case 'e': pEventKey = optarg; break;
+            case 'w': timeout_ms = atoi(optarg); break;
+            case 'L': pLogFile = optarg; break;
+            default: status = -1; break;
+        }
+        if (status != 0)
+        {
+            usage();
+            return 2;
+        }
+    }
+    if (config.pIfname == NULL || (server && (config.server_ip == 0 || config.offer_ip == 0 || config.pool_size == 0)) || (!server && pLeaseFile == NULL))
+    {
+        usage();
+        return 2;
+    }
+
+    if (pLogFile != NULL)
+    {
+        gLog = (strcmp(pLogFile, "-") == 0) ? stdout : fopen(pLogFile, "a");
+        if (gLog == NULL)
+        {
+            fprintf(stderr, "dhcp_standin: cannot open %s: %s\n", pLogFile, strerror(errno));
+            return 1;
+        }
+    }
+
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = on_signal;
+    sigaction(SIGTERM, &sa, NULL);
+    sigaction(SIGINT, &sa, NULL);
+
+    status = server ? run_server(&config) : run_client(config.pIfname, pLeaseFile, pEventKey, timeout_ms);
+    if (gLog != NULL && gLog != stdout)
+    {
+        fclose(gLog);
+    }
+    return status;
+}
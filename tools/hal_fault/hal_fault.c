@@ -0,0 +1,548 @@
+/*
+* If not stated otherwise in this file or this component's LICENSE file the
+* following copyright and licenses apply:*
+* Copyright 2023 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+/**
+* @file hal_fault.c
+*
+* LD_PRELOAD library that makes the HAL getters slow or flaky on purpose.
+*
+* It defines every getter of tools/hal_interpose/hal_symbols.h. A call
+* waits, fails, stalls or writes only part of its output as the rules of
+* $HAL_FAULT_CONFIG say, and is otherwise passed on to the HAL library
+* loaded after it. Callers' timeouts and retries can then be tried against
+* a degraded HAL on an ordinary Linux box: against a vendor library
+* directly, or against the skeletons built with SKELETON_SHARED=1.
+*
+* The configuration is read once, at load. One rule per line:
+*
+*   <function pattern> [latency=...] [error=...] [partial=...] [stall=...]
+*   seed <n>
+*
+* The pattern is an fnmatch() glob such as "dhcpv4c_get_ert_*" or "*", and
+* a getter takes the rule of the last line it matches. A probability is a
+* fraction ("0.05") or a percentage ("5%"); a duration is a number with ns,
+* us, ms or s.
+*
+* - latency=fixed:D, uniform:MIN:MAX or exp:MEAN - added before every call
+* - stall=P:D         - with probability P, also waits D (a hung HAL)
+* - error=P[:STATUS]  - with probability P, returns STATUS (default -1)
+*                       without calling the HAL
+* - partial=P[:BYTES] - with probability P, the HAL's output reaches the
+*                       caller cut to BYTES (default half of it); the rest
+*                       of the caller's buffer is left as it was
+*
+* Randomness comes from a per-thread generator seeded from "seed" (default
+* 1), so a single-threaded caller sees the same faults on every run. A line
+* that cannot be parsed stops the process at load, rather than leaving a
+* fault silently off. With $HAL_FAULT_REPORT set to a file, or "-" for
+* standard error, every process that called a getter appends its calls and
+* injections per getter there at exit.
+*/
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+#include <fnmatch.h>
+#include <math.h>
+#include <time.h>
+#include <dlfcn.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include "hal_symbols.h"
+
+#define FAULT_CONFIG_ENV    "HAL_FAULT_CONFIG"
+#define FAULT_REPORT_ENV    "HAL_FAULT_REPORT"
+#define FAULT_LINE_MAX      512
+#define FAULT_PATTERN_MAX   128
+#define FAULT_RULES_MAX     64
+#define FAULT_NS_PER_SEC    1000000000ULL
+#define FAULT_SPIN_NS       200000ULL   /* Delays shorter than this are busy-waited */
+
+typedef enum
+{
+    FAULT_LATENCY_NONE = 0,
+    FAULT_LATENCY_FIXED,
+    FAULT_LATENCY_UNIFORM,
+    FAULT_LATENCY_EXP
+} fault_latency_t;
+
+typedef struct
+{
+    char            pattern[FAULT_PATTERN_MAX];
+    fault_latency_t latency;
+    uint64_t        latencyA;       /* Fixed or minimum or mean, ns */
+    uint64_t        latencyB;       /* Maximum of uniform, ns */
+    double          stallP;
+    uint64_t        stallNs;
+    double          errorP;
+    int             errorStatus;
+    double          partialP;
+    long            partialBytes;   /* -1: half of the output */
+} fault_rule_t;
+
+/* Counters of one getter */
+typedef struct
+{
+    uint64_t calls;
+    uint64_t delayedNs;
+    uint64_t stalls;
+    uint64_t errors;
+    uint64_t partials;
+} fault_counters_t;
+
+typedef struct
+{
+    const char       *pName;
+    const fault_rule_t *pRule;      /* NULL: passed straight on */
+    void             *pReal;        /* Resolved on first call */
+    int               missing;      /* Not found after this library */
+    fault_counters_t  counters;
+} fault_site_t;
+
+static const char *const gSymbolNames[] = { HAL_SYMBOLS(HAL_SYMBOL_NAME) };
+static fault_rule_t gRules[FAULT_RULES_MAX];
+static uint32_t gRuleCount;
+static uint64_t gSeed = 1;
+static fault_site_t gSites[HAL_SYMBOL_COUNT];
+static __thread uint64_t gRandom;
+
+static uint64_t now_ns( void )
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * FAULT_NS_PER_SEC + (uint64_t)ts.tv_nsec;
+}
+
+/* xorshift64*, seeded per thread so threads do not share a sequence */
+static double random_unit( void )
+{
+    uint64_t x = gRandom;
+
+    if (x == 0)
+    {
+        x = (gSeed ^ ((uint64_t)syscall(SYS_gettid) * 0x9E3779B97F4A7C15ULL)) | 1;
+    }
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    gRandom = x;
+    return (double)((x * 0x2545F4914F6CDD1DULL) >> 11) / (double)(1ULL << 53);
+}
+
+static int chance( double p )
+{
+    return (p > 0.0) && (random_unit() < p);
+}
+
+/* Short delays spin: a sleep overshoots them by the timer slack, typically 50 us */
+static void wait_ns( uint64_t ns )
+{
+    uint64_t deadline = now_ns() + ns;
+    struct timespec ts;
+
+    if (ns < FAULT_SPIN_NS)
+    {
+        while (now_ns() < deadline)
+        {
+        }
+        return;
+    }
+    ts.tv_sec = (time_t)(deadline / FAULT_NS_PER_SEC);
+    ts.tv_nsec = (long)(deadline % FAULT_NS_PER_SEC);
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) == EINTR)
+    {
+    }
+}
+
+static uint64_t latency_ns( const fault_rule_t *pRule )
+{
+    switch (pRule->latency)
+    {
+        case FAULT_LATENCY_FIXED:
+            return pRule->latencyA;
+        case FAULT_LATENCY_UNIFORM:
+            return pRule->latencyA + (uint64_t)(random_unit() * (double)(pRule->latencyB - pRule->latencyA));
+        case FAULT_LATENCY_EXP:
+            return (uint64_t)(-log(1.0 - random_unit()) * (double)pRule->latencyA);
+        default:
+            return 0;
+    }
+}
+
+/**
+* @brief Applies the delays of a call and decides whether it fails
+*
+* @return Non-zero with *pStatus set if the call is to fail without reaching the HAL
+*/
+static int fault_enter( fault_site_t *pSite, int *pStatus )
+{
+    const fault_rule_t *pRule = pSite->pRule;
+    uint64_t delay;
+
+    __atomic_add_fetch(&pSite->counters.calls, 1, __ATOMIC_RELAXED);
+    if (pRule == NULL)
+    {
+        return 0;
+    }
+    delay = latency_ns(pRule);
+    if (chance(pRule->stallP))
+    {
+        __atomic_add_fetch(&pSite->counters.stalls, 1, __ATOMIC_RELAXED);
+        delay += pRule->stallNs;
+    }
+    if (delay != 0)
+    {
+        __atomic_add_fetch(&pSite->counters.delayedNs, delay, __ATOMIC_RELAXED);
+        wait_ns(delay);
+    }
+    if (chance(pRule->errorP))
+    {
+        __atomic_add_fetch(&pSite->counters.errors, 1, __ATOMIC_RELAXED);
+        *pStatus = pRule->errorStatus;
+        return 1;
+    }
+    return 0;
+}
+
+/**
+* @brief Decides whether a call's output is cut short
+*/
+static int fault_partial( fault_site_t *pSite, const void *pOut )
+{
+    if (pSite->pRule == NULL || pOut == NULL || !chance(pSite->pRule->partialP))
+    {
+        return 0;
+    }
+    __atomic_add_fetch(&pSite->counters.partials, 1, __ATOMIC_RELAXED);
+    return 1;
+}
+
+static void fault_copy_partial( const fault_site_t *pSite, void *pOut, const void *pFull, size_t size )
+{
+    size_t bytes = (pSite->pRule->partialBytes < 0) ? size / 2 : (size_t)pSite->pRule->partialBytes;
+
+    memcpy(pOut, pFull, (bytes < size) ? bytes : size);
+}
+
+/**
+* @brief Returns the HAL's own definition of a getter, or NULL if none is loaded
+*/
+static void *fault_real( fault_site_t *pSite )
+{
+    void *pReal = __atomic_load_n(&pSite->pReal, __ATOMIC_ACQUIRE);
+
+    if (pReal == NULL && !__atomic_load_n(&pSite->missing, __ATOMIC_RELAXED))
+    {
+        pReal = dlsym(RTLD_NEXT, pSite->pName);
+        if (pReal == NULL)
+        {
+            fprintf(stderr, "hal_fault: %s is not defined by any library loaded after this one\n", pSite->pName);
+            __atomic_store_n(&pSite->missing, 1, __ATOMIC_RELAXED);
+        }
+        __atomic_store_n(&pSite->pReal, pReal, __ATOMIC_RELEASE);
+    }
+    return pReal;
+}
+
+#define FAULT_WRAPPER(function, shape, type, count) \
+    int function( HAL_PARAMS_##shape(type) ) \
+    { \
+        typedef int (*real_t)( HAL_PARAMS_##shape(type) ); \
+        fault_site_t *pSite = &gSites[HAL_ID_##function]; \
+        type full[count]; \
+        real_t real; \
+        int status; \
+        \
+        if (fault_enter(pSite, &status)) \
+        { \
+            return status; \
+        } \
+        real = (real_t)fault_real(pSite); \
+        if (real == NULL) \
+        { \
+            return -1; \
+        } \
+        if (!fault_partial(pSite, pOut)) \
+        { \
+            return real(HAL_ARGS_##shape(pOut)); \
+        } \
+        memset(full, 0, sizeof(full)); \
+        status = real(HAL_ARGS_##shape(full)); \
+        fault_copy_partial(pSite, pOut, full, sizeof(full)); \
+        return status; \
+    }
+
+HAL_SYMBOLS(FAULT_WRAPPER)
+
+/**
+* @brief Reads a duration such as "250us" into nanoseconds
+*
+* @return 0 on success, -1 if it is not a number with a unit
+*/
+static int parse_duration( const char *pText, char **ppEnd, uint64_t *pNs )
+{
+    static const struct { const char *pUnit; double scale; } units[] =
+    {
+        { "ns", 1.0 }, { "us", 1e3 }, { "ms", 1e6 }, { "s", 1e9 }
+    };
+    char *pEnd;
+    double value = strtod(pText, &pEnd);
+    uint32_t i;
+
+    if (pEnd == pText || value < 0.0)
+    {
+        return -1;
+    }
+    for (i = 0; i < sizeof(units) / sizeof(units[0]); i++)
+    {
+        size_t length = strlen(units[i].pUnit);
+
+        if (strncmp(pEnd, units[i].pUnit, length) == 0)
+        {
+            *pNs = (uint64_t)(value * units[i].scale);
+            *ppEnd = pEnd + length;
+            return 0;
+        }
+    }
+    return -1;
+}
+
+static int parse_probability( const char *pText, char **ppEnd, double *pP )
+{
+    char *pEnd;
+    double value = strtod(pText, &pEnd);
+
+    if (pEnd == pText)
+    {
+        return -1;
+    }
+    if (*pEnd == '%')
+    {
+        value /= 100.0;
+        pEnd++;
+    }
+    if (value < 0.0 || value > 1.0)
+    {
+        return -1;
+    }
+    *pP = value;
+    *ppEnd = pEnd;
+    return 0;
+}
+
+/**
+* @brief Parses one key=value of a rule
+*
+* @return 0 on success, -1 if the key is unknown or the value malformed
+*/
+static int parse_setting( fault_rule_t *pRule, const char *pSetting )
+{
+    const char *pValue = strchr(pSetting, '=');
+    char *pEnd = NULL;
+    int ok = 0;
+
+    if (pValue == NULL)
+    {
+        return -1;
+    }
+    pValue++;
+    if (strncmp(pSetting, "latency=", 8) == 0)
+    {
+        if (strncmp(pValue, "fixed:", 6) == 0)
+        {
+            pRule->latency = FAULT_LATENCY_FIXED;
+            ok = (parse_duration(pValue + 6, &pEnd, &pRule->latencyA) == 0);
+        }
+        else if (strncmp(pValue, "uniform:", 8) == 0)
+        {
+            pRule->latency = FAULT_LATENCY_UNIFORM;
+            ok = (parse_duration(pValue + 8, &pEnd, &pRule->latencyA) == 0 && *pEnd == ':' &&
+                  parse_duration(pEnd + 1, &pEnd, &pRule->latencyB) == 0 && pRule->latencyB >= pRule->latencyA);
+        }
+        else if (strncmp(pValue, "exp:", 4) == 0)
+        {
+            pRule->latency = FAULT_LATENCY_EXP;
+            ok = (parse_duration(pValue + 4, &pEnd, &pRule->latencyA) == 0);
+        }
+    }
+    else if (strncmp(pSetting, "stall=", 6) == 0)
+    {
+        ok = (parse_probability(pValue, &pEnd, &pRule->stallP) == 0 && *pEnd == ':' &&
+              parse_duration(pEnd + 1, &pEnd, &pRule->stallNs) == 0);
+    }
+    else if (strncmp(pSetting, "error=", 6) == 0)
+    {
+        ok = (parse_probability(pValue, &pEnd, &pRule->errorP) == 0);
+        if (ok && *pEnd == ':')
+        {
+            pRule->errorStatus = (int)strtol(pEnd + 1, &pEnd, 0);
+        }
+    }
+    else if (strncmp(pSetting, "partial=", 8) == 0)
+    {
+        ok = (parse_probability(pValue, &pEnd, &pRule->partialP) == 0);
+        if (ok && *pEnd == ':')
+        {
+            pRule->partialBytes = strtol(pEnd + 1, &pEnd, 0);
+            ok = (pRule->partialBytes >= 0);
+        }
+    }
+    return (ok && *pEnd == '\0') ? 0 : -1;
+}
+
+/**
+* @brief Parses one line of the configuration
+*
+* @return 0 on success or for a blank or comment line, -1 on an error
+*/
+static int parse_line( char *pLine )
+{
+    char *pSave = NULL;
+    char *pToken = strtok_r(pLine, " \t\r\n", &pSave);
+    fault_rule_t *pRule;
+
+    if (pToken == NULL || pToken[0] == '#')
+    {
+        return 0;
+    }
+    if (strcmp(pToken, "seed") == 0)
+    {
+        pToken = strtok_r(NULL, " \t\r\n", &pSave);
+        if (pToken == NULL)
+        {
+            return -1;
+        }
+        gSeed = strtoull(pToken, NULL, 0);
+        return 0;
+    }
+    if (gRuleCount == FAULT_RULES_MAX || strlen(pToken) >= FAULT_PATTERN_MAX)
+    {
+        return -1;
+    }
+    pRule = &gRules[gRuleCount];
+    memset(pRule, 0, sizeof(*pRule));
+    strcpy(pRule->pattern, pToken);
+    pRule->errorStatus = -1;
+    pRule->partialBytes = -1;
+    while ((pToken = strtok_r(NULL, " \t\r\n", &pSave)) != NULL)
+    {
+        if (parse_setting(pRule, pToken) != 0)
+        {
+            fprintf(stderr, "hal_fault: cannot parse \"%s\"\n", pToken);
+            return -1;
+        }
+    }
+    gRuleCount++;
+    return 0;
+}
+
+static void fault_report( void )
+{
+    const char *pPath = getenv(FAULT_REPORT_ENV);
+    uint64_t calls = 0;
+    FILE *pFile;
+    uint32_t i;
+
+    for (i = 0; i < HAL_SYMBOL_COUNT; i++)
+    {
+        calls += gSites[i].counters.calls;
+    }
+    if (pPath == NULL || calls == 0)
+    {
+        return;
+    }
+    /* Forked and spawned processes inherit the library, so each adds its own table */
+    pFile = (strcmp(pPath, "-") == 0) ? stderr : fopen(pPath, "a");
+    if (pFile == NULL)
+    {
+        fprintf(stderr, "hal_fault: cannot write %s\n", pPath);
+        return;
+    }
+    fprintf(pFile, "hal_fault: pid %d\n", (int)getpid());
+    fprintf(pFile, "%-40s %10s %14s %8s %8s %8s\n", "function", "calls", "delayed ms", "stalls", "errors", "partial");
+    for (i = 0; i < HAL_SYMBOL_COUNT; i++)
+    {
+        const fault_counters_t *pCounters = &gSites[i].counters;
+
+        if (pCounters->calls != 0)
+        {
+            fprintf(pFile, "%-40s %10llu %14.3f %8llu %8llu %8llu\n", gSites[i].pName, (unsigned long long)pCounters->calls,
+                    (double)pCounters->delayedNs / 1e6, (unsigned long long)pCounters->stalls,
+                    (unsigned long long)pCounters->errors, (unsigned long long)pCounters->partials);
+        }
+    }
+    if (pFile != stderr)
+    {
+        fclose(pFile);
+    }
+}
+
+__attribute__((constructor))
+static void fault_load( void )
+{
+    const char *pPath = getenv(FAULT_CONFIG_ENV);
+    char line[FAULT_LINE_MAX];
+    uint32_t lineNumber = 0;
+    FILE *pFile;
+    uint32_t i;
+    uint32_t r;
+
+    for (i = 0; i < HAL_SYMBOL_COUNT; i++)
+    {
+        gSites[i].pName = gSymbolNames[i];
+    }
+    atexit(fault_report);
+    if (pPath == NULL)
+    {
+        return;
+    }
+    pFile = fopen(pPath, "r");
+    if (pFile == NULL)
+    {
+        fprintf(stderr, "hal_fault: cannot read %s: %s\n", pPath, strerror(errno));
+        exit(EXIT_FAILURE);
+    }
+    while (fgets(line, sizeof(line), pFile) != NULL)
+    {
+        lineNumber++;
+        if (parse_line(line) != 0)
+        {
+            fprintf(stderr, "hal_fault: %s:%u: invalid rule\n", pPath, lineNumber);
+            exit(EXIT_FAILURE);
+        }
+    }
+    fclose(pFile);
+
+    for (i = 0; i < HAL_SYMBOL_COUNT; i++)
+    {
+        for (r = 0; r < gRuleCount; r++)
+        {
+            if (fnmatch(gRules[r].pattern, gSites[i].pName, 0) == 0)
+            {
+                gSites[i].pRule = &gRules[r];
+            }
+        }
+    }
+}
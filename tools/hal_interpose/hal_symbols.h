@@ -0,0 +1,180 @@
+/*
+* If not stated otherwise in this file or this component's LICENSE file the
+* following copyright and licenses apply:*
+* Copyright 2023 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+/**
+* @file hal_symbols.h
+*
+* Every dhcp4c_get_* and dhcpv4c_get_* getter, for libraries that interpose
+* on the HAL libraries with LD_PRELOAD.
+*
+* HAL_SYMBOLS(X) expands X(function, shape, C type, element count) once per
+* getter of the families the build selects (DHCP4CAPI, DHCPV4C_API and their
+* _EXT flags, as for the tests). The shape gives the arguments before the
+* output pointer, and HAL_PARAMS_<shape> and HAL_ARGS_<shape> spell them out,
+* so an interposer defines each getter with the HAL's own prototype:
+*
+* - OUT:   getter(type *pOut)
+* - IF:    getter(unsigned int ifIndex, type *pOut)
+* - NAME:  getter(const char *pIfname, type *pOut)
+*
+* The output is sizeof(type) * count bytes, as in src/test_getters.h.
+*/
+
+#ifndef __HAL_SYMBOLS_H__
+#define __HAL_SYMBOLS_H__
+
+#ifdef DHCP4CAPI
+#include "dhcp4cApi.h"
+#define HAL_DHCP4C_SYMBOLS(X) \
+    X(dhcp4c_get_ert_lease_time, OUT, unsigned int, 1) \
+    X(dhcp4c_get_ert_remain_lease_time, OUT, unsigned int, 1) \
+    X(dhcp4c_get_ert_remain_renew_time, OUT, unsigned int, 1) \
+    X(dhcp4c_get_ert_remain_rebind_time, OUT, unsigned int, 1) \
+    X(dhcp4c_get_ert_config_attempts, OUT, int, 1) \
+    X(dhcp4c_get_ert_ifname, OUT, char, 64) \
+    X(dhcp4c_get_ert_fsm_state, OUT, int, 1) \
+    X(dhcp4c_get_ert_ip_addr, OUT, unsigned int, 1) \
+    X(dhcp4c_get_ert_mask, OUT, unsigned int, 1) \
+    X(dhcp4c_get_ert_gw, OUT, unsigned int, 1) \
+    X(dhcp4c_get_ert_dns_svrs, OUT, ipv4AddrList_t, 1) \
+    X(dhcp4c_get_ert_dhcp_svr, OUT, unsigned int, 1) \
+    X(dhcp4c_get_ecm_lease_time, OUT, unsigned int, 1) \
+    X(dhcp4c_get_ecm_remain_lease_time, OUT, unsigned int, 1) \
+    X(dhcp4c_get_ecm_remain_renew_time, OUT, unsigned int, 1) \
+    X(dhcp4c_get_ecm_remain_rebind_time, OUT, unsigned int, 1) \
+    X(dhcp4c_get_ecm_config_attempts, OUT, int, 1) \
+    X(dhcp4c_get_ecm_ifname, OUT, char, 64) \
+    X(dhcp4c_get_ecm_fsm_state, OUT, int, 1) \
+    X(dhcp4c_get_ecm_ip_addr, OUT, unsigned int, 1) \
+    X(dhcp4c_get_ecm_mask, OUT, unsigned int, 1) \
+    X(dhcp4c_get_ecm_gw, OUT, unsigned int, 1) \
+    X(dhcp4c_get_ecm_dns_svrs, OUT, ipv4AddrList_t, 1) \
+    X(dhcp4c_get_ecm_dhcp_svr, OUT, unsigned int, 1) \
+    X(dhcp4c_get_emta_remain_lease_time, OUT, unsigned int, 1) \
+    X(dhcp4c_get_emta_remain_renew_time, OUT, unsigned int, 1) \
+    X(dhcp4c_get_emta_remain_rebind_time, OUT, unsigned int, 1)
+#else
+#define HAL_DHCP4C_SYMBOLS(X)
+#endif
+
+#ifdef DHCP4CAPI_EXT
+#include "dhcp4cApi_ext.h"
+#define HAL_DHCP4C_EXT_SYMBOLS(X) \
+    X(dhcp4c_get_if_count, OUT, unsigned int, 1) \
+    X(dhcp4c_get_if_index, NAME, unsigned int, 1) \
+    X(dhcp4c_get_if_lease_time, IF, unsigned int, 1) \
+    X(dhcp4c_get_if_remain_lease_time, IF, unsigned int, 1) \
+    X(dhcp4c_get_if_remain_renew_time, IF, unsigned int, 1) \
+    X(dhcp4c_get_if_remain_rebind_time, IF, unsigned int, 1) \
+    X(dhcp4c_get_if_config_attempts, IF, int, 1) \
+    X(dhcp4c_get_if_ifname, IF, char, DHCP4C_IFNAME_SIZE) \
+    X(dhcp4c_get_if_fsm_state, IF, int, 1) \
+    X(dhcp4c_get_if_ip_addr, IF, unsigned int, 1) \
+    X(dhcp4c_get_if_mask, IF, unsigned int, 1) \
+    X(dhcp4c_get_if_gw, IF, unsigned int, 1) \
+    X(dhcp4c_get_if_dns_svrs, IF, ipv4AddrList_t, 1) \
+    X(dhcp4c_get_if_dhcp_svr, IF, unsigned int, 1)
+#else
+#define HAL_DHCP4C_EXT_SYMBOLS(X)
+#endif
+
+#ifdef DHCPV4C_API
+#include "dhcpv4c_api.h"
+#define HAL_DHCPV4C_SYMBOLS(X) \
+    X(dhcpv4c_get_ert_lease_time, OUT, UINT, 1) \
+    X(dhcpv4c_get_ert_remain_lease_time, OUT, UINT, 1) \
+    X(dhcpv4c_get_ert_remain_renew_time, OUT, UINT, 1) \
+    X(dhcpv4c_get_ert_remain_rebind_time, OUT, UINT, 1) \
+    X(dhcpv4c_get_ert_config_attempts, OUT, INT, 1) \
+    X(dhcpv4c_get_ert_ifname, OUT, CHAR, 64) \
+    X(dhcpv4c_get_ert_fsm_state, OUT, INT, 1) \
+    X(dhcpv4c_get_ert_ip_addr, OUT, UINT, 1) \
+    X(dhcpv4c_get_ert_mask, OUT, UINT, 1) \
+    X(dhcpv4c_get_ert_gw, OUT, UINT, 1) \
+    X(dhcpv4c_get_ert_dns_svrs, OUT, dhcpv4c_ip_list_t, 1) \
+    X(dhcpv4c_get_ert_dhcp_svr, OUT, UINT, 1) \
+    X(dhcpv4c_get_ecm_lease_time, OUT, UINT, 1) \
+    X(dhcpv4c_get_ecm_remain_lease_time, OUT, UINT, 1) \
+    X(dhcpv4c_get_ecm_remain_renew_time, OUT, UINT, 1) \
+    X(dhcpv4c_get_ecm_remain_rebind_time, OUT, UINT, 1) \
+    X(dhcpv4c_get_ecm_config_attempts, OUT, INT, 1) \
+    X(dhcpv4c_get_ecm_ifname, OUT, CHAR, 64) \
+    X(dhcpv4c_get_ecm_fsm_state, OUT, INT, 1) \
+    X(dhcpv4c_get_ecm_ip_addr, OUT, UINT, 1) \
+    X(dhcpv4c_get_ecm_mask, OUT, UINT, 1) \
+    X(dhcpv4c_get_ecm_gw, OUT, UINT, 1) \
+    X(dhcpv4c_get_ecm_dns_svrs, OUT, dhcpv4c_ip_list_t, 1) \
+    X(dhcpv4c_get_ecm_dhcp_svr, OUT, UINT, 1) \
+    X(dhcpv4c_get_emta_remain_lease_time, OUT, UINT, 1) \
+    X(dhcpv4c_get_emta_remain_renew_time, OUT, UINT, 1) \
+    X(dhcpv4c_get_emta_remain_rebind_time, OUT, UINT, 1)
+#else
+#define HAL_DHCPV4C_SYMBOLS(X)
+#endif
+
+#ifdef DHCPV4C_API_EXT
+#include "dhcpv4c_api_ext.h"
+#define HAL_DHCPV4C_EXT_SYMBOLS(X) \
+    X(dhcpv4c_get_ert_snapshot, OUT, dhcpv4c_lease_snapshot_t, 1) \
+    X(dhcpv4c_get_ecm_snapshot, OUT, dhcpv4c_lease_snapshot_t, 1) \
+    X(dhcpv4c_get_emta_snapshot, OUT, dhcpv4c_emta_snapshot_t, 1) \
+    X(dhcpv4c_get_if_count, OUT, UINT, 1) \
+    X(dhcpv4c_get_if_index, NAME, UINT, 1) \
+    X(dhcpv4c_get_if_lease_time, IF, UINT, 1) \
+    X(dhcpv4c_get_if_remain_lease_time, IF, UINT, 1) \
+    X(dhcpv4c_get_if_remain_renew_time, IF, UINT, 1) \
+    X(dhcpv4c_get_if_remain_rebind_time, IF, UINT, 1) \
+    X(dhcpv4c_get_if_config_attempts, IF, INT, 1) \
+    X(dhcpv4c_get_if_ifname, IF, CHAR, DHCPV4C_IFNAME_SIZE) \
+    X(dhcpv4c_get_if_fsm_state, IF, INT, 1) \
+    X(dhcpv4c_get_if_ip_addr, IF, UINT, 1) \
+    X(dhcpv4c_get_if_mask, IF, UINT, 1) \
+    X(dhcpv4c_get_if_gw, IF, UINT, 1) \
+    X(dhcpv4c_get_if_dns_svrs, IF, dhcpv4c_ip_list_t, 1) \
+    X(dhcpv4c_get_if_dhcp_svr, IF, UINT, 1) \
+    X(dhcpv4c_get_if_snapshot, IF, dhcpv4c_lease_snapshot_t, 1)
+#else
+#define HAL_DHCPV4C_EXT_SYMBOLS(X)
+#endif
+
+#define HAL_SYMBOLS(X) \
+    HAL_DHCP4C_SYMBOLS(X) \
+    HAL_DHCP4C_EXT_SYMBOLS(X) \
+    HAL_DHCPV4C_SYMBOLS(X) \
+    HAL_DHCPV4C_EXT_SYMBOLS(X)
+
+#define HAL_PARAMS_OUT(type)    type *pOut
+#define HAL_PARAMS_IF(type)     unsigned int ifIndex, type *pOut
+#define HAL_PARAMS_NAME(type)   const char *pIfname, type *pOut
+#define HAL_ARGS_OUT(out)       out
+#define HAL_ARGS_IF(out)        ifIndex, out
+#define HAL_ARGS_NAME(out)      pIfname, out
+
+#define HAL_SYMBOL_ID(function, shape, type, count)    HAL_ID_##function,
+#define HAL_SYMBOL_NAME(function, shape, type, count)  #function,
+
+/**
+* @brief Index of every getter, in HAL_SYMBOLS() order
+*/
+typedef enum
+{
+    HAL_SYMBOLS(HAL_SYMBOL_ID)
+    HAL_SYMBOL_COUNT
+} hal_symbol_id_t;
+
+#endif /* __HAL_SYMBOLS_H__ */
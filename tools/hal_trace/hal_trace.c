@@ -0,0 +1,339 @@
+/*
+* If not stated otherwise in this file or this component's LICENSE file the
+* following copyright and licenses apply:*
+* Copyright 2023 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+/**
+* @file hal_trace.c
+*
+* Segment, ring ownership and the record path of hal_trace.h.
+*
+* A thread keeps its ring, and the tail it last saw, in thread-local
+* storage, so that recording reads the reader's cache line only when the
+* ring looks full. The variables use the initial-exec model, which reaches
+* them through the thread pointer rather than __tls_get_addr() when this is
+* built into bin/libhal_trace.so. hal_trace_attach() bumps a generation number that makes
+* every thread take a ring afresh in the new segment; a forked child starts
+* without a ring, since the one it inherited belongs to its parent.
+*/
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include "hal_trace.h"
+
+#define TRACE_OPEN_WAIT_MS  1000    /* Longest wait for another process to initialise the segment */
+#define TRACE_RETRY_CALLS   4096    /* Calls left untraced before looking for a free ring again */
+#define TRACE_TLS           __thread __attribute__((tls_model("initial-exec")))
+
+typedef char hal_trace_record_size_check[(sizeof(hal_trace_record_t) == 24) ? 1 : -1];
+typedef char hal_trace_slots_check[((HAL_TRACE_SLOTS & (HAL_TRACE_SLOTS - 1)) == 0) ? 1 : -1];
+
+static hal_trace_segment_t *gSegment;
+static uint32_t gGeneration;
+static pthread_once_t gOnce = PTHREAD_ONCE_INIT;
+static pthread_key_t gRingKey;
+
+static TRACE_TLS hal_trace_ring_t *gRing;
+static TRACE_TLS uint32_t gRingGeneration;
+static TRACE_TLS uint64_t gCachedTail;
+static TRACE_TLS uint64_t gOwner;
+static TRACE_TLS uint32_t gRetryCalls;
+
+int gHalTraceCounter;
+
+static void release_ring( void *pValue )
+{
+    hal_trace_ring_t *pRing = pValue;
+
+    /* A ring of a segment since detached may no longer be mapped */
+    if (pRing != NULL && pRing == gRing && gRingGeneration == __atomic_load_n(&gGeneration, __ATOMIC_ACQUIRE))
+    {
+        __atomic_store_n(&pRing->owner, 0, __ATOMIC_RELEASE);
+    }
+    gRing = NULL;
+}
+
+static void forget_ring( void )
+{
+    gRing = NULL;
+    gOwner = 0;
+    gRetryCalls = 0;
+}
+
+static void trace_init_once( void )
+{
+    pthread_key_create(&gRingKey, release_ring);
+    pthread_atfork(NULL, NULL, forget_ring);
+}
+
+/**
+* @brief Tells whether the kernel itself keeps time with the counter hal_trace_now() reads
+*
+* The kernel only does so when the counter is constant in rate and the same
+* on every CPU, which is what the reader's conversion to nanoseconds needs.
+*/
+static int counter_usable( void )
+{
+#if defined(__x86_64__) || defined(__i386__) || defined(__aarch64__)
+    char source[32] = "";
+    FILE *pFile = fopen(HAL_TRACE_CLOCKSOURCE, "r");
+
+    if (pFile == NULL)
+    {
+        return 0;
+    }
+    if (fgets(source, sizeof(source), pFile) == NULL)
+    {
+        source[0] = '\0';
+    }
+    fclose(pFile);
+    return (strncmp(source, "tsc\n", 4) == 0) || (strncmp(source, "arch_sys_counter\n", 17) == 0);
+#else
+    return 0;
+#endif
+}
+
+static int owner_alive( uint64_t owner )
+{
+    return (kill((pid_t)(owner >> 32), 0) == 0) || (errno != ESRCH);
+}
+
+/**
+* @brief Takes a free ring for the calling thread, or one whose process has died
+*
+* @return The ring, or NULL if every ring belongs to a live thread
+*/
+static hal_trace_ring_t *claim_ring( hal_trace_segment_t *pSegment, uint32_t generation )
+{
+    uint32_t tid = (uint32_t)syscall(SYS_gettid);
+    uint32_t pass;
+    uint32_t n;
+
+    pthread_once(&gOnce, trace_init_once);
+    gOwner = ((uint64_t)(uint32_t)getpid() << 32) | tid;
+    for (pass = 0; pass < 2; pass++)
+    {
+        for (n = 0; n < HAL_TRACE_RINGS; n++)
+        {
+            hal_trace_ring_t *pRing = &pSegment->rings[(tid + n) % HAL_TRACE_RINGS];
+            uint64_t owner = __atomic_load_n(&pRing->owner, __ATOMIC_RELAXED);
+
+            if ((owner == 0 || (pass == 1 && !owner_alive(owner))) &&
+                __atomic_compare_exchange_n(&pRing->owner, &owner, gOwner, 0, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
+            {
+                gRing = pRing;
+                gRingGeneration = generation;
+                gCachedTail = __atomic_load_n(&pRing->tail, __ATOMIC_ACQUIRE);
+                pthread_setspecific(gRingKey, pRing);
+                return pRing;
+            }
+        }
+    }
+    return NULL;
+}
+
+hal_trace_segment_t *hal_trace_open( const char *pName )
+{
+    hal_trace_segment_t *pSegment;
+    struct stat st;
+    uint32_t waited = 0;
+    int created = 1;
+    int fd;
+
+    fd = shm_open(pName, O_RDWR | O_CREAT | O_EXCL, 0660);
+    if (fd < 0 && errno == EEXIST)
+    {
+        created = 0;
+        fd = shm_open(pName, O_RDWR, 0);
+    }
+    if (fd < 0)
+    {
+        return NULL;
+    }
+    if (created && ftruncate(fd, sizeof(hal_trace_segment_t)) != 0)
+    {
+        close(fd);
+        shm_unlink(pName);
+        return NULL;
+    }
+    /* Another process may have created the segment and not sized it yet */
+    while (fstat(fd, &st) == 0 && st.st_size < (off_t)sizeof(hal_trace_segment_t) && waited++ < TRACE_OPEN_WAIT_MS)
+    {
+        usleep(1000);
+    }
+    pSegment = mmap(NULL, sizeof(hal_trace_segment_t), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (pSegment == MAP_FAILED)
+    {
+        return NULL;
+    }
+    if (created)
+    {
+        pSegment->version = HAL_TRACE_VERSION;
+        pSegment->ringCount = HAL_TRACE_RINGS;
+        pSegment->slotCount = HAL_TRACE_SLOTS;
+        pSegment->clock = counter_usable() ? HAL_TRACE_CLOCK_COUNTER : HAL_TRACE_CLOCK_MONOTONIC;
+        __atomic_store_n(&pSegment->magic, HAL_TRACE_MAGIC, __ATOMIC_RELEASE);
+    }
+    while (__atomic_load_n(&pSegment->magic, __ATOMIC_ACQUIRE) != HAL_TRACE_MAGIC && waited++ < TRACE_OPEN_WAIT_MS)
+    {
+        usleep(1000);
+    }
+    if (pSegment->magic != HAL_TRACE_MAGIC || pSegment->version != HAL_TRACE_VERSION ||
+        pSegment->ringCount != HAL_TRACE_RINGS || pSegment->slotCount != HAL_TRACE_SLOTS)
+    {
+        munmap(pSegment, sizeof(hal_trace_segment_t));
+        return NULL;
+    }
+    gHalTraceCounter = (pSegment->clock == HAL_TRACE_CLOCK_COUNTER);
+    return pSegment;
+}
+
+void hal_trace_close( hal_trace_segment_t *pSegment )
+{
+    if (pSegment != NULL)
+    {
+        munmap(pSegment, sizeof(hal_trace_segment_t));
+    }
+}
+
+void hal_trace_unlink( const char *pName )
+{
+    shm_unlink(pName);
+}
+
+void hal_trace_set_functions( hal_trace_segment_t *pSegment, const char *const *ppNames, uint32_t count )
+{
+    uint32_t expected = 0;
+    uint32_t i;
+
+    if (count > HAL_TRACE_FUNCTIONS_MAX)
+    {
+        count = HAL_TRACE_FUNCTIONS_MAX;
+    }
+    if (!__atomic_compare_exchange_n(&pSegment->functionsClaimed, &expected, 1, 0, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
+    {
+        return;
+    }
+    for (i = 0; i < count; i++)
+    {
+        strncpy(pSegment->functions[i], ppNames[i], HAL_TRACE_FUNCTION_LEN - 1);
+    }
+    __atomic_store_n(&pSegment->functionCount, count, __ATOMIC_RELEASE);
+}
+
+void hal_trace_attach( hal_trace_segment_t *pSegment )
+{
+    if (gRing != NULL && gRingGeneration == __atomic_load_n(&gGeneration, __ATOMIC_RELAXED))
+    {
+        __atomic_store_n(&gRing->owner, 0, __ATOMIC_RELEASE);
+    }
+    gRing = NULL;
+    gRetryCalls = 0;
+    /* A thread that sees the new generation also sees the new segment */
+    __atomic_store_n(&gSegment, pSegment, __ATOMIC_RELEASE);
+    __atomic_add_fetch(&gGeneration, 1, __ATOMIC_RELEASE);
+}
+
+void hal_trace_record( uint16_t function, uint64_t start, uint64_t end, int status )
+{
+    hal_trace_ring_t *pRing = gRing;
+    uint32_t generation = __atomic_load_n(&gGeneration, __ATOMIC_ACQUIRE);
+    hal_trace_record_t *pRecord;
+    uint64_t duration = end - start;
+    uint64_t head;
+
+    if (pRing == NULL || gRingGeneration != generation)
+    {
+        hal_trace_segment_t *pSegment = __atomic_load_n(&gSegment, __ATOMIC_ACQUIRE);
+
+        if (pSegment == NULL)
+        {
+            return;
+        }
+        /* Every ring taken: look again some calls later rather than on every call */
+        pRing = (gRetryCalls == 0) ? claim_ring(pSegment, generation) : NULL;
+        if (pRing == NULL)
+        {
+            gRetryCalls = (gRetryCalls == 0) ? TRACE_RETRY_CALLS : gRetryCalls - 1;
+            __atomic_add_fetch(&pSegment->untraced, 1, __ATOMIC_RELAXED);
+            return;
+        }
+    }
+    head = pRing->head;
+    if (head - gCachedTail >= HAL_TRACE_SLOTS)
+    {
+        gCachedTail = __atomic_load_n(&pRing->tail, __ATOMIC_ACQUIRE);
+        if (head - gCachedTail >= HAL_TRACE_SLOTS)
+        {
+            __atomic_store_n(&pRing->dropped, pRing->dropped + 1, __ATOMIC_RELAXED);
+            return;
+        }
+    }
+    pRecord = &pRing->records[head & (HAL_TRACE_SLOTS - 1)];
+    pRecord->start = start;
+    pRecord->duration = (duration > UINT32_MAX) ? UINT32_MAX : (uint32_t)duration;
+    pRecord->pid = (uint32_t)(gOwner >> 32);
+    pRecord->tid = (uint32_t)gOwner;
+    pRecord->function = function;
+    pRecord->status = (int16_t)status;
+    __atomic_store_n(&pRing->head, head + 1, __ATOMIC_RELEASE);
+}
+
+uint32_t hal_trace_drain( hal_trace_segment_t *pSegment, hal_trace_record_t *pRecords, uint32_t max )
+{
+    uint32_t count = 0;
+    uint32_t r;
+
+    for (r = 0; r < HAL_TRACE_RINGS && count < max; r++)
+    {
+        hal_trace_ring_t *pRing = &pSegment->rings[r];
+        uint64_t tail = __atomic_load_n(&pRing->tail, __ATOMIC_RELAXED);
+        uint64_t head = __atomic_load_n(&pRing->head, __ATOMIC_ACQUIRE);
+
+        while (tail != head && count < max)
+        {
+            pRecords[count++] = pRing->records[tail & (HAL_TRACE_SLOTS - 1)];
+            tail++;
+        }
+        __atomic_store_n(&pRing->tail, tail, __ATOMIC_RELEASE);
+    }
+    return count;
+}
+
+uint64_t hal_trace_dropped( const hal_trace_segment_t *pSegment )
+{
+    uint64_t dropped = 0;
+    uint32_t r;
+
+    for (r = 0; r < HAL_TRACE_RINGS; r++)
+    {
+        dropped += __atomic_load_n(&pSegment->rings[r].dropped, __ATOMIC_RELAXED);
+    }
+    return dropped;
+}
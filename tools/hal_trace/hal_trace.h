@@ -0,0 +1,221 @@
+/*
+* If not stated otherwise in this file or this component's LICENSE file the
+* following copyright and licenses apply:*
+* Copyright 2023 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+/**
+* @file hal_trace.h
+*
+* Shared memory call trace of the HAL getters.
+*
+* The segment holds HAL_TRACE_RINGS single-producer, single-consumer rings.
+* A thread that records a call takes a free ring for itself on its first
+* call and gives it back when it exits; a ring left by a process that died
+* is taken over by the next thread that finds none free. Recording a call
+* is two clock reads, a 24-byte copy and a release store: no lock and no
+* system call. When the reader falls behind and a ring is full, the call is
+* counted as dropped instead of waiting, so a traced caller is never slowed
+* down by the reader.
+*
+* Where the kernel keeps time with the CPU's own counter (the TSC on x86,
+* the generic timer on AArch64), records hold its raw ticks, which are
+* cheaper to read than CLOCK_MONOTONIC; the reader converts them to
+* nanoseconds. The process that creates the segment chooses, and every
+* other process records in the same units.
+*
+* There is one reader, which drains every ring with hal_trace_drain().
+* Records carry the process and thread that made the call, so a ring can
+* pass from thread to thread without the reader losing track.
+*/
+
+#ifndef __HAL_TRACE_H__
+#define __HAL_TRACE_H__
+
+#include <stdint.h>
+#include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#define HAL_TRACE_DEFAULT_NAME  "/hal_trace"   /*!< Segment used when $HAL_TRACE_SHM is not set */
+#define HAL_TRACE_NAME_ENV      "HAL_TRACE_SHM"
+#define HAL_TRACE_MAGIC         0x48545243U    /*!< "HTRC" */
+#define HAL_TRACE_VERSION       1
+#define HAL_TRACE_CLOCKSOURCE   "/sys/devices/system/clocksource/clocksource0/current_clocksource"
+#define HAL_TRACE_RINGS         64             /*!< Threads that can record at once */
+#define HAL_TRACE_SLOTS         1024           /*!< Records per ring, a power of two */
+#define HAL_TRACE_FUNCTIONS_MAX 128
+#define HAL_TRACE_FUNCTION_LEN  48
+#define HAL_TRACE_CACHE_LINE    64
+
+/**
+* @brief What the times of a segment's records count
+*/
+typedef enum
+{
+    HAL_TRACE_CLOCK_MONOTONIC = 0,  /*!< CLOCK_MONOTONIC nanoseconds */
+    HAL_TRACE_CLOCK_COUNTER         /*!< Ticks of the CPU counter, see hal_trace_now() */
+} hal_trace_clock_t;
+
+/**
+* @brief One traced call
+*/
+typedef struct
+{
+    uint64_t start;         /*!< hal_trace_now() when the call was made */
+    uint32_t duration;      /*!< In the same units; saturates at UINT32_MAX, over a second */
+    uint32_t pid;
+    uint32_t tid;
+    uint16_t function;      /*!< Index into hal_trace_segment_t.functions */
+    int16_t  status;        /*!< What the getter returned */
+} hal_trace_record_t;
+
+/**
+* @brief Ring of one thread
+*
+* head is written by the owning thread only and tail by the reader only,
+* each on its own cache line.
+*/
+typedef struct
+{
+    uint64_t owner;         /*!< (pid << 32) | thread id of the producer, 0 if free */
+    uint64_t dropped;       /*!< Calls not recorded because the ring was full */
+    uint8_t  pad0[HAL_TRACE_CACHE_LINE - 16];
+    uint64_t head;
+    uint8_t  pad1[HAL_TRACE_CACHE_LINE - 8];
+    uint64_t tail;
+    uint8_t  pad2[HAL_TRACE_CACHE_LINE - 8];
+    hal_trace_record_t records[HAL_TRACE_SLOTS];
+} hal_trace_ring_t;
+
+/**
+* @brief The shared memory segment
+*/
+typedef struct
+{
+    uint32_t magic;         /*!< HAL_TRACE_MAGIC once initialised */
+    uint32_t version;
+    uint32_t ringCount;
+    uint32_t slotCount;
+    uint32_t clock;         /*!< hal_trace_clock_t of every record */
+    uint32_t functionsClaimed;  /*!< Set by the process that writes the function names */
+    uint32_t functionCount;     /*!< Names readable, 0 until they are written */
+    uint64_t untraced;      /*!< Calls not recorded because no ring was free */
+    char     functions[HAL_TRACE_FUNCTIONS_MAX][HAL_TRACE_FUNCTION_LEN];
+    hal_trace_ring_t rings[HAL_TRACE_RINGS] __attribute__((aligned(HAL_TRACE_CACHE_LINE)));
+} hal_trace_segment_t;
+
+/** Non-zero when the mapped segment counts in HAL_TRACE_CLOCK_COUNTER ticks; read by hal_trace_now() */
+extern int gHalTraceCounter;
+
+/**
+* @brief Returns CLOCK_MONOTONIC in nanoseconds
+*/
+static inline uint64_t hal_trace_now_ns( void )
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/**
+* @brief Returns the current time in the units of the mapped segment
+*/
+static inline uint64_t hal_trace_now( void )
+{
+#if defined(__x86_64__) || defined(__i386__)
+    if (gHalTraceCounter)
+    {
+        return __rdtsc();
+    }
+#elif defined(__aarch64__)
+    if (gHalTraceCounter)
+    {
+        uint64_t ticks;
+
+        __asm__ __volatile__("mrs %0, cntvct_el0" : "=r"(ticks));
+        return ticks;
+    }
+#endif
+    return hal_trace_now_ns();
+}
+
+/**
+* @brief Maps a trace segment, creating it if it does not exist
+*
+* hal_trace_now() then counts in the segment's units.
+*
+* @param[in] pName - POSIX shared memory name, such as HAL_TRACE_DEFAULT_NAME
+*
+* @return The segment, or NULL if it cannot be created or has another layout
+*/
+hal_trace_segment_t *hal_trace_open( const char *pName );
+
+/**
+* @brief Unmaps a segment; the segment itself stays until hal_trace_unlink()
+*/
+void hal_trace_close( hal_trace_segment_t *pSegment );
+
+/**
+* @brief Removes a segment's name; mappings stay valid until closed
+*/
+void hal_trace_unlink( const char *pName );
+
+/**
+* @brief Writes the function names records refer to, unless another process already has
+*
+* @param[in] ppNames - Names, indexed by the function field of a record
+* @param[in] count   - Number of names, at most HAL_TRACE_FUNCTIONS_MAX
+*/
+void hal_trace_set_functions( hal_trace_segment_t *pSegment, const char *const *ppNames, uint32_t count );
+
+/**
+* @brief Makes the calling process record into a segment, NULL to stop
+*
+* Each thread takes a ring on its next hal_trace_record().
+*/
+void hal_trace_attach( hal_trace_segment_t *pSegment );
+
+/**
+* @brief Records one call of the calling thread
+*
+* @param[in] function - Index of the function
+* @param[in] start    - hal_trace_now() before the call
+* @param[in] end      - hal_trace_now() after it
+* @param[in] status   - What the call returned
+*/
+void hal_trace_record( uint16_t function, uint64_t start, uint64_t end, int status );
+
+/**
+* @brief Moves recorded calls out of every ring
+*
+* Only one reader may drain a segment at a time. Records come out ring by
+* ring, each ring's in the order they were made.
+*
+* @param[out] pRecords - Receives the records
+* @param[in]  max      - Capacity of pRecords
+*
+* @return Number of records written to pRecords
+*/
+uint32_t hal_trace_drain( hal_trace_segment_t *pSegment, hal_trace_record_t *pRecords, uint32_t max );
+
+/**
+* @brief Sums the calls dropped for full rings over every ring
+*/
+uint64_t hal_trace_dropped( const hal_trace_segment_t *pSegment );
+
+#endif /* __HAL_TRACE_H__ */
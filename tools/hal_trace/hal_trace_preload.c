@@ -0,0 +1,117 @@
+/*
+* If not stated otherwise in this file or this component's LICENSE file the
+* following copyright and licenses apply:*
+* Copyright 2023 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+/**
+* @file hal_trace_preload.c
+*
+* LD_PRELOAD library that records every HAL getter call into the trace
+* segment of hal_trace.h.
+*
+* It defines every getter of tools/hal_interpose/hal_symbols.h, times the
+* call to the HAL library loaded after it and records the process, thread,
+* getter, start, duration and status. The segment is $HAL_TRACE_SHM, else
+* /hal_trace, created by whichever traced process or reader comes first;
+* tools/hal_trace/hal_trace_reader.c drains it. If the segment cannot be
+* mapped the calls are passed on untraced.
+*/
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <dlfcn.h>
+#include "hal_symbols.h"
+#include "hal_trace.h"
+
+typedef char hal_trace_functions_check[(HAL_SYMBOL_COUNT <= HAL_TRACE_FUNCTIONS_MAX) ? 1 : -1];
+
+static const char *const gSymbolNames[] = { HAL_SYMBOLS(HAL_SYMBOL_NAME) };
+static void *gReal[HAL_SYMBOL_COUNT];
+static int gMissing[HAL_SYMBOL_COUNT];
+static hal_trace_segment_t *gTraceSegment;
+
+/**
+* @brief Returns the HAL's own definition of a getter, or NULL if none is loaded
+*/
+static void *trace_real( hal_symbol_id_t id )
+{
+    void *pReal = __atomic_load_n(&gReal[id], __ATOMIC_ACQUIRE);
+
+    if (pReal == NULL && !__atomic_load_n(&gMissing[id], __ATOMIC_RELAXED))
+    {
+        pReal = dlsym(RTLD_NEXT, gSymbolNames[id]);
+        if (pReal == NULL)
+        {
+            fprintf(stderr, "hal_trace: %s is not defined by any library loaded after this one\n", gSymbolNames[id]);
+            __atomic_store_n(&gMissing[id], 1, __ATOMIC_RELAXED);
+        }
+        __atomic_store_n(&gReal[id], pReal, __ATOMIC_RELEASE);
+    }
+    return pReal;
+}
+
+#define TRACE_WRAPPER(function, shape, type, count) \
+    int function( HAL_PARAMS_##shape(type) ) \
+    { \
+        typedef int (*real_t)( HAL_PARAMS_##shape(type) ); \
+        real_t real = (real_t)trace_real(HAL_ID_##function); \
+        uint64_t start; \
+        int status; \
+        \
+        if (real == NULL) \
+        { \
+            return -1; \
+        } \
+        start = hal_trace_now(); \
+        status = real(HAL_ARGS_##shape(pOut)); \
+        hal_trace_record(HAL_ID_##function, start, hal_trace_now(), status); \
+        return status; \
+    }
+
+HAL_SYMBOLS(TRACE_WRAPPER)
+
+__attribute__((constructor))
+static void trace_load( void )
+{
+    const char *pName = getenv(HAL_TRACE_NAME_ENV);
+
+    if (pName == NULL)
+    {
+        pName = HAL_TRACE_DEFAULT_NAME;
+    }
+    gTraceSegment = hal_trace_open(pName);
+    if (gTraceSegment == NULL)
+    {
+        fprintf(stderr, "hal_trace: cannot map %s, calls are not traced\n", pName);
+        return;
+    }
+    hal_trace_set_functions(gTraceSegment, gSymbolNames, HAL_SYMBOL_COUNT);
+    hal_trace_attach(gTraceSegment);
+}
+
+/* Gives back the ring of the thread that exits the process; the rings of others are taken over once it has gone */
+__attribute__((destructor))
+static void trace_unload( void )
+{
+    if (gTraceSegment != NULL)
+    {
+        hal_trace_attach(NULL);
+    }
+}
@@ -0,0 +1,307 @@
+/*
+* If not stated otherwise in this file or this component's LICENSE file the
+* following copyright and licenses apply:*
+* Copyright 2023 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+/**
+* @file hal_trace_reader.c
+*
+* Drains the HAL call trace written by bin/libhal_trace.so.
+*
+*   hal_trace_reader [-n name] [-i ms] [-s] [-1] [-u]
+*
+* By default every call is printed as it is drained, one line each:
+* "<start ns> <pid> <tid> <function> <duration ns> <status>", in start order
+* within each drain. -s prints instead, on exit, calls, failures, mean and
+* maximum duration per process and function. The reader drains every -i
+* milliseconds (default 100) until interrupted, or once with -1. It creates
+* the segment if no traced process has yet, so it can be started first; -u
+* removes it on exit. Calls dropped because the reader fell behind, and
+* calls made while every ring was taken, are reported on exit.
+*
+* A segment that counts CPU counter ticks is converted to CLOCK_MONOTONIC
+* nanoseconds by pairing counter and clock readings: once over
+* READER_CALIBRATE_MS at start, then again at every drain, over the whole
+* time the reader has run.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <signal.h>
+#include <unistd.h>
+#include "hal_trace.h"
+
+#define READER_DEFAULT_INTERVAL_MS  100
+#define READER_CAPACITY             (HAL_TRACE_RINGS * HAL_TRACE_SLOTS)
+#define READER_SUMMARY_MAX          4096    /* Distinct process and function pairs, a power of two */
+#define READER_CALIBRATE_MS         20
+
+typedef struct
+{
+    uint64_t ticks;
+    uint64_t ns;
+    double   nsPerTick;     /*!< 1 for a CLOCK_MONOTONIC segment */
+} reader_clock_t;
+
+typedef struct
+{
+    uint32_t pid;
+    uint16_t function;
+    uint16_t used;
+    uint64_t calls;
+    uint64_t failed;
+    uint64_t totalNs;
+    uint32_t maxNs;
+} summary_t;
+
+static volatile sig_atomic_t gStop = 0;
+static summary_t gSummary[READER_SUMMARY_MAX];
+static uint64_t gSummaryOverflow;
+
+static void on_signal( int signum )
+{
+    (void)signum;
+    gStop = 1;
+}
+
+/* A counter reading and the clock at the same moment, as the middle of two clock reads */
+static void clock_pair( uint64_t *pTicks, uint64_t *pNs )
+{
+    uint64_t before = hal_trace_now_ns();
+
+    *pTicks = hal_trace_now();
+    *pNs = before + (hal_trace_now_ns() - before) / 2;
+}
+
+static void clock_start( reader_clock_t *pClock )
+{
+    pClock->ticks = 0;
+    pClock->ns = 0;
+    pClock->nsPerTick = 1.0;
+    if (gHalTraceCounter)
+    {
+        clock_pair(&pClock->ticks, &pClock->ns);
+        usleep(READER_CALIBRATE_MS * 1000);
+    }
+}
+
+static void clock_update( reader_clock_t *pClock )
+{
+    uint64_t ticks;
+    uint64_t ns;
+
+    if (gHalTraceCounter)
+    {
+        clock_pair(&ticks, &ns);
+        if (ticks > pClock->ticks)
+        {
+            pClock->nsPerTick = (double)(ns - pClock->ns) / (double)(ticks - pClock->ticks);
+        }
+    }
+}
+
+static uint64_t clock_ns( const reader_clock_t *pClock, uint64_t time )
+{
+    if (!gHalTraceCounter)
+    {
+        return time;
+    }
+    /* Calls recorded before the reader started come before its first pair */
+    return pClock->ns + (int64_t)((double)(int64_t)(time - pClock->ticks) * pClock->nsPerTick);
+}
+
+static int by_start( const void *pA, const void *pB )
+{
+    const hal_trace_record_t *pRecordA = pA;
+    const hal_trace_record_t *pRecordB = pB;
+
+    return (pRecordA->start > pRecordB->start) - (pRecordA->start < pRecordB->start);
+}
+
+static const char *function_name( const hal_trace_segment_t *pSegment, uint16_t function, char *pBuffer, size_t size )
+{
+    if (function < __atomic_load_n(&pSegment->functionCount, __ATOMIC_ACQUIRE))
+    {
+        return pSegment->functions[function];
+    }
+    snprintf(pBuffer, size, "#%u", function);
+    return pBuffer;
+}
+
+/* Open addressing on pid and function */
+static void summarise( const hal_trace_record_t *pRecord, uint32_t durationNs )
+{
+    uint32_t slot = (pRecord->pid * 2654435761U + pRecord->function) & (READER_SUMMARY_MAX - 1);
+    uint32_t probes;
+
+    for (probes = 0; probes < READER_SUMMARY_MAX; probes++, slot = (slot + 1) & (READER_SUMMARY_MAX - 1))
+    {
+        summary_t *pEntry = &gSummary[slot];
+
+        if (!pEntry->used)
+        {
+            pEntry->used = 1;
+            pEntry->pid = pRecord->pid;
+            pEntry->function = pRecord->function;
+        }
+        if (pEntry->pid == pRecord->pid && pEntry->function == pRecord->function)
+        {
+            pEntry->calls++;
+            pEntry->failed += (pRecord->status != 0);
+            pEntry->totalNs += durationNs;
+            pEntry->maxNs = (durationNs > pEntry->maxNs) ? durationNs : pEntry->maxNs;
+            return;
+        }
+    }
+    gSummaryOverflow++;
+}
+
+static void print_summary( const hal_trace_segment_t *pSegment )
+{
+    char name[16];
+    uint32_t i;
+
+    printf("%8s  %-40s %10s %8s %12s %12s\n", "pid", "function", "calls", "failed", "mean ns", "max ns");
+    for (i = 0; i < READER_SUMMARY_MAX; i++)
+    {
+        const summary_t *pEntry = &gSummary[i];
+
+        if (pEntry->used)
+        {
+            printf("%8u  %-40s %10llu %8llu %12llu %12u\n", pEntry->pid,
+                   function_name(pSegment, pEntry->function, name, sizeof(name)), (unsigned long long)pEntry->calls,
+                   (unsigned long long)pEntry->failed, (unsigned long long)(pEntry->totalNs / pEntry->calls), pEntry->maxNs);
+        }
+    }
+    if (gSummaryOverflow != 0)
+    {
+        printf("%llu calls of further processes and functions not summarised\n", (unsigned long long)gSummaryOverflow);
+    }
+}
+
+static void usage( const char *pProgram )
+{
+    fprintf(stderr, "usage: %s [-n name] [-i ms] [-s] [-1] [-u]\n", pProgram);
+    fprintf(stderr, "  -n  shared memory segment, default $%s or %s\n", HAL_TRACE_NAME_ENV, HAL_TRACE_DEFAULT_NAME);
+    fprintf(stderr, "  -i  drain interval in milliseconds, default %u\n", READER_DEFAULT_INTERVAL_MS);
+    fprintf(stderr, "  -s  print a summary per process and function on exit instead of every call\n");
+    fprintf(stderr, "  -1  drain once and exit\n");
+    fprintf(stderr, "  -u  remove the segment on exit\n");
+}
+
+int main( int argc, char **argv )
+{
+    const char *pName = getenv(HAL_TRACE_NAME_ENV);
+    uint32_t intervalMs = READER_DEFAULT_INTERVAL_MS;
+    int summary = 0;
+    int once = 0;
+    int unlinkOnExit = 0;
+    hal_trace_segment_t *pSegment;
+    hal_trace_record_t *pRecords;
+    reader_clock_t clock;
+    uint64_t total = 0;
+    int option;
+
+    while ((option = getopt(argc, argv, "n:i:s1u")) != -1)
+    {
+        switch (option)
+        {
+            case 'n':
+                pName = optarg;
+                break;
+            case 'i':
+                intervalMs = (uint32_t)strtoul(optarg, NULL, 0);
+                break;
+            case 's':
+                summary = 1;
+                break;
+            case '1':
+                once = 1;
+                break;
+            case 'u':
+                unlinkOnExit = 1;
+                break;
+            default:
+                usage(argv[0]);
+                return 1;
+        }
+    }
+    if (pName == NULL)
+    {
+        pName = HAL_TRACE_DEFAULT_NAME;
+    }
+    pSegment = hal_trace_open(pName);
+    pRecords = malloc(sizeof(hal_trace_record_t) * READER_CAPACITY);
+    if (pSegment == NULL || pRecords == NULL)
+    {
+        fprintf(stderr, "hal_trace_reader: cannot map %s\n", pName);
+        return 1;
+    }
+    signal(SIGINT, on_signal);
+    signal(SIGTERM, on_signal);
+    setvbuf(stdout, NULL, _IOFBF, 1 << 16);
+    clock_start(&clock);
+
+    do
+    {
+        uint32_t count;
+        uint32_t i;
+
+        if (!once)
+        {
+            usleep(intervalMs * 1000);
+        }
+        count = hal_trace_drain(pSegment, pRecords, READER_CAPACITY);
+        clock_update(&clock);
+        qsort(pRecords, count, sizeof(hal_trace_record_t), by_start);
+        for (i = 0; i < count; i++)
+        {
+            double duration = pRecords[i].duration * clock.nsPerTick;
+            uint32_t durationNs = (duration >= UINT32_MAX) ? UINT32_MAX : (uint32_t)duration;
+
+            if (summary)
+            {
+                summarise(&pRecords[i], durationNs);
+            }
+            else
+            {
+                char name[16];
+
+                printf("%llu %u %u %s %u %d\n", (unsigned long long)clock_ns(&clock, pRecords[i].start), pRecords[i].pid,
+                       pRecords[i].tid, function_name(pSegment, pRecords[i].function, name, sizeof(name)), durationNs,
+                       pRecords[i].status);
+            }
+        }
+        total += count;
+        fflush(stdout);
+    } while (!once && !gStop);
+
+    if (summary)
+    {
+        print_summary(pSegment);
+    }
+    fprintf(stderr, "hal_trace_reader: %llu calls read, %llu dropped for a full ring, %llu made with no ring free\n",
+            (unsigned long long)total, (unsigned long long)hal_trace_dropped(pSegment),
+            (unsigned long long)__atomic_load_n(&pSegment->untraced, __ATOMIC_RELAXED));
+    if (unlinkOnExit)
+    {
+        hal_trace_unlink(pName);
+    }
+    hal_trace_close(pSegment);
+    free(pRecords);
+    return 0;
+}
@@ -0,0 +1,454 @@
+/*
+* If not stated otherwise in this file or this component's LICENSE file the
+* following copyright and licenses apply:*
+* Copyright 2023 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+/**
+* @file sysevent_standin.c
+*
+* Minimal syseventd stand-in, so that lease notifications work on plain Linux.
+*
+* daemon: keeps key/value tuples and notifies the connections that asked
+*         for a key whenever it is set. One request per line on a UNIX
+*         stream socket, as described in skeletons/include/dhcp_sysevent.h:
+*         "SET key value", "GET key" and "NOTIFY key".
+* set/get: one request from the command line, like the sysevent utility,
+*         for DHCP client scripts and manual tests.
+*
+* The socket is -s, else $DHCP_SYSEVENT_SOCKET, else /tmp/sysevent_standin.sock.
+* The daemon serves every connection from one poll() loop, so requests are
+* handled in the order they arrive and a notification is queued before the
+* reply to the SET that caused it.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <signal.h>
+#include <unistd.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+#define STANDIN_DEFAULT_SOCKET  "/tmp/sysevent_standin.sock"
+#define STANDIN_SOCKET_ENV      "DHCP_SYSEVENT_SOCKET"
+#define STANDIN_MAX_CLIENTS     64
+#define STANDIN_MAX_TUPLES      128
+#define STANDIN_MAX_NOTIFY      16      /* Keys one connection may ask for */
+#define STANDIN_KEY_LEN         64      /* As DHCP_SYSEVENT_KEY_LEN */
+#define STANDIN_VALUE_LEN       256     /* As DHCP_SYSEVENT_VALUE_LEN */
+#define STANDIN_LINE_LEN        (STANDIN_KEY_LEN + STANDIN_VALUE_LEN + 16)
+
+typedef struct
+{
+    char key[STANDIN_KEY_LEN];
+    char value[STANDIN_VALUE_LEN];
+} tuple_t;
+
+typedef struct
+{
+    int    fd;
+    size_t used;
+    char   buffer[STANDIN_LINE_LEN];
+    int    notifyCount;
+    char   notify[STANDIN_MAX_NOTIFY][STANDIN_KEY_LEN];
+} client_t;
+
+static volatile sig_atomic_t gStop = 0;
+static tuple_t gTuples[STANDIN_MAX_TUPLES];
+static int gTupleCount;
+static client_t gClients[STANDIN_MAX_CLIENTS];
+
+static void on_signal( int signum )
+{
+    (void)signum;
+    gStop = 1;
+}
+
+static const char *socket_path( const char *pOption )
+{
+    const char *pEnv = getenv(STANDIN_SOCKET_ENV);
+
+    if (pOption != NULL)
+    {
+        return pOption;
+    }
+    return (pEnv != NULL && pEnv[0] != '\0') ? pEnv : STANDIN_DEFAULT_SOCKET;
+}
+
+static int make_address( const char *pPath, struct sockaddr_un *pAddress )
+{
+    if (strlen(pPath) >= sizeof(pAddress->sun_path))
+    {
+        fprintf(stderr, "sysevent_standin: socket path too long: %s\n", pPath);
+        return -1;
+    }
+    memset(pAddress, 0, sizeof(*pAddress));
+    pAddress->sun_family = AF_UNIX;
+    strcpy(pAddress->sun_path, pPath);
+    return 0;
+}
+
+static void drop_client( client_t *pClient )
+{
+    close(pClient->fd);
+    memset(pClient, 0, sizeof(*pClient));
+    pClient->fd = -1;
+}
+
+/* A client that does not keep up with its notifications is dropped rather than waited for */
+static void send_text( client_t *pClient, const char *pText )
+{
+    size_t length = strlen(pText);
+
+    if (send(pClient->fd, pText, length, MSG_NOSIGNAL | MSG_DONTWAIT) != (ssize_t)length)
+    {
+        drop_client(pClient);
+    }
+}
+
+static tuple_t *find_tuple( const char *pKey )
+{
+    int i;
+
+    for (i = 0; i < gTupleCount; i++)
+    {
+        if (strcmp(gTuples[i].key, pKey) == 0)
+        {
+            return &gTuples[i];
+        }
+    }
+    return NULL;
+}
+
+static void notify( const char *pKey, const char *pValue )
+{
+    char line[STANDIN_LINE_LEN];
+    int i;
+    int j;
+
+    snprintf(line, sizeof(line), "EVENT %s %s\n", pKey, pValue);
+    for (i = 0; i < STANDIN_MAX_CLIENTS; i++)
+    {
+        for (j = 0; gClients[i].fd >= 0 && j < gClients[i].notifyCount; j++)
+        {
+            if (strcmp(gClients[i].notify[j], pKey) == 0)
+            {
+                send_text(&gClients[i], line);
+                break;
+            }
+        }
+    }
+}
+
+static void handle_line( client_t *pClient, char *pLine )
+{
+    char reply[STANDIN_LINE_LEN];
+    char *pKey;
+    char *pValue;
+    tuple_t *pTuple;
+
+    pKey = strchr(pLine, ' ');
+    if (pKey == NULL)
+    {
+        send_text(pClient, "ERROR\n");
+        return;
+    }
+    *pKey++ = '\0';
+    pValue = strchr(pKey, ' ');
+    if (pValue != NULL)
+    {
+        *pValue++ = '\0';
+    }
+    if (pKey[0] == '\0' || strlen(pKey) >= STANDIN_KEY_LEN || (pValue != NULL && strlen(pValue) >= STANDIN_VALUE_LEN))
+    {
+        send_text(pClient, "ERROR\n");
+        return;
+    }
+
+    if (strcmp(pLine, "SET") == 0)
+    {
+        pTuple = find_tuple(pKey);
+        if (pTuple == NULL && gTupleCount == STANDIN_MAX_TUPLES)
+        {
+            send_text(pClient, "ERROR\n");
+            return;
+        }
+        if (pTuple == NULL)
+        {
+            pTuple = &gTuples[gTupleCount++];
+            strcpy(pTuple->key, pKey);
+        }
+        strcpy(pTuple->value, (pValue != NULL) ? pValue : "");
+        notify(pKey, pTuple->value);
+        if (pClient->fd >= 0)
+        {
+            send_text(pClient, "OK\n");
+        }
+    }
+    else if (strcmp(pLine, "GET") == 0)
+    {
+        pTuple = find_tuple(pKey);
+        if (pTuple == NULL)
+        {
+            send_text(pClient, "NONE\n");
+            return;
+        }
+        snprintf(reply, sizeof(reply), "VALUE %s\n", pTuple->value);
+        send_text(pClient, reply);
+    }
+    else if (strcmp(pLine, "NOTIFY") == 0 && pClient->notifyCount < STANDIN_MAX_NOTIFY)
+    {
+        strcpy(pClient->notify[pClient->notifyCount++], pKey);
+        send_text(pClient, "OK\n");
+    }
+    else
+    {
+        send_text(pClient, "ERROR\n");
+    }
+}
+
+static void read_client( client_t *pClient )
+{
+    ssize_t got = recv(pClient->fd, &pClient->buffer[pClient->used], sizeof(pClient->buffer) - pClient->used, 0);
+    char *pStart;
+    char *pEnd;
+
+    if (got <= 0)
+    {
+        if (got == 0 || errno != EINTR)
+        {
+            drop_client(pClient);
+        }
+        return;
+    }
+    pClient->used += (size_t)got;
+    pStart = pClient->buffer;
+    while (pClient->fd >= 0 && (pEnd = memchr(pStart, '\n', pClient->used - (size_t)(pStart - pClient->buffer))) != NULL)
+    {
+        *pEnd = '\0';
+        handle_line(pClient, pStart);
+        pStart = pEnd + 1;
+    }
+    if (pClient->fd < 0)
+    {
+        return;
+    }
+    pClient->used -= (size_t)(pStart - pClient->buffer);
+    memmove(pClient->buffer, pStart, pClient->used);
+    if (pClient->used == sizeof(pClient->buffer))
+    {
+        /* No request is that long */
+        drop_client(pClient);
+    }
+}
+
+static int run_daemon( const char *pPath )
+{
+    struct pollfd fds[STANDIN_MAX_CLIENTS + 1];
+    struct sockaddr_un address;
+    int listener;
+    int fd;
+    int i;
+
+    if (make_address(pPath, &address) != 0)
+    {
+        return 1;
+    }
+    listener = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (listener < 0)
+    {
+        perror("sysevent_standin: socket");
+        return 1;
+    }
+    unlink(pPath);
+    if (bind(listener, (struct sockaddr *)&address, sizeof(address)) != 0 || listen(listener, 16) != 0)
+    {
+        fprintf(stderr, "sysevent_standin: cannot listen on %s: %s\n", pPath, strerror(errno));
+        close(listener);
+        return 1;
+    }
+    for (i = 0; i < STANDIN_MAX_CLIENTS; i++)
+    {
+        gClients[i].fd = -1;
+    }
+    printf("READY %s\n", pPath);
+    fflush(stdout);
+
+    while (!gStop)
+    {
+        fds[0].fd = listener;
+        fds[0].events = POLLIN;
+        for (i = 0; i < STANDIN_MAX_CLIENTS; i++)
+        {
+            fds[i + 1].fd = gClients[i].fd;
+            fds[i + 1].events = POLLIN;
+            fds[i + 1].revents = 0;
+        }
+        if (poll(fds, STANDIN_MAX_CLIENTS + 1, 500) < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            perror("sysevent_standin: poll");
+            break;
+        }
+        for (i = 0; i < STANDIN_MAX_CLIENTS; i++)
+        {
+            if (gClients[i].fd >= 0 && fds[i + 1].revents != 0)
+            {
+                read_client(&gClients[i]);
+            }
+        }
+        if (fds[0].revents & POLLIN)
+        {
+            fd = accept(listener, NULL, NULL);
+            for (i = 0; fd >= 0 && i < STANDIN_MAX_CLIENTS && gClients[i].fd >= 0; i++)
+            {
+            }
+            if (fd >= 0 && i == STANDIN_MAX_CLIENTS)
+            {
+                fprintf(stderr, "sysevent_standin: too many connections\n");
+                close(fd);
+            }
+            else if (fd >= 0)
+            {
+                gClients[i].fd = fd;
+            }
+        }
+    }
+
+    for (i = 0; i < STANDIN_MAX_CLIENTS; i++)
+    {
+        if (gClients[i].fd >= 0)
+        {
+            close(gClients[i].fd);
+        }
+    }
+    close(listener);
+    unlink(pPath);
+    return 0;
+}
+
+/* Sends one request and prints the reply; exits 0 on OK or VALUE, 1 otherwise */
+static int run_request( const char *pPath, const char *pRequest )
+{
+    char reply[STANDIN_LINE_LEN];
+    struct sockaddr_un address;
+    size_t used = 0;
+    ssize_t got;
+    int fd;
+
+    if (make_address(pPath, &address) != 0)
+    {
+        return 1;
+    }
+    fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0 || connect(fd, (struct sockaddr *)&address, sizeof(address)) != 0)
+    {
+        fprintf(stderr, "sysevent_standin: cannot connect to %s: %s\n", pPath, strerror(errno));
+        if (fd >= 0)
+        {
+            close(fd);
+        }
+        return 1;
+    }
+    if (send(fd, pRequest, strlen(pRequest), MSG_NOSIGNAL) != (ssize_t)strlen(pRequest))
+    {
+        close(fd);
+        return 1;
+    }
+    while (used < sizeof(reply) - 1 && memchr(reply, '\n', used) == NULL)
+    {
+        got = recv(fd, &reply[used], sizeof(reply) - 1 - used, 0);
+        if (got <= 0)
+        {
+            break;
+        }
+        used += (size_t)got;
+    }
+    close(fd);
+    reply[used] = '\0';
+    if (strncmp(reply, "VALUE ", 6) == 0)
+    {
+        fputs(&reply[6], stdout);
+        return 0;
+    }
+    return (strcmp(reply, "OK\n") == 0) ? 0 : 1;
+}
+
+static void usage( void )
+{
+    fprintf(stderr,
+            "Usage: sysevent_standin daemon [-s socket]\n"
+            "       sysevent_standin set key value [-s socket]\n"
+            "       sysevent_standin get key [-s socket]\n");
+}
+
+int main( int argc, char **argv )
+{
+    char request[STANDIN_LINE_LEN];
+    const char *pSocket = NULL;
+    const char *pArgs[2] = { NULL, NULL };
+    struct sigaction sa;
+    int count = 0;
+    int i;
+
+    for (i = 2; i < argc; i++)
+    {
+        if (strcmp(argv[i], "-s") == 0 && i + 1 < argc)
+        {
+            pSocket = argv[++i];
+        }
+        else if (count < 2)
+        {
+            pArgs[count++] = argv[i];
+        }
+        else
+        {
+            count = -1;
+            break;
+        }
+    }
+    if (argc < 2 || count < 0)
+    {
+        usage();
+        return 2;
+    }
+
+    if (strcmp(argv[1], "daemon") == 0 && count == 0)
+    {
+        memset(&sa, 0, sizeof(sa));
+        sa.sa_handler = on_signal;
+        sigaction(SIGTERM, &sa, NULL);
+        sigaction(SIGINT, &sa, NULL);
+        return run_daemon(socket_path(pSocket));
+    }
+    if (strcmp(argv[1], "set") == 0 && count == 2 && strchr(pArgs[0], ' ') == NULL &&
+        strchr(pArgs[1], '\n') == NULL && snprintf(request, sizeof(request), "SET %s %s\n", pArgs[0], pArgs[1]) < (int)sizeof(request))
+    {
+        return run_request(socket_path(pSocket), request);
+    }
+    if (strcmp(argv[1], "get") == 0 && count == 1 && strchr(pArgs[0], ' ') == NULL &&
+        snprintf(request, sizeof(request), "GET %s\n", pArgs[0]) < (int)sizeof(request))
+    {
+        return run_request(socket_path(pSocket), request);
+    }
+    usage();
+    return 2;
+}